@@ -0,0 +1,112 @@
+#pragma once
+/*
+ * Copyright (c) 2025 Chenhui Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lux::cxx
+{
+    /**
+     * @brief Whether moving a @p T to a new address and destroying the source can
+     *        be replaced by copying its bytes (and not running the destructor).
+     *
+     * Defaults to true for trivially copyable types. Specialize it to opt a type in:
+     * a type qualifies when no part of it points into the object itself and nothing
+     * outside tracks its address.
+     *
+     * @code
+     * template <> struct lux::cxx::is_trivially_relocatable<MyHandle> : std::true_type {};
+     * @endcode
+     */
+    template <class T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    template <class T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+    // ---- standard library types --------------------------------------------
+
+    template <class T, class Deleter>
+    struct is_trivially_relocatable<std::unique_ptr<T, Deleter>>
+        : is_trivially_relocatable<Deleter> {};
+
+    template <class T>
+    struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+    template <class T>
+    struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+    template <class First, class Second>
+    struct is_trivially_relocatable<std::pair<First, Second>>
+        : std::bool_constant<is_trivially_relocatable_v<First> && is_trivially_relocatable_v<Second>> {};
+
+    // Checked-iterator builds keep a proxy that points back at the container.
+#if !defined(_GLIBCXX_DEBUG) && !(defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL != 0)
+    template <class T>
+    struct is_trivially_relocatable<std::vector<T, std::allocator<T>>> : std::true_type {};
+#endif
+
+    // libstdc++ points a short string at its own inline buffer, so only libc++
+    // and release-mode MSVC strings may be byte-copied.
+#if defined(_LIBCPP_VERSION) || (defined(_MSC_VER) && defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL == 0)
+    template <class CharT, class Traits>
+    struct is_trivially_relocatable<std::basic_string<CharT, Traits, std::allocator<CharT>>> : std::true_type {};
+#endif
+
+    // ---- relocation helpers ------------------------------------------------
+
+    /**
+     * @brief Relocates [@p first, @p last) to @p dest with one memmove; the ranges may overlap.
+     *
+     * Afterwards the source range holds no objects and must not be destroyed.
+     */
+    template <class T>
+    T* trivially_relocate(T* first, T* last, T* dest) noexcept
+    {
+        static_assert(is_trivially_relocatable_v<T>, "trivially_relocate: T is not trivially relocatable");
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (n != 0 && first != dest)
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+        return dest + n;
+    }
+
+    /**
+     * @brief Exchanges two trivially relocatable objects byte-wise, without
+     *        calling their move constructors or assignment operators.
+     */
+    template <class T>
+    void relocating_swap(T& a, T& b) noexcept
+    {
+        static_assert(is_trivially_relocatable_v<T>, "relocating_swap: T is not trivially relocatable");
+        alignas(T) std::byte tmp[sizeof(T)];
+        std::memcpy(tmp, static_cast<const void*>(std::addressof(a)), sizeof(T));
+        std::memcpy(static_cast<void*>(std::addressof(a)), static_cast<const void*>(std::addressof(b)), sizeof(T));
+        std::memcpy(static_cast<void*>(std::addressof(b)), tmp, sizeof(T));
+    }
+
+} // namespace lux::cxx
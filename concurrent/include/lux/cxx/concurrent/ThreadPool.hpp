@@ -256,6 +256,54 @@ namespace lux::cxx
             return fut;
         }
 
+        /**
+         * @brief Runs @p func(i) for every i in [0, count) and waits for all of them
+         *
+         * @tparam Func Callable taking a std::size_t index
+         * @param count Number of calls
+         * @param func Function to execute; shared by reference between the calls
+         * @throws The first exception thrown by any call, after every call has finished
+         *
+         * Index 0 runs on the calling thread and the others are submitted as tasks,
+         * so callers usually pass thread_count() + 1. Must not be called from a task
+         * running on this pool.
+         */
+        template <typename Func>
+        requires std::invocable<Func&, std::size_t>
+        void parallel_for(std::size_t count, Func&& func)
+        {
+            if (count == 0) return;
+
+            std::vector<std::future<void>> pending;
+            pending.reserve(count - 1);
+#if ENABLE_EXCEPTIONS
+            std::exception_ptr error;
+            try {
+#endif
+                for (std::size_t i = 1; i < count; ++i)
+                    pending.push_back(submit([&func, i] { func(i); }));
+                func(std::size_t(0));
+#if ENABLE_EXCEPTIONS
+            }
+            catch (...) { error = std::current_exception(); }
+#endif
+            // Every task references func, so wait for all of them before reporting.
+            for (auto& f : pending) f.wait();
+#if ENABLE_EXCEPTIONS
+            for (auto& f : pending)
+            {
+                try { f.get(); }
+                catch (...) { if (!error) error = std::current_exception(); }
+            }
+            if (error) std::rethrow_exception(error);
+#endif
+        }
+
+        /**
+         * @brief Returns the number of worker threads
+         */
+        std::size_t thread_count() const noexcept { return _workers.size(); }
+
         /**
          * @brief Closes the thread pool, preventing new tasks from being submitted
          * 
@@ -55,6 +55,27 @@ int main()
     std::this_thread::sleep_for(120ms);
     h_token.request_stop();
 
+    /*------------------------------------------------------------
+     * 3. parallel_for：调用线程执行 0 号，等待全部完成并转发异常
+     *-----------------------------------------------------------*/
+    assert(pool.thread_count() == 5);
+
+    std::vector<int> hits(pool.thread_count() + 1, 0);
+    pool.parallel_for(hits.size(), [&hits](std::size_t i) { hits[i] += int(i) + 1; });
+    for (std::size_t i = 0; i < hits.size(); ++i) assert(hits[i] == int(i) + 1);
+
+    std::atomic<int> finished{ 0 };
+    try {
+        pool.parallel_for(4, [&finished](std::size_t i) {
+            std::this_thread::sleep_for(10ms);
+            ++finished;
+            if (i == 2) throw std::runtime_error("chunk 2");
+            });
+        assert(false);
+    }
+    catch (const std::runtime_error&) {}
+    assert(finished == 4);
+
     /* 现在再关闭线程池 */
     pool.close();
 
@@ -63,7 +84,7 @@ int main()
     assert(loops > 0);
 
     /*------------------------------------------------------------
-     * 3. 关闭后的 submit 必须抛异常
+     * 4. 关闭后的 submit 必须抛异常
      *-----------------------------------------------------------*/
     try {
         pool.submit([] {});
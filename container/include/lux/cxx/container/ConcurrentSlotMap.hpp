@@ -0,0 +1,572 @@
+#pragma once
+/**
+ * @file ConcurrentSlotMap.hpp
+ * @brief A thread-safe slot map with wait-free lookups, sharded writers and
+ *        epoch-based reclamation of erased values.
+ *
+ * @copyright
+ * Copyright (c) 2025 Chenhui Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <lux/cxx/container/SlotMap.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lux::cxx
+{
+    /**
+     * @class ConcurrentSlotMap
+     * @brief Slot map safe for concurrent readers and writers.
+     *
+     * Layout:
+     * - **Slots** live in fixed-size chunks reached through a fixed chunk directory.
+     *   Chunks are allocated on demand and never move, so a slot address is stable
+     *   for the lifetime of the map.
+     * - Every slot holds an atomic pointer to a heap **node** carrying the value, and the
+     *   slot's atomic generation. A lookup is a few acquire loads of the chunk pointer,
+     *   the node pointer and the generation, followed by a compare. It never touches the
+     *   node, so find() and is_valid() are wait-free and need no pin.
+     * - Free slot indices are kept in **sharded free lists**; a writer uses the shard
+     *   picked for its thread and only steals from other shards when its own is empty.
+     * - Erased (or replaced) nodes are **retired**, and freed only once no reader that
+     *   might still see them remains pinned (epoch-based reclamation).
+     *
+     * Readers must hold a ReadGuard (see pin()) while they dereference pointers returned
+     * by find() or use for_each(); pinning is lock-free and touches only a per-thread record.
+     * Values are published immutably: use assign() to replace a value (RCU style).
+     *
+     * @tparam Value     The element type.
+     * @tparam Tag       Type tag forwarded to SlotKey for compile-time discrimination.
+     * @tparam ChunkSize Slots per chunk.
+     * @tparam MaxChunks Size of the chunk directory; capacity is ChunkSize * MaxChunks.
+     */
+    template <typename Value, typename Tag = void, std::size_t ChunkSize = 4096, std::size_t MaxChunks = 1024>
+    class ConcurrentSlotMap
+    {
+        static_assert(ChunkSize > 0 && MaxChunks > 0,
+            "ConcurrentSlotMap: ChunkSize and MaxChunks must be > 0");
+        static_assert(ChunkSize * MaxChunks < (std::numeric_limits<std::uint32_t>::max)(),
+            "ConcurrentSlotMap: capacity must fit a 32-bit slot index");
+
+    public:
+        using key_t        = SlotKey<Tag, std::uint32_t, std::uint32_t>;
+        using value_t      = Value;
+        using size_t       = std::size_t;
+        using index_t      = typename key_t::index_t;
+        using generation_t = typename key_t::generation_t;
+
+        /** @brief Number of writer shards (free lists and retire lists). */
+        static constexpr size_t SHARD_COUNT = 16;
+        /** @brief Maximum number of simultaneously pinned readers. */
+        static constexpr size_t MAX_READERS = 256;
+        /** @brief Retired nodes per shard that trigger a reclamation attempt. */
+        static constexpr size_t RECLAIM_THRESHOLD = 64;
+
+        static constexpr size_t CAPACITY = ChunkSize * MaxChunks;
+
+    private:
+        struct Node
+        {
+            template <typename... Args>
+            explicit Node(generation_t gen, Args&&... args)
+                : value(std::forward<Args>(args)...), generation(gen)
+            {
+            }
+
+            Value         value;
+            generation_t  generation;       ///< Generation this node was published with.
+            std::uint64_t retire_epoch = 0; ///< Global epoch at retirement.
+        };
+
+        struct Slot
+        {
+            std::atomic<Node*>        node{ nullptr };
+            /// Generation of the live node, or of the next insert while the slot is free.
+            /// Only the slot's current writer stores it.
+            std::atomic<generation_t> generation{ 1 };
+        };
+
+        struct alignas(64) ReaderRecord
+        {
+            std::atomic<std::uint64_t> epoch{ 0 };    ///< Announced epoch, 0 when not pinned.
+            std::atomic<bool>          in_use{ false };
+        };
+
+        struct alignas(64) Shard
+        {
+            std::mutex           mutex;
+            std::vector<index_t> free_indices;
+            std::vector<Node*>   retired;
+        };
+
+    public:
+        /**
+         * @brief RAII pin that keeps every node visible to this reader alive.
+         *
+         * Pointers obtained from find() stay valid until the guard is destroyed,
+         * even if the element is concurrently erased.
+         */
+        class ReadGuard
+        {
+        public:
+            ReadGuard(ReadGuard&& other) noexcept
+                : record_(std::exchange(other.record_, nullptr))
+            {
+            }
+
+            ReadGuard(const ReadGuard&)            = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+            ReadGuard& operator=(ReadGuard&&)      = delete;
+
+            ~ReadGuard()
+            {
+                if (record_)
+                {
+                    record_->epoch.store(0, std::memory_order_release);
+                    record_->in_use.store(false, std::memory_order_release);
+                }
+            }
+
+        private:
+            friend class ConcurrentSlotMap;
+            explicit ReadGuard(ReaderRecord* record) noexcept : record_(record) {}
+
+            ReaderRecord* record_;
+        };
+
+        // ---- constructors ---------------------------------------------------
+
+        ConcurrentSlotMap() = default;
+
+        ConcurrentSlotMap(const ConcurrentSlotMap&)            = delete;
+        ConcurrentSlotMap& operator=(const ConcurrentSlotMap&) = delete;
+
+        /**
+         * @brief Destroys all live and retired values. No thread may access the map concurrently.
+         */
+        ~ConcurrentSlotMap()
+        {
+            for (auto& chunk_ptr : chunks_)
+            {
+                Slot* chunk = chunk_ptr.load(std::memory_order_acquire);
+                if (!chunk)
+                    continue;
+                for (size_t i = 0; i < ChunkSize; ++i)
+                    delete chunk[i].node.load(std::memory_order_relaxed);
+                delete[] chunk;
+            }
+            for (auto& shard : shards_)
+                for (Node* node : shard.retired)
+                    delete node;
+        }
+
+        // ---- readers --------------------------------------------------------
+
+        /**
+         * @brief Pins the calling thread so that nodes it reads are not reclaimed.
+         *
+         * Lock-free: claims a reader record (normally the one this thread used last)
+         * and announces the current epoch.
+         */
+        [[nodiscard]] ReadGuard pin()
+        {
+            ReaderRecord* record = acquire_record();
+            // seq_cst: the epoch read is ordered against the fence retire() issues after an unlink.
+            record->epoch.store(global_epoch_.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+            // Pairs with the fence in try_reclaim(): either the reclaimer sees this
+            // announcement, or every later load here observes the unlinked slot.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return ReadGuard(record);
+        }
+
+        /**
+         * @brief Checks whether a key is currently valid. Wait-free; needs no pin.
+         */
+        [[nodiscard]] bool is_valid(key_t key) const noexcept
+        {
+            return load_node(key) != nullptr;
+        }
+
+        /**
+         * @brief Returns a pointer to the value, or nullptr if the key is stale. Wait-free.
+         *
+         * The lookup itself needs no pin, but the pointer may only be dereferenced
+         * while a ReadGuard from pin() is alive.
+         */
+        [[nodiscard]] const Value* find(key_t key) const noexcept
+        {
+            Node* node = load_node(key);
+            return node ? &node->value : nullptr;
+        }
+
+        /**
+         * @brief Pins, looks up @p key and calls `func(const Value&)` if it is present.
+         * @return True if the key was valid and @p func was called.
+         */
+        template <typename Func>
+        bool read(key_t key, Func&& func)
+        {
+            auto guard = pin();
+            if (const Value* value = find(key))
+            {
+                std::invoke(std::forward<Func>(func), *value);
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Calls `func(key_t, const Value&)` for every live element.
+         *
+         * Must be called while pinned. Elements inserted or erased concurrently may
+         * or may not be visited.
+         */
+        template <typename Func>
+        void for_each(Func&& func) const
+        {
+            const size_t end = (std::min)(next_index_.load(std::memory_order_acquire), CAPACITY);
+            for (size_t c = 0; c * ChunkSize < end; ++c)
+            {
+                Slot* chunk = chunks_[c].load(std::memory_order_acquire);
+                if (!chunk)
+                    continue;
+                for (size_t i = 0; i < ChunkSize && c * ChunkSize + i < end; ++i)
+                {
+                    if (Node* node = chunk[i].node.load(std::memory_order_acquire))
+                        func(key_t{ static_cast<index_t>(c * ChunkSize + i), node->generation }, node->value);
+                }
+            }
+        }
+
+        // ---- writers --------------------------------------------------------
+
+        key_t insert(const Value& value) { return emplace(value); }
+        key_t insert(Value&& value)      { return emplace(std::move(value)); }
+
+        /**
+         * @brief Constructs a value in-place and publishes it. Returns the handle.
+         * @throws std::length_error if all CAPACITY slots are in use.
+         */
+        template <typename... Args>
+        key_t emplace(Args&&... args)
+        {
+            const index_t idx  = acquire_index();
+            Slot&         slot = slot_at(idx);
+            Node*         node = nullptr;
+            try
+            {
+                node = new Node(slot.generation.load(std::memory_order_relaxed), std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                release_index(idx);
+                throw;
+            }
+            slot.node.store(node, std::memory_order_release);
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return key_t{ idx, node->generation };
+        }
+
+        /**
+         * @brief Replaces the value of a live key with a newly constructed one (RCU style).
+         *
+         * Readers holding the previous value keep seeing it until they unpin.
+         * @return True if the key was valid and its value replaced.
+         */
+        template <typename... Args>
+        bool assign(key_t key, Args&&... args)
+        {
+            Slot* slot = find_slot(key);
+            if (!slot)
+                return false;
+
+            auto  guard       = pin();
+            Node* replacement = new Node(key.gen, std::forward<Args>(args)...);
+            Node* current     = slot->node.load(std::memory_order_acquire);
+            while (current && current->generation == key.gen)
+            {
+                if (slot->node.compare_exchange_weak(current, replacement,
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    Shard& shard = local_shard();
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    retire(shard, current);
+                    return true;
+                }
+            }
+            delete replacement;
+            return false;
+        }
+
+        /**
+         * @brief Removes the element identified by @p key.
+         * @return True if the element was erased, false if the key was stale or invalid.
+         *
+         * The value is destroyed once no pinned reader can still observe it.
+         */
+        bool erase(key_t key)
+        {
+            Slot* slot = find_slot(key);
+            if (!slot)
+                return false;
+
+            auto  guard   = pin();
+            Node* current = slot->node.load(std::memory_order_acquire);
+            while (current && current->generation == key.gen)
+            {
+                if (slot->node.compare_exchange_weak(current, nullptr,
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    // Winning the CAS makes this thread the slot's exclusive owner.
+                    generation_t next = slot->generation.load(std::memory_order_relaxed) + 1;
+                    if (next == 0)
+                        next = 1;
+                    slot->generation.store(next, std::memory_order_release);
+
+                    Shard& shard = local_shard();
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    shard.free_indices.push_back(key.index);
+                    retire(shard, current);
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Frees every retired node that no pinned reader can still observe.
+         * @return The number of nodes freed.
+         */
+        size_t collect()
+        {
+            size_t freed = 0;
+            for (auto& shard : shards_)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                freed += try_reclaim(shard);
+            }
+            return freed;
+        }
+
+        // ---- capacity -------------------------------------------------------
+
+        /**
+         * @brief Number of live elements (a snapshot under concurrent writes).
+         */
+        [[nodiscard]] size_t size()  const noexcept { return size_.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool   empty() const noexcept { return size() == 0; }
+
+        /**
+         * @brief Number of retired nodes awaiting reclamation.
+         */
+        [[nodiscard]] size_t retired_count()
+        {
+            size_t count = 0;
+            for (auto& shard : shards_)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                count += shard.retired.size();
+            }
+            return count;
+        }
+
+    private:
+        // ---- slot addressing ------------------------------------------------
+
+        Slot& slot_at(index_t idx) const noexcept
+        {
+            return chunks_[idx / ChunkSize].load(std::memory_order_acquire)[idx % ChunkSize];
+        }
+
+        Slot* find_slot(key_t key) const noexcept
+        {
+            if (key.is_null() || key.index >= CAPACITY)
+                return nullptr;
+            Slot* chunk = chunks_[key.index / ChunkSize].load(std::memory_order_acquire);
+            return chunk ? &chunk[key.index % ChunkSize] : nullptr;
+        }
+
+        Node* load_node(key_t key) const noexcept
+        {
+            Slot* slot = find_slot(key);
+            if (!slot)
+                return nullptr;
+            // A node published after an erase is ordered after the bumped generation,
+            // so a stale key never matches a newer node. The second node load rejects
+            // a node that was unlinked before the generation we compared against.
+            Node* node = slot->node.load(std::memory_order_acquire);
+            if (!node || slot->generation.load(std::memory_order_acquire) != key.gen)
+                return nullptr;
+            return slot->node.load(std::memory_order_acquire) == node ? node : nullptr;
+        }
+
+        void ensure_chunk(size_t c)
+        {
+            if (chunks_[c].load(std::memory_order_acquire))
+                return;
+            Slot*  fresh    = new Slot[ChunkSize];
+            Slot*  expected = nullptr;
+            if (!chunks_[c].compare_exchange_strong(expected, fresh,
+                    std::memory_order_acq_rel, std::memory_order_acquire))
+                delete[] fresh; // another writer installed the chunk first
+        }
+
+        // ---- sharded free lists ---------------------------------------------
+
+        Shard& local_shard() noexcept
+        {
+            thread_local const size_t shard_hint =
+                std::hash<std::thread::id>{}(std::this_thread::get_id()) % SHARD_COUNT;
+            return shards_[shard_hint];
+        }
+
+        index_t acquire_index()
+        {
+            Shard& own = local_shard();
+            {
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.free_indices.empty())
+                {
+                    index_t idx = own.free_indices.back();
+                    own.free_indices.pop_back();
+                    return idx;
+                }
+            }
+            // Steal from other shards before growing, so indices freed by one
+            // thread are reused by another.
+            for (auto& shard : shards_)
+            {
+                if (&shard == &own)
+                    continue;
+                std::unique_lock<std::mutex> lock(shard.mutex, std::try_to_lock);
+                if (lock.owns_lock() && !shard.free_indices.empty())
+                {
+                    index_t idx = shard.free_indices.back();
+                    shard.free_indices.pop_back();
+                    return idx;
+                }
+            }
+
+            const size_t idx = next_index_.fetch_add(1, std::memory_order_acq_rel);
+            if (idx >= CAPACITY)
+                throw std::length_error("ConcurrentSlotMap: capacity exhausted");
+            ensure_chunk(idx / ChunkSize);
+            return static_cast<index_t>(idx);
+        }
+
+        void release_index(index_t idx)
+        {
+            Shard& shard = local_shard();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.free_indices.push_back(idx);
+        }
+
+        // ---- epoch-based reclamation ----------------------------------------
+
+        ReaderRecord* acquire_record()
+        {
+            thread_local size_t record_hint = 0;
+            for (;;)
+            {
+                for (size_t n = 0; n < MAX_READERS; ++n)
+                {
+                    const size_t i = (record_hint + n) % MAX_READERS;
+                    bool expected  = false;
+                    if (!readers_[i].in_use.load(std::memory_order_relaxed) &&
+                        readers_[i].in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    {
+                        record_hint = i;
+                        return &readers_[i];
+                    }
+                }
+                // More than MAX_READERS concurrent pins: wait for one to finish.
+                std::this_thread::yield();
+            }
+        }
+
+        /** @brief Queues @p node for reclamation. Requires @p shard.mutex. */
+        void retire(Shard& shard, Node* node)
+        {
+            // Orders the caller's unlink before the epoch read: a reader announcing a later
+            // epoch can no longer load the node it is about to be stamped with.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            node->retire_epoch = global_epoch_.load(std::memory_order_seq_cst);
+            shard.retired.push_back(node);
+            if (shard.retired.size() >= RECLAIM_THRESHOLD)
+                try_reclaim(shard);
+        }
+
+        /** @brief Frees the retired nodes of @p shard older than every pinned reader. Requires @p shard.mutex. */
+        size_t try_reclaim(Shard& shard)
+        {
+            global_epoch_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            std::uint64_t min_epoch = (std::numeric_limits<std::uint64_t>::max)();
+            for (auto& reader : readers_)
+            {
+                const std::uint64_t e = reader.epoch.load(std::memory_order_acquire);
+                if (e != 0 && e < min_epoch)
+                    min_epoch = e;
+            }
+
+            size_t freed = 0;
+            auto&  retired = shard.retired;
+            for (size_t i = 0; i < retired.size();)
+            {
+                if (retired[i]->retire_epoch < min_epoch)
+                {
+                    delete retired[i];
+                    retired[i] = retired.back();
+                    retired.pop_back();
+                    ++freed;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            return freed;
+        }
+
+        // ---- data members ---------------------------------------------------
+
+        std::array<std::atomic<Slot*>, MaxChunks> chunks_{};   ///< Fixed chunk directory.
+        alignas(64) std::atomic<size_t>           next_index_{ 0 };
+        alignas(64) std::atomic<size_t>           size_{ 0 };
+        alignas(64) std::atomic<std::uint64_t>    global_epoch_{ 1 };
+        std::array<Shard, SHARD_COUNT>            shards_;
+        std::array<ReaderRecord, MAX_READERS>     readers_;
+    };
+
+} // namespace lux::cxx
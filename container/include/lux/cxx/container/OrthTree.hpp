@@ -22,6 +22,7 @@
  */
 
 #include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -29,7 +30,21 @@
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory_resource>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <lux/cxx/concurrent/ThreadPool.hpp>
 
 namespace lux::cxx
 {
@@ -144,6 +159,44 @@ namespace lux::cxx
             }
             return dist2 <= r2;
         }
+
+        /**
+         * @brief Squared distance from a point to the closest point of this box (0 when inside).
+         * @tparam VecLike A vector-like type whose elements are accessible via operator[].
+         * @param p The point.
+         * @return The squared Euclidean distance.
+         */
+        template <class VecLike>
+        [[nodiscard]] constexpr Scalar distanceSquared(const VecLike& p) const noexcept
+        {
+            Scalar dist2 = Scalar(0);
+            for (std::size_t i = 0; i < Dim; ++i)
+            {
+                Scalar v = Scalar(p[i]);
+                Scalar d = v < min[i] ? min[i] - v : (v > max[i] ? v - max[i] : Scalar(0));
+                dist2 += d * d;
+            }
+            return dist2;
+        }
+
+        /**
+         * @brief Squared distance from a point to the farthest corner of this box.
+         * @tparam VecLike A vector-like type whose elements are accessible via operator[].
+         * @param p The point.
+         * @return The squared Euclidean distance.
+         */
+        template <class VecLike>
+        [[nodiscard]] constexpr Scalar maxDistanceSquared(const VecLike& p) const noexcept
+        {
+            Scalar dist2 = Scalar(0);
+            for (std::size_t i = 0; i < Dim; ++i)
+            {
+                Scalar v = Scalar(p[i]);
+                Scalar d = std::max(v - min[i], max[i] - v);
+                dist2 += d * d;
+            }
+            return dist2;
+        }
     };
 
     /**
@@ -159,12 +212,478 @@ namespace lux::cxx
     template <class PointT>
     struct DefaultGetPosition
     {
-        constexpr decltype(auto) operator()(const PointT& p) const noexcept
+        // A template only so that point types without @c .position make it non-invocable
+        // (std::is_invocable) instead of ill-formed; P is always PointT.
+        template <class P = PointT>
+        constexpr auto operator()(const std::type_identity_t<P>& p) const noexcept -> decltype((p.position))
         {
             return (p.position);
         }
     };
 
+    namespace detail
+    {
+        /// Sort record for Orthtree bulk loading: a point's leaf path code and its source index.
+        struct OrthtreeSortKey
+        {
+            std::uint64_t code;
+            std::uint32_t index;
+        };
+
+        /// Branch-free @c cond ? a : b for floating-point scalars (compilers tend to branch on the ternary).
+        template <class Scalar>
+        Scalar orthtreeSelect(bool cond, Scalar a, Scalar b) noexcept
+        {
+            if constexpr (std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>)
+            {
+                using Bits = std::conditional_t<sizeof(Scalar) == 4, std::uint32_t, std::uint64_t>;
+                const Bits mask = Bits(0) - Bits(cond);
+                return std::bit_cast<Scalar>((std::bit_cast<Bits>(a) & mask) | (std::bit_cast<Bits>(b) & ~mask));
+            }
+            else
+            {
+                return cond ? a : b;
+            }
+        }
+
+        /// Number of chunks to split @p n items into: one per pool thread plus the caller, at least 16K items each.
+        inline std::size_t orthtreeChunkCount(const ThreadPool* pool, std::size_t n) noexcept
+        {
+            constexpr std::size_t kMinChunk = std::size_t(1) << 14;
+            if (pool == nullptr) return 1;
+            return std::max<std::size_t>(1, std::min(pool->thread_count() + 1, n / kMinChunk));
+        }
+
+        /// Runs @p fn(c) for c in [0, @p chunks), on @p pool when there is more than one chunk.
+        template <class Fn>
+        void orthtreeRunChunks(ThreadPool* pool, std::size_t chunks, Fn&& fn)
+        {
+            if (chunks == 1) fn(std::size_t(0));
+            else pool->parallel_for(chunks, fn);
+        }
+
+        /**
+         * @brief Stable LSD radix sort of @p keys by the low @p bits of their code.
+         *
+         * Eight bits per pass; a pass whose digit is the same for every key is skipped.
+         * With a pool every pass histograms and scatters disjoint chunks in parallel,
+         * which keeps the sort stable.
+         */
+        inline void orthtreeRadixSort(std::vector<OrthtreeSortKey>& keys,
+            std::vector<OrthtreeSortKey>& scratch, unsigned bits, ThreadPool* pool)
+        {
+            const std::size_t n = keys.size();
+            scratch.resize(n);
+
+            const std::size_t chunks = orthtreeChunkCount(pool, n);
+            std::vector<std::array<std::size_t, 256>> offsets(chunks);
+
+            for (unsigned shift = 0; shift < bits; shift += 8)
+            {
+                orthtreeRunChunks(pool, chunks, [&](std::size_t c) {
+                    auto& hist = offsets[c];
+                    hist.fill(0);
+                    for (std::size_t i = n * c / chunks, e = n * (c + 1) / chunks; i < e; ++i)
+                        ++hist[(keys[i].code >> shift) & 0xFF];
+                });
+
+                // Exclusive prefix over (digit, chunk) so every chunk scatters into its own slots.
+                std::size_t sum = 0;
+                bool single_digit = false;
+                for (std::size_t d = 0; d < 256; ++d)
+                {
+                    std::size_t digit_total = 0;
+                    for (std::size_t c = 0; c < chunks; ++c)
+                    {
+                        const std::size_t cnt = offsets[c][d];
+                        offsets[c][d] = sum;
+                        sum += cnt;
+                        digit_total += cnt;
+                    }
+                    if (digit_total == n) single_digit = true;
+                }
+                if (single_digit) continue;
+
+                orthtreeRunChunks(pool, chunks, [&](std::size_t c) {
+                    auto& off = offsets[c];
+                    for (std::size_t i = n * c / chunks, e = n * (c + 1) / chunks; i < e; ++i)
+                        scratch[off[(keys[i].code >> shift) & 0xFF]++] = keys[i];
+                });
+                keys.swap(scratch);
+            }
+        }
+
+        /**
+         * @brief Computes the Morton code of the depth-@p levels cell containing a position.
+         *
+         * The code names exactly the path @c Orthtree::insert would take (same centers, same
+         * comparison), with the first level in the most significant bits. Along one axis
+         * that path only depends on the coordinate, and the bisection centers of the
+         * first levels, listed in order, are the boundaries between the cells of that
+         * level. So each axis is located with a table lookup guessed by scaling and
+         * corrected against the neighbouring boundaries. Levels beyond the table are
+         * bisected from the cell's bounds.
+         */
+        template <class Scalar, std::size_t Dim>
+        class OrthtreeMortonEncoder
+        {
+        public:
+            using box_type = Box<Scalar, Dim>;
+
+            /// Deepest level whose child indices fit in a 64-bit code, keeping one bit for an outside marker.
+            static constexpr std::uint32_t kMaxLevels = static_cast<std::uint32_t>(63 / Dim);
+            static constexpr std::uint32_t kTableLevels = 16;
+
+            OrthtreeMortonEncoder(const box_type& root, std::uint32_t levels, std::uint64_t outside)
+                : root_(root), levels_(levels), table_levels_(std::min(levels, kTableLevels)), outside_(outside)
+            {
+                const std::size_t cells = std::size_t(1) << table_levels_;
+                for (std::size_t axis = 0; axis < Dim; ++axis)
+                {
+                    splits_[axis].resize(cells - 1);
+                    fillSplits(splits_[axis], 0, cells, root.min[axis], root.max[axis]);
+                    const Scalar extent = root.max[axis] - root.min[axis];
+                    scale_[axis] = extent > Scalar(0) ? Scalar(cells) / extent : Scalar(0);
+                }
+            }
+
+            template <class VecLike>
+            std::uint64_t operator()(const VecLike& pos) const
+            {
+                if (!root_.contains(pos)) return outside_;
+
+                const std::int64_t last = (std::int64_t(1) << table_levels_) - 1;
+                std::array<std::int64_t, Dim> cell{};
+                for (std::size_t axis = 0; axis < Dim; ++axis)
+                {
+                    const Scalar p = Scalar(pos[axis]);
+                    const auto& splits = splits_[axis];
+                    const Scalar guess = (p - root_.min[axis]) * scale_[axis];
+                    std::int64_t q = guess > Scalar(0) ? static_cast<std::int64_t>(std::min(guess, Scalar(last))) : 0;
+                    while (q > 0 && p < splits[q - 1]) --q;
+                    while (q < last && p >= splits[q]) ++q;
+                    cell[axis] = q;
+                }
+
+                std::uint64_t code = 0;
+                for (std::uint32_t bit = table_levels_; bit-- > 0;)
+                {
+                    std::uint64_t idx = 0;
+                    for (std::size_t axis = 0; axis < Dim; ++axis)
+                        idx |= std::uint64_t((cell[axis] >> bit) & 1) << axis;
+                    code = (code << Dim) | idx;
+                }
+                if (levels_ == table_levels_) return code;
+
+                std::array<Scalar, Dim> lo{};
+                std::array<Scalar, Dim> hi{};
+                for (std::size_t axis = 0; axis < Dim; ++axis)
+                {
+                    const std::int64_t q = cell[axis];
+                    lo[axis] = q == 0 ? root_.min[axis] : splits_[axis][q - 1];
+                    hi[axis] = q == last ? root_.max[axis] : splits_[axis][q];
+                }
+                // Kept branch-free: the comparisons are unpredictable for scattered input.
+                for (std::uint32_t level = table_levels_; level < levels_; ++level)
+                {
+                    std::uint64_t idx = 0;
+                    for (std::size_t axis = 0; axis < Dim; ++axis)
+                    {
+                        const Scalar c = (lo[axis] + hi[axis]) * Scalar(0.5);
+                        const bool upper = Scalar(pos[axis]) >= c;
+                        idx |= std::uint64_t(upper) << axis;
+                        lo[axis] = orthtreeSelect(upper, c, lo[axis]);
+                        hi[axis] = orthtreeSelect(upper, hi[axis], c);
+                    }
+                    code = (code << Dim) | idx;
+                }
+                return code;
+            }
+
+        private:
+            /// Writes the centers splitting cells [first, first + count) of [lo, hi], as @c center() computes them.
+            static void fillSplits(std::vector<Scalar>& out, std::size_t first, std::size_t count, Scalar lo, Scalar hi)
+            {
+                if (count == 1) return;
+                const Scalar c = (lo + hi) * Scalar(0.5);
+                const std::size_t half = count / 2;
+                out[first + half - 1] = c;
+                fillSplits(out, first, half, lo, c);
+                fillSplits(out, first + half, half, c, hi);
+            }
+
+            box_type                                  root_;
+            std::uint32_t                             levels_;
+            std::uint32_t                             table_levels_;
+            std::uint64_t                             outside_;
+            std::array<std::vector<Scalar>, Dim>      splits_;
+            std::array<Scalar, Dim>                   scale_{};
+        };
+
+        /**
+         * @brief Radix-sorts @p n positions by the Morton code of their depth-@p levels cell.
+         *
+         * @p keys receives one (code, index) pair per position, positions outside @p root
+         * last. Code computation and the sort passes are split across @p pool if given.
+         *
+         * @return The number of positions inside @p root.
+         */
+        template <class Scalar, std::size_t Dim, class It, class GetPos>
+        std::size_t orthtreeSortByMorton(It first, std::size_t n, const GetPos& get_pos,
+            const Box<Scalar, Dim>& root, std::uint32_t levels, ThreadPool* pool,
+            std::vector<OrthtreeSortKey>& keys)
+        {
+            const unsigned code_bits = static_cast<unsigned>(Dim * levels);
+            const std::uint64_t outside = std::uint64_t(1) << code_bits;
+            const OrthtreeMortonEncoder<Scalar, Dim> encode(root, levels, outside);
+
+            keys.resize(n);
+            const std::size_t chunks = orthtreeChunkCount(pool, n);
+            orthtreeRunChunks(pool, chunks, [&](std::size_t c) {
+                for (std::size_t i = n * c / chunks, e = n * (c + 1) / chunks; i < e; ++i)
+                    keys[i] = { encode(get_pos(first[i])), static_cast<std::uint32_t>(i) };
+            });
+
+            {
+                std::vector<OrthtreeSortKey> scratch;
+                orthtreeRadixSort(keys, scratch, code_bits + 1, pool);
+            }
+            return static_cast<std::size_t>(std::partition_point(keys.begin(), keys.end(),
+                [outside](const OrthtreeSortKey& k) { return k.code != outside; }) - keys.begin());
+        }
+
+        template <class Scalar, std::size_t Dim, class VecLikeA, class VecLikeB>
+        Scalar orthtreeDistanceSquared(const VecLikeA& a, const VecLikeB& b) noexcept
+        {
+            Scalar d2 = Scalar(0);
+            for (std::size_t i = 0; i < Dim; ++i)
+            {
+                Scalar d = Scalar(a[i]) - Scalar(b[i]);
+                d2 += d * d;
+            }
+            return d2;
+        }
+
+        /// True when @p pos is within sqrt(@p r2) of @p center; stops as soon as the sum exceeds @p r2.
+        template <class Scalar, std::size_t Dim, class VecLikeA, class VecLikeB>
+        bool orthtreeWithinDistance(const VecLikeA& pos, const VecLikeB& center, Scalar r2) noexcept
+        {
+            Scalar d2 = Scalar(0);
+            for (std::size_t i = 0; i < Dim; ++i)
+            {
+                Scalar d = Scalar(pos[i]) - Scalar(center[i]);
+                d2 += d * d;
+                if (d2 > r2) return false;
+            }
+            return d2 <= r2;
+        }
+
+        /// Points per position block of an Orthtree leaf: each axis fills one 64-byte line.
+        template <class Scalar>
+        inline constexpr std::size_t kOrthtreeLaneWidth = 64 / sizeof(Scalar);
+
+        /// Whether the build has vector leaf-scan kernels; scanning lanes with the scalar
+        /// fallback is slower than testing points one by one, so trees only use lanes with these.
+#if defined(__AVX512F__) || defined(__AVX2__)
+        inline constexpr bool kOrthtreeLaneKernels = true;
+#else
+        inline constexpr bool kOrthtreeLaneKernels = false;
+#endif
+
+        /**
+         * @brief Bit @a j is set when byte @a j of @p alive is non-zero, for the first @p count
+         *        (at most @c kOrthtreeLaneWidth) bytes.
+         */
+        template <class Scalar>
+        std::uint32_t orthtreeAliveMask(const std::uint8_t* alive, std::size_t count) noexcept
+        {
+            constexpr std::size_t W = kOrthtreeLaneWidth<Scalar>;
+#if defined(__SSE2__)
+            if (count == W)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                if constexpr (W == 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alive));
+                    return ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))) & 0xFFFFu;
+                }
+                else if constexpr (W == 8)
+                {
+                    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(alive));
+                    return ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))) & 0xFFu;
+                }
+            }
+#endif
+            std::uint32_t bits = 0;
+            for (std::size_t j = 0; j < count; ++j)
+                bits |= std::uint32_t(alive[j] != 0) << j;
+            return bits;
+        }
+
+        /**
+         * @brief Tests one position block against @p box; bit @a j is set when lane @a j passes
+         *        @c Box::contains.
+         *
+         * @p block holds @c kOrthtreeLaneWidth coordinates per axis, axis after axis. Uses
+         * AVX-512 or AVX2 when the build enables them. The comparisons are the negated ones
+         * @c Box::contains uses, so NaN lanes give the same answer as the scalar test.
+         */
+        template <class Scalar, std::size_t Dim>
+        std::uint32_t orthtreeBlockInBox(const Scalar* block, const Box<Scalar, Dim>& box) noexcept
+        {
+            constexpr std::size_t W = kOrthtreeLaneWidth<Scalar>;
+#if defined(__AVX512F__)
+            if constexpr (std::is_same_v<Scalar, float>)
+            {
+                __mmask16 m = 0xFFFF;
+                for (std::size_t a = 0; a < Dim; ++a)
+                {
+                    const __m512 v = _mm512_loadu_ps(block + a * W);
+                    m = _mm512_mask_cmp_ps_mask(m, v, _mm512_set1_ps(box.min[a]), _CMP_NLT_UQ);
+                    m = _mm512_mask_cmp_ps_mask(m, v, _mm512_set1_ps(box.max[a]), _CMP_NGT_UQ);
+                }
+                return m;
+            }
+            else if constexpr (std::is_same_v<Scalar, double>)
+            {
+                __mmask8 m = 0xFF;
+                for (std::size_t a = 0; a < Dim; ++a)
+                {
+                    const __m512d v = _mm512_loadu_pd(block + a * W);
+                    m = _mm512_mask_cmp_pd_mask(m, v, _mm512_set1_pd(box.min[a]), _CMP_NLT_UQ);
+                    m = _mm512_mask_cmp_pd_mask(m, v, _mm512_set1_pd(box.max[a]), _CMP_NGT_UQ);
+                }
+                return m;
+            }
+#elif defined(__AVX2__)
+            if constexpr (std::is_same_v<Scalar, float>)
+            {
+                std::uint32_t bits = 0;
+                for (std::size_t h = 0; h < W; h += 8)
+                {
+                    __m256 in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                    for (std::size_t a = 0; a < Dim; ++a)
+                    {
+                        const __m256 v = _mm256_loadu_ps(block + a * W + h);
+                        in = _mm256_and_ps(in, _mm256_cmp_ps(v, _mm256_set1_ps(box.min[a]), _CMP_NLT_UQ));
+                        in = _mm256_and_ps(in, _mm256_cmp_ps(v, _mm256_set1_ps(box.max[a]), _CMP_NGT_UQ));
+                    }
+                    bits |= static_cast<std::uint32_t>(_mm256_movemask_ps(in)) << h;
+                }
+                return bits;
+            }
+            else if constexpr (std::is_same_v<Scalar, double>)
+            {
+                std::uint32_t bits = 0;
+                for (std::size_t h = 0; h < W; h += 4)
+                {
+                    __m256d in = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+                    for (std::size_t a = 0; a < Dim; ++a)
+                    {
+                        const __m256d v = _mm256_loadu_pd(block + a * W + h);
+                        in = _mm256_and_pd(in, _mm256_cmp_pd(v, _mm256_set1_pd(box.min[a]), _CMP_NLT_UQ));
+                        in = _mm256_and_pd(in, _mm256_cmp_pd(v, _mm256_set1_pd(box.max[a]), _CMP_NGT_UQ));
+                    }
+                    bits |= static_cast<std::uint32_t>(_mm256_movemask_pd(in)) << h;
+                }
+                return bits;
+            }
+#endif
+            std::uint32_t bits = 0;
+            for (std::size_t j = 0; j < W; ++j)
+            {
+                bool in = true;
+                for (std::size_t a = 0; a < Dim; ++a)
+                {
+                    const Scalar v = block[a * W + j];
+                    in &= !(v < box.min[a]) & !(v > box.max[a]);
+                }
+                bits |= std::uint32_t(in) << j;
+            }
+            return bits;
+        }
+
+        /**
+         * @brief Tests one position block against a ball; bit @a j is set when lane @a j passes
+         *        @c orthtreeWithinDistance.
+         *
+         * Squares are summed axis by axis with separate multiplies and adds, as the scalar
+         * test does.
+         */
+        template <class Scalar, std::size_t Dim>
+        std::uint32_t orthtreeBlockInBall(const Scalar* block, const std::array<Scalar, Dim>& center, Scalar r2) noexcept
+        {
+            constexpr std::size_t W = kOrthtreeLaneWidth<Scalar>;
+#if defined(__AVX512F__)
+            if constexpr (std::is_same_v<Scalar, float>)
+            {
+                __m512 d2 = _mm512_setzero_ps();
+                for (std::size_t a = 0; a < Dim; ++a)
+                {
+                    const __m512 d = _mm512_sub_ps(_mm512_loadu_ps(block + a * W), _mm512_set1_ps(center[a]));
+                    d2 = _mm512_add_ps(d2, _mm512_mul_ps(d, d));
+                }
+                return _mm512_cmp_ps_mask(d2, _mm512_set1_ps(r2), _CMP_LE_OQ);
+            }
+            else if constexpr (std::is_same_v<Scalar, double>)
+            {
+                __m512d d2 = _mm512_setzero_pd();
+                for (std::size_t a = 0; a < Dim; ++a)
+                {
+                    const __m512d d = _mm512_sub_pd(_mm512_loadu_pd(block + a * W), _mm512_set1_pd(center[a]));
+                    d2 = _mm512_add_pd(d2, _mm512_mul_pd(d, d));
+                }
+                return _mm512_cmp_pd_mask(d2, _mm512_set1_pd(r2), _CMP_LE_OQ);
+            }
+#elif defined(__AVX2__)
+            if constexpr (std::is_same_v<Scalar, float>)
+            {
+                std::uint32_t bits = 0;
+                for (std::size_t h = 0; h < W; h += 8)
+                {
+                    __m256 d2 = _mm256_setzero_ps();
+                    for (std::size_t a = 0; a < Dim; ++a)
+                    {
+                        const __m256 d = _mm256_sub_ps(_mm256_loadu_ps(block + a * W + h), _mm256_set1_ps(center[a]));
+                        d2 = _mm256_add_ps(d2, _mm256_mul_ps(d, d));
+                    }
+                    bits |= static_cast<std::uint32_t>(_mm256_movemask_ps(
+                        _mm256_cmp_ps(d2, _mm256_set1_ps(r2), _CMP_LE_OQ))) << h;
+                }
+                return bits;
+            }
+            else if constexpr (std::is_same_v<Scalar, double>)
+            {
+                std::uint32_t bits = 0;
+                for (std::size_t h = 0; h < W; h += 4)
+                {
+                    __m256d d2 = _mm256_setzero_pd();
+                    for (std::size_t a = 0; a < Dim; ++a)
+                    {
+                        const __m256d d = _mm256_sub_pd(_mm256_loadu_pd(block + a * W + h), _mm256_set1_pd(center[a]));
+                        d2 = _mm256_add_pd(d2, _mm256_mul_pd(d, d));
+                    }
+                    bits |= static_cast<std::uint32_t>(_mm256_movemask_pd(
+                        _mm256_cmp_pd(d2, _mm256_set1_pd(r2), _CMP_LE_OQ))) << h;
+                }
+                return bits;
+            }
+#endif
+            std::uint32_t bits = 0;
+            for (std::size_t j = 0; j < W; ++j)
+            {
+                Scalar d2 = Scalar(0);
+                for (std::size_t a = 0; a < Dim; ++a)
+                {
+                    const Scalar d = block[a * W + j] - center[a];
+                    d2 += d * d;
+                }
+                bits |= std::uint32_t(d2 <= r2) << j;
+            }
+            return bits;
+        }
+    } // namespace detail
+
     /**
      * @brief Generic Dim-dimensional orthographic tree (quadtree for Dim=2, octree for Dim=3).
      *
@@ -175,6 +694,11 @@ namespace lux::cxx
      * The tree is parameterised over an allocator so that node and point storage can be
      * backed by any standard-compliant allocator (including PMR allocators).
      *
+     * Const member functions only read, so any number of threads may query the tree at
+     * once while no thread modifies it; @c freeze() turns a write during such a phase
+     * into an exception. Overloads taking a @c ThreadPool split one query or deletion
+     * across the pool themselves.
+     *
      * @tparam PointT        Type of the spatial points stored in the tree.
      * @tparam Dim           Number of spatial dimensions (must be >= 1).
      * @tparam Scalar        Scalar type used for bounding-box coordinates.
@@ -212,6 +736,19 @@ namespace lux::cxx
         using node_allocator = rebind_alloc_t<Node>;
         using point_allocator = rebind_alloc_t<PointT>;
         using byte_allocator = rebind_alloc_t<std::uint8_t>;
+        using handle_allocator = rebind_alloc_t<std::uint32_t>;
+        using scalar_allocator = rebind_alloc_t<Scalar>;
+
+        using position_type = std::remove_cvref_t<std::invoke_result_t<const GetPosition&, const PointT&>>;
+        using position_scalar = std::remove_cvref_t<decltype(std::declval<const position_type&>()[0])>;
+
+        /// Leaf scans can run on position lanes: vector kernels built in, float/double coordinates
+        /// stored as Scalar, Dim 2 or 3.
+        static constexpr bool kLaneScan = detail::kOrthtreeLaneKernels
+            && (std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>)
+            && std::is_same_v<position_scalar, Scalar> && (Dim == 2 || Dim == 3);
+        static constexpr std::size_t kLaneWidth = detail::kOrthtreeLaneWidth<Scalar>;
+        static constexpr std::size_t kLaneBlock = kLaneWidth * Dim;
 
         struct Node
         {
@@ -219,7 +756,8 @@ namespace lux::cxx
             box_type bounds{};
             /// Child node IDs (kInvalidNode means the child slot is empty).
             std::array<node_id, kChildCount> children{};
-            /// True when this node is a leaf (stores points directly).
+            /// True when this node is a leaf (stores points directly). Freed nodes are
+            /// neither leaves nor reachable.
             bool is_leaf = true;
             /// Subdivision depth from the root.
             std::uint32_t depth = 0;
@@ -228,18 +766,33 @@ namespace lux::cxx
             std::vector<PointT, point_allocator> points;
             /// Alive flags parallel to @c points (1 = alive, 0 = soft-deleted).
             std::vector<std::uint8_t, byte_allocator> alive;
+            /// Handle slot of each point, parallel to @c points (empty unless handles are tracked).
+            std::vector<std::uint32_t, handle_allocator> handles;
+            /// Positions of @c points in blocks of @c kLaneWidth per axis (empty unless lanes are on).
+            std::vector<Scalar, scalar_allocator> lanes;
 
             /// Dirty flag consumed by external systems (e.g., for GPU upload or synchronisation).
             bool dirty = false;
             /// Indicates that soft-deleted (dead) points are present and compaction is needed.
             bool need_compact = false;
+            /// True while this node is in the maintenance queue.
+            bool compact_queued = false;
+
+            /// Parent node ID (kInvalidNode for the root).
+            node_id parent = kInvalidNode;
+            /// Version of the mutation that last changed this node's points, alive flags or role.
+            std::uint64_t modified_version = 0;
+            /// Largest @c modified_version in this node's subtree; lets deltas skip unchanged subtrees.
+            std::uint64_t subtree_version = 0;
 
             /**
-             * @brief Constructs a Node with the given per-point and alive-byte allocators.
+             * @brief Constructs a Node with the given per-point, alive-byte, handle and lane allocators.
              */
             explicit Node(const point_allocator& pa = point_allocator{},
-                const byte_allocator& ba = byte_allocator{})
-                : points(pa), alive(ba)
+                const byte_allocator& ba = byte_allocator{},
+                const handle_allocator& ha = handle_allocator{},
+                const scalar_allocator& sa = scalar_allocator{})
+                : points(pa), alive(ba), handles(ha), lanes(sa)
             {
                 children.fill(kInvalidNode);
             }
@@ -272,6 +825,53 @@ namespace lux::cxx
             std::uint32_t max_depth = 10;
             /// Maximum number of alive points a leaf may hold before it is split.
             std::uint32_t max_points_per_leaf = 512;
+            /// @c maintain() collapses an internal node whose children are all leaves once
+            /// they hold at most this many alive points in total (0 disables merging).
+            /// Keep it well below @c max_points_per_leaf so merged leaves do not split again.
+            std::uint32_t merge_threshold = 128;
+            /// Gives every point a stable @c PointHandle (see @c insertTracked and @c update).
+            /// Costs one slot per point and bookkeeping whenever points move between leaves.
+            bool          track_handles = false;
+            /// Keeps a copy of every leaf's positions in SIMD-friendly blocks so box and ball
+            /// scans test a block per instruction. Only used for float/double positions in 2D
+            /// and 3D in builds with AVX2 or AVX-512; costs @c Dim scalars per point.
+            bool          position_lanes = true;
+        };
+
+        /**
+         * @brief Stable reference to one point, valid until the point is erased.
+         *
+         * Survives splits, compaction, merges and @c update. A handle whose point was
+         * removed (or whose tree was cleared or bulk-loaded again) is rejected by every
+         * member that takes one: its slot may be reused, but with a new generation.
+         */
+        struct PointHandle
+        {
+            std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+            std::uint32_t generation = 0;
+
+            /// Returns false for a default-constructed handle.
+            [[nodiscard]] bool valid() const noexcept { return index != std::numeric_limits<std::uint32_t>::max(); }
+            friend bool operator==(const PointHandle&, const PointHandle&) = default;
+        };
+
+        /**
+         * @brief What one @c maintain() call did.
+         */
+        struct MaintenanceStats
+        {
+            /// Leaves whose soft-deleted points were removed.
+            std::size_t leaves_compacted = 0;
+            /// Soft-deleted points removed.
+            std::size_t points_removed = 0;
+            /// Internal nodes collapsed into a leaf.
+            std::size_t nodes_merged = 0;
+            /// Nodes put on the free list (merged children and emptied leaves).
+            std::size_t nodes_freed = 0;
+            /// Work spent, in points moved or scanned.
+            std::size_t work = 0;
+            /// True when no leaf is left waiting for compaction.
+            bool done = true;
         };
 
         /**
@@ -304,6 +904,51 @@ namespace lux::cxx
             std::uint64_t version = 0;
         };
 
+        /**
+         * @brief The leaves that changed between two versions, as returned by @c captureDelta.
+         *
+         * To bring a leaf map captured at @c since_version up to @c version, erase the
+         * ids in @c removed, then insert or overwrite the leaves in @c changed. When
+         * @c full is set the history did not reach back to @c since_version: drop the
+         * whole map first; @c changed then holds every leaf.
+         */
+        struct Delta
+        {
+            /// Leaves created or modified after @c since_version (including empty ones).
+            std::vector<LeafView> changed;
+            /// IDs that were leaves after @c since_version and no longer are (split or freed).
+            /// May include IDs the consumer never saw.
+            std::vector<node_id> removed;
+            std::uint64_t since_version = 0;
+            std::uint64_t version = 0;
+            bool full = false;
+        };
+
+        /**
+         * @brief A read-only view of one leaf's storage, valid while the tree stays frozen.
+         */
+        struct LeafSpan
+        {
+            node_id id = kInvalidNode;
+            box_type bounds{};
+            bool dirty = false;
+
+            std::span<const PointT> points;
+            std::span<const std::uint8_t> alive;
+        };
+
+        /**
+         * @brief Zero-copy counterpart of @c Delta returned by @c captureDeltaView.
+         */
+        struct DeltaView
+        {
+            std::vector<LeafSpan> changed;
+            std::vector<node_id> removed;
+            std::uint64_t since_version = 0;
+            std::uint64_t version = 0;
+            bool full = false;
+        };
+
     public:
         /**
          * @brief Constructs an Orthtree with the given configuration.
@@ -339,16 +984,53 @@ namespace lux::cxx
             nodes_[root_].depth = 0;
         }
 
+        /**
+         * @brief Constructs an Orthtree and bulk-loads @p pts into it (see @c bulkLoad).
+         *
+         * @tparam Range Any range whose elements convert to @c const PointT&.
+         * @param cfg     Tree configuration (bounds, depth limit, leaf capacity).
+         * @param pts     The points to load.
+         * @param get_pos Position accessor functor.
+         * @param alloc   Base allocator for all internal storage.
+         */
+        template <class Range>
+            requires std::ranges::input_range<const Range>
+                && std::convertible_to<std::ranges::range_reference_t<const Range>, const PointT&>
+        Orthtree(const Config& cfg, const Range& pts,
+            const GetPosition& get_pos = GetPosition{},
+            const BaseAllocator& alloc = BaseAllocator{})
+            : Orthtree(cfg, get_pos, alloc)
+        {
+            bulkLoad(pts);
+        }
+
         // ---------------------- Accessors ---------------------- //
 
         /// Returns the current configuration.
         [[nodiscard]] const Config& config() const noexcept { return config_; }
+        /// Returns the position accessor functor.
+        [[nodiscard]] const GetPosition& positionAccessor() const noexcept { return get_pos_; }
         /// Returns the monotonically increasing version counter (incremented on every mutation).
         [[nodiscard]] std::uint64_t version() const noexcept { return version_; }
         /// Returns the node ID of the root node.
         [[nodiscard]] node_id root() const noexcept { return root_; }
         /// Returns the total number of allocated nodes (including internal nodes).
         [[nodiscard]] std::uint32_t nodeCount() const noexcept { return static_cast<std::uint32_t>(nodes_.size()); }
+        /// Returns the number of allocated nodes waiting on the free list for reuse.
+        [[nodiscard]] std::uint32_t freeNodeCount() const noexcept { return static_cast<std::uint32_t>(free_nodes_.size()); }
+        /// Returns true while the tree is frozen (see @c freeze).
+        [[nodiscard]] bool frozen() const noexcept { return frozen_; }
+
+        /**
+         * @brief Forbids modification until @c unfreeze is called.
+         *
+         * While frozen, every member that changes points, alive flags or nodes throws
+         * @c std::logic_error instead, so spans handed out by @c captureDeltaView stay
+         * valid. Dirty-flag acknowledgement is still allowed.
+         */
+        void freeze() noexcept { frozen_ = true; }
+        /// Allows modification again; spans from @c captureDeltaView must no longer be used.
+        void unfreeze() noexcept { frozen_ = false; }
 
         // ---------------------- Modification ---------------------- //
 
@@ -359,6 +1041,12 @@ namespace lux::cxx
          */
         void clear()
         {
+            throwIfFrozen("Orthtree::clear");
+            resetDeltaHistory();
+            resetHandles(0);
+            rebuildFreeHandles();
+            compact_queue_.clear();
+            free_nodes_.clear();
             nodes_.clear();
             nodes_.reserve(1024);
             root_ = allocateNode();
@@ -381,6 +1069,7 @@ namespace lux::cxx
          */
         bool insert(const PointT& p)
         {
+            throwIfFrozen("Orthtree::insert");
             if (root_ == kInvalidNode) return false;
             bool inserted = insertInternal(root_, p, 0);
             if (inserted) ++version_;
@@ -409,6 +1098,7 @@ namespace lux::cxx
         template <class... Args>
         bool emplace(Args&&... args)
         {
+            throwIfFrozen("Orthtree::emplace");
             if (root_ == kInvalidNode) return false;
             PointT p(std::forward<Args>(args)...);
             bool inserted = emplaceInternal(root_, std::move(p), 0);
@@ -445,6 +1135,7 @@ namespace lux::cxx
         template <class VecLike, class... Args>
         bool emplaceAt(const VecLike& pos, Args&&... args)
         {
+            throwIfFrozen("Orthtree::emplaceAt");
             if (root_ == kInvalidNode) return false;
             bool inserted = emplaceAtInternal(root_, pos, 0, std::forward<Args>(args)...);
             if (inserted) ++version_;
@@ -459,6 +1150,7 @@ namespace lux::cxx
         template <class Range>
         void insertMany(const Range& pts)
         {
+            throwIfFrozen("Orthtree::insertMany");
             if (root_ == kInvalidNode) return;
             bool any = false;
             for (const auto& p : pts)
@@ -466,28 +1158,240 @@ namespace lux::cxx
             if (any) ++version_;
         }
 
-        // ---------------------- Soft Deletion ---------------------- //
+        // ---------------------- Bulk Loading ---------------------- //
 
         /**
-         * @brief Soft-deletes all alive points whose positions fall within @p region.
+         * @brief Replaces the tree contents with @p pts, building the hierarchy in one pass.
          *
-         * Points are marked dead (alive flag set to 0). Call @c compactDirtyLeaves() to
-         * physically remove them. Increments the version counter if any points were marked.
+         * Every point gets the Morton code of the deepest cell it falls in (the child
+         * indices along its root-to-leaf path, computed with the same centers as
+         * @c insert), the codes are radix-sorted, and each node is created once over
+         * the contiguous run of codes it covers. A node becomes a leaf when it holds at
+         * most @c max_points_per_leaf points or reaches @c max_depth, and each leaf's
+         * storage is sized exactly. Within a leaf, points are stored in Morton order.
          *
-         * @param region The axis-aligned box defining the deletion region.
-         * @return The number of points that were marked as deleted.
+         * Points outside the root bounds are skipped. Increments the version counter.
+         *
+         * @tparam Range Any range whose elements convert to @c const PointT&.
+         * @param pts The points to load.
+         * @return The number of points loaded.
          */
-        std::size_t markDeletedInBox(const box_type& region)
+        template <class Range>
+        std::size_t bulkLoad(const Range& pts)
         {
-            if (root_ == kInvalidNode) return 0;
-
-            auto prune = [&](const box_type& b) { return b.intersects(region); };
-            auto pred = [&](const PointT& p) {
-                const auto& pos = get_pos_(p);
-                return region.contains(pos);
-            };
+            throwIfFrozen("Orthtree::bulkLoad");
+            return bulkLoadImpl(pts, nullptr);
+        }
 
-            std::size_t removed = markDeletedRecursive(root_, pred, prune);
+        /**
+         * @brief Parallel @c bulkLoad: code computation, radix sort passes and leaf
+         *        filling are split across @p pool and the calling thread.
+         *
+         * Allocations still happen on the calling thread, so allocators that are not
+         * thread-safe (e.g. @c std::pmr::unsynchronized_pool_resource) may be used.
+         */
+        template <class Range>
+        std::size_t bulkLoad(const Range& pts, ThreadPool& pool)
+        {
+            throwIfFrozen("Orthtree::bulkLoad");
+            return bulkLoadImpl(pts, &pool);
+        }
+
+        // ---------------------- Point Handles ---------------------- //
+
+        /**
+         * @brief Inserts @p p and returns a handle that follows it through the tree.
+         *
+         * Requires @c Config::track_handles; plain @c insert and @c emplace also attach
+         * a handle then, they just do not return it. Increments the version counter on
+         * success.
+         *
+         * @return The new handle, or an invalid one if @p p lies outside the root bounds.
+         * @throws std::logic_error if handles are not tracked.
+         */
+        PointHandle insertTracked(const PointT& p)
+        {
+            throwIfFrozen("Orthtree::insertTracked");
+            requireHandles("Orthtree::insertTracked");
+            if (root_ == kInvalidNode) return {};
+            const std::uint32_t h = acquireHandle();
+            if (!insertInternal(root_, p, 0, h))
+            {
+                releaseHandle(h);
+                return {};
+            }
+            ++version_;
+            return { h, slots_[h].generation };
+        }
+
+        /**
+         * @brief @c bulkLoad that also returns one handle per input point.
+         *
+         * @p handles[i] refers to @p pts[i], or is invalid if that point was skipped.
+         * Handles issued before the call are invalidated.
+         *
+         * @throws std::logic_error if handles are not tracked.
+         */
+        template <class Range>
+            requires std::ranges::sized_range<const Range>
+        std::size_t bulkLoad(const Range& pts, std::vector<PointHandle>& handles)
+        {
+            throwIfFrozen("Orthtree::bulkLoad");
+            requireHandles("Orthtree::bulkLoad");
+            const std::size_t loaded = bulkLoadImpl(pts, nullptr);
+            handles.assign(static_cast<std::size_t>(std::ranges::size(pts)), PointHandle{});
+            for (std::size_t i = 0; i < handles.size(); ++i)
+                if (slots_[i].leaf != kInvalidNode)
+                    handles[i] = { static_cast<std::uint32_t>(i), slots_[i].generation };
+            return loaded;
+        }
+
+        /**
+         * @brief Returns the point @p h refers to, or nullptr if it was erased,
+         *        soft-deleted or @p h is stale.
+         *
+         * The pointer is invalidated by the next modification.
+         */
+        [[nodiscard]] const PointT* find(PointHandle h) const
+        {
+            const HandleSlot* slot = resolveHandle(h);
+            if (!slot) return nullptr;
+            const Node& node = nodes_[slot->leaf];
+            return node.alive[slot->index] ? &node.points[slot->index] : nullptr;
+        }
+
+        /**
+         * @brief Removes the point @p h refers to immediately and invalidates @p h.
+         *
+         * The last point of the leaf takes its place, so no compaction is needed. A leaf
+         * left empty is queued for @c maintain(). Increments the version counter on success.
+         *
+         * @return False if @p h is stale or its point is soft-deleted.
+         */
+        bool erase(PointHandle h)
+        {
+            throwIfFrozen("Orthtree::erase");
+            const HandleSlot* slot = resolveHandle(h);
+            if (!slot || !nodes_[slot->leaf].alive[slot->index]) return false;
+            removePoint(slot->leaf, slot->index);
+            releaseHandle(h.index);
+            ++version_;
+            return true;
+        }
+
+        /**
+         * @brief Replaces the point @p h refers to with @p value, moving it if its
+         *        position left the leaf.
+         *
+         * A position still inside the leaf's cell is an assignment in place. Otherwise
+         * the point is removed from its leaf (the leaf's last point takes its slot) and
+         * inserted again below the nearest ancestor whose cell holds the new position,
+         * so only that subtree is walked. @p value is the whole new point because
+         * positions are read from points through @c GetPosition; it must not refer to
+         * a point stored in this tree. Increments the version counter on success.
+         *
+         * @return False, leaving the point unchanged, if @p h is stale, its point is
+         *         soft-deleted, or the new position lies outside the root bounds.
+         */
+        bool update(PointHandle h, const PointT& value)
+        {
+            throwIfFrozen("Orthtree::update");
+            if (!updateInternal(h, value)) return false;
+            ++version_;
+            return true;
+        }
+
+        /**
+         * @brief Applies a batch of @c update calls, splitting overfull leaves once at the end.
+         *
+         * Points staying in their leaf are assigned in input order. The others are
+         * taken out of their leaves first, then appended to their destination leaves,
+         * each found from the nearest ancestor of the source leaf that holds the new
+         * position. Consecutive points landing in the same leaf skip the descent. No
+         * leaf splits while points are still arriving; every leaf left overfull is
+         * split once afterwards, recursively, instead of after each insert. A handle
+         * should appear once: after its point has been taken out, later entries for
+         * it are rejected. Increments the version counter once if any update succeeded.
+         *
+         * @tparam Range Random-access range of pairs (or structs) of @c PointHandle and
+         *               @c PointT, unpacked with a structured binding.
+         * @return The number of successful updates.
+         */
+        template <class Range>
+            requires std::ranges::random_access_range<const Range> && std::ranges::sized_range<const Range>
+        std::size_t updateMany(const Range& moves)
+        {
+            throwIfFrozen("Orthtree::updateMany");
+            const auto first = std::ranges::begin(moves);
+            const std::size_t n = static_cast<std::size_t>(std::ranges::size(moves));
+            if (n > std::numeric_limits<std::uint32_t>::max())
+                throw std::length_error("Orthtree::updateMany: more than 2^32 - 1 updates in one batch");
+
+            // 1. Moves that stay in their leaf are assignments. The others are taken out of
+            //    their leaf while it is in cache and queued with the subtree to descend from.
+            std::vector<std::pair<std::uint32_t, node_id>> movers;
+            std::size_t updated = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const auto [h, value] = unpackMove(first[i]);
+                const LeafUpdate r = updateInLeaf(h, value);
+                if (r == LeafUpdate::kDone) ++updated;
+                if (r != LeafUpdate::kLeavesLeaf) continue;
+
+                HandleSlot& slot = slots_[h.index];
+                const node_id ancestor = enclosingAncestor(slot.leaf, get_pos_(value));
+                if (ancestor == kInvalidNode) continue;
+                removePoint(slot.leaf, slot.index);
+                slot.leaf = kInvalidNode; // in transit: later entries for it are rejected
+                movers.push_back({ static_cast<std::uint32_t>(i), ancestor });
+            }
+
+            // 2. Append them to their destination leaves without splitting.
+            std::vector<node_id> overfull;
+            node_id last = kInvalidNode;
+            for (const auto& [i, ancestor] : movers)
+            {
+                const auto [h, value] = unpackMove(first[i]);
+                const auto& pos = get_pos_(value);
+                const node_id leaf = (last != kInvalidNode && nodes_[last].bounds.contains(pos))
+                    ? last : descendToLeaf(ancestor, pos);
+                appendToLeaf(leaf, value, h.index);
+                if (nodes_[leaf].points.size() > config_.max_points_per_leaf
+                    && (overfull.empty() || overfull.back() != leaf))
+                    overfull.push_back(leaf);
+                last = leaf;
+                ++updated;
+            }
+
+            // 3. Split what overflowed, once per leaf.
+            std::sort(overfull.begin(), overfull.end());
+            overfull.erase(std::unique(overfull.begin(), overfull.end()), overfull.end());
+            for (const node_id leaf : overfull) splitOverfull(leaf);
+
+            if (updated > 0) ++version_;
+            return updated;
+        }
+
+        // ---------------------- Soft Deletion ---------------------- //
+
+        /**
+         * @brief Soft-deletes all alive points whose positions fall within @p region.
+         *
+         * Points are marked dead (alive flag set to 0). Call @c compactDirtyLeaves() to
+         * physically remove them. Increments the version counter if any points were marked.
+         *
+         * @param region The axis-aligned box defining the deletion region.
+         * @return The number of points that were marked as deleted.
+         */
+        std::size_t markDeletedInBox(const box_type& region)
+        {
+            throwIfFrozen("Orthtree::markDeletedInBox");
+            if (root_ == kInvalidNode) return 0;
+
+            auto prune = [&](const box_type& b) { return b.intersects(region); };
+            BoxTest pred{ get_pos_, region };
+
+            std::size_t removed = markDeletedRecursive(root_, pred, prune);
             if (removed > 0) ++version_;
             return removed;
         }
@@ -503,27 +1407,49 @@ namespace lux::cxx
         template <class VecLike>
         std::size_t markDeletedInBall(const VecLike& center, Scalar radius)
         {
+            throwIfFrozen("Orthtree::markDeletedInBall");
             if (root_ == kInvalidNode) return 0;
             const Scalar r2 = radius * radius;
 
             auto prune = [&](const box_type& b) { return b.intersectsBall(center, radius); };
-            auto pred = [&](const PointT& p) {
-                const auto& pos = get_pos_(p);
-                Scalar d2 = Scalar(0);
-                for (std::size_t i = 0; i < Dim; ++i)
-                {
-                    Scalar d = Scalar(pos[i]) - Scalar(center[i]);
-                    d2 += d * d;
-                    if (d2 > r2) return false;
-                }
-                return d2 <= r2;
-            };
+            auto pred = makeBallTest(center, r2);
 
             std::size_t removed = markDeletedRecursive(root_, pred, prune);
             if (removed > 0) ++version_;
             return removed;
         }
 
+        /**
+         * @brief Parallel @c markDeletedInBox: the subtrees overlapping @p region are
+         *        processed by @p pool and the calling thread.
+         *
+         * Leaves are disjoint, so only the final bookkeeping runs serially.
+         */
+        std::size_t markDeletedInBox(const box_type& region, ThreadPool& pool)
+        {
+            throwIfFrozen("Orthtree::markDeletedInBox");
+            if (root_ == kInvalidNode) return 0;
+
+            auto prune = [&](const box_type& b) { return b.intersects(region); };
+            BoxTest pred{ get_pos_, region };
+            return markDeletedParallel(pred, prune, pool);
+        }
+
+        /**
+         * @brief Parallel @c markDeletedInBall; see @c markDeletedInBox(region, pool).
+         */
+        template <class VecLike>
+        std::size_t markDeletedInBall(const VecLike& center, Scalar radius, ThreadPool& pool)
+        {
+            throwIfFrozen("Orthtree::markDeletedInBall");
+            if (root_ == kInvalidNode) return 0;
+            const Scalar r2 = radius * radius;
+
+            auto prune = [&](const box_type& b) { return b.intersectsBall(center, radius); };
+            auto pred = makeBallTest(center, r2);
+            return markDeletedParallel(pred, prune, pool);
+        }
+
         /**
          * @brief Soft-deletes all points that satisfy an arbitrary predicate.
          *
@@ -536,6 +1462,7 @@ namespace lux::cxx
         template <class Predicate>
         std::size_t markDeletedIf(Predicate pred)
         {
+            throwIfFrozen("Orthtree::markDeletedIf");
             if (root_ == kInvalidNode) return 0;
 
             auto prune = [](const box_type&) { return true; };
@@ -550,6 +1477,9 @@ namespace lux::cxx
         /**
          * @brief Physically removes all soft-deleted points from dirty leaf nodes.
          *
+         * Scans every node. @c maintain() does the same work incrementally, from a
+         * queue of the leaves that need it, and also merges near-empty subtrees.
+         *
          * After compaction, point indices within leaves may change. The version counter
          * is incremented if any points were removed.
          *
@@ -557,39 +1487,51 @@ namespace lux::cxx
          */
         std::size_t compactDirtyLeaves()
         {
+            throwIfFrozen("Orthtree::compactDirtyLeaves");
             std::size_t total_removed = 0;
-            for (auto& node : nodes_)
+            for (node_id id = 0; id < static_cast<node_id>(nodes_.size()); ++id)
             {
-                if (!node.is_leaf) continue;
-                if (!node.need_compact) continue;
-
-                std::size_t write = 0;
-                for (std::size_t read = 0; read < node.points.size(); ++read)
-                {
-                    if (node.alive[read])
-                    {
-                        if (write != read)
-                        {
-                            node.points[write] = std::move(node.points[read]);
-                            node.alive[write]  = 1;
-                        }
-                        ++write;
-                    }
-                    else
-                    {
-                        ++total_removed;
-                    }
-                }
-                node.points.resize(write);
-                node.alive.resize(write);
-                node.need_compact = false;
-                node.dirty = true;
+                nodes_[id].compact_queued = false;
+                if (!nodes_[id].is_leaf) continue;
+                if (!nodes_[id].need_compact) continue;
+                total_removed += compactLeaf(id);
             }
+            compact_queue_.clear();
 
             if (total_removed > 0) ++version_;
             return total_removed;
         }
 
+        /**
+         * @brief Incremental maintenance: compacts queued leaves and merges near-empty
+         *        subtrees until @p work_budget is spent.
+         *
+         * Leaves are queued when they first receive a soft deletion, so no full scan
+         * is needed. A leaf left empty by compaction is unlinked from its parent. The
+         * parent is then collapsed into a single leaf if all of its children are leaves
+         * holding at most @c Config::merge_threshold alive points together, and the
+         * check repeats one level up. Freed nodes go to a free list that later
+         * allocations reuse.
+         * The budget is checked between leaves, so one call may overrun it by a single
+         * leaf's work. Increments the version counter if anything changed.
+         *
+         * @param work_budget Maximum work, counted in points scanned or moved.
+         * @return What was done, including whether the queue is now empty.
+         */
+        MaintenanceStats maintain(std::size_t work_budget = std::numeric_limits<std::size_t>::max())
+        {
+            return maintainImpl([&](const MaintenanceStats& st) { return st.work < work_budget; });
+        }
+
+        /**
+         * @brief Same as @c maintain(work_budget), stopping once @p time_budget has elapsed.
+         */
+        MaintenanceStats maintain(std::chrono::steady_clock::duration time_budget)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + time_budget;
+            return maintainImpl([&](const MaintenanceStats&) { return std::chrono::steady_clock::now() < deadline; });
+        }
+
         // ---------------------- Queries ---------------------- //
 
         /**
@@ -621,6 +1563,244 @@ namespace lux::cxx
             forEachPointInBox(region, [&](const PointT& p) { *out++ = p; });
         }
 
+        /**
+         * @brief Visits every alive point within @p radius of @p center, invoking @p fn on each.
+         *
+         * Nodes entirely inside the ball are emitted without per-point distance tests.
+         *
+         * @tparam VecLike A vector-like type whose elements are accessible via operator[].
+         * @tparam Func    Callable with signature: void(const PointT&).
+         * @param center The center of the hypersphere.
+         * @param radius The radius of the hypersphere.
+         * @param fn     The visitor function.
+         */
+        template <class VecLike, class Func>
+        void forEachPointInBall(const VecLike& center, Scalar radius, Func&& fn) const
+        {
+            if (root_ == kInvalidNode) return;
+            forEachPointInBallRecursive(root_, center, radius, radius * radius, fn);
+        }
+
+        /**
+         * @brief Writes every alive point within @p radius of @p center to an output iterator.
+         *
+         * @tparam VecLike  A vector-like type whose elements are accessible via operator[].
+         * @tparam OutputIt An iterator satisfying OutputIterator requirements.
+         * @param center The center of the hypersphere.
+         * @param radius The radius of the hypersphere.
+         * @param out    The output iterator to write results to.
+         */
+        template <class VecLike, class OutputIt>
+        void queryPointsInBall(const VecLike& center, Scalar radius, OutputIt out) const
+        {
+            forEachPointInBall(center, radius, [&](const PointT& p) { *out++ = p; });
+        }
+
+        /**
+         * @brief Returns the alive point closest to @p pos, or nullptr if there is none
+         *        within @p max_distance.
+         *
+         * The pointer refers into leaf storage and is invalidated by the next modification.
+         *
+         * @tparam VecLike A vector-like type whose elements are accessible via operator[].
+         * @param pos          The query position (may lie outside the root bounds).
+         * @param max_distance Search radius; points farther away are ignored.
+         * @return Pointer to the nearest point, or nullptr.
+         */
+        template <class VecLike>
+        const PointT* nearest(const VecLike& pos,
+            Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+        {
+            KnnScratch scratch;
+            searchNearest(pos, 1, max_distance, scratch);
+            return scratch.best.empty() ? nullptr : scratch.best.front().point;
+        }
+
+        /**
+         * @brief Writes the @p k alive points closest to @p pos to @p out, nearest first.
+         *
+         * Best-first search: nodes are expanded in order of their box distance to
+         * @p pos, and the search stops once the next node is farther away than the
+         * current k-th candidate.
+         *
+         * @tparam VecLike  A vector-like type whose elements are accessible via operator[].
+         * @tparam OutputIt An iterator satisfying OutputIterator requirements.
+         * @param pos          The query position (may lie outside the root bounds).
+         * @param k            Maximum number of points to return.
+         * @param out          The output iterator to write results to.
+         * @param max_distance Search radius; points farther away are ignored.
+         * @return The number of points written (less than @p k if the tree holds fewer
+         *         alive points within @p max_distance).
+         */
+        template <class VecLike, class OutputIt>
+        std::size_t kNearest(const VecLike& pos, std::size_t k, OutputIt out,
+            Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+        {
+            KnnScratch scratch;
+            searchNearest(pos, k, max_distance, scratch);
+            for (const Neighbor& nb : scratch.best) *out++ = *nb.point;
+            return scratch.best.size();
+        }
+
+        // ---------------------- Batched Queries ---------------------- //
+
+        /**
+         * @brief Runs @c kNearest for every position in @p queries.
+         *
+         * Queries are answered in Morton order of their positions, so consecutive
+         * searches walk mostly the same nodes and leaves while they are still cached,
+         * and the search buffers are reused throughout. @p fn receives each query's
+         * neighbours nearest first, but queries do not arrive in input order.
+         *
+         * @tparam QueryRange A random-access range of vector-like positions.
+         * @tparam Func       Callable with signature: void(std::size_t query_index, const PointT&).
+         * @param queries      The query positions.
+         * @param k            Maximum number of neighbours per query.
+         * @param fn           Receives (index into @p queries, neighbour).
+         * @param max_distance Search radius; points farther away are ignored.
+         */
+        template <class QueryRange, class Func>
+        void kNearestMany(const QueryRange& queries, std::size_t k, Func&& fn,
+            Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+        {
+            const auto first = std::ranges::begin(queries);
+            KnnScratch scratch;
+            for (std::uint32_t q : mortonOrder(queries))
+            {
+                searchNearest(first[q], k, max_distance, scratch);
+                for (const Neighbor& nb : scratch.best) fn(std::size_t(q), *nb.point);
+            }
+        }
+
+        /**
+         * @brief Runs @c forEachPointInBall for every center in @p centers in one traversal.
+         *
+         * Each node is visited once with the subset of balls that reach it, and every
+         * leaf point is loaded once and tested against all of them.
+         *
+         * @tparam CenterRange A random-access range of vector-like positions.
+         * @tparam Func        Callable with signature: void(std::size_t query_index, const PointT&).
+         * @param centers The ball centers.
+         * @param radius  The radius shared by all balls.
+         * @param fn      Receives (index into @p centers, point) for every hit.
+         */
+        template <class CenterRange, class Func>
+        void forEachPointInBalls(const CenterRange& centers, Scalar radius, Func&& fn) const
+        {
+            if (root_ == kInvalidNode) return;
+
+            const auto first = std::ranges::begin(centers);
+            const std::size_t n = static_cast<std::size_t>(std::ranges::size(centers));
+            std::vector<std::array<Scalar, Dim>> balls(n);
+            for (std::size_t q = 0; q < n; ++q)
+                for (std::size_t i = 0; i < Dim; ++i) balls[q][i] = Scalar(first[q][i]);
+
+            // One candidate list per level; depth never exceeds max_depth.
+            std::vector<std::vector<std::uint32_t>> active(config_.max_depth + 2);
+            active[0].resize(n);
+            for (std::size_t q = 0; q < n; ++q) active[0][q] = static_cast<std::uint32_t>(q);
+
+            forEachPointInBallsRecursive(root_, 0, balls, radius, radius * radius, active, fn);
+        }
+
+        /**
+         * @brief Visits the alive points inside each box of @p boxes in one shared traversal.
+         *
+         * Every node is visited once with the subset of boxes that overlap it; a box
+         * that contains a node entirely takes the whole subtree without per-point tests
+         * and leaves the subset.
+         *
+         * @tparam BoxRange A sized random-access range of @c box_type.
+         * @tparam Func     Callable with signature: void(std::size_t query_index, const PointT&).
+         * @param boxes The query boxes.
+         * @param fn    The visitor function.
+         */
+        template <class BoxRange, class Func>
+        void forEachPointInBoxes(const BoxRange& boxes, Func&& fn) const
+        {
+            if (root_ == kInvalidNode) return;
+
+            const auto first = std::ranges::begin(boxes);
+            const std::size_t n = static_cast<std::size_t>(std::ranges::size(boxes));
+            std::vector<std::uint32_t> all(n);
+            for (std::size_t q = 0; q < n; ++q) all[q] = static_cast<std::uint32_t>(q);
+            forEachPointInBoxSubset(first, all, fn);
+        }
+
+        // ---------------------- Parallel Queries ---------------------- //
+
+        /**
+         * @brief Parallel @c forEachPointInBox: the subtrees overlapping @p region are
+         *        handed out to @p pool and the calling thread.
+         *
+         * @p fn runs concurrently. Its first argument is the slot of the thread running
+         * it, in [0, pool.thread_count()], so per-slot accumulators need no locking.
+         * Points arrive in no particular order.
+         *
+         * @tparam Func Callable with signature: void(std::size_t slot, const PointT&).
+         * @param region The axis-aligned query box.
+         * @param pool   The pool to run on; must not be the pool running the caller.
+         * @param fn     The visitor function.
+         */
+        template <class Func>
+        void forEachPointInBox(const box_type& region, ThreadPool& pool, Func&& fn) const
+        {
+            if (root_ == kInvalidNode || !nodes_[root_].bounds.intersects(region)) return;
+
+            const auto subtrees = overlappingSubtrees(
+                [&](const box_type& b) { return b.intersects(region); }, 8 * (pool.thread_count() + 1));
+            forEachSubtreeParallel(subtrees, pool, [&](std::size_t slot, node_id nid) {
+                auto emit = [&](const PointT& p) { fn(slot, p); };
+                forEachPointInBoxRecursive(nid, region, emit);
+            });
+        }
+
+        /**
+         * @brief Parallel @c queryPointsInBox: each slot fills its own buffer, and the
+         *        buffers are appended to @p out at the end.
+         */
+        template <class OutputIt>
+        void queryPointsInBox(const box_type& region, OutputIt out, ThreadPool& pool) const
+        {
+            std::vector<std::vector<PointT>> buffers(pool.thread_count() + 1);
+            forEachPointInBox(region, pool, [&](std::size_t slot, const PointT& p) { buffers[slot].push_back(p); });
+            for (const auto& buffer : buffers)
+                for (const PointT& p : buffer) *out++ = p;
+        }
+
+        /**
+         * @brief Parallel @c forEachPointInBoxes: the boxes are sorted by Morton order of
+         *        their centers and split into runs, each answered by one shared traversal.
+         *
+         * Every query index is handled by exactly one thread, so @p fn may write to
+         * per-query outputs without locking; it must not touch state shared between
+         * queries.
+         */
+        template <class BoxRange, class Func>
+        void forEachPointInBoxes(const BoxRange& boxes, ThreadPool& pool, Func&& fn) const
+        {
+            if (root_ == kInvalidNode) return;
+
+            const auto first = std::ranges::begin(boxes);
+            const std::size_t n = static_cast<std::size_t>(std::ranges::size(boxes));
+            std::vector<std::array<Scalar, Dim>> centers(n);
+            for (std::size_t q = 0; q < n; ++q) centers[q] = first[q].center();
+            const std::vector<std::uint32_t> order = mortonOrder(centers);
+
+            // Several runs per thread so an expensive region does not stall the rest.
+            const std::size_t runs = std::min(n, 4 * (pool.thread_count() + 1));
+            std::atomic<std::size_t> next{ 0 };
+            pool.parallel_for(pool.thread_count() + 1, [&](std::size_t) {
+                std::vector<std::uint32_t> subset;
+                for (std::size_t r; (r = next.fetch_add(1, std::memory_order_relaxed)) < runs;)
+                {
+                    subset.assign(order.begin() + static_cast<std::ptrdiff_t>(n * r / runs),
+                                  order.begin() + static_cast<std::ptrdiff_t>(n * (r + 1) / runs));
+                    forEachPointInBoxSubset(first, subset, fn);
+                }
+            });
+        }
+
         // ---------------------- Snapshot ---------------------- //
 
         /**
@@ -661,6 +1841,70 @@ namespace lux::cxx
             return snap;
         }
 
+        /**
+         * @brief Deep-copies only the leaves that changed after @p since_version.
+         *
+         * Every node records the version of the mutation that last changed it, and the
+         * largest such version in its subtree, so unchanged subtrees are skipped and the
+         * cost follows the amount of change rather than the tree size. Leaves that split
+         * since then are reported in @c Delta::removed and their children in
+         * @c Delta::changed. If @p since_version predates @c clear, @c bulkLoad or
+         * @c trimDeltaHistory, the result is a full delta (see @c Delta).
+         *
+         * @param since_version A version previously returned by @c version().
+         * @return The changes that bring a view at @p since_version up to @c version().
+         */
+        Delta captureDelta(std::uint64_t since_version) const
+        {
+            Delta delta;
+            collectDelta(since_version, delta, [this](node_id id, const Node& node) {
+                LeafView view;
+                view.id = id;
+                view.bounds = node.bounds;
+                view.dirty = node.dirty;
+                view.points.assign(node.points.begin(), node.points.end());
+                view.alive.assign(node.alive.begin(), node.alive.end());
+                return view;
+            });
+            return delta;
+        }
+
+        /**
+         * @brief Same as @c captureDelta, but hands out spans into leaf storage instead of copies.
+         *
+         * The spans stay valid until @c unfreeze is called.
+         *
+         * @throws std::logic_error if the tree is not frozen.
+         */
+        DeltaView captureDeltaView(std::uint64_t since_version) const
+        {
+            if (!frozen_)
+                throw std::logic_error("Orthtree::captureDeltaView: the tree must be frozen");
+
+            DeltaView delta;
+            collectDelta(since_version, delta, [](node_id id, const Node& node) {
+                return LeafSpan{ id, node.bounds, node.dirty,
+                    std::span<const PointT>(node.points.data(), node.points.size()),
+                    std::span<const std::uint8_t>(node.alive.data(), node.alive.size()) };
+            });
+            return delta;
+        }
+
+        /**
+         * @brief Forgets split history up to @p version; deltas since an older version become full.
+         *
+         * The history holds one entry per split, so long-running trees should trim it
+         * once every consumer has caught up to @p version.
+         */
+        void trimDeltaHistory(std::uint64_t version)
+        {
+            version = std::min(version, version_);
+            if (version <= history_floor_) return;
+            retired_.erase(retired_.begin(), std::upper_bound(retired_.begin(), retired_.end(), version,
+                [](std::uint64_t v, const RetiredLeaf& r) { return v < r.version; }));
+            history_floor_ = version;
+        }
+
         // ---------------------- Statistics ---------------------- //
 
         /// Returns the total number of alive (non-deleted) points across all leaf nodes.
@@ -708,40 +1952,553 @@ namespace lux::cxx
             }
         }
 
-        /// Clears the dirty flag on all leaf nodes.
-        void clearAllLeafDirtyFlags()
+        /// Clears the dirty flag on all leaf nodes.
+        void clearAllLeafDirtyFlags()
+        {
+            for (auto& node : nodes_)
+                if (node.is_leaf) node.dirty = false;
+        }
+
+    private:
+        // ---------------------- Data Members ---------------------- //
+
+        /// Tree configuration (bounds, depth limit, leaf point capacity).
+        Config config_{};
+        /// Position accessor functor.
+        GetPosition get_pos_{};
+
+        /// Base allocator used to rebind storage for nodes, points, and alive flags.
+        BaseAllocator base_alloc_{};
+        /// Flat array of all allocated nodes (indexed by node_id).
+        std::vector<Node, node_allocator> nodes_;
+        /// Node ID of the root node.
+        node_id root_ = kInvalidNode;
+
+        /// Monotonically increasing mutation version.
+        std::uint64_t version_ = 0;
+        /// True while modification is forbidden.
+        bool frozen_ = false;
+
+        /// A leaf that stopped being a leaf (split) at @c version.
+        struct RetiredLeaf
+        {
+            std::uint64_t version;
+            node_id       id;
+        };
+        /// Retired leaves in version order, for @c captureDelta.
+        std::vector<RetiredLeaf> retired_;
+        /// Deltas since a version before this one are full.
+        std::uint64_t history_floor_ = 0;
+
+        /// Leaves that received soft deletions since they were last compacted (may hold stale IDs).
+        std::vector<node_id> compact_queue_;
+        /// Freed node IDs, reused by @c allocateNode.
+        std::vector<node_id> free_nodes_;
+
+        /// Marks "no handle slot" (handles not tracked, or allocate a new slot).
+        static constexpr std::uint32_t kNoHandle = std::numeric_limits<std::uint32_t>::max();
+        /// Where a tracked point lives; @c generation changes whenever the slot is released.
+        struct HandleSlot
+        {
+            node_id       leaf = kInvalidNode;
+            std::uint32_t index = 0;
+            std::uint32_t generation = 0;
+        };
+        /// Handle slots indexed by @c PointHandle::index (only used when handles are tracked).
+        std::vector<HandleSlot> slots_;
+        /// Released slot indices, reused by @c acquireHandle.
+        std::vector<std::uint32_t> free_handles_;
+
+    private:
+        // ---------------------- Internal Helpers ---------------------- //
+
+        void throwIfFrozen(const char* what) const
+        {
+            if (frozen_) throw std::logic_error(std::string(what) + ": the tree is frozen");
+        }
+
+        /**
+         * @brief Records that @p id changes in the mutation producing version @c version_ + 1.
+         *
+         * Ancestors get the stamp as their subtree version; the walk stops at the first
+         * ancestor already stamped by this mutation.
+         */
+        void stampModified(node_id id)
+        {
+            const std::uint64_t v = version_ + 1;
+            nodes_[id].modified_version = v;
+            nodes_[id].subtree_version = v;
+            for (node_id p = nodes_[id].parent; p != kInvalidNode && nodes_[p].subtree_version < v; p = nodes_[p].parent)
+                nodes_[p].subtree_version = v;
+        }
+
+        /// Records that the leaf @p id became an internal node in the current mutation.
+        void retireLeaf(node_id id)
+        {
+            stampModified(id);
+            retired_.push_back({ version_ + 1, id });
+        }
+
+        /// Every old node disappears in the current mutation, so older deltas must be full.
+        void resetDeltaHistory()
+        {
+            retired_.clear();
+            history_floor_ = version_ + 1;
+        }
+
+        /// Fills @p delta for @c captureDelta / @c captureDeltaView; @p make turns a leaf into an entry.
+        template <class DeltaT, class MakeEntry>
+        void collectDelta(std::uint64_t since_version, DeltaT& delta, const MakeEntry& make) const
+        {
+            delta.since_version = since_version;
+            delta.version = version_;
+            if (root_ == kInvalidNode || since_version >= version_) return;
+
+            delta.full = since_version < history_floor_;
+            const std::uint64_t since = delta.full ? 0 : since_version;
+
+            std::vector<node_id> stack{ root_ };
+            while (!stack.empty())
+            {
+                const node_id nid = stack.back();
+                stack.pop_back();
+                const Node& node = nodes_[nid];
+                if (node.subtree_version <= since) continue;
+                if (node.is_leaf)
+                {
+                    if (node.modified_version > since) delta.changed.push_back(make(nid, node));
+                    continue;
+                }
+                for (std::size_t c = kChildCount; c-- > 0;)
+                    if (node.children[c] != kInvalidNode) stack.push_back(node.children[c]);
+            }
+            if (delta.full) return;
+
+            // A leaf that split and became a leaf again since then is already in changed.
+            auto it = std::upper_bound(retired_.begin(), retired_.end(), since,
+                [](std::uint64_t v, const RetiredLeaf& r) { return v < r.version; });
+            for (; it != retired_.end(); ++it)
+                if (!nodes_[it->id].is_leaf) delta.removed.push_back(it->id);
+            std::sort(delta.removed.begin(), delta.removed.end());
+            delta.removed.erase(std::unique(delta.removed.begin(), delta.removed.end()), delta.removed.end());
+        }
+
+        /// Allocates a new node, reusing a freed ID when there is one, and returns its ID.
+        node_id allocateNode()
+        {
+            node_id id;
+            if (!free_nodes_.empty())
+            {
+                id = free_nodes_.back();
+                free_nodes_.pop_back();
+                Node& node = nodes_[id];
+                node.children.fill(kInvalidNode);
+                node.is_leaf = true;
+                node.depth = 0;
+                node.dirty = false;
+                node.need_compact = false;
+                node.compact_queued = false;
+                node.parent = kInvalidNode;
+            }
+            else
+            {
+                id = static_cast<node_id>(nodes_.size());
+                nodes_.emplace_back(point_allocator(base_alloc_), byte_allocator(base_alloc_),
+                    handle_allocator(base_alloc_), scalar_allocator(base_alloc_));
+            }
+            nodes_[id].modified_version = version_ + 1;
+            nodes_[id].subtree_version = version_ + 1;
+            return id;
+        }
+
+        /// Releases the storage of the leaf @p id and puts its ID on the free list.
+        void freeNode(node_id id)
+        {
+            Node& node = nodes_[id];
+            retireLeaf(id);
+            node.points = std::vector<PointT, point_allocator>(node.points.get_allocator());
+            node.alive = std::vector<std::uint8_t, byte_allocator>(node.alive.get_allocator());
+            node.handles = std::vector<std::uint32_t, handle_allocator>(node.handles.get_allocator());
+            node.lanes = std::vector<Scalar, scalar_allocator>(node.lanes.get_allocator());
+            node.is_leaf = false;
+            node.dirty = false;
+            node.need_compact = false;
+            node.compact_queued = false;
+            free_nodes_.push_back(id);
+        }
+
+        /// Records soft deletions in the leaf @p id: version stamp and maintenance queue.
+        void noteDeletion(node_id id)
+        {
+            stampModified(id);
+            if (!nodes_[id].compact_queued)
+            {
+                nodes_[id].compact_queued = true;
+                compact_queue_.push_back(id);
+            }
+        }
+
+        void requireHandles(const char* what) const
+        {
+            if (!config_.track_handles) throw std::logic_error(std::string(what) + ": Config::track_handles is off");
+        }
+
+        /// Returns the slot @p h refers to, or nullptr if @p h is stale.
+        const HandleSlot* resolveHandle(PointHandle h) const noexcept
+        {
+            if (h.index >= slots_.size()) return nullptr;
+            const HandleSlot& slot = slots_[h.index];
+            if (slot.leaf == kInvalidNode || slot.generation != h.generation) return nullptr;
+            return &slot;
+        }
+
+        std::uint32_t acquireHandle()
+        {
+            if (!free_handles_.empty())
+            {
+                const std::uint32_t h = free_handles_.back();
+                free_handles_.pop_back();
+                return h;
+            }
+            if (slots_.size() >= kNoHandle)
+                throw std::length_error("Orthtree: more than 2^32 - 1 tracked points");
+            slots_.emplace_back();
+            return static_cast<std::uint32_t>(slots_.size() - 1);
+        }
+
+        void releaseHandle(std::uint32_t h)
+        {
+            slots_[h].leaf = kInvalidNode;
+            ++slots_[h].generation;
+            free_handles_.push_back(h);
+        }
+
+        /**
+         * @brief Bookkeeping for the point just appended to the leaf @p leaf: its position
+         *        lanes and, when handles are tracked, @p handle (a new slot for @c kNoHandle).
+         */
+        void onAppend(node_id leaf, std::uint32_t handle)
+        {
+            Node& node = nodes_[leaf];
+            storeLane(node, node.points.size() - 1);
+            if (!config_.track_handles) return;
+            if (handle == kNoHandle) handle = acquireHandle();
+            slots_[handle].leaf = leaf;
+            slots_[handle].index = static_cast<std::uint32_t>(node.handles.size());
+            node.handles.push_back(handle);
+        }
+
+        /// True when leaves keep position lanes.
+        bool lanesOn() const noexcept
+        {
+            if constexpr (kLaneScan) return config_.position_lanes;
+            else return false;
+        }
+
+        /// Writes the lanes of point @p i of @p node from its position, growing them by a block if needed.
+        void storeLane(Node& node, std::size_t i)
+        {
+            if constexpr (kLaneScan)
+            {
+                if (!config_.position_lanes) return;
+                const std::size_t need = (i / kLaneWidth + 1) * kLaneBlock;
+                if (node.lanes.size() < need) node.lanes.resize(need, Scalar(0));
+                const auto& pos = get_pos_(node.points[i]);
+                Scalar* lane = node.lanes.data() + i / kLaneWidth * kLaneBlock + i % kLaneWidth;
+                for (std::size_t a = 0; a < Dim; ++a) lane[a * kLaneWidth] = pos[a];
+            }
+        }
+
+        /// Drops lane blocks past the last point of @p node.
+        void truncateLanes(Node& node)
+        {
+            if (lanesOn()) node.lanes.resize((node.points.size() + kLaneWidth - 1) / kLaneWidth * kLaneBlock);
+        }
+
+        /// Invalidates every handle and detaches all slots; keeps at least @p n of them for @c bulkLoad.
+        void resetHandles(std::size_t n)
+        {
+            if (!config_.track_handles) return;
+            for (HandleSlot& slot : slots_)
+            {
+                slot.leaf = kInvalidNode;
+                ++slot.generation;
+            }
+            if (slots_.size() < n) slots_.resize(n);
+        }
+
+        /// Puts every detached slot on the free list, lowest index on top.
+        void rebuildFreeHandles()
+        {
+            free_handles_.clear();
+            for (std::size_t i = slots_.size(); i-- > 0;)
+                if (slots_[i].leaf == kInvalidNode) free_handles_.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        /**
+         * @brief Removes point @p index of the leaf @p leaf by moving the leaf's last point
+         *        into its place; the caller releases or reattaches its handle.
+         */
+        void removePoint(node_id leaf, std::uint32_t index)
+        {
+            Node& node = nodes_[leaf];
+            const std::size_t last = node.points.size() - 1;
+            if (index != last)
+            {
+                node.points[index] = std::move(node.points[last]);
+                node.alive[index] = node.alive[last];
+                storeLane(node, index);
+                if (!node.handles.empty())
+                {
+                    node.handles[index] = node.handles[last];
+                    slots_[node.handles[index]].index = index;
+                }
+            }
+            node.points.pop_back();
+            node.alive.pop_back();
+            if (!node.handles.empty()) node.handles.pop_back();
+            truncateLanes(node);
+            node.dirty = true;
+            stampModified(leaf);
+            if (node.points.empty() && node.parent != kInvalidNode)
+            {
+                // Let maintain() unlink it and try to merge its siblings.
+                node.need_compact = true;
+                noteDeletion(leaf);
+            }
+        }
+
+        /// Reads one @c updateMany element, a pair or struct of (handle, point).
+        template <class Move>
+        static std::tuple<PointHandle, const PointT&> unpackMove(const Move& m)
+        {
+            const auto& [h, value] = m;
+            return { h, value };
+        }
+
+        /// Outcome of @c updateInLeaf.
+        enum class LeafUpdate { kRejected, kDone, kLeavesLeaf };
+
+        /// Assigns @p value in place if its position stays in the leaf of @p h.
+        LeafUpdate updateInLeaf(PointHandle h, const PointT& value)
+        {
+            const HandleSlot* slot = resolveHandle(h);
+            if (!slot) return LeafUpdate::kRejected;
+            const node_id leaf = slot->leaf;
+            Node& node = nodes_[leaf];
+            if (!node.alive[slot->index]) return LeafUpdate::kRejected;
+            if (!node.bounds.contains(get_pos_(value))) return LeafUpdate::kLeavesLeaf;
+
+            node.points[slot->index] = value;
+            storeLane(node, slot->index);
+            node.dirty = true;
+            stampModified(leaf);
+            return LeafUpdate::kDone;
+        }
+
+        /// Returns the nearest proper ancestor of @p id whose cell holds @p pos (kInvalidNode if none).
+        template <class VecLike>
+        node_id enclosingAncestor(node_id id, const VecLike& pos) const
+        {
+            node_id ancestor = nodes_[id].parent;
+            while (ancestor != kInvalidNode && !nodes_[ancestor].bounds.contains(pos))
+                ancestor = nodes_[ancestor].parent;
+            return ancestor;
+        }
+
+        /**
+         * @brief Moves the point of @p h, which @c updateInLeaf found leaving its leaf, to
+         *        the leaf holding @p value's position; false if that is outside the root.
+         */
+        bool relocate(PointHandle h, const PointT& value)
+        {
+            const node_id leaf = slots_[h.index].leaf;
+            const node_id ancestor = enclosingAncestor(leaf, get_pos_(value));
+            if (ancestor == kInvalidNode) return false;
+
+            removePoint(leaf, slots_[h.index].index);
+            insertInternal(ancestor, value, nodes_[ancestor].depth, h.index);
+            return true;
+        }
+
+        /// Appends @p p to the leaf @p leaf without checking whether it should split.
+        void appendToLeaf(node_id leaf, const PointT& p, std::uint32_t handle)
+        {
+            nodes_[leaf].points.push_back(p);
+            nodes_[leaf].alive.push_back(1);
+            onAppend(leaf, handle);
+            nodes_[leaf].dirty = true;
+            stampModified(leaf);
+        }
+
+        /// Walks from @p id, whose cell holds @p pos, to the leaf holding it, creating missing children.
+        template <class VecLike>
+        node_id descendToLeaf(node_id id, const VecLike& pos)
+        {
+            while (!nodes_[id].is_leaf)
+            {
+                const std::size_t child_idx = childIndexForPosition(nodes_[id].bounds, pos);
+                node_id child_id = nodes_[id].children[child_idx];
+                if (child_id == kInvalidNode)
+                {
+                    // Save bounds before allocateNode() potentially reallocates nodes_.
+                    const box_type parent_bounds = nodes_[id].bounds;
+                    const std::uint32_t depth = nodes_[id].depth;
+                    child_id = allocateNode();
+                    nodes_[id].children[child_idx] = child_id;
+
+                    Node& child = nodes_[child_id];
+                    child.bounds = computeChildBounds(parent_bounds, child_idx);
+                    child.is_leaf = true;
+                    child.depth = depth + 1;
+                    child.parent = id;
+                }
+                id = child_id;
+            }
+            return id;
+        }
+
+        /// Splits the leaf @p id while it holds more than @c max_points_per_leaf alive points.
+        void splitOverfull(node_id id)
+        {
+            const Node& node = nodes_[id];
+            if (!node.is_leaf || node.depth >= config_.max_depth
+                || node.aliveCount() <= config_.max_points_per_leaf)
+                return;
+            splitLeaf(id, node.depth);
+            for (std::size_t c = 0; c < kChildCount; ++c)
+            {
+                const node_id child = nodes_[id].children[c];
+                if (child != kInvalidNode) splitOverfull(child);
+            }
+        }
+
+        /// @c update without the version increment.
+        bool updateInternal(PointHandle h, const PointT& value)
+        {
+            const LeafUpdate r = updateInLeaf(h, value);
+            return r == LeafUpdate::kDone || (r == LeafUpdate::kLeavesLeaf && relocate(h, value));
+        }
+
+        /// Removes the soft-deleted points of the leaf @p id; returns how many.
+        std::size_t compactLeaf(node_id id)
+        {
+            Node& node = nodes_[id];
+            std::size_t write = 0;
+            for (std::size_t read = 0; read < node.points.size(); ++read)
+            {
+                if (!node.alive[read])
+                {
+                    if (!node.handles.empty()) releaseHandle(node.handles[read]);
+                    continue;
+                }
+                if (write != read)
+                {
+                    node.points[write] = std::move(node.points[read]);
+                    node.alive[write]  = 1;
+                    storeLane(node, write);
+                    if (!node.handles.empty())
+                    {
+                        node.handles[write] = node.handles[read];
+                        slots_[node.handles[write]].index = static_cast<std::uint32_t>(write);
+                    }
+                }
+                ++write;
+            }
+            const std::size_t removed = node.points.size() - write;
+            node.points.erase(node.points.begin() + static_cast<std::ptrdiff_t>(write), node.points.end());
+            node.alive.resize(write);
+            if (!node.handles.empty()) node.handles.resize(write);
+            truncateLanes(node);
+            node.need_compact = false;
+            node.dirty = true;
+            stampModified(id);
+            return removed;
+        }
+
+        template <class KeepGoing>
+        MaintenanceStats maintainImpl(const KeepGoing& keep_going)
         {
-            for (auto& node : nodes_)
-                if (node.is_leaf) node.dirty = false;
+            throwIfFrozen("Orthtree::maintain");
+            MaintenanceStats st;
+            while (!compact_queue_.empty() && keep_going(st))
+            {
+                const node_id id = compact_queue_.back();
+                compact_queue_.pop_back();
+                Node& node = nodes_[id];
+                node.compact_queued = false;
+                // Entries go stale when their leaf split or was merged away.
+                if (!node.is_leaf || !node.need_compact) continue;
+
+                st.work += node.points.size();
+                st.points_removed += compactLeaf(id);
+                ++st.leaves_compacted;
+
+                node_id parent = node.parent;
+                if (parent == kInvalidNode) continue;
+                if (node.points.empty())
+                {
+                    // Unlink the empty leaf; inserts recreate it on demand.
+                    for (node_id& cid : nodes_[parent].children)
+                        if (cid == id) cid = kInvalidNode;
+                    freeNode(id);
+                    ++st.nodes_freed;
+                }
+                for (; parent != kInvalidNode && tryMerge(parent, st); parent = nodes_[parent].parent) {}
+            }
+            st.done = compact_queue_.empty();
+            if (st.leaves_compacted > 0 || st.nodes_merged > 0) ++version_;
+            return st;
         }
 
-    private:
-        // ---------------------- Data Members ---------------------- //
-
-        /// Tree configuration (bounds, depth limit, leaf point capacity).
-        Config config_{};
-        /// Position accessor functor.
-        GetPosition get_pos_{};
-
-        /// Base allocator used to rebind storage for nodes, points, and alive flags.
-        BaseAllocator base_alloc_{};
-        /// Flat array of all allocated nodes (indexed by node_id).
-        std::vector<Node, node_allocator> nodes_;
-        /// Node ID of the root node.
-        node_id root_ = kInvalidNode;
-
-        /// Monotonically increasing mutation version.
-        std::uint64_t version_ = 0;
+        /**
+         * @brief Collapses @p id into a leaf if its children are all leaves holding at most
+         *        @c merge_threshold alive points together.
+         */
+        bool tryMerge(node_id id, MaintenanceStats& st)
+        {
+            const std::size_t limit = std::min(config_.merge_threshold, config_.max_points_per_leaf);
+            if (limit == 0) return false;
 
-    private:
-        // ---------------------- Internal Helpers ---------------------- //
+            std::size_t alive = 0;
+            for (node_id cid : nodes_[id].children)
+            {
+                if (cid == kInvalidNode) continue;
+                if (!nodes_[cid].is_leaf) return false;
+                alive += nodes_[cid].aliveCount();
+                if (alive > limit) return false;
+            }
 
-        /// Allocates a new node and returns its ID.
-        node_id allocateNode()
-        {
-            node_id id = static_cast<node_id>(nodes_.size());
-            nodes_.emplace_back(point_allocator(base_alloc_), byte_allocator(base_alloc_));
-            return id;
+            Node& node = nodes_[id];
+            node.points.reserve(alive);
+            node.alive.reserve(alive);
+            for (node_id& cid : node.children)
+            {
+                if (cid == kInvalidNode) continue;
+                Node& child = nodes_[cid];
+                st.work += child.points.size();
+                for (std::size_t i = 0; i < child.points.size(); ++i)
+                {
+                    const std::uint32_t h = child.handles.empty() ? kNoHandle : child.handles[i];
+                    if (!child.alive[i])
+                    {
+                        if (h != kNoHandle) releaseHandle(h);
+                        continue;
+                    }
+                    node.points.push_back(std::move(child.points[i]));
+                    node.alive.push_back(1);
+                    onAppend(id, h);
+                }
+                freeNode(cid);
+                cid = kInvalidNode;
+                ++st.nodes_freed;
+            }
+            node.is_leaf = true;
+            node.dirty = true;
+            node.need_compact = false;
+            stampModified(id);
+            ++st.nodes_merged;
+            return true;
         }
 
         static box_type computeChildBounds(const box_type& parent, std::size_t child_index)
@@ -796,9 +2553,11 @@ namespace lux::cxx
          * @param node_id_value Root of the subtree.
          * @param p             Point to insert.
          * @param depth         Current depth of @p node_id_value.
+         * @param handle        Handle slot to attach when handles are tracked; a new one if @c kNoHandle.
          * @return True if the point was inserted.
          */
-        bool insertInternal(node_id node_id_value, const PointT& p, std::uint32_t depth)
+        bool insertInternal(node_id node_id_value, const PointT& p, std::uint32_t depth,
+                            std::uint32_t handle = kNoHandle)
         {
             const auto& pos = get_pos_(p);
 
@@ -807,9 +2566,7 @@ namespace lux::cxx
 
             if (nodes_[node_id_value].is_leaf)
             {
-                nodes_[node_id_value].points.push_back(p);
-                nodes_[node_id_value].alive.push_back(1);
-                nodes_[node_id_value].dirty = true;
+                appendToLeaf(node_id_value, p, handle);
 
                 if (depth < config_.max_depth)
                 {
@@ -837,9 +2594,10 @@ namespace lux::cxx
                 child.bounds = computeChildBounds(parent_bounds, child_idx);
                 child.is_leaf = true;
                 child.depth = depth + 1;
+                child.parent = node_id_value;
             }
 
-            return insertInternal(child_id, p, depth + 1);
+            return insertInternal(child_id, p, depth + 1, handle);
         }
 
         /**
@@ -867,7 +2625,9 @@ namespace lux::cxx
             {
                 nodes_[node_id_value].points.push_back(std::move(p));
                 nodes_[node_id_value].alive.push_back(1);
+                onAppend(node_id_value, kNoHandle);
                 nodes_[node_id_value].dirty = true;
+                stampModified(node_id_value);
 
                 if (depth < config_.max_depth)
                 {
@@ -892,6 +2652,7 @@ namespace lux::cxx
                 child.bounds = computeChildBounds(parent_bounds, child_idx);
                 child.is_leaf = true;
                 child.depth = depth + 1;
+                child.parent = node_id_value;
             }
 
             return emplaceInternal(child_id, std::move(p), depth + 1);
@@ -926,7 +2687,9 @@ namespace lux::cxx
                 // Construct the point directly inside the vector's storage.
                 nodes_[node_id_value].points.emplace_back(std::forward<Args>(args)...);
                 nodes_[node_id_value].alive.push_back(1);
+                onAppend(node_id_value, kNoHandle);
                 nodes_[node_id_value].dirty = true;
+                stampModified(node_id_value);
 
                 if (depth < config_.max_depth)
                 {
@@ -951,6 +2714,7 @@ namespace lux::cxx
                 child.bounds = computeChildBounds(parent_bounds, child_idx);
                 child.is_leaf = true;
                 child.depth = depth + 1;
+                child.parent = node_id_value;
             }
 
             return emplaceAtInternal(child_id, pos, depth + 1, std::forward<Args>(args)...);
@@ -969,16 +2733,20 @@ namespace lux::cxx
             if (depth >= config_.max_depth) return;
 
             // Move points/alive out to avoid iterator invalidation while allocating children.
-            auto old_points = std::move(nodes_[node_id_value].points);
-            auto old_alive  = std::move(nodes_[node_id_value].alive);
+            auto old_points  = std::move(nodes_[node_id_value].points);
+            auto old_alive   = std::move(nodes_[node_id_value].alive);
+            auto old_handles = std::move(nodes_[node_id_value].handles);
 
             nodes_[node_id_value].points.clear();
             nodes_[node_id_value].alive.clear();
+            nodes_[node_id_value].handles.clear();
+            nodes_[node_id_value].lanes = std::vector<Scalar, scalar_allocator>(nodes_[node_id_value].lanes.get_allocator());
 
             // Convert to an internal node (internal nodes do not store points directly).
             nodes_[node_id_value].is_leaf = false;
             nodes_[node_id_value].dirty = false;
             nodes_[node_id_value].need_compact = false;
+            retireLeaf(node_id_value);
 
             // Precompute center to avoid recomputing it for every point in the loop.
             const auto split_center = nodes_[node_id_value].bounds.center();
@@ -986,7 +2754,11 @@ namespace lux::cxx
             // Redistribute alive points to child nodes (children are created on demand).
             for (std::size_t i = 0; i < old_points.size(); ++i)
             {
-                if (!old_alive[i]) continue;
+                if (!old_alive[i])
+                {
+                    if (!old_handles.empty()) releaseHandle(old_handles[i]);
+                    continue;
+                }
 
                 const PointT& p = old_points[i];
                 const auto& pos = get_pos_(p);
@@ -1004,15 +2776,235 @@ namespace lux::cxx
                     child.bounds = computeChildBounds(parent_bounds, child_idx);
                     child.is_leaf = true;
                     child.depth = depth + 1;
+                    child.parent = node_id_value;
                 }
 
                 Node& child = nodes_[child_id];
                 child.points.push_back(p);
                 child.alive.push_back(1);
+                onAppend(child_id, old_handles.empty() ? kNoHandle : old_handles[i]);
                 child.dirty = true;
             }
         }
 
+        // ---------------------- Bulk Loading Helpers ---------------------- //
+
+        /// Deepest level a bulk-load Morton code resolves.
+        static constexpr std::uint32_t kMaxCodeLevels = detail::OrthtreeMortonEncoder<Scalar, Dim>::kMaxLevels;
+
+        /// A leaf created by @c bulkLoad and the run of sorted keys its points come from.
+        struct BulkLeaf
+        {
+            node_id     id;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        template <class Range>
+        std::size_t bulkLoadImpl(const Range& pts, ThreadPool* pool)
+        {
+            if constexpr (!(std::ranges::random_access_range<const Range> && std::ranges::sized_range<const Range>))
+            {
+                // Buffer single-pass ranges once so points can be gathered by index.
+                std::vector<PointT> buffered;
+                for (const PointT& p : pts) buffered.push_back(p);
+                return bulkLoadImpl(buffered, pool);
+            }
+            else
+            {
+                const auto first = std::ranges::begin(pts);
+                const std::size_t n = static_cast<std::size_t>(std::ranges::size(pts));
+                if (n > std::numeric_limits<std::uint32_t>::max())
+                    throw std::length_error("Orthtree::bulkLoad: more than 2^32 - 1 points");
+
+                // 1-2. Morton code per point, radix-sorted; points outside the root bounds end up last and are dropped.
+                const std::uint32_t levels = std::min(config_.max_depth, kMaxCodeLevels);
+                std::vector<detail::OrthtreeSortKey> keys;
+                const std::size_t inside = detail::orthtreeSortByMorton(first, n, get_pos_,
+                    config_.root_bounds, levels, pool, keys);
+
+                // 3. Hierarchy: one node per distinct code prefix that needs it; leaf storage reserved exactly.
+                resetDeltaHistory();
+                resetHandles(n);
+                compact_queue_.clear();
+                free_nodes_.clear();
+                nodes_.clear();
+                nodes_.reserve(std::max<std::size_t>(1024,
+                    2 * inside / std::max<std::uint32_t>(1, config_.max_points_per_leaf)));
+                root_ = allocateNode();
+                nodes_[root_].bounds = config_.root_bounds;
+                nodes_[root_].is_leaf = true;
+                nodes_[root_].depth = 0;
+
+                std::vector<BulkLeaf> leaves;
+                bulkBuildNode(root_, 0, levels, keys, 0, inside, first, leaves);
+                // Lanes in a pass of their own, so the point arrays of neighbouring leaves stay
+                // adjacent in memory for queries that stream whole leaves.
+                if (lanesOn())
+                    for (const BulkLeaf& leaf : leaves)
+                        nodes_[leaf.id].lanes.resize((leaf.end - leaf.begin + kLaneWidth - 1) / kLaneWidth * kLaneBlock);
+
+                // 4. Copy points into their leaves. Nothing allocates here (lanes were sized
+                //    above), so leaves are filled in parallel regardless of the allocator.
+                const std::size_t fill_chunks = detail::orthtreeChunkCount(pool, inside);
+                detail::orthtreeRunChunks(pool, fill_chunks, [&](std::size_t c) {
+                    const std::size_t lo = inside * c / fill_chunks;
+                    const std::size_t hi = inside * (c + 1) / fill_chunks;
+                    auto by_begin = [](const BulkLeaf& l, std::size_t v) { return l.begin < v; };
+                    auto it = std::lower_bound(leaves.begin(), leaves.end(), lo, by_begin);
+                    const auto last = std::lower_bound(it, leaves.end(), hi, by_begin);
+                    for (; it != last; ++it)
+                    {
+                        Node& node = nodes_[it->id];
+                        for (std::size_t k = it->begin; k < it->end; ++k)
+                            node.points.push_back(first[keys[k].index]);
+                        node.alive.resize(node.points.size(), 1);
+                        for (std::size_t i = 0; i < node.points.size(); ++i) storeLane(node, i);
+                        if (!config_.track_handles) continue;
+                        // Input i keeps slot i; every slot is written by exactly one leaf.
+                        for (std::size_t k = it->begin; k < it->end; ++k)
+                        {
+                            const std::uint32_t h = keys[k].index;
+                            slots_[h].leaf = it->id;
+                            slots_[h].index = static_cast<std::uint32_t>(node.handles.size());
+                            node.handles.push_back(h);
+                        }
+                    }
+                });
+                rebuildFreeHandles();
+
+                ++version_;
+                return inside;
+            }
+        }
+
+        /**
+         * @brief Creates the subtree of @p id over the sorted keys [@p begin, @p end).
+         *
+         * All keys in the range share the path down to @p id, so each child's keys form
+         * a contiguous run ordered by child index. Leaves are only reserved and recorded
+         * in @p leaves; a leaf that would exceed the capacity below the code resolution
+         * is finished with ordinary insertion.
+         */
+        template <class It>
+        void bulkBuildNode(node_id id, std::uint32_t depth, std::uint32_t levels,
+            const std::vector<detail::OrthtreeSortKey>& keys, std::size_t begin, std::size_t end,
+            It first, std::vector<BulkLeaf>& leaves)
+        {
+            const std::size_t count = end - begin;
+            if (count <= config_.max_points_per_leaf || depth >= config_.max_depth)
+            {
+                Node& node = nodes_[id];
+                node.points.reserve(count);
+                node.alive.reserve(count);
+                if (config_.track_handles) node.handles.reserve(count);
+                node.dirty = true;
+                leaves.push_back({ id, begin, end });
+                return;
+            }
+            if (depth >= levels)
+            {
+                for (std::size_t k = begin; k < end; ++k)
+                    insertInternal(id, first[keys[k].index], depth, keys[k].index);
+                return;
+            }
+
+            nodes_[id].is_leaf = false;
+            const unsigned shift = static_cast<unsigned>(Dim * (levels - depth - 1));
+            const std::uint64_t mask = kChildCount - 1;
+
+            for (std::size_t lo = begin; lo < end;)
+            {
+                const std::size_t child_idx = static_cast<std::size_t>((keys[lo].code >> shift) & mask);
+                const std::size_t hi = static_cast<std::size_t>(std::partition_point(
+                    keys.begin() + lo, keys.begin() + end,
+                    [&](const detail::OrthtreeSortKey& k) { return ((k.code >> shift) & mask) == child_idx; })
+                    - keys.begin());
+
+                // Save bounds before allocateNode() potentially reallocates nodes_.
+                const box_type parent_bounds = nodes_[id].bounds;
+                const node_id child_id = allocateNode();
+                nodes_[id].children[child_idx] = child_id;
+
+                Node& child = nodes_[child_id];
+                child.bounds = computeChildBounds(parent_bounds, child_idx);
+                child.is_leaf = true;
+                child.depth = depth + 1;
+                child.parent = id;
+
+                bulkBuildNode(child_id, depth + 1, levels, keys, lo, hi, first, leaves);
+                lo = hi;
+            }
+        }
+
+        /// Box test for @c scanLeaf and @c markDeletedRecursive.
+        struct BoxTest
+        {
+            const GetPosition& get_pos;
+            const box_type& region;
+
+            bool operator()(const PointT& p) const { return region.contains(get_pos(p)); }
+            bool covers(const box_type& b) const { return region.contains(b.min) && region.contains(b.max); }
+            std::uint32_t block(const Scalar* lanes) const { return detail::orthtreeBlockInBox<Scalar, Dim>(lanes, region); }
+        };
+
+        /// Ball test for @c scanLeaf and @c markDeletedRecursive; @c lane_center is @c center as Scalars.
+        template <class VecLike>
+        struct BallTest
+        {
+            const GetPosition& get_pos;
+            const VecLike& center;
+            Scalar r2;
+            std::array<Scalar, Dim> lane_center;
+
+            bool operator()(const PointT& p) const { return detail::orthtreeWithinDistance<Scalar, Dim>(get_pos(p), center, r2); }
+            bool covers(const box_type& b) const { return b.maxDistanceSquared(center) <= r2; }
+            std::uint32_t block(const Scalar* lanes) const { return detail::orthtreeBlockInBall<Scalar, Dim>(lanes, lane_center, r2); }
+        };
+
+        template <class VecLike>
+        BallTest<VecLike> makeBallTest(const VecLike& center, Scalar r2) const
+        {
+            BallTest<VecLike> test{ get_pos_, center, r2, {} };
+            for (std::size_t a = 0; a < Dim; ++a) test.lane_center[a] = Scalar(center[a]);
+            return test;
+        }
+
+        /**
+         * @brief Calls @p emit(i) for every alive point @a i of the leaf @p node that @p test accepts.
+         *
+         * A leaf inside the tested shape emits every alive point. Otherwise, with position
+         * lanes, each block is tested at once and its hit mask is ANDed with the alive
+         * flags; without them points are tested one by one.
+         */
+        template <class Test, class Emit>
+        void scanLeaf(const Node& node, const Test& test, Emit&& emit) const
+        {
+            const std::size_t n = node.points.size();
+            if (test.covers(node.bounds))
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                    if (node.alive[i]) emit(i);
+                return;
+            }
+            if constexpr (kLaneScan)
+            {
+                if (config_.position_lanes)
+                {
+                    for (std::size_t base = 0; base < n; base += kLaneWidth)
+                    {
+                        std::uint32_t bits = test.block(node.lanes.data() + base / kLaneWidth * kLaneBlock)
+                            & detail::orthtreeAliveMask<Scalar>(node.alive.data() + base, std::min(kLaneWidth, n - base));
+                        for (; bits != 0; bits &= bits - 1)
+                            emit(base + static_cast<std::size_t>(std::countr_zero(bits)));
+                    }
+                    return;
+                }
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                if (node.alive[i] && test(node.points[i])) emit(i);
+        }
+
         /**
          * @brief Recursive query helper for box range searches.
          *
@@ -1030,24 +3022,335 @@ namespace lux::cxx
             if (!node.bounds.intersects(region))
                 return;
 
+            const BoxTest test{ get_pos_, region };
+            if (test.covers(node.bounds))
+            {
+                // Nothing below needs a containment check.
+                forEachAlivePointRecursive(node_id_value, fn);
+                return;
+            }
+            if (node.is_leaf)
+            {
+                scanLeaf(node, test, [&](std::size_t i) { fn(node.points[i]); });
+                return;
+            }
+
+            for (std::size_t i = 0; i < kChildCount; ++i)
+            {
+                node_id cid = node.children[i];
+                if (cid == kInvalidNode) continue;
+                forEachPointInBoxRecursive(cid, region, fn);
+            }
+        }
+
+        // ---------------------- Parallel Traversal Helpers ---------------------- //
+
+        /**
+         * @brief Roots of disjoint subtrees that together cover every node @p overlaps accepts.
+         *
+         * Starting from the root, internal nodes are replaced by their accepted children
+         * until there are at least @p target roots or only leaves remain.
+         */
+        template <class Overlaps>
+        std::vector<node_id> overlappingSubtrees(const Overlaps& overlaps, std::size_t target) const
+        {
+            std::vector<node_id> current{ root_ };
+            std::vector<node_id> next;
+            while (current.size() < target)
+            {
+                next.clear();
+                bool expanded = false;
+                for (node_id nid : current)
+                {
+                    const Node& node = nodes_[nid];
+                    if (node.is_leaf) { next.push_back(nid); continue; }
+                    expanded = true;
+                    for (node_id cid : node.children)
+                        if (cid != kInvalidNode && overlaps(nodes_[cid].bounds)) next.push_back(cid);
+                }
+                current.swap(next);
+                if (!expanded) break;
+            }
+            return current;
+        }
+
+        /// Runs @p fn(slot, root) for every root in @p subtrees, handed out dynamically to @p pool and the caller.
+        template <class Func>
+        void forEachSubtreeParallel(const std::vector<node_id>& subtrees, ThreadPool& pool, Func&& fn) const
+        {
+            std::atomic<std::size_t> next{ 0 };
+            pool.parallel_for(pool.thread_count() + 1, [&](std::size_t slot) {
+                for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < subtrees.size();)
+                    fn(slot, subtrees[i]);
+            });
+        }
+
+        template <class Predicate, class Prune>
+        std::size_t markDeletedParallel(Predicate& pred, const Prune& prune, ThreadPool& pool)
+        {
+            if (!prune(nodes_[root_].bounds)) return 0;
+
+            const std::size_t slots = pool.thread_count() + 1;
+            const auto subtrees = overlappingSubtrees(prune, 8 * slots);
+            std::vector<std::size_t> removed(slots, 0);
+            std::vector<std::vector<node_id>> touched(slots);
+            forEachSubtreeParallel(subtrees, pool, [&](std::size_t slot, node_id nid) {
+                removed[slot] += markDeletedRecursive(nid, pred, prune, &touched[slot]);
+            });
+
+            // Version stamps walk up shared ancestors and the queue is shared, so both are updated here.
+            for (const auto& ids : touched)
+                for (node_id id : ids) noteDeletion(id);
+
+            std::size_t total = 0;
+            for (std::size_t r : removed) total += r;
+            if (total > 0) ++version_;
+            return total;
+        }
+
+        /**
+         * @brief Shared traversal for @c forEachPointInBoxes over the queries in @p subset.
+         */
+        template <class BoxIt, class Func>
+        void forEachPointInBoxSubset(BoxIt boxes, const std::vector<std::uint32_t>& subset, Func& fn) const
+        {
+            if (subset.empty()) return;
+
+            // One candidate list per level; depth never exceeds max_depth.
+            std::vector<std::vector<std::uint32_t>> active(config_.max_depth + 2);
+            active[0] = subset;
+            forEachPointInBoxesRecursive(root_, 0, boxes, active, fn);
+        }
+
+        template <class BoxIt, class Func>
+        void forEachPointInBoxesRecursive(node_id nid, std::size_t level, BoxIt boxes,
+            std::vector<std::vector<std::uint32_t>>& active, Func& fn) const
+        {
+            const Node& node = nodes_[nid];
+            const auto& reaching_parent = active[level];
+            auto& reaching = active[level + 1];
+            reaching.clear();
+            for (std::uint32_t q : reaching_parent)
+            {
+                const box_type& region = boxes[q];
+                if (!node.bounds.intersects(region)) continue;
+                if (region.contains(node.bounds.min) && region.contains(node.bounds.max))
+                {
+                    auto emit = [&](const PointT& p) { fn(std::size_t(q), p); };
+                    forEachAlivePointRecursive(nid, emit);
+                }
+                else reaching.push_back(q);
+            }
+            if (reaching.empty()) return;
+
+            if (node.is_leaf)
+            {
+                for (std::size_t i = 0; i < node.points.size(); ++i)
+                {
+                    if (!node.alive[i]) continue;
+                    const auto& pos = get_pos_(node.points[i]);
+                    for (std::uint32_t q : reaching)
+                        if (boxes[q].contains(pos)) fn(std::size_t(q), node.points[i]);
+                }
+                return;
+            }
+
+            for (std::size_t c = 0; c < kChildCount; ++c)
+            {
+                const node_id cid = node.children[c];
+                if (cid == kInvalidNode) continue;
+                forEachPointInBoxesRecursive(cid, level + 1, boxes, active, fn);
+            }
+        }
+
+        // ---------------------- Distance Query Helpers ---------------------- //
+
+        /// A kNN candidate: squared distance to the query and the point in leaf storage.
+        struct Neighbor
+        {
+            Scalar        distance2;
+            const PointT* point;
+        };
+
+        /// Buffers of one best-first search, reused across the queries of a batch.
+        struct KnnScratch
+        {
+            /// Min-heap of (box distance, node) still to expand.
+            std::vector<std::pair<Scalar, node_id>> frontier;
+            /// Max-heap of the best candidates; sorted nearest first once the search ends.
+            std::vector<Neighbor> best;
+        };
+
+        /**
+         * @brief Best-first k-nearest search; leaves the result in @p s.best, nearest first.
+         *
+         * @p s.frontier is a min-heap of nodes keyed by box distance and @p s.best a
+         * bounded max-heap of candidates. Once @p s.best holds @p k points its top is
+         * the pruning radius, for both frontier entries and leaf points.
+         */
+        template <class VecLike>
+        void searchNearest(const VecLike& pos, std::size_t k, Scalar max_distance, KnnScratch& s) const
+        {
+            s.frontier.clear();
+            s.best.clear();
+            if (root_ == kInvalidNode || k == 0) return;
+
+            std::array<Scalar, Dim> q{};
+            for (std::size_t i = 0; i < Dim; ++i) q[i] = Scalar(pos[i]);
+
+            Scalar bound = max_distance == std::numeric_limits<Scalar>::max()
+                ? std::numeric_limits<Scalar>::max()
+                : max_distance * max_distance;
+
+            auto nearer_node = [](const auto& a, const auto& b) { return a.first > b.first; };
+            auto farther = [](const Neighbor& a, const Neighbor& b) { return a.distance2 < b.distance2; };
+
+            s.frontier.emplace_back(nodes_[root_].bounds.distanceSquared(q), root_);
+            while (!s.frontier.empty())
+            {
+                std::pop_heap(s.frontier.begin(), s.frontier.end(), nearer_node);
+                const auto [node_d2, nid] = s.frontier.back();
+                s.frontier.pop_back();
+                if (node_d2 > bound) break;
+
+                const Node& node = nodes_[nid];
+                if (node.is_leaf)
+                {
+                    for (std::size_t i = 0; i < node.points.size(); ++i)
+                    {
+                        if (!node.alive[i]) continue;
+                        const Scalar d2 = detail::orthtreeDistanceSquared<Scalar, Dim>(get_pos_(node.points[i]), q);
+                        if (d2 > bound) continue;
+                        if (s.best.size() < k)
+                        {
+                            s.best.push_back({ d2, &node.points[i] });
+                            std::push_heap(s.best.begin(), s.best.end(), farther);
+                            if (s.best.size() == k) bound = s.best.front().distance2;
+                        }
+                        else if (d2 < s.best.front().distance2)
+                        {
+                            std::pop_heap(s.best.begin(), s.best.end(), farther);
+                            s.best.back() = { d2, &node.points[i] };
+                            std::push_heap(s.best.begin(), s.best.end(), farther);
+                            bound = s.best.front().distance2;
+                        }
+                    }
+                    continue;
+                }
+
+                for (std::size_t c = 0; c < kChildCount; ++c)
+                {
+                    const node_id cid = node.children[c];
+                    if (cid == kInvalidNode) continue;
+                    const Scalar child_d2 = nodes_[cid].bounds.distanceSquared(q);
+                    if (child_d2 > bound) continue;
+                    s.frontier.emplace_back(child_d2, cid);
+                    std::push_heap(s.frontier.begin(), s.frontier.end(), nearer_node);
+                }
+            }
+            std::sort_heap(s.best.begin(), s.best.end(), farther);
+        }
+
+        /// Indices of @p queries sorted by the Morton code of their positions (outside the root last).
+        template <class QueryRange>
+        std::vector<std::uint32_t> mortonOrder(const QueryRange& queries) const
+        {
+            const auto first = std::ranges::begin(queries);
+            const std::size_t n = static_cast<std::size_t>(std::ranges::size(queries));
+            if (n > std::numeric_limits<std::uint32_t>::max())
+                throw std::length_error("Orthtree: more than 2^32 - 1 queries in one batch");
+
+            std::vector<detail::OrthtreeSortKey> keys;
+            detail::orthtreeSortByMorton(first, n, [](const auto& q) -> const auto& { return q; },
+                config_.root_bounds, std::min(config_.max_depth, kMaxCodeLevels), nullptr, keys);
+
+            std::vector<std::uint32_t> order(n);
+            for (std::size_t i = 0; i < n; ++i) order[i] = keys[i].index;
+            return order;
+        }
+
+        /// Invokes @p fn on every alive point below @p nid.
+        template <class Func>
+        void forEachAlivePointRecursive(node_id nid, Func& fn) const
+        {
+            const Node& node = nodes_[nid];
+            if (node.is_leaf)
+            {
+                for (std::size_t i = 0; i < node.points.size(); ++i)
+                    if (node.alive[i]) fn(node.points[i]);
+                return;
+            }
+            for (std::size_t c = 0; c < kChildCount; ++c)
+                if (node.children[c] != kInvalidNode) forEachAlivePointRecursive(node.children[c], fn);
+        }
+
+        /**
+         * @brief Recursive query helper for ball searches.
+         *
+         * Prunes nodes that miss the ball and emits whole subtrees whose bounds lie inside it.
+         */
+        template <class VecLike, class Func>
+        void forEachPointInBallRecursive(node_id nid, const VecLike& center, Scalar radius, Scalar r2, Func& fn) const
+        {
+            const Node& node = nodes_[nid];
+            if (!node.bounds.intersectsBall(center, radius))
+                return;
+            if (node.bounds.maxDistanceSquared(center) <= r2)
+            {
+                forEachAlivePointRecursive(nid, fn);
+                return;
+            }
+
+            if (node.is_leaf)
+            {
+                scanLeaf(node, makeBallTest(center, r2), [&](std::size_t i) { fn(node.points[i]); });
+                return;
+            }
+
+            for (std::size_t c = 0; c < kChildCount; ++c)
+            {
+                const node_id cid = node.children[c];
+                if (cid == kInvalidNode) continue;
+                forEachPointInBallRecursive(cid, center, radius, r2, fn);
+            }
+        }
+
+        /**
+         * @brief Shared-traversal helper for @c forEachPointInBalls.
+         *
+         * @p active[level] holds the balls that reach the parent; the ones that also reach
+         * @p nid are written to @p active[level + 1] for the children to filter further.
+         */
+        template <class Func>
+        void forEachPointInBallsRecursive(node_id nid, std::size_t level,
+            const std::vector<std::array<Scalar, Dim>>& balls, Scalar radius, Scalar r2,
+            std::vector<std::vector<std::uint32_t>>& active, Func& fn) const
+        {
+            const Node& node = nodes_[nid];
+            const auto& reaching_parent = active[level];
+            auto& reaching = active[level + 1];
+            reaching.clear();
+            for (std::uint32_t q : reaching_parent)
+                if (node.bounds.intersectsBall(balls[q], radius)) reaching.push_back(q);
+            if (reaching.empty()) return;
+
             if (node.is_leaf)
             {
-                // Skip per-point contains check when the leaf is fully inside the query region.
-                const bool fully_inside = region.contains(node.bounds.min) && region.contains(node.bounds.max);
                 for (std::size_t i = 0; i < node.points.size(); ++i)
                 {
                     if (!node.alive[i]) continue;
-                    if (fully_inside || region.contains(get_pos_(node.points[i])))
-                        fn(node.points[i]);
+                    const auto& pos = get_pos_(node.points[i]);
+                    for (std::uint32_t q : reaching)
+                        if (detail::orthtreeWithinDistance<Scalar, Dim>(pos, balls[q], r2)) fn(std::size_t(q), node.points[i]);
                 }
                 return;
             }
 
-            for (std::size_t i = 0; i < kChildCount; ++i)
+            for (std::size_t c = 0; c < kChildCount; ++c)
             {
-                node_id cid = node.children[i];
+                const node_id cid = node.children[c];
                 if (cid == kInvalidNode) continue;
-                forEachPointInBoxRecursive(cid, region, fn);
+                forEachPointInBallsRecursive(cid, level + 1, balls, radius, r2, active, fn);
             }
         }
 
@@ -1057,13 +3360,16 @@ namespace lux::cxx
          * @tparam Predicate Callable: bool(const PointT&) — returns true for points to delete.
          * @tparam Prune     Callable: bool(const box_type&) — returns true when a node should
          *                   be visited (bounding-box early-out).
-         * @param nid   Root of the subtree to process.
-         * @param pred  Deletion predicate.
-         * @param prune Pruning functor.
+         * @param nid     Root of the subtree to process.
+         * @param pred    Deletion predicate.
+         * @param prune   Pruning functor.
+         * @param touched If given, changed leaves are appended here instead of being
+         *                version-stamped (for callers running subtrees in parallel).
          * @return The number of points that were soft-deleted.
          */
         template <class Predicate, class Prune>
-        std::size_t markDeletedRecursive(node_id nid, Predicate& pred, const Prune& prune)
+        std::size_t markDeletedRecursive(node_id nid, Predicate& pred, const Prune& prune,
+            std::vector<node_id>* touched = nullptr)
         {
             Node& node = nodes_[nid];
 
@@ -1074,16 +3380,18 @@ namespace lux::cxx
 
             if (node.is_leaf)
             {
-                for (std::size_t i = 0; i < node.points.size(); ++i)
+                auto mark = [&](std::size_t i) { node.alive[i] = 0; ++removed; };
+                if constexpr (requires { pred.block(static_cast<const Scalar*>(nullptr)); })
+                    scanLeaf(node, pred, mark);
+                else
+                    for (std::size_t i = 0; i < node.points.size(); ++i)
+                        if (node.alive[i] && pred(node.points[i])) mark(i);
+                if (removed > 0)
                 {
-                    if (!node.alive[i]) continue;
-                    if (pred(node.points[i]))
-                    {
-                        node.alive[i] = 0;
-                        node.need_compact = true;
-                        node.dirty = true;
-                        ++removed;
-                    }
+                    node.need_compact = true;
+                    node.dirty = true;
+                    if (touched) touched->push_back(nid);
+                    else noteDeletion(nid);
                 }
                 return removed;
             }
@@ -1092,7 +3400,7 @@ namespace lux::cxx
             {
                 node_id cid = node.children[i];
                 if (cid == kInvalidNode) continue;
-                removed += markDeletedRecursive(cid, pred, prune);
+                removed += markDeletedRecursive(cid, pred, prune, touched);
             }
             return removed;
         }
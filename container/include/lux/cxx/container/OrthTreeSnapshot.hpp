@@ -0,0 +1,571 @@
+#pragma once
+/**
+ * @file OrthTreeSnapshot.hpp
+ * @brief On-disk format for Orthtree / PackedOrthtree and a read-only view that answers
+ *        box, ball and nearest-neighbour queries straight from a memory-mapped file.
+ *
+ * @copyright
+ * Copyright (c) 2025 Chenhui Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <lux/cxx/container/PackedOrthTree.hpp>
+#include <lux/cxx/container/Snapshot.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lux::cxx
+{
+    /*
+     * File layout: the Snapshot.hpp frame (SnapshotHeader of kind Orthtree, then three
+     * 64-byte aligned sections) holding a PackedOrthtree without its dead points.
+     *
+     *   header                 key_size = Dim, aux_size = sizeof(Scalar), value_size and
+     *                          value_align of the record type, size = point count,
+     *                          aux = bits per coordinate in section 1
+     *   section 0              nodes in breadth-first order (OrthtreeSnapshotNode)
+     *   section 1              one position per point, in point order: Dim Scalars, or
+     *                          Dim uint16 relative to the bounds of the point's leaf, or
+     *                          nothing (aux = 0) when the records are the points and
+     *                          carry their own positions
+     *   section 2              one record per point (the points themselves, or what the
+     *                          writer projected them to)
+     *
+     * Points are sorted by leaf, so every node covers one contiguous run of sections 1
+     * and 2. The format version is the frame's @c kSnapshotVersion.
+     */
+    namespace detail
+    {
+        inline constexpr std::uint32_t kOrthtreeQuantizedBits = 16;
+        inline constexpr std::uint32_t kOrthtreeQuantizedMax  = (1u << kOrthtreeQuantizedBits) - 1;
+
+        /**
+         * @brief On-disk node (mirrors PackedOrthtree::PackedNode, bounds as two arrays).
+         */
+        template <typename Scalar, std::size_t Dim>
+        struct OrthtreeSnapshotNode
+        {
+            std::array<Scalar, Dim> min{};
+            std::array<Scalar, Dim> max{};
+            std::uint32_t first_child = 0;
+            std::uint32_t child_count = 0; ///< 0 for a leaf.
+            std::uint32_t begin       = 0; ///< First point of the subtree.
+            std::uint32_t end         = 0; ///< One past the last point of the subtree.
+        };
+
+        template <typename Record, std::size_t Dim, typename Scalar>
+        SnapshotHeader orthtree_snapshot_header()
+        {
+            SnapshotHeader h;
+            h.kind        = static_cast<std::uint32_t>(SnapshotKind::Orthtree);
+            h.value_size  = sizeof(Record);
+            h.value_align = alignof(Record);
+            h.key_size    = static_cast<std::uint32_t>(Dim);
+            h.aux_size    = sizeof(Scalar);
+            return h;
+        }
+
+        /// Coordinate @p v of a point in [@p lo, @p hi] as a fraction of the range in 16 bits.
+        template <typename Scalar>
+        std::uint16_t orthtree_quantize(Scalar v, Scalar lo, Scalar hi) noexcept
+        {
+            if (!(hi > lo)) return 0;
+            const double t = (double(v) - double(lo)) / (double(hi) - double(lo)) * kOrthtreeQuantizedMax;
+            return static_cast<std::uint16_t>(std::clamp(std::lround(t), 0l, long(kOrthtreeQuantizedMax)));
+        }
+
+        /**
+         * @brief Writes a PackedOrthtree in the format above, skipping dead points.
+         *
+         * Positions and records are streamed a chunk at a time, so the only copies held
+         * in memory are the node array and one rank per 64 points.
+         */
+        template <typename Tree, typename Project>
+        void save_orthtree_snapshot(std::ostream& os, const Tree& tree, const Project& project, bool quantize)
+        {
+            // Unprojected, unquantized records already hold the positions.
+            const bool separate_positions = quantize || !std::is_same_v<Project, std::identity>;
+            using PointT = typename Tree::point_type;
+            using Scalar = typename Tree::scalar_type;
+            constexpr std::size_t Dim = Tree::box_type::dim;
+            using Record = std::remove_cvref_t<std::invoke_result_t<const Project&, const PointT&>>;
+            using Node   = OrthtreeSnapshotNode<Scalar, Dim>;
+            static_assert(std::is_trivially_copyable_v<Record>, "save_snapshot: Orthtree records must be trivially copyable");
+            static_assert(alignof(Record) <= kSnapshotAlign, "save_snapshot: record alignment exceeds section alignment");
+
+            const auto points = tree.points();
+            const auto nodes  = tree.nodes();
+
+            // rank[w] = alive points before bitset word w; maps old point indices to written ones.
+            const std::size_t words = (points.size() + 63) / 64;
+            std::vector<std::uint32_t> rank(words + 1, 0);
+            for (std::size_t w = 0; w < words; ++w)
+            {
+                rank[w + 1] = rank[w];
+                for (std::size_t i = w * 64; i < std::min(points.size(), w * 64 + 64); ++i)
+                    rank[w + 1] += tree.isAlive(i) ? 1u : 0u;
+            }
+            auto new_index = [&](std::uint32_t i) {
+                std::uint32_t r = rank[i >> 6];
+                for (std::uint32_t j = i & ~63u; j < i; ++j) r += tree.isAlive(j) ? 1u : 0u;
+                return r;
+            };
+            const std::uint64_t count = rank[words];
+
+            std::vector<Node> disk_nodes(nodes.size());
+            std::vector<std::uint32_t> leaves;
+            for (std::size_t id = 0; id < nodes.size(); ++id)
+            {
+                const auto& n = nodes[id];
+                disk_nodes[id] = { n.bounds.min, n.bounds.max, n.first_child, n.child_count, new_index(n.begin), new_index(n.end) };
+                if (n.isLeaf() && n.begin != n.end) leaves.push_back(static_cast<std::uint32_t>(id));
+            }
+            // Leaves in point order, so positions can be encoded against their leaf in one sweep.
+            std::sort(leaves.begin(), leaves.end(), [&](std::uint32_t a, std::uint32_t b) { return nodes[a].begin < nodes[b].begin; });
+
+            auto header = orthtree_snapshot_header<Record, Dim, Scalar>();
+            header.size = count;
+            header.aux  = !separate_positions ? 0 : quantize ? kOrthtreeQuantizedBits : 8 * sizeof(Scalar);
+            const std::uint64_t position_bytes = !separate_positions ? 0
+                : quantize ? sizeof(std::array<std::uint16_t, Dim>) : sizeof(std::array<Scalar, Dim>);
+
+            constexpr std::size_t kChunk = 4096;
+            auto stream = [&](auto&& make) {
+                using T = std::remove_cvref_t<decltype(make(nodes[0], points[0]))>;
+                std::vector<T> buffer;
+                buffer.reserve(kChunk);
+                auto flush = [&] {
+                    os.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+                    buffer.clear();
+                };
+                for (std::uint32_t leaf : leaves)
+                    for (std::uint32_t i = nodes[leaf].begin; i < nodes[leaf].end; ++i)
+                    {
+                        if (!tree.isAlive(i)) continue;
+                        buffer.push_back(make(nodes[leaf], points[i]));
+                        if (buffer.size() == kChunk) flush();
+                    }
+                flush();
+            };
+
+            const auto& get_pos = tree.positionAccessor();
+            write_snapshot_sections(os, header, { disk_nodes.size() * sizeof(Node), count * position_bytes, count * sizeof(Record) },
+                [&](std::size_t section) {
+                    if (section == 0)
+                        os.write(reinterpret_cast<const char*>(disk_nodes.data()), static_cast<std::streamsize>(disk_nodes.size() * sizeof(Node)));
+                    else if (section == 2)
+                        stream([&](const auto&, const PointT& p) -> Record { return std::invoke(project, p); });
+                    else if (!separate_positions)
+                        return;
+                    else if (quantize)
+                        stream([&](const auto& leaf, const PointT& p) {
+                            const auto& pos = get_pos(p);
+                            std::array<std::uint16_t, Dim> q;
+                            for (std::size_t a = 0; a < Dim; ++a)
+                                q[a] = orthtree_quantize<Scalar>(Scalar(pos[a]), leaf.bounds.min[a], leaf.bounds.max[a]);
+                            return q;
+                        });
+                    else
+                        stream([&](const auto&, const PointT& p) {
+                            const auto& pos = get_pos(p);
+                            std::array<Scalar, Dim> v;
+                            for (std::size_t a = 0; a < Dim; ++a) v[a] = Scalar(pos[a]);
+                            return v;
+                        });
+                });
+        }
+    } // namespace detail
+
+    /**
+     * @brief Options for @c save_snapshot of an Orthtree or PackedOrthtree.
+     */
+    struct OrthtreeSnapshotOptions
+    {
+        /// Stores each coordinate in 16 bits relative to the bounds of its leaf instead of as
+        /// a Scalar. Views then test and return the decoded positions, which are off by at
+        /// most half a step (leaf extent / 65535 / 2) per axis.
+        bool quantize_positions = false;
+    };
+
+    /**
+     * @class OrthtreeView
+     * @brief Read-only Orthtree served directly from snapshot bytes (e.g. a MappedFile).
+     *
+     * Construction validates the header and section bounds and nothing else, so opening
+     * costs the same for any tree size; nodes are checked as queries reach them. Queries
+     * work like @c PackedOrthtree's and hand out records. Positions come from the position
+     * section or, for a file of unprojected, unquantized points, from the records through
+     * @p GetPosition. The bytes must outlive the view.
+     *
+     * @tparam Record      Type of the stored records: the point type, or what
+     *                     @c save_snapshot projected the points to.
+     * @tparam Dim         Number of spatial dimensions.
+     * @tparam Scalar      Scalar type of the tree that was saved.
+     * @tparam GetPosition Position accessor for records that are points; unused otherwise.
+     */
+    template <typename Record, std::size_t Dim, typename Scalar = float, typename GetPosition = DefaultGetPosition<Record>>
+    class OrthtreeView
+    {
+        static_assert(std::is_trivially_copyable_v<Record>, "OrthtreeView: Record must be trivially copyable");
+        static_assert(alignof(Record) <= detail::kSnapshotAlign, "OrthtreeView: Record alignment exceeds section alignment");
+
+        using node_t      = detail::OrthtreeSnapshotNode<Scalar, Dim>;
+        using quantized_t = std::array<std::uint16_t, Dim>;
+
+        static constexpr std::size_t kChildCount = std::size_t(1) << Dim;
+        static constexpr std::size_t kStackSize  = detail::OrthtreeMortonEncoder<Scalar, Dim>::kMaxLevels * (kChildCount - 1) + 1;
+        static constexpr bool kRecordPositions   = std::is_invocable_v<const GetPosition&, const Record&>;
+
+    public:
+        using record_type   = Record;
+        using box_type      = Box<Scalar, Dim>;
+        using position_type = std::array<Scalar, Dim>;
+
+        OrthtreeView() = default;
+
+        /**
+         * @throws std::runtime_error if @p bytes do not hold a matching Orthtree snapshot.
+         */
+        explicit OrthtreeView(std::span<const std::byte> bytes, const GetPosition& get_pos = GetPosition{})
+            : get_pos_(get_pos)
+        {
+            const auto header = detail::parse_snapshot_header(bytes, detail::orthtree_snapshot_header<Record, Dim, Scalar>());
+            nodes_   = detail::snapshot_section<node_t>(bytes, header, 0);
+            records_ = detail::snapshot_section<Record>(bytes, header, 2);
+            if (header.aux == 8 * sizeof(Scalar))
+                positions_ = detail::snapshot_section<position_type>(bytes, header, 1);
+            else if (header.aux == detail::kOrthtreeQuantizedBits)
+                quantized_ = detail::snapshot_section<quantized_t>(bytes, header, 1);
+            else if (header.aux != 0 || !kRecordPositions)
+                throw std::runtime_error("snapshot: unsupported Orthtree position encoding");
+            if (nodes_.empty() || records_.size() != header.size
+                || (header.aux != 0 && positions_.size() + quantized_.size() != header.size)
+                || nodes_[0].begin != 0 || nodes_[0].end != header.size)
+                throw std::runtime_error("snapshot: inconsistent Orthtree sections");
+        }
+
+        [[nodiscard]] std::size_t size()      const noexcept { return records_.size(); }
+        [[nodiscard]] bool        empty()     const noexcept { return records_.empty(); }
+        [[nodiscard]] bool        quantized() const noexcept { return !quantized_.empty(); }
+        /// Returns the number of nodes (including internal nodes).
+        [[nodiscard]] std::uint32_t nodeCount() const noexcept { return static_cast<std::uint32_t>(nodes_.size()); }
+        /// Returns the root bounds of the saved tree.
+        [[nodiscard]] box_type bounds() const noexcept { return nodes_.empty() ? box_type{} : box_type(nodes_[0].min, nodes_[0].max); }
+        /// Returns the records in storage (leaf, Morton) order.
+        [[nodiscard]] std::span<const Record> records() const noexcept { return records_; }
+
+        /**
+         * @brief Visits every point inside @p region in storage order.
+         *
+         * @p fn is called as fn(record), or as fn(record, position) if it accepts the
+         * (decoded) position too. Subtrees entirely inside @p region are emitted without
+         * per-point tests.
+         *
+         * @throws std::runtime_error if a node the query reaches is corrupt.
+         */
+        template <typename Func>
+        void forEachPointInBox(const box_type& region, Func&& fn) const
+        {
+            visit(
+                [&](const box_type& b) { return b.intersects(region); },
+                [&](const box_type& b) { return region.contains(b.min) && region.contains(b.max); },
+                [&](const auto& p) { return region.contains(p); },
+                fn);
+        }
+
+        /**
+         * @brief Visits every point within @p radius of @p center, as @c forEachPointInBox.
+         */
+        template <typename VecLike, typename Func>
+        void forEachPointInBall(const VecLike& center, Scalar radius, Func&& fn) const
+        {
+            const Scalar r2 = radius * radius;
+            visit(
+                [&](const box_type& b) { return b.intersectsBall(center, radius); },
+                [&](const box_type& b) { return b.maxDistanceSquared(center) <= r2; },
+                [&](const auto& p) { return detail::orthtreeWithinDistance<Scalar, Dim>(p, center, r2); },
+                fn);
+        }
+
+        /**
+         * @brief Returns the record of the point closest to @p pos, or nullptr if there is
+         *        none within @p max_distance. The pointer refers into the snapshot bytes.
+         */
+        template <typename VecLike>
+        const Record* nearest(const VecLike& pos, Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+        {
+            KnnScratch scratch;
+            searchNearest(pos, 1, max_distance, scratch);
+            return scratch.best.empty() ? nullptr : &records_[scratch.best.front().index];
+        }
+
+        /**
+         * @brief Writes the records of the @p k points closest to @p pos to @p out, nearest first.
+         * @return The number of records written.
+         */
+        template <typename VecLike, typename OutputIt>
+        std::size_t kNearest(const VecLike& pos, std::size_t k, OutputIt out,
+            Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+        {
+            KnnScratch scratch;
+            searchNearest(pos, k, max_distance, scratch);
+            for (const Neighbor& nb : scratch.best) *out++ = records_[nb.index];
+            return scratch.best.size();
+        }
+
+    private:
+        static box_type boundsOf(const node_t& n) noexcept { return box_type(n.min, n.max); }
+
+        /// Throws unless @p n (node @p id) has children after it and a point range inside the section.
+        void checkNode(const node_t& n, std::size_t id) const
+        {
+            if (n.begin > n.end || n.end > records_.size() || n.child_count > kChildCount
+                || (n.child_count != 0 && (n.first_child <= id
+                    || std::uint64_t(n.first_child) + n.child_count > nodes_.size())))
+                throw std::runtime_error("OrthtreeView: corrupt node");
+        }
+
+        /// Calls @p emit(i, position) for every point of leaf @p n that passes @p accept.
+        template <typename Accept, typename Emit>
+        void scanLeaf(const node_t& n, const Accept& accept, const Emit& emit) const
+        {
+            if (!positions_.empty())
+            {
+                for (std::uint32_t i = n.begin; i < n.end; ++i)
+                    if (accept(positions_[i])) emit(i, positions_[i]);
+                return;
+            }
+            if (quantized_.empty())
+            {
+                if constexpr (kRecordPositions)
+                    for (std::uint32_t i = n.begin; i < n.end; ++i)
+                    {
+                        const auto& p = get_pos_(records_[i]);
+                        if (accept(p)) emit(i, p);
+                    }
+                return;
+            }
+            position_type step;
+            for (std::size_t a = 0; a < Dim; ++a)
+                step[a] = (n.max[a] - n.min[a]) / Scalar(detail::kOrthtreeQuantizedMax);
+            for (std::uint32_t i = n.begin; i < n.end; ++i)
+            {
+                position_type p;
+                for (std::size_t a = 0; a < Dim; ++a) p[a] = n.min[a] + Scalar(quantized_[i][a]) * step[a];
+                if (accept(p)) emit(i, p);
+            }
+        }
+
+        /**
+         * @brief Shared iterative traversal for region queries.
+         *
+         * Nodes for which @p overlaps holds are descended into; below a node for which
+         * @p inside holds, leaves are emitted whole. Children are pushed in reverse so
+         * points come out in storage order.
+         */
+        template <typename Overlaps, typename Inside, typename Accept, typename Func>
+        void visit(const Overlaps& overlaps, const Inside& inside, const Accept& accept, Func& fn) const
+        {
+            if (records_.empty() || !overlaps(boundsOf(nodes_[0]))) return;
+
+            auto emit = [&](std::uint32_t i, const auto& p) {
+                if constexpr (std::is_invocable_v<Func&, const Record&, const position_type&>) fn(records_[i], p);
+                else fn(records_[i]);
+            };
+            auto all = [](const auto&) { return true; };
+
+            std::array<std::pair<std::uint32_t, bool>, kStackSize> stack;
+            std::size_t top = 0;
+            stack[top++] = { 0, false };
+            while (top > 0)
+            {
+                const auto [id, covered_parent] = stack[--top];
+                const node_t& node = nodes_[id];
+                checkNode(node, id);
+                const bool covered = covered_parent || inside(boundsOf(node));
+                if (node.child_count == 0)
+                {
+                    if (covered) scanLeaf(node, all, emit);
+                    else scanLeaf(node, accept, emit);
+                    continue;
+                }
+                if (top + node.child_count > kStackSize)
+                    throw std::runtime_error("OrthtreeView: corrupt node");
+                for (std::uint32_t c = node.child_count; c-- > 0;)
+                {
+                    const std::uint32_t cid = node.first_child + c;
+                    if (nodes_[cid].begin != nodes_[cid].end && (covered || overlaps(boundsOf(nodes_[cid]))))
+                        stack[top++] = { cid, covered };
+                }
+            }
+        }
+
+        /// A kNN candidate: squared distance to the query and the index of the point.
+        struct Neighbor
+        {
+            Scalar      distance2;
+            std::size_t index;
+        };
+
+        struct KnnScratch
+        {
+            std::vector<std::pair<Scalar, std::uint32_t>> frontier;
+            std::vector<Neighbor> best;
+        };
+
+        /// Best-first k-nearest search, as in @c PackedOrthtree; leaves the result in @p s.best, nearest first.
+        template <typename VecLike>
+        void searchNearest(const VecLike& pos, std::size_t k, Scalar max_distance, KnnScratch& s) const
+        {
+            s.frontier.clear();
+            s.best.clear();
+            if (records_.empty() || k == 0) return;
+
+            position_type q{};
+            for (std::size_t i = 0; i < Dim; ++i) q[i] = Scalar(pos[i]);
+
+            Scalar bound = max_distance == std::numeric_limits<Scalar>::max()
+                ? std::numeric_limits<Scalar>::max()
+                : max_distance * max_distance;
+
+            auto nearer_node = [](const auto& a, const auto& b) { return a.first > b.first; };
+            auto farther = [](const Neighbor& a, const Neighbor& b) { return a.distance2 < b.distance2; };
+            auto all = [](const auto&) { return true; };
+
+            s.frontier.emplace_back(boundsOf(nodes_[0]).distanceSquared(q), 0u);
+            while (!s.frontier.empty())
+            {
+                std::pop_heap(s.frontier.begin(), s.frontier.end(), nearer_node);
+                const auto [node_d2, id] = s.frontier.back();
+                s.frontier.pop_back();
+                if (node_d2 > bound) break;
+
+                const node_t& node = nodes_[id];
+                checkNode(node, id);
+                if (node.child_count == 0)
+                {
+                    scanLeaf(node, all, [&](std::uint32_t i, const auto& p) {
+                        const Scalar d2 = detail::orthtreeDistanceSquared<Scalar, Dim>(p, q);
+                        if (d2 > bound) return;
+                        if (s.best.size() < k)
+                        {
+                            s.best.push_back({ d2, i });
+                            std::push_heap(s.best.begin(), s.best.end(), farther);
+                            if (s.best.size() == k) bound = s.best.front().distance2;
+                        }
+                        else if (d2 < s.best.front().distance2)
+                        {
+                            std::pop_heap(s.best.begin(), s.best.end(), farther);
+                            s.best.back() = { d2, i };
+                            std::push_heap(s.best.begin(), s.best.end(), farther);
+                            bound = s.best.front().distance2;
+                        }
+                    });
+                    continue;
+                }
+
+                for (std::uint32_t c = 0; c < node.child_count; ++c)
+                {
+                    const std::uint32_t cid = node.first_child + c;
+                    if (nodes_[cid].begin == nodes_[cid].end) continue;
+                    const Scalar child_d2 = boundsOf(nodes_[cid]).distanceSquared(q);
+                    if (child_d2 > bound) continue;
+                    s.frontier.emplace_back(child_d2, cid);
+                    std::push_heap(s.frontier.begin(), s.frontier.end(), nearer_node);
+                }
+            }
+            std::sort_heap(s.best.begin(), s.best.end(), farther);
+        }
+
+        GetPosition                    get_pos_{};
+        std::span<const node_t>        nodes_;
+        std::span<const position_type> positions_;
+        std::span<const quantized_t>   quantized_;
+        std::span<const Record>        records_;
+    };
+
+    // ---- save -----------------------------------------------------------------
+
+    /**
+     * @brief Writes the alive points of @p tree to @p os in the format @c OrthtreeView reads.
+     *
+     * @p project maps each point to the record stored for it (for example its id, when
+     * the positions alone are worth keeping at full size); the view is then opened as
+     * @c OrthtreeView<Record, Dim, Scalar>.
+     *
+     * @throws std::runtime_error if writing fails.
+     */
+    template <class PointT, std::size_t Dim, class Scalar, class GetPosition, class Alloc, class Project>
+        requires std::invocable<const Project&, const PointT&>
+    void save_snapshot(std::ostream& os, const PackedOrthtree<PointT, Dim, Scalar, GetPosition, Alloc>& tree,
+                       const Project& project, const OrthtreeSnapshotOptions& options = {})
+    {
+        detail::save_orthtree_snapshot(os, tree, project, options.quantize_positions);
+    }
+
+    /**
+     * @brief Writes the alive points of @p tree to @p os; records are the points themselves.
+     */
+    template <class PointT, std::size_t Dim, class Scalar, class GetPosition, class Alloc>
+    void save_snapshot(std::ostream& os, const PackedOrthtree<PointT, Dim, Scalar, GetPosition, Alloc>& tree,
+                       const OrthtreeSnapshotOptions& options = {})
+    {
+        detail::save_orthtree_snapshot(os, tree, std::identity{}, options.quantize_positions);
+    }
+
+    /**
+     * @brief Packs @p tree (see the @c PackedOrthtree converting constructor) and writes it
+     *        with @p project, as for a PackedOrthtree.
+     */
+    template <class PointT, std::size_t Dim, class Scalar, class GetPosition, class Alloc, class Project>
+        requires std::invocable<const Project&, const PointT&>
+    void save_snapshot(std::ostream& os, const Orthtree<PointT, Dim, Scalar, GetPosition, Alloc>& tree,
+                       const Project& project, const OrthtreeSnapshotOptions& options = {})
+    {
+        detail::save_orthtree_snapshot(os, PackedOrthtree<PointT, Dim, Scalar, GetPosition>(tree), project,
+            options.quantize_positions);
+    }
+
+    /**
+     * @brief Packs @p tree and writes it; records are the points themselves.
+     *
+     * Positions are read through @p tree's own accessor, so stateful accessors are honoured.
+     */
+    template <class PointT, std::size_t Dim, class Scalar, class GetPosition, class Alloc>
+    void save_snapshot(std::ostream& os, const Orthtree<PointT, Dim, Scalar, GetPosition, Alloc>& tree,
+                       const OrthtreeSnapshotOptions& options = {})
+    {
+        detail::save_orthtree_snapshot(os, PackedOrthtree<PointT, Dim, Scalar, GetPosition>(tree), std::identity{},
+            options.quantize_positions);
+    }
+
+} // namespace lux::cxx
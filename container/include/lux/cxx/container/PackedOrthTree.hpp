@@ -0,0 +1,786 @@
+#pragma once
+/*
+ * Copyright (c) 2025 Chenhui Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+
+#include <lux/cxx/container/OrthTree.hpp>
+
+namespace lux::cxx
+{
+    /**
+     * @brief Orthtree with a pointer-free node layout, built in one pass from a point set.
+     *
+     * All points live in a single array sorted by leaf, in Morton order. Nodes live in a
+     * second array in breadth-first order: the children of a node are adjacent, and each
+     * node records the range of the point array its subtree covers. Deletion clears a bit
+     * in an alive bitset. A traversal therefore touches two flat arrays and never follows
+     * a per-leaf allocation, and a node that lies entirely inside a query is emitted by
+     * streaming its point range.
+     *
+     * The structure is rebuilt rather than updated: points cannot be inserted, only
+     * soft-deleted, and @c compact() drops the dead ones in place. Use @c Orthtree for
+     * data that changes point by point and convert it when it settles.
+     *
+     * As with @c Orthtree, const members only read, so a tree that is not being
+     * soft-deleted from or compacted can be queried from any number of threads.
+     *
+     * @tparam PointT        Type of the spatial points stored in the tree.
+     * @tparam Dim           Number of spatial dimensions (must be >= 1).
+     * @tparam Scalar        Scalar type used for bounding-box coordinates.
+     * @tparam GetPosition   Functor that extracts a position from a PointT value.
+     * @tparam BaseAllocator Standard allocator used for all internal storage.
+     */
+    template <
+        class PointT,
+        std::size_t Dim,
+        class Scalar = float,
+        class GetPosition = DefaultGetPosition<PointT>,
+        class BaseAllocator = std::allocator<std::byte>>
+    class PackedOrthtree
+    {
+        static_assert(Dim >= 1, "Dim must be >= 1");
+
+    public:
+        using point_type = PointT;
+        using scalar_type = Scalar;
+        using box_type = Box<Scalar, Dim>;
+        using node_id = std::uint32_t;
+        using Config = typename Orthtree<PointT, Dim, Scalar, GetPosition, BaseAllocator>::Config;
+
+        static constexpr std::size_t kChildCount = (std::size_t(1) << Dim);
+
+        /**
+         * @brief A node of the breadth-first node array.
+         *
+         * Points [@c begin, @c end) of the point array belong to this node's subtree.
+         * A node without children is a leaf.
+         */
+        struct PackedNode
+        {
+            /// Axis-aligned bounding box of this node.
+            box_type      bounds{};
+            /// Index of the first child; the children occupy [first_child, first_child + child_count).
+            node_id       first_child = 0;
+            /// Number of non-empty children (0 for a leaf).
+            std::uint32_t child_count = 0;
+            /// First point of the subtree.
+            std::uint32_t begin = 0;
+            /// One past the last point of the subtree.
+            std::uint32_t end = 0;
+
+            /// Returns true if this node has no children.
+            [[nodiscard]] bool isLeaf() const noexcept { return child_count == 0; }
+        };
+
+    private:
+        using base_alloc_traits = std::allocator_traits<BaseAllocator>;
+
+        template <class T>
+        using rebind_alloc_t = typename base_alloc_traits::template rebind_alloc<T>;
+
+        using node_allocator = rebind_alloc_t<PackedNode>;
+        using point_allocator = rebind_alloc_t<PointT>;
+        using word_allocator = rebind_alloc_t<std::uint64_t>;
+
+        using Encoder = detail::OrthtreeMortonEncoder<Scalar, Dim>;
+
+        /// Depth-first traversal stack bound: every level leaves at most kChildCount - 1 siblings pending.
+        static constexpr std::size_t kStackSize = Encoder::kMaxLevels * (kChildCount - 1) + 1;
+
+    public:
+        /**
+         * @brief Constructs an empty tree with the given configuration.
+         *
+         * If @p cfg.root_bounds is invalid, the root bounds default to the Dim-dimensional
+         * unit hypercube [-1, 1]^Dim.
+         *
+         * @param cfg     Tree configuration (bounds, depth limit, leaf capacity).
+         * @param get_pos Position accessor functor.
+         * @param alloc   Base allocator for all internal storage.
+         */
+        explicit PackedOrthtree(const Config& cfg,
+            const GetPosition& get_pos = GetPosition{},
+            const BaseAllocator& alloc = BaseAllocator{})
+            : config_(cfg),
+            get_pos_(get_pos),
+            nodes_(node_allocator(alloc)),
+            points_(point_allocator(alloc)),
+            alive_(word_allocator(alloc))
+        {
+            if (!config_.root_bounds.isValid())
+            {
+                std::array<Scalar, Dim> mn{};
+                std::array<Scalar, Dim> mx{};
+                for (std::size_t i = 0; i < Dim; ++i) { mn[i] = Scalar(-1); mx[i] = Scalar(1); }
+                config_.root_bounds = box_type(mn, mx);
+            }
+            resetRoot();
+        }
+
+        /**
+         * @brief Constructs a tree and bulk-loads @p pts into it (see @c bulkLoad).
+         *
+         * @tparam Range Any range whose elements convert to @c const PointT&.
+         * @param cfg     Tree configuration (bounds, depth limit, leaf capacity).
+         * @param pts     The points to load.
+         * @param get_pos Position accessor functor.
+         * @param alloc   Base allocator for all internal storage.
+         */
+        template <class Range>
+            requires std::ranges::input_range<const Range>
+                && std::convertible_to<std::ranges::range_reference_t<const Range>, const PointT&>
+        PackedOrthtree(const Config& cfg, const Range& pts,
+            const GetPosition& get_pos = GetPosition{},
+            const BaseAllocator& alloc = BaseAllocator{})
+            : PackedOrthtree(cfg, get_pos, alloc)
+        {
+            bulkLoad(pts);
+        }
+
+        /**
+         * @brief Packs the alive points of @p tree, using its configuration and position accessor.
+         *
+         * The node hierarchy is rebuilt from the points, so it is the canonical shape for
+         * this point set rather than a copy of @p tree's history-dependent one.
+         *
+         * @param tree  The tree to convert; it may use a different allocator.
+         * @param alloc Base allocator for all internal storage.
+         */
+        template <class OtherAllocator>
+        explicit PackedOrthtree(const Orthtree<PointT, Dim, Scalar, GetPosition, OtherAllocator>& tree,
+            const BaseAllocator& alloc = BaseAllocator{})
+            : PackedOrthtree(convertConfig(tree.config()), tree.positionAccessor(), alloc)
+        {
+            std::vector<PointT> alive;
+            alive.reserve(static_cast<std::size_t>(tree.totalAlivePoints()));
+            tree.forEachPointInBox(tree.config().root_bounds, [&](const PointT& p) { alive.push_back(p); });
+            bulkLoad(alive);
+        }
+
+        // ---------------------- Accessors ---------------------- //
+
+        /// Returns the current configuration.
+        [[nodiscard]] const Config& config() const noexcept { return config_; }
+        /// Returns the position accessor functor.
+        [[nodiscard]] const GetPosition& positionAccessor() const noexcept { return get_pos_; }
+        /// Returns the monotonically increasing version counter (incremented on every mutation).
+        [[nodiscard]] std::uint64_t version() const noexcept { return version_; }
+        /// Returns the number of nodes (including internal nodes).
+        [[nodiscard]] std::uint32_t nodeCount() const noexcept { return static_cast<std::uint32_t>(nodes_.size()); }
+        /// Returns the number of stored points, including soft-deleted ones.
+        [[nodiscard]] std::size_t size() const noexcept { return points_.size(); }
+
+        /// Returns the node array in breadth-first order; the root is element 0.
+        [[nodiscard]] std::span<const PackedNode> nodes() const noexcept { return { nodes_.data(), nodes_.size() }; }
+        /// Returns the point array, sorted by leaf.
+        [[nodiscard]] std::span<const PointT> points() const noexcept { return { points_.data(), points_.size() }; }
+
+        /// Returns true if the point at @p index (an index into @c points()) is alive.
+        [[nodiscard]] bool isAlive(std::size_t index) const noexcept
+        {
+            return (alive_[index >> 6] >> (index & 63)) & 1u;
+        }
+
+        /// Returns the number of leaves.
+        [[nodiscard]] std::uint32_t leafCount() const noexcept
+        {
+            std::uint32_t c = 0;
+            for (const PackedNode& n : nodes_) if (n.isLeaf()) ++c;
+            return c;
+        }
+
+        /// Returns the number of alive points.
+        [[nodiscard]] std::uint64_t totalAlivePoints() const noexcept
+        {
+            std::uint64_t total = 0;
+            for (std::uint64_t w : alive_) total += static_cast<std::uint64_t>(std::popcount(w));
+            return total;
+        }
+
+        // ---------------------- Loading ---------------------- //
+
+        /**
+         * @brief Replaces the contents of the tree with @p pts.
+         *
+         * Points are sorted by the Morton code of their cell at the deepest level the
+         * configuration allows (capped at @c 63 / Dim levels), and the node array is
+         * built breadth-first from the sorted codes. A leaf holds at most
+         * @c max_points_per_leaf points unless it is at @c max_depth or at the code
+         * resolution, where coincident or very close points stay together. Points
+         * outside the root bounds are skipped. Increments the version counter.
+         *
+         * @tparam Range Any range whose elements convert to @c const PointT&.
+         * @param pts The points to load.
+         * @return The number of points loaded.
+         * @throws std::length_error if @p pts holds more than 2^32 - 1 points.
+         */
+        template <class Range>
+        std::size_t bulkLoad(const Range& pts)
+        {
+            return bulkLoadImpl(pts, nullptr);
+        }
+
+        /**
+         * @brief Same as @c bulkLoad(pts), with code computation and sorting split across @p pool.
+         */
+        template <class Range>
+        std::size_t bulkLoad(const Range& pts, ThreadPool& pool)
+        {
+            return bulkLoadImpl(pts, &pool);
+        }
+
+        // ---------------------- Deletion ---------------------- //
+
+        /**
+         * @brief Soft-deletes all alive points whose positions fall within @p region.
+         *
+         * @param region The axis-aligned box defining the deletion region.
+         * @return The number of points that were marked as deleted.
+         */
+        std::size_t markDeletedInBox(const box_type& region)
+        {
+            std::size_t removed = 0;
+            visitIndices(
+                [&](const PackedNode& n) { return n.bounds.intersects(region); },
+                [&](const PackedNode& n) { return containsBox(region, n.bounds); },
+                [&](std::size_t i) { return region.contains(get_pos_(points_[i])); },
+                [&](std::size_t i) { clearAlive(i); ++removed; });
+            if (removed > 0) ++version_;
+            return removed;
+        }
+
+        /**
+         * @brief Soft-deletes all alive points within a hypersphere.
+         *
+         * @tparam VecLike A vector-like type whose elements are accessible via operator[].
+         * @param center The center of the hypersphere.
+         * @param radius The radius of the hypersphere.
+         * @return The number of points that were marked as deleted.
+         */
+        template <class VecLike>
+        std::size_t markDeletedInBall(const VecLike& center, Scalar radius)
+        {
+            const Scalar r2 = radius * radius;
+            std::size_t removed = 0;
+            visitIndices(
+                [&](const PackedNode& n) { return n.bounds.intersectsBall(center, radius); },
+                [&](const PackedNode& n) { return n.bounds.maxDistanceSquared(center) <= r2; },
+                [&](std::size_t i) { return detail::orthtreeWithinDistance<Scalar, Dim>(get_pos_(points_[i]), center, r2); },
+                [&](std::size_t i) { clearAlive(i); ++removed; });
+            if (removed > 0) ++version_;
+            return removed;
+        }
+
+        /**
+         * @brief Soft-deletes all points that satisfy an arbitrary predicate.
+         *
+         * @tparam Predicate Callable with signature: bool(const PointT&).
+         * @param pred The predicate; returns true for points that should be deleted.
+         * @return The number of points that were marked as deleted.
+         */
+        template <class Predicate>
+        std::size_t markDeletedIf(Predicate pred)
+        {
+            std::size_t removed = 0;
+            forEachAliveIndex(0, points_.size(), [&](std::size_t i) {
+                if (pred(points_[i])) { clearAlive(i); ++removed; }
+            });
+            if (removed > 0) ++version_;
+            return removed;
+        }
+
+        /**
+         * @brief Physically removes all soft-deleted points.
+         *
+         * Alive points keep their relative order and the node array keeps its shape;
+         * only the point ranges shrink, so leaves may become empty. Indices into
+         * @c points() change. Increments the version counter if any points were removed.
+         *
+         * @return The number of points removed.
+         */
+        std::size_t compact()
+        {
+            const std::size_t n = points_.size();
+            const std::size_t words = alive_.size();
+
+            // rank[w] = number of alive points before word w.
+            std::vector<std::uint32_t> rank(words + 1, 0);
+            for (std::size_t w = 0; w < words; ++w)
+                rank[w + 1] = rank[w] + static_cast<std::uint32_t>(std::popcount(alive_[w]));
+            const std::size_t alive_total = rank[words];
+            if (alive_total == n) return 0;
+
+            auto new_index = [&](std::uint32_t i) -> std::uint32_t {
+                const std::size_t w = i >> 6;
+                const unsigned bit = i & 63u;
+                if (bit == 0) return rank[w];
+                return rank[w] + static_cast<std::uint32_t>(std::popcount(alive_[w] & ((std::uint64_t(1) << bit) - 1)));
+            };
+            for (PackedNode& node : nodes_)
+            {
+                node.begin = new_index(node.begin);
+                node.end = new_index(node.end);
+            }
+
+            std::size_t write = 0;
+            for (std::size_t read = 0; read < n; ++read)
+            {
+                if (!isAlive(read)) continue;
+                if (write != read) points_[write] = std::move(points_[read]);
+                ++write;
+            }
+            points_.erase(points_.begin() + static_cast<std::ptrdiff_t>(write), points_.end());
+            resetAlive(write);
+
+            ++version_;
+            return n - write;
+        }
+
+        // ---------------------- Queries ---------------------- //
+
+        /**
+         * @brief Visits every alive point inside @p region, invoking @p fn on each.
+         *
+         * Points arrive in storage (Morton) order. Nodes entirely inside @p region are
+         * emitted without per-point tests.
+         *
+         * @tparam Func Callable with signature: void(const PointT&).
+         * @param region The axis-aligned query box.
+         * @param fn     The visitor function.
+         */
+        template <class Func>
+        void forEachPointInBox(const box_type& region, Func&& fn) const
+        {
+            visitIndices(
+                [&](const PackedNode& n) { return n.bounds.intersects(region); },
+                [&](const PackedNode& n) { return containsBox(region, n.bounds); },
+                [&](std::size_t i) { return region.contains(get_pos_(points_[i])); },
+                [&](std::size_t i) { fn(points_[i]); });
+        }
+
+        /**
+         * @brief Writes every alive point inside @p region to an output iterator.
+         *
+         * @tparam OutputIt An iterator satisfying OutputIterator requirements.
+         * @param region The axis-aligned query box.
+         * @param out    The output iterator to write results to.
+         */
+        template <class OutputIt>
+        void queryPointsInBox(const box_type& region, OutputIt out) const
+        {
+            forEachPointInBox(region, [&](const PointT& p) { *out++ = p; });
+        }
+
+        /**
+         * @brief Visits every alive point within @p radius of @p center, invoking @p fn on each.
+         *
+         * Nodes entirely inside the ball are emitted without per-point distance tests.
+         *
+         * @tparam VecLike A vector-like type whose elements are accessible via operator[].
+         * @tparam Func    Callable with signature: void(const PointT&).
+         * @param center The center of the hypersphere.
+         * @param radius The radius of the hypersphere.
+         * @param fn     The visitor function.
+         */
+        template <class VecLike, class Func>
+        void forEachPointInBall(const VecLike& center, Scalar radius, Func&& fn) const
+        {
+            const Scalar r2 = radius * radius;
+            visitIndices(
+                [&](const PackedNode& n) { return n.bounds.intersectsBall(center, radius); },
+                [&](const PackedNode& n) { return n.bounds.maxDistanceSquared(center) <= r2; },
+                [&](std::size_t i) { return detail::orthtreeWithinDistance<Scalar, Dim>(get_pos_(points_[i]), center, r2); },
+                [&](std::size_t i) { fn(points_[i]); });
+        }
+
+        /**
+         * @brief Writes every alive point within @p radius of @p center to an output iterator.
+         *
+         * @tparam VecLike  A vector-like type whose elements are accessible via operator[].
+         * @tparam OutputIt An iterator satisfying OutputIterator requirements.
+         * @param center The center of the hypersphere.
+         * @param radius The radius of the hypersphere.
+         * @param out    The output iterator to write results to.
+         */
+        template <class VecLike, class OutputIt>
+        void queryPointsInBall(const VecLike& center, Scalar radius, OutputIt out) const
+        {
+            forEachPointInBall(center, radius, [&](const PointT& p) { *out++ = p; });
+        }
+
+        /**
+         * @brief Returns the alive point closest to @p pos, or nullptr if there is none
+         *        within @p max_distance.
+         *
+         * The pointer refers into the point array and is invalidated by @c bulkLoad and
+         * @c compact.
+         *
+         * @tparam VecLike A vector-like type whose elements are accessible via operator[].
+         * @param pos          The query position (may lie outside the root bounds).
+         * @param max_distance Search radius; points farther away are ignored.
+         * @return Pointer to the nearest point, or nullptr.
+         */
+        template <class VecLike>
+        const PointT* nearest(const VecLike& pos,
+            Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+        {
+            KnnScratch scratch;
+            searchNearest(pos, 1, max_distance, scratch);
+            return scratch.best.empty() ? nullptr : &points_[scratch.best.front().index];
+        }
+
+        /**
+         * @brief Writes the @p k alive points closest to @p pos to @p out, nearest first.
+         *
+         * @tparam VecLike  A vector-like type whose elements are accessible via operator[].
+         * @tparam OutputIt An iterator satisfying OutputIterator requirements.
+         * @param pos          The query position (may lie outside the root bounds).
+         * @param k            Maximum number of points to return.
+         * @param out          The output iterator to write results to.
+         * @param max_distance Search radius; points farther away are ignored.
+         * @return The number of points written.
+         */
+        template <class VecLike, class OutputIt>
+        std::size_t kNearest(const VecLike& pos, std::size_t k, OutputIt out,
+            Scalar max_distance = std::numeric_limits<Scalar>::max()) const
+        {
+            KnnScratch scratch;
+            searchNearest(pos, k, max_distance, scratch);
+            for (const Neighbor& nb : scratch.best) *out++ = points_[nb.index];
+            return scratch.best.size();
+        }
+
+    private:
+        // ---------------------- Internal Helpers ---------------------- //
+
+        /// Copies an @c Orthtree configuration; the types differ when the allocators do.
+        template <class OtherConfig>
+        static Config convertConfig(const OtherConfig& other)
+        {
+            Config cfg;
+            cfg.root_bounds = other.root_bounds;
+            cfg.max_depth = other.max_depth;
+            cfg.max_points_per_leaf = other.max_points_per_leaf;
+            cfg.merge_threshold = other.merge_threshold;
+            return cfg;
+        }
+
+        void resetRoot()
+        {
+            nodes_.clear();
+            PackedNode root;
+            root.bounds = config_.root_bounds;
+            nodes_.push_back(root);
+        }
+
+        /// Sizes the bitset for @p n points, all alive; bits past @p n stay clear.
+        void resetAlive(std::size_t n)
+        {
+            alive_.assign((n + 63) / 64, ~std::uint64_t(0));
+            if (n % 64 != 0) alive_.back() = (std::uint64_t(1) << (n % 64)) - 1;
+        }
+
+        void clearAlive(std::size_t i) noexcept
+        {
+            alive_[i >> 6] &= ~(std::uint64_t(1) << (i & 63));
+        }
+
+        static bool containsBox(const box_type& outer, const box_type& inner) noexcept
+        {
+            return outer.contains(inner.min) && outer.contains(inner.max);
+        }
+
+        /// Invokes @p fn(i) for every alive index in [@p begin, @p end), a bitset word at a time.
+        template <class Func>
+        void forEachAliveIndex(std::size_t begin, std::size_t end, Func&& fn) const
+        {
+            if (begin >= end) return;
+            std::size_t w = begin >> 6;
+            const std::size_t last_w = (end - 1) >> 6;
+            std::uint64_t bits = alive_[w] & (~std::uint64_t(0) << (begin & 63));
+            for (;;)
+            {
+                if (w == last_w && (end & 63) != 0)
+                    bits &= (std::uint64_t(1) << (end & 63)) - 1;
+                while (bits)
+                {
+                    fn((w << 6) + static_cast<std::size_t>(std::countr_zero(bits)));
+                    bits &= bits - 1;
+                }
+                if (w == last_w) return;
+                bits = alive_[++w];
+            }
+        }
+
+        /**
+         * @brief Shared iterative traversal for region queries and deletions.
+         *
+         * Descends into nodes for which @p overlaps holds; a node for which @p inside
+         * holds emits its whole alive range, and a partially covered leaf emits the
+         * alive points that pass @p accept. Children are pushed in reverse so points
+         * are emitted in storage order.
+         */
+        template <class Overlaps, class Inside, class Accept, class Emit>
+        void visitIndices(const Overlaps& overlaps, const Inside& inside, const Accept& accept, const Emit& emit) const
+        {
+            if (points_.empty() || !overlaps(nodes_[0])) return;
+
+            std::array<node_id, kStackSize> stack;
+            std::size_t top = 0;
+            stack[top++] = 0;
+            while (top > 0)
+            {
+                const PackedNode& node = nodes_[stack[--top]];
+                if (inside(node))
+                {
+                    forEachAliveIndex(node.begin, node.end, emit);
+                    continue;
+                }
+                if (node.isLeaf())
+                {
+                    forEachAliveIndex(node.begin, node.end, [&](std::size_t i) { if (accept(i)) emit(i); });
+                    continue;
+                }
+                for (std::uint32_t c = node.child_count; c-- > 0;)
+                {
+                    const node_id cid = node.first_child + c;
+                    if (overlaps(nodes_[cid])) stack[top++] = cid;
+                }
+            }
+        }
+
+        /// A kNN candidate: squared distance to the query and the index of the point.
+        struct Neighbor
+        {
+            Scalar      distance2;
+            std::size_t index;
+        };
+
+        struct KnnScratch
+        {
+            std::vector<std::pair<Scalar, node_id>> frontier;
+            std::vector<Neighbor> best;
+        };
+
+        /**
+         * @brief Best-first k-nearest search; leaves the result in @p s.best, nearest first.
+         *
+         * Same scheme as @c Orthtree: a min-heap of nodes by box distance and a bounded
+         * max-heap of candidates whose top is the pruning radius.
+         */
+        template <class VecLike>
+        void searchNearest(const VecLike& pos, std::size_t k, Scalar max_distance, KnnScratch& s) const
+        {
+            s.frontier.clear();
+            s.best.clear();
+            if (points_.empty() || k == 0) return;
+
+            std::array<Scalar, Dim> q{};
+            for (std::size_t i = 0; i < Dim; ++i) q[i] = Scalar(pos[i]);
+
+            Scalar bound = max_distance == std::numeric_limits<Scalar>::max()
+                ? std::numeric_limits<Scalar>::max()
+                : max_distance * max_distance;
+
+            auto nearer_node = [](const auto& a, const auto& b) { return a.first > b.first; };
+            auto farther = [](const Neighbor& a, const Neighbor& b) { return a.distance2 < b.distance2; };
+
+            s.frontier.emplace_back(nodes_[0].bounds.distanceSquared(q), node_id(0));
+            while (!s.frontier.empty())
+            {
+                std::pop_heap(s.frontier.begin(), s.frontier.end(), nearer_node);
+                const auto [node_d2, nid] = s.frontier.back();
+                s.frontier.pop_back();
+                if (node_d2 > bound) break;
+
+                const PackedNode& node = nodes_[nid];
+                if (node.isLeaf())
+                {
+                    forEachAliveIndex(node.begin, node.end, [&](std::size_t i) {
+                        const Scalar d2 = detail::orthtreeDistanceSquared<Scalar, Dim>(get_pos_(points_[i]), q);
+                        if (d2 > bound) return;
+                        if (s.best.size() < k)
+                        {
+                            s.best.push_back({ d2, i });
+                            std::push_heap(s.best.begin(), s.best.end(), farther);
+                            if (s.best.size() == k) bound = s.best.front().distance2;
+                        }
+                        else if (d2 < s.best.front().distance2)
+                        {
+                            std::pop_heap(s.best.begin(), s.best.end(), farther);
+                            s.best.back() = { d2, i };
+                            std::push_heap(s.best.begin(), s.best.end(), farther);
+                            bound = s.best.front().distance2;
+                        }
+                    });
+                    continue;
+                }
+
+                for (std::uint32_t c = 0; c < node.child_count; ++c)
+                {
+                    const node_id cid = node.first_child + c;
+                    if (nodes_[cid].begin == nodes_[cid].end) continue;
+                    const Scalar child_d2 = nodes_[cid].bounds.distanceSquared(q);
+                    if (child_d2 > bound) continue;
+                    s.frontier.emplace_back(child_d2, cid);
+                    std::push_heap(s.frontier.begin(), s.frontier.end(), nearer_node);
+                }
+            }
+            std::sort_heap(s.best.begin(), s.best.end(), farther);
+        }
+
+        template <class Range>
+        std::size_t bulkLoadImpl(const Range& pts, ThreadPool* pool)
+        {
+            if constexpr (!(std::ranges::random_access_range<const Range> && std::ranges::sized_range<const Range>))
+            {
+                std::vector<PointT> buffered;
+                for (const PointT& p : pts) buffered.push_back(p);
+                return bulkLoadImpl(buffered, pool);
+            }
+            else
+            {
+                const auto first = std::ranges::begin(pts);
+                const std::size_t n = static_cast<std::size_t>(std::ranges::size(pts));
+                if (n > std::numeric_limits<std::uint32_t>::max())
+                    throw std::length_error("PackedOrthtree::bulkLoad: more than 2^32 - 1 points");
+
+                const std::uint32_t levels = std::min(config_.max_depth, Encoder::kMaxLevels);
+                std::vector<detail::OrthtreeSortKey> keys;
+                const std::size_t inside = detail::orthtreeSortByMorton(first, n, get_pos_,
+                    config_.root_bounds, levels, pool, keys);
+
+                points_.clear();
+                points_.reserve(inside);
+                for (std::size_t k = 0; k < inside; ++k)
+                    points_.push_back(first[keys[k].index]);
+                resetAlive(inside);
+
+                resetRoot();
+                nodes_.front().end = static_cast<std::uint32_t>(inside);
+                buildLevels(keys, levels);
+
+                ++version_;
+                return inside;
+            }
+        }
+
+        /**
+         * @brief Splits nodes level by level; the node array doubles as the BFS queue.
+         *
+         * The keys of a node's points form a contiguous run, and within it the keys of
+         * each child form a contiguous sub-run ordered by child index, so children are
+         * appended in that order and stay adjacent.
+         */
+        void buildLevels(const std::vector<detail::OrthtreeSortKey>& keys, std::uint32_t levels)
+        {
+            const std::uint32_t split_depth = std::min(config_.max_depth, levels);
+            const std::uint64_t mask = kChildCount - 1;
+
+            std::size_t level_begin = 0;
+            for (std::uint32_t depth = 0; depth < split_depth && level_begin < nodes_.size(); ++depth)
+            {
+                const std::size_t level_end = nodes_.size();
+                const unsigned shift = static_cast<unsigned>(Dim * (levels - depth - 1));
+                for (std::size_t id = level_begin; id < level_end; ++id)
+                {
+                    const std::uint32_t begin = nodes_[id].begin;
+                    const std::uint32_t end = nodes_[id].end;
+                    if (end - begin <= config_.max_points_per_leaf) continue;
+
+                    const box_type parent_bounds = nodes_[id].bounds;
+                    nodes_[id].first_child = static_cast<node_id>(nodes_.size());
+                    std::uint32_t child_count = 0;
+                    for (std::uint32_t lo = begin; lo < end; ++child_count)
+                    {
+                        const std::size_t child_idx = static_cast<std::size_t>((keys[lo].code >> shift) & mask);
+                        const std::uint32_t hi = static_cast<std::uint32_t>(std::partition_point(
+                            keys.begin() + lo, keys.begin() + end,
+                            [&](const detail::OrthtreeSortKey& k) { return ((k.code >> shift) & mask) == child_idx; })
+                            - keys.begin());
+
+                        PackedNode child;
+                        child.bounds = childBounds(parent_bounds, child_idx);
+                        child.begin = lo;
+                        child.end = hi;
+                        nodes_.push_back(child);
+                        lo = hi;
+                    }
+                    nodes_[id].child_count = child_count;
+                }
+                level_begin = level_end;
+            }
+        }
+
+        /// Same split as @c Orthtree::computeChildBounds: bit i of @p child_index selects the upper half of axis i.
+        static box_type childBounds(const box_type& parent, std::size_t child_index)
+        {
+            const auto c = parent.center();
+            box_type b = parent;
+            for (std::size_t i = 0; i < Dim; ++i)
+            {
+                if (child_index & (std::size_t(1) << i)) b.min[i] = c[i];
+                else b.max[i] = c[i];
+            }
+            return b;
+        }
+
+        Config config_{};
+        GetPosition get_pos_{};
+        std::uint64_t version_ = 0;
+
+        std::vector<PackedNode, node_allocator> nodes_;
+        std::vector<PointT, point_allocator> points_;
+        /// Bit i set = point i alive.
+        std::vector<std::uint64_t, word_allocator> alive_;
+    };
+
+    /**
+     * @brief Convenience alias for a PackedOrthtree that uses PMR polymorphic allocators.
+     *
+     * @tparam PointT      Type of spatial points stored in the tree.
+     * @tparam Dim         Number of spatial dimensions (must be >= 1).
+     * @tparam Scalar      Scalar type used for bounding-box coordinates.
+     * @tparam GetPosition Functor that extracts a position from a PointT value.
+     */
+    template <
+        class PointT,
+        std::size_t Dim,
+        class Scalar      = float,
+        class GetPosition = DefaultGetPosition<PointT>>
+    using PackedOrthtreePmr = PackedOrthtree<
+        PointT, Dim, Scalar, GetPosition,
+        std::pmr::polymorphic_allocator<std::byte>>;
+
+} // namespace lux::cxx
@@ -0,0 +1,324 @@
+#pragma once
+/**
+ * @file PagedVector.hpp
+ * @brief A vector built from fixed-size pages: growth never relocates elements,
+ *        so element addresses stay stable for as long as the element exists.
+ *
+ * @copyright
+ * Copyright (c) 2025 Chenhui Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lux::cxx
+{
+    /**
+     * @class PagedVector
+     * @brief Sequence container storing its elements in pages of @p PageSize elements.
+     *
+     * - push_back/emplace_back allocate at most one new page and never move existing
+     *   elements, so pointers and references stay valid until the element is popped.
+     *   Only the page directory (one pointer per page) is reallocated on growth.
+     * - Elements are contiguous within a page; use page() / page_count() for
+     *   page-wise loops that vectorize like a plain array.
+     * - pop_back/clear keep the pages for reuse; shrink_to_fit releases unused pages.
+     *
+     * @tparam T        Element type.
+     * @tparam PageSize Elements per page; a power of two keeps indexing to a shift and mask.
+     */
+    template <typename T, std::size_t PageSize = 1024>
+    class PagedVector
+    {
+        static_assert(PageSize > 0, "PagedVector: PageSize must be > 0");
+
+        template <bool Const>
+        class Iterator;
+
+    public:
+        using value_type      = T;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference       = T&;
+        using const_reference = const T&;
+        using pointer         = T*;
+        using const_pointer   = const T*;
+        using iterator        = Iterator<false>;
+        using const_iterator  = Iterator<true>;
+
+        static constexpr size_type page_size = PageSize;
+
+        // ---- constructors ---------------------------------------------------
+
+        PagedVector() = default;
+
+        PagedVector(const PagedVector& other)
+        {
+            reserve(other.size_);
+            for (size_type i = 0; i < other.size_; ++i)
+                emplace_back(other[i]);
+        }
+
+        PagedVector(PagedVector&& other) noexcept
+            : pages_(std::move(other.pages_)), size_(std::exchange(other.size_, 0))
+        {
+        }
+
+        PagedVector& operator=(const PagedVector& other)
+        {
+            if (this != &other)
+            {
+                PagedVector copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        PagedVector& operator=(PagedVector&& other) noexcept
+        {
+            if (this != &other)
+            {
+                destroy_all();
+                pages_ = std::move(other.pages_);
+                size_  = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        ~PagedVector()
+        {
+            destroy_all();
+        }
+
+        void swap(PagedVector& other) noexcept
+        {
+            pages_.swap(other.pages_);
+            std::swap(size_, other.size_);
+        }
+
+        // ---- capacity -------------------------------------------------------
+
+        [[nodiscard]] size_type size()     const noexcept { return size_; }
+        [[nodiscard]] bool      empty()    const noexcept { return size_ == 0; }
+        [[nodiscard]] size_type capacity() const noexcept { return pages_.size() * PageSize; }
+
+        /**
+         * @brief Allocates pages until at least @p n elements fit. Never moves elements.
+         */
+        void reserve(size_type n)
+        {
+            const size_type pages = (n + PageSize - 1) / PageSize;
+            pages_.reserve(pages);
+            while (pages_.size() < pages)
+                append_page();
+        }
+
+        /**
+         * @brief Releases every page past the one holding the last element.
+         */
+        void shrink_to_fit()
+        {
+            const size_type used = (size_ + PageSize - 1) / PageSize;
+            while (pages_.size() > used)
+            {
+                deallocate_page(pages_.back());
+                pages_.pop_back();
+            }
+            pages_.shrink_to_fit();
+        }
+
+        /**
+         * @brief Destroys all elements; the pages are kept for reuse.
+         */
+        void clear() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (size_type i = 0; i < size_; ++i)
+                    std::destroy_at(&(*this)[i]);
+            }
+            size_ = 0;
+        }
+
+        // ---- modifiers ------------------------------------------------------
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (size_ == capacity())
+                append_page();
+            T* slot = slot_at(size_);
+            std::construct_at(slot, std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value)      { emplace_back(std::move(value)); }
+
+        void pop_back() noexcept
+        {
+            --size_;
+            std::destroy_at(slot_at(size_));
+        }
+
+        // ---- element access -------------------------------------------------
+
+        [[nodiscard]] T&       operator[](size_type i)       noexcept { return *slot_at(i); }
+        [[nodiscard]] const T& operator[](size_type i) const noexcept { return *slot_at(i); }
+
+        [[nodiscard]] T&       back()       noexcept { return (*this)[size_ - 1]; }
+        [[nodiscard]] const T& back() const noexcept { return (*this)[size_ - 1]; }
+
+        /**
+         * @brief Number of pages holding at least one element.
+         */
+        [[nodiscard]] size_type page_count() const noexcept
+        {
+            return (size_ + PageSize - 1) / PageSize;
+        }
+
+        /**
+         * @brief Returns the live elements of page @p p as one contiguous span.
+         */
+        [[nodiscard]] std::span<T> page(size_type p) noexcept
+        {
+            return { pages_[p], page_extent(p) };
+        }
+
+        [[nodiscard]] std::span<const T> page(size_type p) const noexcept
+        {
+            return { pages_[p], page_extent(p) };
+        }
+
+        // ---- iteration ------------------------------------------------------
+
+        [[nodiscard]] iterator       begin()        noexcept { return { this, 0 }; }
+        [[nodiscard]] iterator       end()          noexcept { return { this, size_ }; }
+        [[nodiscard]] const_iterator begin()  const noexcept { return { this, 0 }; }
+        [[nodiscard]] const_iterator end()    const noexcept { return { this, size_ }; }
+        [[nodiscard]] const_iterator cbegin() const noexcept { return { this, 0 }; }
+        [[nodiscard]] const_iterator cend()   const noexcept { return { this, size_ }; }
+
+    private:
+        template <bool Const>
+        class Iterator
+        {
+            using owner_t = std::conditional_t<Const, const PagedVector, PagedVector>;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = std::conditional_t<Const, const T*, T*>;
+            using reference         = std::conditional_t<Const, const T&, T&>;
+
+            Iterator() = default;
+            Iterator(owner_t* owner, size_type index) noexcept : owner_(owner), index_(index) {}
+
+            /** @brief Allows iterator → const_iterator conversion. */
+            operator Iterator<true>() const noexcept { return { owner_, index_ }; }
+
+            reference operator*()  const noexcept { return (*owner_)[index_]; }
+            pointer   operator->() const noexcept { return &(*owner_)[index_]; }
+            reference operator[](difference_type n) const noexcept { return (*owner_)[index_ + n]; }
+
+            Iterator& operator++() noexcept { ++index_; return *this; }
+            Iterator  operator++(int) noexcept { Iterator tmp = *this; ++index_; return tmp; }
+            Iterator& operator--() noexcept { --index_; return *this; }
+            Iterator  operator--(int) noexcept { Iterator tmp = *this; --index_; return tmp; }
+
+            Iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; }
+            Iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; }
+
+            friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const Iterator& a, const Iterator& b) noexcept
+            {
+                return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+            }
+
+            friend bool operator==(const Iterator& a, const Iterator& b) noexcept { return a.index_ == b.index_; }
+            friend auto operator<=>(const Iterator& a, const Iterator& b) noexcept { return a.index_ <=> b.index_; }
+
+        private:
+            owner_t*  owner_ = nullptr;
+            size_type index_ = 0;
+        };
+
+        static T* allocate_page()
+        {
+            return static_cast<T*>(::operator new(PageSize * sizeof(T), std::align_val_t{ alignof(T) }));
+        }
+
+        static void deallocate_page(T* page) noexcept
+        {
+            ::operator delete(page, std::align_val_t{ alignof(T) });
+        }
+
+        /**
+         * @brief Adds one page. The directory grows before the page is allocated, so the
+         *        push_back cannot throw and leak it.
+         */
+        void append_page()
+        {
+            if (pages_.size() == pages_.capacity())
+                pages_.reserve(pages_.empty() ? 1 : pages_.size() * 2);
+            pages_.push_back(allocate_page());
+        }
+
+        T* slot_at(size_type i) const noexcept
+        {
+            return pages_[i / PageSize] + (i % PageSize);
+        }
+
+        size_type page_extent(size_type p) const noexcept
+        {
+            const size_type first = p * PageSize;
+            return (size_ - first < PageSize) ? size_ - first : PageSize;
+        }
+
+        void destroy_all() noexcept
+        {
+            clear();
+            for (T* page : pages_)
+                deallocate_page(page);
+            pages_.clear();
+        }
+
+        std::vector<T*> pages_;    ///< Page directory; only this is reallocated on growth.
+        size_type       size_ = 0; ///< Number of constructed elements.
+    };
+
+    /** @brief True if @p C is a PagedVector, whose growth never moves elements. */
+    template <typename C>
+    inline constexpr bool is_paged_vector_v = false;
+
+    template <typename T, std::size_t PageSize>
+    inline constexpr bool is_paged_vector_v<PagedVector<T, PageSize>> = true;
+
+} // namespace lux::cxx
@@ -25,16 +25,23 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <lux/cxx/container/PagedVector.hpp>
+
 #include <vector>
+#include <algorithm>
 #include <cstdint>
 #include <cstddef>
 #include <limits>
+#include <ranges>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 namespace lux::cxx
 {
+    struct SnapshotAccess; // Snapshot.hpp
+
     /**
      * @brief A generational handle returned by SlotMap.
      *
@@ -86,6 +93,30 @@ namespace lux::cxx
         };
     };
 
+    /**
+     * @brief SlotMap storage policy: plain std::vector arrays (the default).
+     *
+     * Fastest iteration and lookup, but growth reallocates and moves every element.
+     */
+    struct ContiguousStoragePolicy
+    {
+        template <typename T>
+        using container_t = std::vector<T>;
+    };
+
+    /**
+     * @brief SlotMap storage policy: PagedVector arrays of @p PageSize elements.
+     *
+     * Growth only appends a page, so inserts have no relocation spikes and
+     * pointers to values survive later inserts. Iteration stays dense within pages.
+     */
+    template <std::size_t PageSize = 4096>
+    struct PagedStoragePolicy
+    {
+        template <typename T>
+        using container_t = PagedVector<T, PageSize>;
+    };
+
     /**
      * @class SlotMap
      * @brief Dense-storage associative container with O(1) insert, erase, and lookup.
@@ -99,16 +130,25 @@ namespace lux::cxx
      * Insert returns a SlotKey. Lookup and erase validate the generation to detect
      * use-after-free of stale handles.
      *
+     * **Deferred erase**: with set_deferred_erase(true), erase() invalidates the key
+     * and recycles its slot immediately but only *tombstones* the dense entry; the
+     * dense array keeps its order until compact() removes all tombstones in one
+     * order-preserving pass. Use for_each() to skip tombstones while they are pending.
+     *
      * @note **Pointer stability**: Because the dense array uses swap-and-pop erasure,
      *       pointers/references obtained via find() or operator[] are invalidated when
      *       **any** element is erased.  Do not cache pointers across erase() calls.
+     *       With ContiguousStoragePolicy they are also invalidated by any insert that
+     *       grows the arrays; with PagedStoragePolicy inserts never move values.
      *
      * @tparam Value          The element type.
      * @tparam Tag            Type tag forwarded to SlotKey for compile-time discrimination.
      * @tparam IndexType      Unsigned integer for slot/dense indices.
      * @tparam GenerationType Unsigned integer for generation counters.
+     * @tparam StoragePolicy  ContiguousStoragePolicy or PagedStoragePolicy<PageSize>.
      */
-    template <typename Value, typename Tag = void, typename IndexType = std::uint32_t, typename GenerationType = std::uint32_t>
+    template <typename Value, typename Tag = void, typename IndexType = std::uint32_t, typename GenerationType = std::uint32_t,
+              typename StoragePolicy = ContiguousStoragePolicy>
     class SlotMap
     {
         static_assert(std::is_unsigned_v<IndexType>, "SlotMap: IndexType must be unsigned");
@@ -121,6 +161,10 @@ namespace lux::cxx
         using index_t      = IndexType;
         using generation_t = GenerationType;
 
+        template <typename T>
+        using container_t       = typename StoragePolicy::template container_t<T>;
+        using dense_container_t = container_t<Value>;
+
         static constexpr index_t INVALID_INDEX =
             (std::numeric_limits<index_t>::max)();
 
@@ -135,8 +179,9 @@ namespace lux::cxx
 
         // ---- capacity -------------------------------------------------------
 
-        [[nodiscard]] size_t size()     const noexcept { return dense_.size(); }
-        [[nodiscard]] bool   empty()    const noexcept { return dense_.empty(); }
+        /** @brief Number of live elements (excludes pending tombstones). */
+        [[nodiscard]] size_t size()     const noexcept { return dense_.size() - tombstones_; }
+        [[nodiscard]] bool   empty()    const noexcept { return size() == 0; }
         [[nodiscard]] size_t capacity() const noexcept { return slots_.capacity(); }
 
         void reserve(size_t n)
@@ -159,6 +204,8 @@ namespace lux::cxx
             dense_.clear();
             dense_to_slot_.clear();
             free_head_ = INVALID_INDEX;
+            tombstones_      = 0;
+            first_tombstone_ = INVALID_INDEX;
         }
 
         // ---- insert ---------------------------------------------------------
@@ -188,6 +235,27 @@ namespace lux::cxx
             return emplace_impl(std::forward<Args>(args)...);
         }
 
+        /**
+         * @brief Inserts every element of @p values, reserving storage once.
+         * @param values   A sized range of values (copied, or moved from an rvalue-element range).
+         * @param out_keys Receives the handle of each inserted element, in order.
+         * @return The number of inserted elements.
+         * @throws std::length_error if @p out_keys is smaller than @p values.
+         */
+        template <std::ranges::sized_range R>
+        size_t insert_many(R&& values, std::span<key_t> out_keys)
+        {
+            const size_t n = static_cast<size_t>(std::ranges::size(values));
+            if (out_keys.size() < n)
+                throw std::length_error("SlotMap::insert_many: output span too small");
+
+            reserve_additional(n);
+            size_t i = 0;
+            for (auto&& value : values)
+                out_keys[i++] = emplace_impl(std::forward<decltype(value)>(value));
+            return n;
+        }
+
         // ---- erase ----------------------------------------------------------
 
         /**
@@ -200,28 +268,98 @@ namespace lux::cxx
             if (!is_valid(key))
                 return false;
 
-            auto& slot = slots_[key.index];
-            index_t dense_idx = slot.dense_index;
-            index_t last_dense = static_cast<index_t>(dense_.size() - 1);
+            const index_t dense_idx = release_slot(key.index);
+            if (deferred_erase_)
+                tombstone(dense_idx);
+            else
+                remove_dense(dense_idx);
+            return true;
+        }
 
-            // Swap-and-pop in the dense array.
-            if (dense_idx != last_dense)
+        /**
+         * @brief Removes every element identified by @p keys. Stale, invalid and
+         *        duplicate keys are skipped.
+         *
+         * In immediate mode all victims are marked first and the holes are then
+         * filled from the back, skipping marked entries: no element is moved into
+         * a hole only to be erased afterwards, and no sorting is needed.
+         *
+         * @return The number of erased elements.
+         */
+        size_t erase_many(std::span<const key_t> keys)
+        {
+            std::vector<index_t> victims;
+            victims.reserve(keys.size());
+            for (const key_t& key : keys)
             {
-                dense_[dense_idx] = std::move(dense_[last_dense]);
-                dense_to_slot_[dense_idx] = dense_to_slot_[last_dense];
-                // Update the swapped element's slot to point to the new dense position.
-                slots_[dense_to_slot_[dense_idx]].dense_index = dense_idx;
+                if (is_valid(key))
+                    victims.push_back(release_slot(key.index));
             }
-            dense_.pop_back();
-            dense_to_slot_.pop_back();
 
-            // Increment generation so stale handles are detected.
-            slot.generation++;
-            // Push this slot onto the free list.
-            slot.dense_index = free_head_;
-            free_head_ = key.index;
+            for (index_t dense_idx : victims)
+                tombstone(dense_idx);
+            if (!deferred_erase_)
+                fill_holes(victims);
+            return victims.size();
+        }
 
-            return true;
+        // ---- deferred erase -------------------------------------------------
+
+        /**
+         * @brief Enables or disables deferred erase. Disabling compacts pending tombstones.
+         */
+        void set_deferred_erase(bool enabled)
+        {
+            deferred_erase_ = enabled;
+            if (!enabled)
+                compact();
+        }
+
+        [[nodiscard]] bool deferred_erase() const noexcept { return deferred_erase_; }
+
+        /**
+         * @brief Number of dense entries erased in deferred mode and not yet compacted.
+         */
+        [[nodiscard]] size_t pending_erase_count() const noexcept { return tombstones_; }
+
+        /**
+         * @brief Returns true if the dense entry at @p dense_index is a pending tombstone.
+         */
+        [[nodiscard]] bool is_tombstone(size_t dense_index) const noexcept
+        {
+            return dense_to_slot_[dense_index] == INVALID_INDEX;
+        }
+
+        /**
+         * @brief Removes all tombstones in a single pass, preserving the relative
+         *        order of the surviving elements.
+         *
+         * Only the tail starting at the first tombstone is touched.
+         */
+        void compact()
+        {
+            if (tombstones_ == 0)
+                return;
+
+            const size_t n = dense_.size();
+            size_t write = first_tombstone_;
+            for (size_t read = first_tombstone_; read < n; ++read)
+            {
+                const index_t slot_idx = dense_to_slot_[read];
+                if (slot_idx == INVALID_INDEX)
+                    continue;
+                dense_[write]         = std::move(dense_[read]);
+                dense_to_slot_[write] = slot_idx;
+                slots_[slot_idx].dense_index = static_cast<index_t>(write);
+                ++write;
+            }
+            while (dense_.size() > write)
+            {
+                dense_.pop_back();
+                dense_to_slot_.pop_back();
+            }
+            tombstones_      = 0;
+            first_tombstone_ = INVALID_INDEX;
         }
 
         // ---- lookup ---------------------------------------------------------
@@ -287,23 +425,41 @@ namespace lux::cxx
 
         // ---- dense iteration ------------------------------------------------
 
+        /**
+         * @brief Calls `func(Value&)` for every live element in dense order, skipping
+         *        pending tombstones.
+         */
+        template <typename Func>
+        void for_each(Func&& func)
+        {
+            for_each_impl(*this, func);
+        }
+
+        template <typename Func>
+        void for_each(Func&& func) const
+        {
+            for_each_impl(*this, func);
+        }
+
         /**
          * @brief Returns a const reference to the dense array of values.
          *
          * The order is unspecified but the array is contiguous — ideal for
          * cache-friendly iteration in ECS-style loops.
          */
-        [[nodiscard]] const std::vector<Value>& values() const noexcept { return dense_; }
-        [[nodiscard]]       std::vector<Value>& values()       noexcept { return dense_; }
+        [[nodiscard]] const dense_container_t& values() const noexcept { return dense_; }
+        [[nodiscard]]       dense_container_t& values()       noexcept { return dense_; }
 
-        [[nodiscard]] typename std::vector<Value>::iterator       begin()        noexcept { return dense_.begin(); }
-        [[nodiscard]] typename std::vector<Value>::iterator       end()          noexcept { return dense_.end(); }
-        [[nodiscard]] typename std::vector<Value>::const_iterator begin()  const noexcept { return dense_.begin(); }
-        [[nodiscard]] typename std::vector<Value>::const_iterator end()    const noexcept { return dense_.end(); }
-        [[nodiscard]] typename std::vector<Value>::const_iterator cbegin() const noexcept { return dense_.cbegin(); }
-        [[nodiscard]] typename std::vector<Value>::const_iterator cend()   const noexcept { return dense_.cend(); }
+        [[nodiscard]] typename dense_container_t::iterator       begin()        noexcept { return dense_.begin(); }
+        [[nodiscard]] typename dense_container_t::iterator       end()          noexcept { return dense_.end(); }
+        [[nodiscard]] typename dense_container_t::const_iterator begin()  const noexcept { return dense_.begin(); }
+        [[nodiscard]] typename dense_container_t::const_iterator end()    const noexcept { return dense_.end(); }
+        [[nodiscard]] typename dense_container_t::const_iterator cbegin() const noexcept { return dense_.cbegin(); }
+        [[nodiscard]] typename dense_container_t::const_iterator cend()   const noexcept { return dense_.cend(); }
 
     private:
+        friend struct SnapshotAccess;
+
         /**
          * @brief Internal slot structure.
          *
@@ -317,10 +473,127 @@ namespace lux::cxx
             generation_t generation  = 1;
         };
 
-        std::vector<Slot>       slots_;           ///< Indirect slot array.
-        std::vector<Value>      dense_;            ///< Dense value storage.
-        std::vector<index_t> dense_to_slot_;    ///< Reverse map: dense index → slot index.
+        container_t<Slot>    slots_;            ///< Indirect slot array.
+        dense_container_t    dense_;            ///< Dense value storage.
+        container_t<index_t> dense_to_slot_;    ///< Reverse map: dense index → slot index.
         index_t              free_head_ = INVALID_INDEX; ///< Head of the free list.
+        size_t               tombstones_ = 0;                  ///< Pending deferred erasures.
+        index_t              first_tombstone_ = INVALID_INDEX; ///< Lowest tombstoned dense index.
+        bool                 deferred_erase_ = false;          ///< Whether erase() tombstones.
+
+        template <typename Self, typename Func>
+        static void for_each_impl(Self& self, Func& func)
+        {
+            const size_t n = self.dense_.size();
+            if (self.tombstones_ == 0)
+            {
+                for (size_t i = 0; i < n; ++i)
+                    func(self.dense_[i]);
+                return;
+            }
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (self.dense_to_slot_[i] != INVALID_INDEX)
+                    func(self.dense_[i]);
+            }
+        }
+
+        /**
+         * @brief Grows the arrays once so that @p n more elements fit.
+         *
+         * std::vector arrays keep geometric growth for repeated batches. Paged arrays
+         * never move elements on growth, so they reserve exactly what is needed
+         * instead of allocating pages ahead of use.
+         */
+        void reserve_additional(size_t n)
+        {
+            reserve_for(dense_, dense_.size() + n);
+            reserve_for(dense_to_slot_, dense_to_slot_.size() + n);
+            reserve_for(slots_, slots_.size() + n);
+        }
+
+        template <typename Container>
+        static void reserve_for(Container& c, size_t needed)
+        {
+            if (needed <= c.capacity())
+                return;
+            if constexpr (is_paged_vector_v<Container>)
+                c.reserve(needed);
+            else
+                c.reserve((std::max)(needed, c.capacity() * 2));
+        }
+
+        /**
+         * @brief Invalidates the slot @p slot_idx and pushes it onto the free list.
+         * @return The dense index the slot pointed to.
+         */
+        index_t release_slot(index_t slot_idx)
+        {
+            auto& slot = slots_[slot_idx];
+            const index_t dense_idx = slot.dense_index;
+            // Increment generation so stale handles are detected.
+            slot.generation++;
+            // Push this slot onto the free list.
+            slot.dense_index = free_head_;
+            free_head_ = slot_idx;
+            return dense_idx;
+        }
+
+        /**
+         * @brief Swap-and-pop removal of dense entry @p dense_idx.
+         */
+        void remove_dense(index_t dense_idx)
+        {
+            const index_t last_dense = static_cast<index_t>(dense_.size() - 1);
+            if (dense_idx != last_dense)
+            {
+                dense_[dense_idx] = std::move(dense_[last_dense]);
+                dense_to_slot_[dense_idx] = dense_to_slot_[last_dense];
+                // Update the swapped element's slot to point to the new dense position.
+                const index_t moved_slot = dense_to_slot_[dense_idx];
+                if (moved_slot != INVALID_INDEX)
+                    slots_[moved_slot].dense_index = dense_idx;
+                else
+                    first_tombstone_ = (std::min)(first_tombstone_, dense_idx);
+            }
+            dense_.pop_back();
+            dense_to_slot_.pop_back();
+        }
+
+        /**
+         * @brief Removes the tombstones at @p holes by moving live tail elements into them.
+         */
+        void fill_holes(const std::vector<index_t>& holes)
+        {
+            for (index_t hole : holes)
+            {
+                while (!dense_to_slot_.empty() && dense_to_slot_.back() == INVALID_INDEX)
+                {
+                    dense_.pop_back();
+                    dense_to_slot_.pop_back();
+                }
+                if (hole >= dense_.size())
+                    continue; // already popped off the tail
+                remove_dense(hole);
+            }
+            while (!dense_to_slot_.empty() && dense_to_slot_.back() == INVALID_INDEX)
+            {
+                dense_.pop_back();
+                dense_to_slot_.pop_back();
+            }
+            tombstones_      = 0;
+            first_tombstone_ = INVALID_INDEX;
+        }
+
+        /**
+         * @brief Marks dense entry @p dense_idx as erased without moving anything.
+         */
+        void tombstone(index_t dense_idx) noexcept
+        {
+            dense_to_slot_[dense_idx] = INVALID_INDEX;
+            ++tombstones_;
+            first_tombstone_ = (std::min)(first_tombstone_, dense_idx);
+        }
 
         /**
          * @brief Allocates a slot (from the free list or by growing) and
@@ -355,4 +628,10 @@ namespace lux::cxx
         }
     };
 
+    /**
+     * @brief SlotMap whose arrays grow page by page: no relocation on insert.
+     */
+    template <typename Value, typename Tag = void, std::size_t PageSize = 4096>
+    using PagedSlotMap = SlotMap<Value, Tag, std::uint32_t, std::uint32_t, PagedStoragePolicy<PageSize>>;
+
 } // namespace lux::cxx
@@ -8,14 +8,29 @@
  * elements in a fixed‑size internal buffer before falling back to heap
  * allocation.  The primary motivation is to eliminate heap traffic for small
  * sequences while still supporting dynamic growth. The implementation is
- * single‑header and has no dependencies beyond the C++ standard library.
+ * single‑header; beyond the C++ standard library it only needs the
+ * `is_trivially_relocatable` trait from lux::cxx::compile_time.
  *
  * Key properties:
  *  - **Small‑buffer optimisation** – the first `N` elements reside in an
  *    internal `std::byte` array; `N` defaults to 8.
- *  - **No allocator parameter** – memory is obtained via the global new/delete
- *    operators. This simplifies the implementation and matches the common use
- *    case where custom allocators are unnecessary.
+ *  - **Allocator aware** – heap storage comes from the `Allocator` parameter
+ *    (`std::allocator` by default, `lux::cxx::pmr::SmallVector` for
+ *    `std::pmr`). Elements are constructed in place; the allocator only
+ *    provides memory.
+ *  - **Pluggable growth** – the `GrowthPolicy` parameter chooses the next
+ *    capacity (power of two, geometric 1.5x or exact); reserve_exact()
+ *    bypasses it.
+ *  - **Relocation fast path** – when `lux::cxx::is_trivially_relocatable`
+ *    holds for `T` (trivially copyable types, `std::unique_ptr`,
+ *    `std::vector`, ...), growth, insert and erase move elements with
+ *    memcpy/memmove instead of move‑construct plus destroy.
+ *  - **Compact layout** – `CompactSmallVector` (the `CompactLayout` parameter)
+ *    stores 32‑bit size and capacity and overlaps the heap pointer with the
+ *    inline buffer, for containers held by the million.
+ *  - **realloc fast path** – with the default allocator and trivially
+ *    relocatable `T`, heap storage comes from malloc so that growing an
+ *    already spilled vector is a single `realloc`, often extended in place.
  *  - **Iterator invalidation** – any operation which modifies the container’s
  *    size or capacity invalidates all iterators and references, matching the
  *    behaviour of libc++ / MSVC `std::vector`.
@@ -30,14 +45,19 @@
  * @date 2025‑05‑18
  */
 
+#include <lux/cxx/compile_time/relocatable.hpp>
+
 #include <algorithm>
 #include <bit>          // std::bit_ceil
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>      // std::memcpy / std::memmove
+#include <cstdlib>      // std::malloc / std::realloc / std::free
 #include <initializer_list>
 #include <iterator>
 #include <memory>
+#include <memory_resource>
 #include <new>
 #include <stdexcept>
 #include <type_traits>
@@ -46,12 +66,149 @@
 
 namespace lux::cxx
 {
+    /**
+     * @brief SmallVector growth policy: double and round up to a power of two (default).
+     */
+    struct PowerOfTwoGrowth
+    {
+        static constexpr std::size_t next_capacity(std::size_t current, std::size_t required) noexcept
+        {
+            return std::bit_ceil(std::max(current * 2, required));
+        }
+    };
+
+    /**
+     * @brief SmallVector growth policy: grow by 1.5x, which lets freed blocks be reused
+     *        by later growth steps and wastes less memory than doubling.
+     */
+    struct GeometricGrowth
+    {
+        static constexpr std::size_t next_capacity(std::size_t current, std::size_t required) noexcept
+        {
+            return std::max(current + current / 2, required);
+        }
+    };
+
+    /**
+     * @brief SmallVector growth policy: allocate exactly what is required.
+     *
+     * Minimal memory, but repeated push_back becomes quadratic; use it for
+     * vectors that are sized once.
+     */
+    struct ExactGrowth
+    {
+        static constexpr std::size_t next_capacity(std::size_t, std::size_t required) noexcept
+        {
+            return required;
+        }
+    };
+
+    /**
+     * @brief SmallVector layout: data pointer, size and capacity as `std::size_t`
+     *        next to the inline buffer (default). data() is a plain load.
+     */
+    struct StandardLayout {};
+
+    /**
+     * @brief SmallVector layout for very many small instances.
+     *
+     * Size and capacity are 32‑bit and the heap pointer shares storage with the
+     * inline buffer; the top bit of the capacity word records which one is
+     * live. `CompactSmallVector<uint32_t, 4>` takes 24 bytes instead of 40, at
+     * the price of a branch in data() and at most 2^31 - 1 elements.
+     */
+    struct CompactLayout {};
+
+    namespace detail
+    {
+        template <class T, std::size_t N, class Layout>
+        class SmallVectorStorage;
+
+        /**
+         * @brief Inline buffer plus separate data pointer, size and capacity.
+         */
+        template <class T, std::size_t N>
+        class SmallVectorStorage<T, N, StandardLayout>
+        {
+        public:
+            static constexpr std::size_t max_capacity = static_cast<std::size_t>(-1) / sizeof(T);
+
+            SmallVectorStorage() noexcept = default;
+            SmallVectorStorage(const SmallVectorStorage&) = delete;
+            SmallVectorStorage& operator=(const SmallVectorStorage&) = delete;
+
+            [[nodiscard]] T*          data()        const noexcept { return _data; }
+            [[nodiscard]] std::size_t size()        const noexcept { return _size; }
+            [[nodiscard]] std::size_t capacity()    const noexcept { return _cap; }
+            [[nodiscard]] bool        on_heap()     const noexcept { return _data != inline_data(); }
+            [[nodiscard]] T*          inline_data() const noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(const_cast<std::byte*>(_buffer)));
+            }
+
+            void set_size(std::size_t n) noexcept { _size = n; }
+            void set_heap(T* p, std::size_t cap) noexcept { _data = p; _cap = cap; }
+            void set_inline() noexcept { _data = inline_data(); _cap = N; }
+
+        private:
+            alignas(T) std::byte _buffer[sizeof(T) * N]; //!< Inline element storage.
+            T*          _data = inline_data();            //!< Points to first element storage.
+            std::size_t _size = 0;                        //!< Number of constructed elements.
+            std::size_t _cap  = N;                        //!< Total capacity of @_data.
+        };
+
+        /**
+         * @brief Inline buffer overlapping the heap pointer; 32‑bit size and
+         *        capacity with a "heap" flag in the capacity's top bit.
+         */
+        template <class T, std::size_t N>
+        class SmallVectorStorage<T, N, CompactLayout>
+        {
+            static constexpr std::uint32_t kHeapBit = std::uint32_t{ 1 } << 31;
+            static_assert(N < kHeapBit, "CompactLayout: N must be below 2^31");
+
+        public:
+            static constexpr std::size_t max_capacity =
+                std::min<std::size_t>(kHeapBit - 1, static_cast<std::size_t>(-1) / sizeof(T));
+
+            SmallVectorStorage() noexcept {}
+            SmallVectorStorage(const SmallVectorStorage&) = delete;
+            SmallVectorStorage& operator=(const SmallVectorStorage&) = delete;
+
+            [[nodiscard]] T*          data()     const noexcept { return on_heap() ? _heap : inline_data(); }
+            [[nodiscard]] std::size_t size()     const noexcept { return _size; }
+            [[nodiscard]] std::size_t capacity() const noexcept { return on_heap() ? (_cap & ~kHeapBit) : N; }
+            [[nodiscard]] bool        on_heap()  const noexcept { return (_cap & kHeapBit) != 0; }
+            [[nodiscard]] T*          inline_data() const noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(const_cast<std::byte*>(_buffer)));
+            }
+
+            void set_size(std::size_t n) noexcept { _size = static_cast<std::uint32_t>(n); }
+            void set_heap(T* p, std::size_t cap) noexcept
+            {
+                _heap = p;
+                _cap = static_cast<std::uint32_t>(cap) | kHeapBit;
+            }
+            void set_inline() noexcept { _cap = static_cast<std::uint32_t>(N); }
+
+        private:
+            union
+            {
+                T*                        _heap;                //!< Heap block while on_heap().
+                alignas(T) std::byte      _buffer[sizeof(T) * N]; //!< Inline elements otherwise.
+            };
+            std::uint32_t _size = 0;                            //!< Number of constructed elements.
+            std::uint32_t _cap  = static_cast<std::uint32_t>(N); //!< Capacity | kHeapBit when on the heap.
+        };
+    } // namespace detail
+
     /**
      * @brief Contiguous container with *small‑buffer optimisation*.
      *
      * The template stores up to @p N objects of type @p T inside the object
-     * itself; once this capacity is exceeded additional storage is obtained via
-     * `operator new[]`. All operations have the same asymptotic complexity as
+     * itself; once this capacity is exceeded additional storage is obtained from
+     * @p Allocator. All operations have the same asymptotic complexity as
      * their `std::vector` counterparts. The class provides a pointer‑based
      * random‑access iterator satisfying the *contiguous_iterator* requirements
      * (C++20 [iterator.concept.contiguous]).
@@ -61,10 +218,12 @@ namespace lux::cxx
      * @tparam N Number of elements that fit into the internal stack buffer.
      *           Must be greater than zero. Choosing a power of two can give
      *           better padding / alignment but is not required.
-     *
-     * @note The container deliberately omits an allocator parameter. If you
-     *       need a custom allocator you should embed one in @p T or use
-     *       `std::vector` directly.
+     * @tparam Allocator    Allocator for heap storage (rebound to @p T). The usual
+     *                      propagate_on_container_* traits are honoured.
+     * @tparam GrowthPolicy PowerOfTwoGrowth, GeometricGrowth, ExactGrowth or any type
+     *                      with `static size_t next_capacity(size_t current, size_t required)`.
+     * @tparam Layout       StandardLayout, or CompactLayout to shrink the object header
+     *                      (see CompactSmallVector).
      *
      * @par Iterator invalidation
      * Any mutating operation (insert, erase, push_back, reserve, etc.) makes
@@ -73,7 +232,8 @@ namespace lux::cxx
      * as libc++ where even `push_back` without reallocation invalidates
      * iterators.
      */
-    template <class T, std::size_t N = 8>
+    template <class T, std::size_t N = 8, class Allocator = std::allocator<T>,
+              class GrowthPolicy = PowerOfTwoGrowth, class Layout = StandardLayout>
     class SmallVector
     {
         static_assert(N > 0, "SmallVector<N>: N must be greater than zero");
@@ -92,38 +252,40 @@ namespace lux::cxx
         using const_iterator = const value_type*; //!< Const iterator.
         using reverse_iterator = std::reverse_iterator<iterator>; //!< Reverse iterator.
         using const_reverse_iterator = std::reverse_iterator<const_iterator>; //!< Const reverse.
+        using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<T>; //!< Allocator.
+        using growth_policy = GrowthPolicy; //!< Capacity growth strategy.
+        using layout_type = Layout; //!< Object layout (StandardLayout or CompactLayout).
 
     private:                              // data & helpers
-        /// @brief Number of elements that the internal buffer can store.
-        static constexpr size_type kStackCapacity = N;
+        using alloc_traits = std::allocator_traits<allocator_type>;
 
         /**
-         * @brief Raw storage for @c kStackCapacity elements.
+         * @brief Whether heap storage is managed with malloc/realloc/free.
          *
-         * The buffer is suitably aligned for @p T. Lifetime of objects is
-         * managed manually via placement new and explicit destruction.
+         * Only with the default allocator (whose memory the user cannot observe)
+         * and for types that may be relocated with a byte copy.
          */
-        alignas(alignof(value_type))
-            std::byte _stack[sizeof(value_type) * kStackCapacity];
+        static constexpr bool kUseRealloc =
+            std::is_same_v<allocator_type, std::allocator<T>> &&
+            is_trivially_relocatable_v<T> &&
+            alignof(T) <= alignof(std::max_align_t);
 
-        /// @name Helper functions to convert the raw byte buffer to pointers.
-        ///@{
-        static pointer       stack_ptr(std::byte* p)       noexcept
-        {
-            return std::launder(reinterpret_cast<pointer>(p));
-        }
-        static const_pointer stack_ptr(const std::byte* p) noexcept
-        {
-            return std::launder(reinterpret_cast<const_pointer>(p));
-        }
-        ///@}
+        /// @brief Number of elements that the internal buffer can store.
+        static constexpr size_type kStackCapacity = N;
 
-        pointer   _data = stack_ptr(_stack); //!< Points to first element storage.
-        size_type _size = 0;                 //!< Number of constructed elements.
-        size_type _cap = kStackCapacity;    //!< Total capacity of @_data.
+        /**
+         * @brief Inline buffer for @c kStackCapacity elements plus the data
+         *        pointer, size and capacity, arranged according to @p Layout.
+         *
+         * Lifetime of objects is managed manually via placement new and
+         * explicit destruction.
+         */
+        using storage_type = detail::SmallVectorStorage<T, N, Layout>;
+        storage_type _store;
+        [[no_unique_address]] allocator_type _alloc; //!< Heap storage allocator.
 
         /// @brief Returns @c true if currently using the internal buffer.
-        [[nodiscard]] bool on_stack() const noexcept { return _data == stack_ptr(_stack); }
+        [[nodiscard]] bool on_stack() const noexcept { return !_store.on_heap(); }
 
         // ------------------------------------------------------------------
         //                         Allocation helpers
@@ -134,20 +296,39 @@ namespace lux::cxx
          * @return Pointer to raw storage (may be @c nullptr if @p n == 0).
          * @throw std::bad_alloc If allocation fails.
          */
-        [[nodiscard]] static pointer allocate(size_type n)
+        [[nodiscard]] pointer allocate(size_type n)
         {
-            return n ? static_cast<pointer>(
-                ::operator new[](n * sizeof(value_type),
-                    std::align_val_t{ alignof(value_type) }))
-                : nullptr;
+            if (!n) return nullptr;
+            if constexpr (kUseRealloc)
+            {
+                void* p = std::malloc(n * sizeof(value_type));
+                if (!p) throw std::bad_alloc();
+                return static_cast<pointer>(p);
+            }
+            else
+            {
+                return alloc_traits::allocate(_alloc, n);
+            }
         }
         /**
          * @brief Deallocate storage previously obtained via allocate().
          * @param p Pointer returned by allocate(); may be @c nullptr.
+         * @param n Capacity passed to allocate().
          */
-        static void deallocate(pointer p) noexcept
+        void deallocate(pointer p, size_type n) noexcept
         {
-            ::operator delete[](p, std::align_val_t{ alignof(value_type) });
+            if (!p) return;
+            if constexpr (kUseRealloc)
+                std::free(p);
+            else
+                alloc_traits::deallocate(_alloc, p, n);
+        }
+
+        /// @brief Frees the heap buffer (if any) and points back at the stack.
+        void release_heap() noexcept
+        {
+            if (!on_stack()) deallocate(data(), capacity());
+            _store.set_inline();
         }
 
         // ------------------------------------------------------------------
@@ -173,85 +354,116 @@ namespace lux::cxx
         /**
          * @brief Relocate existing elements to @p new_data.
          *
-         * The function moves or memcpy‑copies (when `std::is_trivially_copyable`
-         * is true) all currently constructed elements from @_data to the new
+         * The function moves or memcpy‑relocates (when `is_trivially_relocatable`
+         * is true) all currently constructed elements from @data() to the new
          * buffer and updates internal bookkeeping. On exception, strong
          * exception safety is provided – the original container remains
          * unchanged.
          *
-         * @param new_data Destination buffer (must be large enough for @c _size
+         * The source pointer and capacity are read up front: with
+         * CompactLayout, moving back into the inline buffer overwrites the
+         * stored heap pointer.
+         *
+         * @param new_data Destination buffer (must be large enough for size()
          *                 elements).
          * @param new_cap  Total capacity associated with @p new_data.
          */
         void relocate_to(pointer new_data, size_type new_cap)
         {
-            if (new_data == _data) return;   // Nothing to do.
-
-            if constexpr (std::is_trivially_copyable_v<value_type>)
+            const pointer   old_data = data();
+            const size_type old_cap  = capacity();
+            const size_type count    = size();
+            const bool      old_heap = !on_stack();
+            const bool      to_inline = new_data == _store.inline_data();
+            if (new_data == old_data) return;   // Nothing to do.
+
+            if constexpr (is_trivially_relocatable_v<value_type>)
             {
-                std::memcpy(new_data, _data, _size * sizeof(value_type));
+                trivially_relocate(old_data, old_data + count, new_data);
             }
             else
             {
                 size_type constructed = 0;
                 try
                 {
-                    for (; constructed < _size; ++constructed)
+                    for (; constructed < count; ++constructed)
                         new (new_data + constructed) value_type(
-                            std::move_if_noexcept(_data[constructed]));
+                            std::move_if_noexcept(old_data[constructed]));
                 }
                 catch (...)
                 {
                     destroy_range(new_data, new_data + constructed);
-                    deallocate(new_data);
+                    if (!to_inline) deallocate(new_data, new_cap);
+                    else if (old_heap) _store.set_heap(old_data, old_cap); // restore an overwritten pointer
                     throw;
                 }
+                destroy_range(old_data, old_data + count);
             }
 
-            destroy_range(_data, _data + _size);
-            if (!on_stack()) deallocate(_data);
+            if (old_heap) deallocate(old_data, old_cap);
 
-            _data = new_data;
-            _cap = new_cap;
+            if (to_inline) _store.set_inline();
+            else _store.set_heap(new_data, new_cap);
+        }
+
+        /**
+         * @brief Move the elements into a heap buffer of exactly @p new_cap elements.
+         *
+         * A heap‑to‑heap move uses `realloc` when kUseRealloc holds, so the
+         * allocator can extend the block in place instead of copying.
+         */
+        void reallocate(size_type new_cap)
+        {
+            if (new_cap > max_size())
+                throw std::length_error("SmallVector: capacity exceeds max_size()");
+            if constexpr (kUseRealloc)
+            {
+                if (!on_stack())
+                {
+                    void* p = std::realloc(static_cast<void*>(data()), new_cap * sizeof(value_type));
+                    if (!p) throw std::bad_alloc();
+                    _store.set_heap(static_cast<pointer>(p), new_cap);
+                    return;
+                }
+            }
+            relocate_to(allocate(new_cap), new_cap);
         }
 
         /**
          * @brief Grow capacity to at least @p min_cap preserving all elements.
          *
-         * New capacity doubles the current one and is rounded up to the next
-         * power of two when `std::bit_ceil` is available (C++20
-         * <bit> header). This growth strategy offers both good cache
-         * performance and low realloc frequency.
+         * The new capacity is chosen by @p GrowthPolicy (power‑of‑two doubling
+         * by default) and clamped to max_size().
+         * @throws std::length_error If @p min_cap exceeds max_size().
          */
         void grow(size_type min_cap)
         {
-            size_type new_cap = std::max(_cap * 2, min_cap);
-#if defined(__cpp_lib_bitops) && __cpp_lib_bitops >= 201907L
-            new_cap = std::bit_ceil(new_cap);               // power‑of‑two growth
-#endif
-            relocate_to(allocate(new_cap), new_cap);
+            if (min_cap > max_size())
+                throw std::length_error("SmallVector: capacity exceeds max_size()");
+            const size_type next = std::max(GrowthPolicy::next_capacity(capacity(), min_cap), min_cap);
+            reallocate(std::min(next, max_size()));
         }
 
         /**
          * @brief Create a hole of @p count elements starting at index @p idx.
          *
          * Internal helper used by insert/erase. Ensures capacity, shifts the
-         * tail, updates @_size and returns a pointer to the first gap slot
+         * tail, updates @size() and returns a pointer to the first gap slot
          * where new elements can be constructed.
          *
          * @return Pointer to the gap.
          */
         pointer make_gap(size_type idx, size_type count)
         {
-            if (_size + count > _cap) grow(_size + count);
+            if (size() + count > capacity()) grow(size() + count);
 
-            pointer pos = _data + idx;
-            size_type tail = _size - idx;
+            pointer pos = data() + idx;
+            size_type tail = size() - idx;
 
-            if constexpr (std::is_trivially_copyable_v<value_type>)
+            if constexpr (is_trivially_relocatable_v<value_type>)
             {
-                std::memmove(pos + count, pos, tail * sizeof(value_type));
-                _size += count;
+                trivially_relocate(pos, pos + tail, pos + count);
+                _store.set_size(size() + count);
                 return pos;
             }
             else
@@ -261,7 +473,7 @@ namespace lux::cxx
                 {
                     while (moved < tail)
                     {
-                        pointer src = _data + _size - 1 - moved;
+                        pointer src = data() + size() - 1 - moved;
                         pointer dst = src + count;
                         new (dst) value_type(std::move_if_noexcept(*src));
                         ++moved;
@@ -269,16 +481,28 @@ namespace lux::cxx
                 }
                 catch (...)
                 {
-                    destroy_range(_data + _size - moved + count,
-                        _data + _size + count);
+                    destroy_range(data() + size() - moved + count,
+                        data() + size() + count);
                     throw;
                 }
                 destroy_range(pos, pos + tail);
-                _size += count;
+                _store.set_size(size() + count);
                 return pos;
             }
         }
 
+        /**
+         * @brief Undo make_gap() after constructing into the gap failed.
+         *
+         * Only used for trivially relocatable types, where shifting the tail
+         * back cannot throw.
+         */
+        void close_gap(pointer pos, size_type count) noexcept
+        {
+            trivially_relocate(pos + count, data() + size(), pos);
+            _store.set_size(size() - count);
+        }
+
         /**
          * @brief Detects whether an iterator originates from *this* container.
          *
@@ -290,7 +514,7 @@ namespace lux::cxx
         [[nodiscard]] bool from_self(It it) const noexcept
         {
             if constexpr (std::is_pointer_v<It>)
-                return it >= _data && it < _data + _size;
+                return it >= data() && it < data() + size();
             else
                 return false;
         }
@@ -303,20 +527,30 @@ namespace lux::cxx
          /**
           * @brief Default‑constructs an empty vector with capacity @c N.
           */
-        SmallVector() noexcept = default;
+        SmallVector() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) = default;
+
+        /**
+         * @brief Constructs an empty vector that allocates from @p alloc.
+         */
+        explicit SmallVector(const allocator_type& alloc) noexcept
+            : _alloc(alloc) {
+        }
 
         /**
          * @brief Constructs the vector with @p count copies of @p value.
          * @param count Number of elements.
          * @param value Value to copy into each element (defaults to
          *              `value_type{}`).
+         * @param alloc Allocator for heap storage.
          * @throws std::bad_alloc On allocation failure.
          */
-        explicit SmallVector(size_type count, const_reference value = value_type{})
+        explicit SmallVector(size_type count, const_reference value = value_type{},
+                             const allocator_type& alloc = allocator_type())
+            : _alloc(alloc)
         {
-            if (count > _cap) grow(count);
-            std::uninitialized_fill_n(_data, count, value);
-            _size = count;
+            if (count > capacity()) grow(count);
+            std::uninitialized_fill_n(data(), count, value);
+            _store.set_size(count);
         }
 
         /**
@@ -332,21 +566,28 @@ namespace lux::cxx
          */
         template <class InputIt,
             class = std::enable_if_t<!std::is_integral_v<InputIt>>>
-        SmallVector(InputIt first, InputIt last) { assign(first, last); }
+        SmallVector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : _alloc(alloc) {
+            assign(first, last);
+        }
 
         /**
          * @brief Initialiser‑list constructor.
          * @param il List of elements.
+         * @param alloc Allocator for heap storage.
          */
-        SmallVector(std::initializer_list<value_type> il)
-            : SmallVector(il.begin(), il.end()) {
+        SmallVector(std::initializer_list<value_type> il, const allocator_type& alloc = allocator_type())
+            : SmallVector(il.begin(), il.end(), alloc) {
         }
 
         /**
          * @brief Copy constructor – performs deep copy.
+         *
+         * The allocator is obtained via `select_on_container_copy_construction`.
          */
         SmallVector(const SmallVector& other)
-            : SmallVector(other.begin(), other.end()) {
+            : SmallVector(other.begin(), other.end(),
+                alloc_traits::select_on_container_copy_construction(other._alloc)) {
         }
 
         /**
@@ -357,23 +598,31 @@ namespace lux::cxx
          * stack buffer.
          */
         SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : _alloc(std::move(other._alloc))
         {
             if (other.on_stack())
             {
-                reserve(other._size);
-                std::uninitialized_move(other.begin(), other.end(), _data);
-                _size = other._size;
-                other.clear();
+                reserve(other.size());
+                if constexpr (is_trivially_relocatable_v<value_type>)
+                {
+                    trivially_relocate(other.data(), other.data() + other.size(), data());
+                    _store.set_size(other.size());
+                    other._store.set_size(0);
+                }
+                else
+                {
+                    std::uninitialized_move(other.begin(), other.end(), data());
+                    _store.set_size(other.size());
+                    other.clear();
+                }
             }
             else
             {
-                _data = other._data;
-                _size = other._size;
-                _cap = other._cap;
+                _store.set_heap(other.data(), other.capacity());
+                _store.set_size(other.size());
 
-                other._data = stack_ptr(other._stack);
-                other._size = 0;
-                other._cap = kStackCapacity;
+                other._store.set_inline();
+                other._store.set_size(0);
             }
         }
 
@@ -381,7 +630,7 @@ namespace lux::cxx
         ~SmallVector() noexcept
         {
             clear();
-            if (!on_stack()) deallocate(_data);
+            if (!on_stack()) deallocate(data(), capacity());
         }
         ///@}
 
@@ -394,38 +643,73 @@ namespace lux::cxx
          */
         SmallVector& operator=(const SmallVector& rhs)
         {
-            if (this != &rhs) assign(rhs.begin(), rhs.end());
+            if (this == &rhs) return *this;
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                if (_alloc != rhs._alloc)
+                {
+                    clear();
+                    release_heap();
+                }
+                _alloc = rhs._alloc;
+            }
+            assign(rhs.begin(), rhs.end());
             return *this;
         }
         /**
-         * @brief Move‑assigns from @p rhs providing strong exception safety.
+         * @brief Move‑assigns from @p rhs.
+         *
+         * Heap storage is stolen when the allocator propagates or compares
+         * equal; otherwise the elements are moved one by one into storage from
+         * this vector's allocator. That buffer is allocated before anything is
+         * destroyed, so a failed allocation leaves *this unchanged; if moving an
+         * element throws, *this is left empty (basic guarantee).
          * @return *this.
          */
-        SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_assignable_v<T>)
+        SmallVector& operator=(SmallVector&& rhs) noexcept(
+            (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+            && std::is_nothrow_move_constructible_v<T>)
         {
             if (this == &rhs) return *this;
 
-            clear();
-            if (!on_stack()) deallocate(_data);
-
-            if (rhs.on_stack())
+            constexpr bool propagate = alloc_traits::propagate_on_container_move_assignment::value;
+            if (rhs.on_stack() || (!propagate && _alloc != rhs._alloc))
             {
-                _data = stack_ptr(_stack);
-                _cap = kStackCapacity;
-                reserve(rhs._size);
-                std::uninitialized_move(rhs.begin(), rhs.end(), _data);
-                _size = rhs._size;
-                rhs.clear();
+                if (rhs.size() > capacity())
+                {
+                    pointer fresh = allocate(rhs.size());
+                    clear();
+                    release_heap();
+                    _store.set_heap(fresh, rhs.size());
+                }
+                else
+                {
+                    clear();
+                }
+                if constexpr (is_trivially_relocatable_v<value_type>)
+                {
+                    trivially_relocate(rhs.data(), rhs.data() + rhs.size(), data());
+                    _store.set_size(rhs.size());
+                    rhs._store.set_size(0);
+                }
+                else
+                {
+                    std::uninitialized_move(rhs.begin(), rhs.end(), data());
+                    _store.set_size(rhs.size());
+                    rhs.clear();
+                }
             }
             else
             {
-                _data = rhs._data;
-                _size = rhs._size;
-                _cap = rhs._cap;
+                clear();
+                release_heap();
+                if constexpr (propagate) _alloc = std::move(rhs._alloc);
+
+                _store.set_heap(rhs.data(), rhs.capacity());
+                _store.set_size(rhs.size());
 
-                rhs._data = stack_ptr(rhs._stack);
-                rhs._size = 0;
-                rhs._cap = kStackCapacity;
+                rhs._store.set_inline();
+                rhs._store.set_size(0);
             }
             return *this;
         }
@@ -471,8 +755,8 @@ namespace lux::cxx
         /**
          * @name Element access
          *///@{
-        reference       operator[](size_type i) { return _data[i]; }
-        const_reference operator[](size_type i) const { return _data[i]; }
+        reference       operator[](size_type i) { return data()[i]; }
+        const_reference operator[](size_type i) const { return data()[i]; }
 
         /**
          * @brief Bounds‑checked element access.
@@ -480,37 +764,37 @@ namespace lux::cxx
          */
         reference at(size_type i)
         {
-            if (i >= _size)
+            if (i >= size())
                 throw std::out_of_range("SmallVector::at");
-            return _data[i];
+            return data()[i];
         }
         /** @copydoc at(size_type) */
         const_reference at(size_type i) const
         {
-            if (i >= _size)
+            if (i >= size())
                 throw std::out_of_range("SmallVector::at");
-            return _data[i];
+            return data()[i];
         }
 
-        reference       front() { assert(!empty()); return *_data; }
-        const_reference front() const { assert(!empty()); return *_data; }
-        reference       back() { assert(!empty()); return _data[_size - 1]; }
-        const_reference back()  const { assert(!empty()); return _data[_size - 1]; }
+        reference       front() { assert(!empty()); return *data(); }
+        const_reference front() const { assert(!empty()); return *data(); }
+        reference       back() { assert(!empty()); return data()[size() - 1]; }
+        const_reference back()  const { assert(!empty()); return data()[size() - 1]; }
 
-        pointer         data() noexcept { return _data; }
-        const_pointer   data() const noexcept { return _data; }
+        pointer         data() noexcept { return _store.data(); }
+        const_pointer   data() const noexcept { return _store.data(); }
         ///@}
 
         // ------------------------------------------------------------------
         //                                Iterators
         // ------------------------------------------------------------------
-        iterator               begin() noexcept { return _data; }
-        const_iterator         begin() const noexcept { return _data; }
-        const_iterator         cbegin() const noexcept { return _data; }
+        iterator               begin() noexcept { return data(); }
+        const_iterator         begin() const noexcept { return data(); }
+        const_iterator         cbegin() const noexcept { return data(); }
 
-        iterator               end() noexcept { return _data + _size; }
-        const_iterator         end() const noexcept { return _data + _size; }
-        const_iterator         cend() const noexcept { return _data + _size; }
+        iterator               end() noexcept { return data() + size(); }
+        const_iterator         end() const noexcept { return data() + size(); }
+        const_iterator         cend() const noexcept { return data() + size(); }
 
         reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
         const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
@@ -523,21 +807,33 @@ namespace lux::cxx
         // ------------------------------------------------------------------
         //                               Capacity
         // ------------------------------------------------------------------
-        [[nodiscard]] bool      empty()    const noexcept { return _size == 0; }
-        [[nodiscard]] size_type size()     const noexcept { return _size; }
-        [[nodiscard]] size_type capacity() const noexcept { return _cap; }
+        [[nodiscard]] bool      empty()    const noexcept { return size() == 0; }
+        [[nodiscard]] size_type size()     const noexcept { return _store.size(); }
+        [[nodiscard]] size_type capacity() const noexcept { return _store.capacity(); }
         [[nodiscard]] size_type max_size() const noexcept
         {
-            return static_cast<size_type>(-1) / sizeof(value_type);
+            return storage_type::max_capacity;
         }
 
+        /// @brief Returns a copy of the allocator.
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return _alloc; }
+
         /**
          * @brief Ensures the container can hold at least @p new_cap elements
-         *        without reallocation.
+         *        without reallocation. The capacity is chosen by @p GrowthPolicy.
          */
         void reserve(size_type new_cap)
         {
-            if (new_cap > _cap) relocate_to(allocate(new_cap), new_cap);
+            if (new_cap > capacity()) grow(new_cap);
+        }
+
+        /**
+         * @brief Ensures capacity for @p new_cap elements, allocating exactly
+         *        @p new_cap when growth is needed (ignores @p GrowthPolicy).
+         */
+        void reserve_exact(size_type new_cap)
+        {
+            if (new_cap > capacity()) reallocate(new_cap);
         }
 
         /**
@@ -549,10 +845,10 @@ namespace lux::cxx
          */
         void shrink_to_fit()
         {
-            if (_size <= kStackCapacity && !on_stack())
-                relocate_to(stack_ptr(_stack), kStackCapacity);
-            else if (_size < _cap && _size > kStackCapacity)
-                relocate_to(allocate(_size), _size);
+            if (size() <= kStackCapacity && !on_stack())
+                relocate_to(_store.inline_data(), kStackCapacity);
+            else if (size() < capacity() && size() > kStackCapacity)
+                reallocate(size());
         }
 
         // ------------------------------------------------------------------
@@ -564,8 +860,8 @@ namespace lux::cxx
          */
         void clear() noexcept
         {
-            destroy_range(_data, _data + _size);
-            _size = 0;
+            destroy_range(data(), data() + size());
+            _store.set_size(0);
         }
 
         // ------------------------------ assign --------------------------------
@@ -586,9 +882,9 @@ namespace lux::cxx
             if constexpr (std::is_base_of_v<std::forward_iterator_tag, cat>)
             {
                 size_type cnt = static_cast<size_type>(std::distance(first, last));
-                if (cnt > _cap) reserve(cnt);
-                std::uninitialized_copy(first, last, _data);
-                _size = cnt;
+                if (cnt > capacity()) reserve_exact(cnt);
+                std::uninitialized_copy(first, last, data());
+                _store.set_size(cnt);
             }
             else           // Single‑pass InputIterator
             {
@@ -601,9 +897,9 @@ namespace lux::cxx
         void assign(size_type count, const_reference value)
         {
             clear();
-            if (count > _cap) reserve(count);
-            std::uninitialized_fill_n(_data, count, value);
-            _size = count;
+            if (count > capacity()) reserve_exact(count);
+            std::uninitialized_fill_n(data(), count, value);
+            _store.set_size(count);
         }
 
         // ------------------------------ resize --------------------------------
@@ -612,16 +908,16 @@ namespace lux::cxx
          */
         void resize(size_type count)
         {
-            if (count < _size)
+            if (count < size())
             {
-                destroy_range(_data + count, _data + _size);
-                _size = count;
+                destroy_range(data() + count, data() + size());
+                _store.set_size(count);
             }
-            else if (count > _size)
+            else if (count > size())
             {
                 reserve(count);
-                std::uninitialized_default_construct_n(_data + _size, count - _size);
-                _size = count;
+                std::uninitialized_default_construct_n(data() + size(), count - size());
+                _store.set_size(count);
             }
         }
         /**
@@ -629,14 +925,14 @@ namespace lux::cxx
          */
         void resize(size_type count, const_reference value)
         {
-            if (count < _size)
-                destroy_range(_data + count, _data + _size);
+            if (count < size())
+                destroy_range(data() + count, data() + size());
             else
             {
                 reserve(count);
-                std::uninitialized_fill_n(_data + _size, count - _size, value);
+                std::uninitialized_fill_n(data() + size(), count - size(), value);
             }
-            _size = count;
+            _store.set_size(count);
         }
 
         // ------------------------------ erase ---------------------------------
@@ -647,17 +943,22 @@ namespace lux::cxx
         iterator erase(const_iterator pos)
         {
             difference_type idx = pos - cbegin();
-            if (idx < 0 || static_cast<size_type>(idx) >= _size)
+            if (idx < 0 || static_cast<size_type>(idx) >= size())
                 throw std::out_of_range("SmallVector::erase");
 
-            pointer p = _data + idx;
-            if constexpr (std::is_trivially_copyable_v<value_type>)
-                std::memmove(p, p + 1, (_size - idx - 1) * sizeof(value_type));
+            pointer p = data() + idx;
+            if constexpr (is_trivially_relocatable_v<value_type>)
+            {
+                destroy_range(p, p + 1);
+                trivially_relocate(p + 1, data() + size(), p);
+                _store.set_size(size() - 1);
+            }
             else
-                std::move(p + 1, _data + _size, p);
-
-            --_size;
-            destroy_range(_data + _size, _data + _size + 1);
+            {
+                std::move(p + 1, data() + size(), p);
+                _store.set_size(size() - 1);
+                destroy_range(data() + size(), data() + size() + 1);
+            }
             return p;
         }
 
@@ -672,6 +973,11 @@ namespace lux::cxx
 
             if constexpr (std::is_trivially_copyable_v<value_type>)
                 std::memcpy(p, &value, sizeof(value_type));
+            else if constexpr (is_trivially_relocatable_v<value_type>)
+            {
+                try { new (p) value_type(value); }
+                catch (...) { close_gap(p, 1); throw; }
+            }
             else
                 new (p) value_type(value);
 
@@ -699,7 +1005,13 @@ namespace lux::cxx
                 size_type cnt = static_cast<size_type>(std::distance(first, last));
                 if (!cnt) return;
                 pointer p = make_gap(idx, cnt);
-                std::uninitialized_copy(first, last, p);
+                if constexpr (is_trivially_relocatable_v<value_type>)
+                {
+                    try { std::uninitialized_copy(first, last, p); }
+                    catch (...) { close_gap(p, cnt); throw; }
+                }
+                else
+                    std::uninitialized_copy(first, last, p);
             }
             else   // Single‑pass InputIterator
             {
@@ -720,10 +1032,10 @@ namespace lux::cxx
         template <class... Args>
         reference emplace_back(Args&&... args)
         {
-            if (_size == _cap) grow(_size + 1);
-            pointer loc = _data + _size;
+            if (size() == capacity()) grow(size() + 1);
+            pointer loc = data() + size();
             new (loc) value_type(std::forward<Args>(args)...);
-            ++_size;
+            _store.set_size(size() + 1);
             return *loc;
         }
         /// @copydoc emplace_back
@@ -737,8 +1049,8 @@ namespace lux::cxx
         void pop_back()
         {
             assert(!empty());
-            --_size;
-            destroy_range(_data + _size, _data + _size + 1);
+            _store.set_size(size() - 1);
+            destroy_range(data() + size(), data() + size() + 1);
         }
 
         // ------------------------------ swap ---------------------------------
@@ -756,52 +1068,60 @@ namespace lux::cxx
 
             bool self_heap = !on_stack();
             bool other_heap = !other.on_stack();
+            constexpr bool propagate = alloc_traits::propagate_on_container_swap::value;
 
-            if (self_heap && other_heap)            // Fast path – just pointers.
+            if (self_heap && other_heap && (propagate || _alloc == other._alloc)) // Fast path – just pointers.
             {
                 using std::swap;
-                swap(_data, other._data);
-                swap(_size, other._size);
-                swap(_cap, other._cap);
+                if constexpr (propagate) swap(_alloc, other._alloc);
+                const pointer   p = data();
+                const size_type s = size();
+                const size_type c = capacity();
+                _store.set_heap(other.data(), other.capacity());
+                _store.set_size(other.size());
+                other._store.set_heap(p, c);
+                other._store.set_size(s);
                 return;
             }
 
             // Element‑wise swap when each side fits into the other's capacity.
-            if (_size <= other._cap && other._size <= _cap)
+            if (size() <= other.capacity() && other.size() <= capacity())
             {
-                size_type min_sz = std::min(_size, other._size);
+                size_type min_sz = std::min(size(), other.size());
                 for (size_type i = 0; i < min_sz; ++i)
-                    std::swap(_data[i], other._data[i]);
+                    std::swap(data()[i], other.data()[i]);
 
-                if (_size > other._size)
+                if (size() > other.size())
                 {
-                    size_type diff = _size - other._size;
-                    pointer src = _data + min_sz;
+                    size_type diff = size() - other.size();
+                    pointer src = data() + min_sz;
 
-                    if constexpr (std::is_trivially_copyable_v<value_type>)
-                        std::memcpy(other._data + other._size,
-                            src, diff * sizeof(value_type));
+                    if constexpr (is_trivially_relocatable_v<value_type>)
+                        trivially_relocate(src, src + diff, other.data() + other.size());
                     else
+                    {
                         std::uninitialized_move(src, src + diff,
-                            other._data + other._size);
-
-                    destroy_range(src, src + diff);
+                            other.data() + other.size());
+                        destroy_range(src, src + diff);
+                    }
                 }
-                else if (other._size > _size)
+                else if (other.size() > size())
                 {
-                    size_type diff = other._size - _size;
-                    pointer src = other._data + min_sz;
+                    size_type diff = other.size() - size();
+                    pointer src = other.data() + min_sz;
 
-                    if constexpr (std::is_trivially_copyable_v<value_type>)
-                        std::memcpy(_data + _size,
-                            src, diff * sizeof(value_type));
+                    if constexpr (is_trivially_relocatable_v<value_type>)
+                        trivially_relocate(src, src + diff, data() + size());
                     else
+                    {
                         std::uninitialized_move(src, src + diff,
-                            _data + _size);
-
-                    destroy_range(src, src + diff);
+                            data() + size());
+                        destroy_range(src, src + diff);
+                    }
                 }
-                std::swap(_size, other._size);
+                const size_type s = size();
+                _store.set_size(other.size());
+                other._store.set_size(s);
                 return;
             }
 
@@ -836,4 +1156,20 @@ namespace lux::cxx
         class T = typename std::iterator_traits<InputIt>::value_type>
     SmallVector(InputIt, InputIt) -> SmallVector<T>;
 
+    /**
+     * @brief SmallVector with CompactLayout: 32‑bit size/capacity and no data
+     *        pointer while the elements are inline.
+     */
+    template <class T, std::size_t N = 8, class Allocator = std::allocator<T>, class GrowthPolicy = PowerOfTwoGrowth>
+    using CompactSmallVector = SmallVector<T, N, Allocator, GrowthPolicy, CompactLayout>;
+
+    namespace pmr
+    {
+        /**
+         * @brief SmallVector whose heap storage comes from a `std::pmr::memory_resource`.
+         */
+        template <class T, std::size_t N = 8, class GrowthPolicy = PowerOfTwoGrowth, class Layout = StandardLayout>
+        using SmallVector = ::lux::cxx::SmallVector<T, N, std::pmr::polymorphic_allocator<T>, GrowthPolicy, Layout>;
+    } // namespace pmr
+
 } // namespace lux::cxx
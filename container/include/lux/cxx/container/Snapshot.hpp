@@ -0,0 +1,806 @@
+#pragma once
+/**
+ * @file Snapshot.hpp
+ * @brief Binary snapshots of SlotMap and OffsetSparseSet, and zero-copy read-only
+ *        views that serve lookups straight from a memory-mapped snapshot file.
+ *
+ * @copyright
+ * Copyright (c) 2025 Chenhui Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <lux/cxx/container/SlotMap.hpp>
+#include <lux/cxx/container/SparseSet.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace lux::cxx
+{
+    /*
+     * File layout (native endianness, checked on load):
+     *
+     *   SnapshotHeader                 magic, version, container kind, element/key sizes,
+     *                                  element count and a table of up to 3 sections
+     *   [padding to 64 bytes]
+     *   section 0 raw bytes            SlotMap: slots_       SparseSet: sparse_
+     *   [padding to 64 bytes]
+     *   section 1 raw bytes            SlotMap: dense_       SparseSet: dense_keys_
+     *   [padding to 64 bytes]
+     *   section 2 raw bytes            SlotMap: dense_to_slot_  SparseSet: dense_values_
+     *
+     * Every section starts at a 64-byte aligned file offset, so a mapping of the file
+     * (page aligned) can be read in place as typed arrays. OrthTreeSnapshot.hpp stores
+     * trees in the same frame.
+     */
+    namespace detail
+    {
+        inline constexpr std::array<char, 8> kSnapshotMagic   = { 'L', 'U', 'X', 'S', 'N', 'A', 'P', '\0' };
+        inline constexpr std::uint32_t       kSnapshotVersion = 1;
+        inline constexpr std::uint32_t       kSnapshotEndian  = 0x01020304u;
+        inline constexpr std::size_t         kSnapshotAlign   = 64;
+
+        enum class SnapshotKind : std::uint32_t
+        {
+            SlotMap   = 1,
+            SparseSet = 2,
+            Orthtree  = 3,
+        };
+
+        struct SnapshotSection
+        {
+            std::uint64_t offset = 0; ///< Byte offset from the start of the snapshot.
+            std::uint64_t bytes  = 0; ///< Section length in bytes.
+        };
+
+        struct SnapshotHeader
+        {
+            std::array<char, 8> magic = kSnapshotMagic;
+            std::uint32_t version     = kSnapshotVersion;
+            std::uint32_t kind        = 0;
+            std::uint32_t endian      = kSnapshotEndian;
+            std::uint32_t value_size  = 0;
+            std::uint32_t value_align = 0;
+            std::uint32_t key_size    = 0; ///< SlotMap: IndexType, SparseSet: Key, Orthtree: Dim.
+            std::uint32_t aux_size    = 0; ///< SlotMap: GenerationType, SparseSet: SparseIndex, Orthtree: Scalar.
+            std::uint32_t reserved    = 0;
+            std::uint64_t aux         = 0; ///< SlotMap: free-list head, SparseSet: Offset, Orthtree: position bits.
+            std::uint64_t size        = 0; ///< Number of elements.
+            std::array<SnapshotSection, 3> sections{};
+        };
+
+        static_assert(std::is_trivially_copyable_v<SnapshotHeader>);
+
+        /**
+         * @brief On-disk layout of a SlotMap slot (mirrors SlotMap::Slot).
+         */
+        template <typename IndexType, typename GenerationType>
+        struct SnapshotSlot
+        {
+            IndexType      dense_index;
+            GenerationType generation;
+        };
+
+        constexpr std::uint64_t snapshot_align_up(std::uint64_t n) noexcept
+        {
+            return (n + kSnapshotAlign - 1) & ~static_cast<std::uint64_t>(kSnapshotAlign - 1);
+        }
+
+        /**
+         * @brief Lays out sections of @p bytes lengths behind @p header and writes them to @p os.
+         *
+         * @p write_section(i) is called once per section, in order, and must write exactly
+         * @p bytes[i] bytes; it lets callers stream sections they do not hold in memory.
+         */
+        template <typename WriteSection>
+        void write_snapshot_sections(std::ostream& os, SnapshotHeader header,
+                                     const std::array<std::uint64_t, 3>& bytes, WriteSection&& write_section)
+        {
+            std::uint64_t pos = sizeof(SnapshotHeader);
+            for (std::size_t i = 0; i < bytes.size(); ++i)
+            {
+                pos = snapshot_align_up(pos);
+                header.sections[i] = { pos, bytes[i] };
+                pos += bytes[i];
+            }
+
+            static constexpr std::array<char, kSnapshotAlign> zeros{};
+            os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            pos = sizeof(header);
+            for (std::size_t i = 0; i < bytes.size(); ++i)
+            {
+                os.write(zeros.data(), static_cast<std::streamsize>(header.sections[i].offset - pos));
+                write_section(i);
+                pos = header.sections[i].offset + bytes[i];
+            }
+            if (!os)
+                throw std::runtime_error("snapshot: write failed");
+        }
+
+        /**
+         * @brief Lays out @p sections behind @p header and writes everything to @p os.
+         */
+        inline void write_snapshot(std::ostream& os, const SnapshotHeader& header,
+                                   const std::array<std::span<const std::byte>, 3>& sections)
+        {
+            write_snapshot_sections(os, header, { sections[0].size(), sections[1].size(), sections[2].size() },
+                [&](std::size_t i) {
+                    os.write(reinterpret_cast<const char*>(sections[i].data()), static_cast<std::streamsize>(sections[i].size()));
+                });
+        }
+
+        /**
+         * @brief Throws unless @p actual was written for the container described by @p expected.
+         */
+        inline void check_snapshot_header(const SnapshotHeader& actual, const SnapshotHeader& expected)
+        {
+            if (actual.magic != kSnapshotMagic)
+                throw std::runtime_error("snapshot: bad magic");
+            if (actual.version != kSnapshotVersion)
+                throw std::runtime_error("snapshot: unsupported version");
+            if (actual.endian != kSnapshotEndian)
+                throw std::runtime_error("snapshot: endianness mismatch");
+            if (actual.kind != expected.kind)
+                throw std::runtime_error("snapshot: container kind mismatch");
+            if (actual.value_size != expected.value_size || actual.value_align != expected.value_align ||
+                actual.key_size != expected.key_size || actual.aux_size != expected.aux_size)
+                throw std::runtime_error("snapshot: element layout mismatch");
+        }
+
+        /**
+         * @brief Reads and validates a header from @p is.
+         */
+        inline SnapshotHeader read_snapshot_header(std::istream& is, const SnapshotHeader& expected)
+        {
+            SnapshotHeader header;
+            if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)))
+                throw std::runtime_error("snapshot: truncated header");
+            check_snapshot_header(header, expected);
+            return header;
+        }
+
+        /**
+         * @brief Reads section @p section into @p dst, skipping the padding before it.
+         * @param pos Current stream position relative to the snapshot start; advanced.
+         */
+        inline void read_snapshot_section(std::istream& is, std::uint64_t& pos,
+                                          const SnapshotSection& section, void* dst)
+        {
+            if (section.offset < pos)
+                throw std::runtime_error("snapshot: overlapping sections");
+            is.ignore(static_cast<std::streamsize>(section.offset - pos));
+            if (!is.read(static_cast<char*>(dst), static_cast<std::streamsize>(section.bytes)))
+                throw std::runtime_error("snapshot: truncated section");
+            pos = section.offset + section.bytes;
+        }
+
+        /**
+         * @brief Validates a header in memory and returns the typed array of section @p i.
+         */
+        template <typename T>
+        std::span<const T> snapshot_section(std::span<const std::byte> bytes, const SnapshotHeader& header, std::size_t i)
+        {
+            const SnapshotSection& section = header.sections[i];
+            if (section.offset > bytes.size() || section.bytes > bytes.size() - section.offset)
+                throw std::runtime_error("snapshot: section out of bounds");
+            if (section.bytes % sizeof(T) != 0)
+                throw std::runtime_error("snapshot: section size mismatch");
+            const std::byte* p = bytes.data() + section.offset;
+            if (reinterpret_cast<std::uintptr_t>(p) % alignof(T) != 0)
+                throw std::runtime_error("snapshot: misaligned section");
+            return { reinterpret_cast<const T*>(p), static_cast<std::size_t>(section.bytes / sizeof(T)) };
+        }
+
+        inline SnapshotHeader parse_snapshot_header(std::span<const std::byte> bytes, const SnapshotHeader& expected)
+        {
+            if (bytes.size() < sizeof(SnapshotHeader))
+                throw std::runtime_error("snapshot: truncated header");
+            SnapshotHeader header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            check_snapshot_header(header, expected);
+            return header;
+        }
+
+        template <typename T>
+        std::span<const std::byte> as_section(const T* data, std::size_t count) noexcept
+        {
+            return { reinterpret_cast<const std::byte*>(data), count * sizeof(T) };
+        }
+
+        /**
+         * @brief Returns the length of the snapshot being read from @p is, of which
+         *        @p consumed bytes were already read, or the maximum if @p is cannot seek.
+         */
+        inline std::uint64_t snapshot_stream_size(std::istream& is, std::uint64_t consumed)
+        {
+            const auto here = is.tellg();
+            if (here == std::istream::pos_type(-1))
+                return (std::numeric_limits<std::uint64_t>::max)();
+            is.seekg(0, std::ios::end);
+            const auto end = is.tellg();
+            is.clear();
+            is.seekg(here);
+            if (end == std::istream::pos_type(-1) || end < here)
+                return (std::numeric_limits<std::uint64_t>::max)();
+            return consumed + static_cast<std::uint64_t>(end - here);
+        }
+
+        /**
+         * @brief Returns the element count of @p section after checking that it fits in
+         *        a snapshot of @p available bytes, so a crafted length cannot force a huge allocation.
+         */
+        template <typename T>
+        std::size_t snapshot_section_count(const SnapshotSection& section, std::uint64_t available)
+        {
+            if (section.offset > available || section.bytes > available - section.offset)
+                throw std::runtime_error("snapshot: section out of bounds");
+            if (section.bytes % sizeof(T) != 0)
+                throw std::runtime_error("snapshot: section size mismatch");
+            if (section.bytes / sizeof(T) > (std::numeric_limits<std::size_t>::max)())
+                throw std::runtime_error("snapshot: section too large");
+            return static_cast<std::size_t>(section.bytes / sizeof(T));
+        }
+    } // namespace detail
+
+    /**
+     * @brief Grants the snapshot functions and views access to container internals.
+     */
+    struct SnapshotAccess
+    {
+        // ---- SlotMap --------------------------------------------------------
+
+        template <typename Value, typename Tag, typename IndexType, typename GenerationType>
+        static detail::SnapshotHeader slot_map_header()
+        {
+            detail::SnapshotHeader h;
+            h.kind        = static_cast<std::uint32_t>(detail::SnapshotKind::SlotMap);
+            h.value_size  = sizeof(Value);
+            h.value_align = alignof(Value);
+            h.key_size    = sizeof(IndexType);
+            h.aux_size    = sizeof(GenerationType);
+            return h;
+        }
+
+        template <typename Value, typename Tag, typename IndexType, typename GenerationType>
+        static void save(std::ostream& os, const SlotMap<Value, Tag, IndexType, GenerationType>& map)
+        {
+            using slot_t = typename SlotMap<Value, Tag, IndexType, GenerationType>::Slot;
+            using disk_t = detail::SnapshotSlot<IndexType, GenerationType>;
+            static_assert(sizeof(slot_t) == sizeof(disk_t) && alignof(slot_t) == alignof(disk_t),
+                "SnapshotSlot must mirror SlotMap::Slot");
+
+            if (map.pending_erase_count() != 0)
+                throw std::logic_error("save_snapshot: SlotMap has pending deferred erasures; compact() first");
+
+            auto header = slot_map_header<Value, Tag, IndexType, GenerationType>();
+            header.aux  = map.free_head_;
+            header.size = map.size();
+            detail::write_snapshot(os, header, {
+                detail::as_section(map.slots_.data(), map.slots_.size()),
+                detail::as_section(map.dense_.data(), map.dense_.size()),
+                detail::as_section(map.dense_to_slot_.data(), map.dense_to_slot_.size()),
+            });
+        }
+
+        template <typename Value, typename Tag, typename IndexType, typename GenerationType>
+        static void load(std::istream& is, SlotMap<Value, Tag, IndexType, GenerationType>& map)
+        {
+            using map_t  = SlotMap<Value, Tag, IndexType, GenerationType>;
+            using slot_t = typename map_t::Slot;
+            constexpr IndexType invalid = map_t::INVALID_INDEX;
+
+            const auto header = detail::read_snapshot_header(is, slot_map_header<Value, Tag, IndexType, GenerationType>());
+            const std::uint64_t available = detail::snapshot_stream_size(is, sizeof(header));
+            const std::size_t slot_count  = detail::snapshot_section_count<slot_t>(header.sections[0], available);
+            const std::size_t dense_count = detail::snapshot_section_count<Value>(header.sections[1], available);
+            if (detail::snapshot_section_count<IndexType>(header.sections[2], available) != dense_count
+                || dense_count != header.size || dense_count > slot_count || slot_count > invalid)
+                throw std::runtime_error("snapshot: inconsistent SlotMap sections");
+            if (header.aux > invalid || (header.aux != invalid && header.aux >= slot_count))
+                throw std::runtime_error("snapshot: SlotMap free list out of range");
+
+            // Read into temporaries so that a rejected snapshot leaves the map untouched.
+            std::vector<slot_t>    slots(slot_count);
+            std::vector<Value>     dense(dense_count);
+            std::vector<IndexType> dense_to_slot(dense_count);
+            std::uint64_t pos = sizeof(header);
+            detail::read_snapshot_section(is, pos, header.sections[0], slots.data());
+            detail::read_snapshot_section(is, pos, header.sections[1], dense.data());
+            detail::read_snapshot_section(is, pos, header.sections[2], dense_to_slot.data());
+
+            // Every slot must be either live (mapped both ways with one dense entry) or on the free list.
+            std::vector<std::uint8_t> live(slot_count, 0);
+            for (std::size_t i = 0; i < dense_count; ++i)
+            {
+                const IndexType slot = dense_to_slot[i];
+                if (slot >= slot_count || live[slot] || slots[slot].dense_index != i)
+                    throw std::runtime_error("snapshot: corrupt SlotMap dense mapping");
+                live[slot] = 1;
+            }
+            std::size_t free_count = 0;
+            for (IndexType cur = static_cast<IndexType>(header.aux); cur != invalid; cur = slots[cur].dense_index)
+            {
+                if (cur >= slot_count || live[cur] || ++free_count > slot_count - dense_count)
+                    throw std::runtime_error("snapshot: corrupt SlotMap free list");
+                live[cur] = 1; // visited; a cycle hits it again
+            }
+            if (free_count != slot_count - dense_count)
+                throw std::runtime_error("snapshot: corrupt SlotMap free list");
+
+            map.clear();
+            map.slots_         = std::move(slots);
+            map.dense_         = std::move(dense);
+            map.dense_to_slot_ = std::move(dense_to_slot);
+            map.free_head_     = static_cast<IndexType>(header.aux);
+        }
+
+        // ---- OffsetSparseSet ------------------------------------------------
+
+        template <typename Key, typename Value, Key Offset, typename SparseIndex>
+        static detail::SnapshotHeader sparse_set_header()
+        {
+            detail::SnapshotHeader h;
+            h.kind        = static_cast<std::uint32_t>(detail::SnapshotKind::SparseSet);
+            h.value_size  = sizeof(Value);
+            h.value_align = alignof(Value);
+            h.key_size    = sizeof(Key);
+            h.aux_size    = sizeof(SparseIndex);
+            h.aux         = static_cast<std::uint64_t>(Offset);
+            return h;
+        }
+
+        template <typename Key, typename Value, Key Offset, typename SparseIndex>
+        static void save(std::ostream& os, const OffsetSparseSet<Key, Value, Offset, SparseIndex>& set)
+        {
+            auto header = sparse_set_header<Key, Value, Offset, SparseIndex>();
+            header.size = set.size();
+            detail::write_snapshot(os, header, {
+                detail::as_section(set.sparse_.data(), set.sparse_.extent()),
+                detail::as_section(set.dense_keys_.data(), set.dense_keys_.size()),
+                detail::as_section(set.dense_values_.data(), set.dense_values_.size()),
+            });
+        }
+
+        template <typename Key, typename Value, Key Offset, typename SparseIndex>
+        static void load(std::istream& is, OffsetSparseSet<Key, Value, Offset, SparseIndex>& set)
+        {
+            using set_t = OffsetSparseSet<Key, Value, Offset, SparseIndex>;
+            constexpr auto invalid = static_cast<SparseIndex>(set_t::INVALID_INDEX);
+
+            const auto header = detail::read_snapshot_header(is, sparse_set_header<Key, Value, Offset, SparseIndex>());
+            if (header.aux != static_cast<std::uint64_t>(Offset))
+                throw std::runtime_error("snapshot: OffsetSparseSet offset mismatch");
+            const std::uint64_t available = detail::snapshot_stream_size(is, sizeof(header));
+            const std::size_t extent      = detail::snapshot_section_count<SparseIndex>(header.sections[0], available);
+            const std::size_t dense_count = detail::snapshot_section_count<Key>(header.sections[1], available);
+            if (detail::snapshot_section_count<Value>(header.sections[2], available) != dense_count
+                || dense_count != header.size || dense_count > extent)
+                throw std::runtime_error("snapshot: inconsistent OffsetSparseSet sections");
+
+            // Read into temporaries so that a rejected snapshot leaves the set untouched.
+            typename set_t::sparse_storage_type sparse;
+            SparseIndex*       sparse_data = sparse.resize(extent);
+            std::vector<Key>   keys(dense_count);
+            std::vector<Value> values(dense_count);
+            std::uint64_t pos = sizeof(header);
+            detail::read_snapshot_section(is, pos, header.sections[0], sparse_data);
+            detail::read_snapshot_section(is, pos, header.sections[1], keys.data());
+            detail::read_snapshot_section(is, pos, header.sections[2], values.data());
+
+            // Keys and sparse entries must map onto each other one to one.
+            for (std::size_t i = 0; i < dense_count; ++i)
+            {
+                if (keys[i] < Offset || static_cast<std::size_t>(keys[i] - Offset) >= extent
+                    || sparse_data[static_cast<std::size_t>(keys[i] - Offset)] != i)
+                    throw std::runtime_error("snapshot: corrupt OffsetSparseSet key");
+            }
+            std::size_t occupied = 0;
+            for (std::size_t k = 0; k < extent; ++k)
+            {
+                if (sparse_data[k] == invalid)
+                    continue;
+                if (sparse_data[k] >= dense_count)
+                    throw std::runtime_error("snapshot: corrupt OffsetSparseSet sparse entry");
+                ++occupied;
+            }
+            if (occupied != dense_count)
+                throw std::runtime_error("snapshot: corrupt OffsetSparseSet sparse entry");
+
+            set.clear();
+            set.sparse_       = std::move(sparse);
+            set.dense_keys_   = std::move(keys);
+            set.dense_values_ = std::move(values);
+        }
+    };
+
+    // ---- save / load ----------------------------------------------------------
+
+    /**
+     * @brief Writes @p map to @p os as a binary snapshot.
+     * @throws std::logic_error if the map has pending deferred erasures.
+     * @throws std::runtime_error if writing fails.
+     */
+    template <typename Value, typename Tag, typename IndexType, typename GenerationType>
+    void save_snapshot(std::ostream& os, const SlotMap<Value, Tag, IndexType, GenerationType>& map)
+    {
+        static_assert(std::is_trivially_copyable_v<Value>, "save_snapshot: Value must be trivially copyable");
+        SnapshotAccess::save(os, map);
+    }
+
+    /**
+     * @brief Replaces the contents of @p map with a snapshot read from @p is.
+     *
+     * Keys handed out before the snapshot was taken stay valid against the loaded map.
+     * Every index in the snapshot is checked before @p map is touched; on failure it is unchanged.
+     * @throws std::runtime_error if the snapshot is malformed or was written for another type.
+     */
+    template <typename Value, typename Tag, typename IndexType, typename GenerationType>
+    void load_snapshot(std::istream& is, SlotMap<Value, Tag, IndexType, GenerationType>& map)
+    {
+        static_assert(std::is_trivially_copyable_v<Value> && std::is_default_constructible_v<Value>,
+            "load_snapshot: Value must be trivially copyable and default constructible");
+        SnapshotAccess::load(is, map);
+    }
+
+    /**
+     * @brief Writes @p set to @p os as a binary snapshot (contiguous sparse storage only).
+     * @throws std::runtime_error if writing fails.
+     */
+    template <typename Key, typename Value, Key Offset, typename SparseIndex>
+    void save_snapshot(std::ostream& os, const OffsetSparseSet<Key, Value, Offset, SparseIndex>& set)
+    {
+        static_assert(std::is_trivially_copyable_v<Value>, "save_snapshot: Value must be trivially copyable");
+        SnapshotAccess::save(os, set);
+    }
+
+    /**
+     * @brief Replaces the contents of @p set with a snapshot read from @p is.
+     *
+     * Every index in the snapshot is checked before @p set is touched; on failure it is unchanged.
+     * @throws std::runtime_error if the snapshot is malformed or was written for another type.
+     */
+    template <typename Key, typename Value, Key Offset, typename SparseIndex>
+    void load_snapshot(std::istream& is, OffsetSparseSet<Key, Value, Offset, SparseIndex>& set)
+    {
+        static_assert(std::is_trivially_copyable_v<Value> && std::is_default_constructible_v<Value>,
+            "load_snapshot: Value must be trivially copyable and default constructible");
+        SnapshotAccess::load(is, set);
+    }
+
+    // ---- read-only views ------------------------------------------------------
+
+    /**
+     * @class SlotMapView
+     * @brief Read-only SlotMap served directly from snapshot bytes (e.g. a MappedFile).
+     *
+     * Construction validates the header and section bounds; lookups then read the
+     * snapshot in place without copying. The bytes must outlive the view.
+     */
+    template <typename Value, typename Tag = void, typename IndexType = std::uint32_t, typename GenerationType = std::uint32_t>
+    class SlotMapView
+    {
+        using map_t  = SlotMap<Value, Tag, IndexType, GenerationType>;
+        using slot_t = detail::SnapshotSlot<IndexType, GenerationType>;
+
+        static_assert(std::is_trivially_copyable_v<Value>, "SlotMapView: Value must be trivially copyable");
+        static_assert(alignof(Value) <= detail::kSnapshotAlign, "SlotMapView: Value alignment exceeds section alignment");
+
+    public:
+        using key_t   = typename map_t::key_t;
+        using value_t = Value;
+        using size_t  = std::size_t;
+
+        SlotMapView() = default;
+
+        /**
+         * @throws std::runtime_error if @p bytes do not hold a matching SlotMap snapshot.
+         */
+        explicit SlotMapView(std::span<const std::byte> bytes)
+        {
+            const auto header = detail::parse_snapshot_header(bytes,
+                SnapshotAccess::slot_map_header<Value, Tag, IndexType, GenerationType>());
+            slots_         = detail::snapshot_section<slot_t>(bytes, header, 0);
+            dense_         = detail::snapshot_section<Value>(bytes, header, 1);
+            dense_to_slot_ = detail::snapshot_section<IndexType>(bytes, header, 2);
+            if (dense_.size() != dense_to_slot_.size())
+                throw std::runtime_error("snapshot: inconsistent SlotMap sections");
+        }
+
+        [[nodiscard]] size_t size()  const noexcept { return dense_.size(); }
+        [[nodiscard]] bool   empty() const noexcept { return dense_.empty(); }
+
+        [[nodiscard]] bool is_valid(key_t key) const noexcept
+        {
+            return !key.is_null() && key.index < slots_.size() && slots_[key.index].generation == key.gen
+                && slots_[key.index].dense_index < dense_.size();
+        }
+
+        [[nodiscard]] const Value* find(key_t key) const noexcept
+        {
+            return is_valid(key) ? &dense_[slots_[key.index].dense_index] : nullptr;
+        }
+
+        [[nodiscard]] const Value& at(key_t key) const
+        {
+            if (!is_valid(key))
+                throw std::out_of_range("SlotMapView::at: invalid or stale key");
+            return dense_[slots_[key.index].dense_index];
+        }
+
+        [[nodiscard]] std::span<const Value> values() const noexcept { return dense_; }
+
+        [[nodiscard]] auto begin() const noexcept { return dense_.begin(); }
+        [[nodiscard]] auto end()   const noexcept { return dense_.end(); }
+
+    private:
+        std::span<const slot_t>    slots_;
+        std::span<const Value>     dense_;
+        std::span<const IndexType> dense_to_slot_;
+    };
+
+    /**
+     * @class SparseSetView
+     * @brief Read-only OffsetSparseSet served directly from snapshot bytes.
+     *
+     * The bytes must outlive the view.
+     */
+    template <typename Key, typename Value, Key Offset = 0, typename SparseIndex = std::size_t>
+    class SparseSetView
+    {
+        static_assert(std::is_trivially_copyable_v<Value>, "SparseSetView: Value must be trivially copyable");
+        static_assert(alignof(Value) <= detail::kSnapshotAlign, "SparseSetView: Value alignment exceeds section alignment");
+
+    public:
+        using size_type  = std::size_t;
+        using key_type   = Key;
+        using value_type = Value;
+
+        static constexpr size_type INVALID_INDEX = (std::numeric_limits<SparseIndex>::max)();
+
+        SparseSetView() = default;
+
+        /**
+         * @throws std::runtime_error if @p bytes do not hold a matching OffsetSparseSet snapshot.
+         */
+        explicit SparseSetView(std::span<const std::byte> bytes)
+        {
+            const auto header = detail::parse_snapshot_header(bytes,
+                SnapshotAccess::sparse_set_header<Key, Value, Offset, SparseIndex>());
+            if (header.aux != static_cast<std::uint64_t>(Offset))
+                throw std::runtime_error("snapshot: OffsetSparseSet offset mismatch");
+            sparse_ = detail::snapshot_section<SparseIndex>(bytes, header, 0);
+            keys_   = detail::snapshot_section<Key>(bytes, header, 1);
+            values_ = detail::snapshot_section<Value>(bytes, header, 2);
+            if (keys_.size() != values_.size())
+                throw std::runtime_error("snapshot: inconsistent OffsetSparseSet sections");
+        }
+
+        [[nodiscard]] size_type size()  const noexcept { return keys_.size(); }
+        [[nodiscard]] bool      empty() const noexcept { return keys_.empty(); }
+
+        /**
+         * @brief Returns the dense index of @p key, or INVALID_INDEX if absent.
+         */
+        [[nodiscard]] size_type index_of(Key key) const noexcept
+        {
+            if (key < Offset)
+                return INVALID_INDEX;
+            const auto idx = static_cast<size_type>(key - Offset);
+            if (idx >= sparse_.size())
+                return INVALID_INDEX;
+            const auto dense = static_cast<size_type>(sparse_[idx]);
+            return dense < keys_.size() ? dense : INVALID_INDEX;
+        }
+
+        [[nodiscard]] bool contains(Key key) const noexcept { return index_of(key) != INVALID_INDEX; }
+
+        [[nodiscard]] const Value* find(Key key) const noexcept
+        {
+            const size_type i = index_of(key);
+            return i != INVALID_INDEX ? &values_[i] : nullptr;
+        }
+
+        [[nodiscard]] const Value& at(Key key) const
+        {
+            const size_type i = index_of(key);
+            if (i == INVALID_INDEX)
+                throw std::out_of_range("SparseSetView::at: key not found");
+            return values_[i];
+        }
+
+        [[nodiscard]] std::span<const Key>   keys()   const noexcept { return keys_; }
+        [[nodiscard]] std::span<const Value> values() const noexcept { return values_; }
+
+    private:
+        std::span<const SparseIndex> sparse_;
+        std::span<const Key>         keys_;
+        std::span<const Value>       values_;
+    };
+
+    // ---- memory mapping -------------------------------------------------------
+
+    /**
+     * @class MappedFile
+     * @brief Read-only memory mapping of a whole file (move-only RAII).
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+
+        /**
+         * @throws std::system_error if the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const std::filesystem::path& path)
+        {
+#if defined(_WIN32)
+            HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), "MappedFile: open");
+            LARGE_INTEGER file_size{};
+            if (!::GetFileSizeEx(file, &file_size))
+            {
+                const auto err = ::GetLastError();
+                ::CloseHandle(file);
+                throw std::system_error(static_cast<int>(err), std::system_category(), "MappedFile: stat");
+            }
+            size_ = static_cast<std::size_t>(file_size.QuadPart);
+            if (size_ != 0)
+            {
+                HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                void*  view    = mapping ? ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+                const auto err = ::GetLastError();
+                if (mapping)
+                    ::CloseHandle(mapping); // the view keeps the mapping alive
+                if (!view)
+                {
+                    ::CloseHandle(file);
+                    throw std::system_error(static_cast<int>(err), std::system_category(), "MappedFile: map");
+                }
+                data_ = static_cast<const std::byte*>(view);
+            }
+            ::CloseHandle(file);
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(), "MappedFile: open");
+            struct stat st{};
+            if (::fstat(fd, &st) != 0)
+            {
+                const int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "MappedFile: stat");
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ != 0)
+            {
+                void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    const int err = errno;
+                    ::close(fd);
+                    throw std::system_error(err, std::generic_category(), "MappedFile: mmap");
+                }
+                data_ = static_cast<const std::byte*>(p);
+            }
+            ::close(fd); // the mapping stays valid after the descriptor is closed
+#endif
+        }
+
+        MappedFile(MappedFile&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+        {
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() { unmap(); }
+
+        [[nodiscard]] const std::byte*           data()  const noexcept { return data_; }
+        [[nodiscard]] std::size_t                size()  const noexcept { return size_; }
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return { data_, size_ }; }
+
+    private:
+        void unmap() noexcept
+        {
+            if (!data_)
+                return;
+#if defined(_WIN32)
+            ::UnmapViewOfFile(data_);
+#else
+            ::munmap(const_cast<std::byte*>(data_), size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        const std::byte* data_ = nullptr;
+        std::size_t      size_ = 0;
+    };
+
+    /**
+     * @class MappedSnapshot
+     * @brief Owns a MappedFile together with a view (SlotMapView / SparseSetView) over it.
+     *
+     * Opening only maps the file and validates the header: pages are faulted in
+     * lazily as lookups touch them.
+     */
+    template <typename View>
+    class MappedSnapshot
+    {
+    public:
+        /**
+         * @throws std::system_error if mapping fails, std::runtime_error if the snapshot is invalid.
+         */
+        explicit MappedSnapshot(const std::filesystem::path& path)
+            : file_(path), view_(file_.bytes())
+        {
+        }
+
+        [[nodiscard]] const View& view()       const noexcept { return view_; }
+        [[nodiscard]] const View* operator->() const noexcept { return &view_; }
+        [[nodiscard]] const View& operator*()  const noexcept { return view_; }
+
+    private:
+        MappedFile file_; ///< Declared first: the view points into it.
+        View       view_;
+    };
+
+} // namespace lux::cxx
@@ -26,13 +26,215 @@
  */
 
 #include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace lux::cxx
 {
+    struct SnapshotAccess; // Snapshot.hpp
+
+    namespace detail
+    {
+        /**
+         * @brief Contiguous sparse array with one entry per key index up to the largest key seen.
+         *
+         * Lookups are a single bounds check plus a load, and the storage is directly
+         * addressable by SIMD gathers. Memory grows with the largest key, not the key count.
+         *
+         * @tparam Index Unsigned integer type stored per key index.
+         */
+        template <typename Index>
+        class FlatSparseArray
+        {
+        public:
+            using size_type = std::size_t;
+
+            static constexpr Index INVALID = (std::numeric_limits<Index>::max)();
+            static constexpr bool  is_contiguous = true;
+
+            Index get(size_type idx) const noexcept
+            {
+                return idx < data_.size() ? data_[idx] : INVALID;
+            }
+
+            /** @brief Returns a writable entry, growing the array to cover @p idx if needed. */
+            Index& ensure(size_type idx)
+            {
+                if (idx >= data_.size()) {
+                    data_.resize(idx + 1, INVALID);
+                }
+                return data_[idx];
+            }
+
+            /** @brief Overwrites an entry that is known to be covered by the array. */
+            void set(size_type idx, Index value) noexcept { data_[idx] = value; }
+
+            void on_insert(size_type) noexcept {}
+            void on_erase(size_type) noexcept {}
+            void on_failed_insert(size_type) noexcept {}
+
+            void clear() noexcept { data_.clear(); }
+
+            /** @brief Number of addressable key indices. */
+            size_type extent() const noexcept { return data_.size(); }
+
+            size_type memory_bytes() const noexcept { return data_.capacity() * sizeof(Index); }
+
+            const Index* data() const noexcept { return data_.data(); }
+
+            /** @brief Resizes the array to @p n entries (new ones INVALID) and returns its storage. */
+            Index* resize(size_type n)
+            {
+                data_.resize(n, INVALID);
+                return data_.data();
+            }
+
+        private:
+            std::vector<Index> data_;
+        };
+
+        /**
+         * @brief Sparse array split into fixed-size pages that are allocated lazily.
+         *
+         * A key index maps to `pages_[idx / PageSize][idx % PageSize]`. Absent pages are
+         * represented by a null pointer and read as INVALID, so lookups stay O(1). Every
+         * page tracks how many live keys it holds and is freed when the count drops to zero.
+         * Memory is proportional to the populated key ranges plus one directory pointer
+         * per PageSize keys of the overall range.
+         *
+         * @tparam Index    Unsigned integer type stored per key index.
+         * @tparam PageSize Number of entries per page; must be a power of two.
+         */
+        template <typename Index, std::size_t PageSize>
+        class PagedSparseArray
+        {
+            static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0,
+                "PagedSparseArray: PageSize must be a power of two.");
+
+        public:
+            using size_type = std::size_t;
+
+            static constexpr Index INVALID = (std::numeric_limits<Index>::max)();
+            static constexpr bool  is_contiguous = false;
+
+            PagedSparseArray() = default;
+
+            PagedSparseArray(const PagedSparseArray& other)
+                : pages_(other.pages_.size())
+                , counts_(other.counts_)
+                , allocated_(other.allocated_)
+            {
+                for (size_type p = 0; p < other.pages_.size(); ++p) {
+                    if (other.pages_[p]) {
+                        pages_[p] = std::make_unique<Index[]>(PageSize);
+                        std::copy_n(other.pages_[p].get(), PageSize, pages_[p].get());
+                    }
+                }
+            }
+
+            PagedSparseArray& operator=(const PagedSparseArray& other)
+            {
+                if (this != &other) {
+                    PagedSparseArray tmp(other);
+                    *this = std::move(tmp);
+                }
+                return *this;
+            }
+
+            PagedSparseArray(PagedSparseArray&&) noexcept            = default;
+            PagedSparseArray& operator=(PagedSparseArray&&) noexcept = default;
+
+            Index get(size_type idx) const noexcept
+            {
+                const size_type p = idx / PageSize;
+                if (p >= pages_.size()) {
+                    return INVALID;
+                }
+                const Index* page = pages_[p].get();
+                return page ? page[idx % PageSize] : INVALID;
+            }
+
+            /** @brief Returns a writable entry, allocating its page if needed. */
+            Index& ensure(size_type idx)
+            {
+                const size_type p = idx / PageSize;
+                if (p >= pages_.size()) {
+                    pages_.resize(p + 1);
+                    counts_.resize(p + 1, 0);
+                }
+                if (!pages_[p]) {
+                    pages_[p] = std::make_unique<Index[]>(PageSize);
+                    std::fill_n(pages_[p].get(), PageSize, INVALID);
+                    ++allocated_;
+                }
+                return pages_[p][idx % PageSize];
+            }
+
+            /** @brief Overwrites an entry whose page is known to be allocated. */
+            void set(size_type idx, Index value) noexcept { pages_[idx / PageSize][idx % PageSize] = value; }
+
+            /** @brief Records that a key was added to the page of @p idx. */
+            void on_insert(size_type idx) noexcept { ++counts_[idx / PageSize]; }
+
+            /** @brief Frees the page of @p idx if an insert allocated it and then failed. */
+            void on_failed_insert(size_type idx) noexcept
+            {
+                const size_type p = idx / PageSize;
+                if (counts_[p] == 0 && pages_[p]) {
+                    pages_[p].reset();
+                    --allocated_;
+                }
+            }
+
+            /** @brief Records that a key was removed from the page of @p idx; frees the page when empty. */
+            void on_erase(size_type idx) noexcept
+            {
+                const size_type p = idx / PageSize;
+                if (--counts_[p] == 0) {
+                    pages_[p].reset();
+                    --allocated_;
+                }
+            }
+
+            void clear() noexcept
+            {
+                pages_.clear();
+                counts_.clear();
+                allocated_ = 0;
+            }
+
+            /** @brief Number of addressable key indices (including unallocated pages). */
+            size_type extent() const noexcept { return pages_.size() * PageSize; }
+
+            /** @brief Number of pages currently allocated. */
+            size_type allocated_pages() const noexcept { return allocated_; }
+
+            size_type memory_bytes() const noexcept
+            {
+                return pages_.capacity() * sizeof(std::unique_ptr<Index[]>)
+                     + counts_.capacity() * sizeof(std::uint32_t)
+                     + allocated_ * PageSize * sizeof(Index);
+            }
+
+        private:
+            std::vector<std::unique_ptr<Index[]>> pages_;
+            std::vector<std::uint32_t>            counts_;     ///< Live keys per page.
+            size_type                             allocated_ = 0;
+        };
+
+    } // namespace detail
     /**
      * @class OffsetSparseSet
      * @brief A sparse set data structure allowing keys to start from a compile-time offset.
@@ -44,15 +246,35 @@ namespace lux::cxx
      * All operations (insert, erase, contains, etc.) work in O(1) on average. The offset
      * ensures that memory is not allocated for all key indices below `Offset`.
      *
-     * @tparam Key    The integral type of the key.
-     * @tparam Value  The type of the stored value.
-     * @tparam Offset A compile-time constant indicating the minimum valid key.
+     * The element type of the sparse array is configurable through @p SparseIndex.
+     * A narrower type (e.g. `std::uint32_t` or `std::uint16_t`) halves or quarters the
+     * sparse array footprint, at the cost of capping the number of stored elements at
+     * `numeric_limits<SparseIndex>::max() - 1`.
+     *
+     * By default the sparse array is one contiguous vector sized to the largest key ever
+     * inserted. A non-zero @p PageSize switches to paged storage: fixed-size pages are
+     * allocated on first use and freed once they hold no keys, so memory follows the
+     * populated key ranges (a single key near 2^31 costs one page, not gigabytes).
+     *
+     * Batched lookups (`contains_many`, `find_many`) resolve many keys per call. When
+     * compiled with AVX2 they use hardware gathers for 32/64-bit keys with a 32/64-bit
+     * contiguous sparse index, and fall back to a scalar loop otherwise.
+     *
+     * @tparam Key         The integral type of the key.
+     * @tparam Value       The type of the stored value.
+     * @tparam Offset      A compile-time constant indicating the minimum valid key.
+     * @tparam SparseIndex Unsigned integer type stored in the sparse array.
+     * @tparam PageSize    Entries per sparse page (power of two), or 0 for a contiguous array.
      */
-    template <typename Key, typename Value, Key Offset = 0>
+    template <typename Key, typename Value, Key Offset = 0, typename SparseIndex = std::size_t, std::size_t PageSize = 0>
     class OffsetSparseSet
     {
         static_assert(std::is_integral_v<Key>,
             "OffsetSparseSet: Key must be an integral type.");
+        static_assert(std::is_unsigned_v<SparseIndex>,
+            "OffsetSparseSet: SparseIndex must be an unsigned integral type.");
+        static_assert(sizeof(SparseIndex) <= sizeof(std::size_t),
+            "OffsetSparseSet: SparseIndex must not be wider than std::size_t.");
 
     public:
         /**
@@ -60,11 +282,29 @@ namespace lux::cxx
          */
         using size_type = std::size_t;
 
+        /**
+         * @brief Key and value types.
+         */
+        using key_type   = Key;
+        using value_type = Value;
+
+        /**
+         * @brief Type stored in the sparse array.
+         */
+        using sparse_index_type = SparseIndex;
+
         /**
          * @brief Constant representing an invalid index within the sparse array.
          */
         static constexpr size_type INVALID_INDEX =
-            (std::numeric_limits<size_type>::max)();
+            (std::numeric_limits<sparse_index_type>::max)();
+
+        /**
+         * @brief Storage backing the sparse array (contiguous or paged).
+         */
+        using sparse_storage_type = std::conditional_t<PageSize == 0,
+            detail::FlatSparseArray<sparse_index_type>,
+            detail::PagedSparseArray<sparse_index_type, (PageSize == 0 ? 1 : PageSize)>>;
 
         /**
          * @brief Default constructor; does not allocate any storage.
@@ -109,6 +349,24 @@ namespace lux::cxx
             dense_values_.reserve(new_capacity);
         }
 
+        /**
+         * @brief Returns the number of bytes currently allocated for the sparse array.
+         * @return Sparse storage footprint in bytes (excluding the dense arrays).
+         */
+        size_type sparse_memory_bytes() const noexcept
+        {
+            return sparse_.memory_bytes();
+        }
+
+        /**
+         * @brief Returns the underlying sparse storage (e.g. to inspect allocated pages).
+         * @return A const reference to the sparse storage.
+         */
+        const sparse_storage_type& sparse_storage() const noexcept
+        {
+            return sparse_;
+        }
+
         /**
          * @brief Removes all elements from the set, clearing both the sparse and dense arrays.
          */
@@ -126,11 +384,7 @@ namespace lux::cxx
          */
         bool contains(Key key) const
         {
-            if (key < Offset) {
-                return false;
-            }
-            size_type idx = toIndex(key);
-            return (idx < sparse_.size()) && (sparse_[idx] != INVALID_INDEX);
+            return lookup(key) != INVALID_INDEX;
         }
 
         /**
@@ -143,13 +397,10 @@ namespace lux::cxx
          */
         void insert(Key key, const Value& value)
         {
-            ensure_sparse_size(key);
-            size_type idx = sparse_[toIndex(key)];
+            sparse_index_type& slot = ensure_sparse_slot(key);
+            size_type idx = slot;
             if (idx == INVALID_INDEX) {
-                idx = dense_keys_.size();
-                dense_keys_.push_back(key);
-                dense_values_.push_back(value);
-                sparse_[toIndex(key)] = idx;
+                idx = append_entry(key, slot, value);
             }
             else {
                 dense_values_[idx] = value;
@@ -166,13 +417,10 @@ namespace lux::cxx
          */
         void insert(Key key, Value&& value)
         {
-            ensure_sparse_size(key);
-            size_type idx = sparse_[toIndex(key)];
+            sparse_index_type& slot = ensure_sparse_slot(key);
+            size_type idx = slot;
             if (idx == INVALID_INDEX) {
-                idx = dense_keys_.size();
-                dense_keys_.push_back(key);
-                dense_values_.push_back(std::move(value));
-                sparse_[toIndex(key)] = idx;
+                idx = append_entry(key, slot, std::move(value));
             }
             else {
                 dense_values_[idx] = std::move(value);
@@ -187,13 +435,10 @@ namespace lux::cxx
          */
         Value& operator[](Key key)
         {
-            ensure_sparse_size(key);
-            size_type idx = sparse_[toIndex(key)];
+            sparse_index_type& slot = ensure_sparse_slot(key);
+            size_type idx = slot;
             if (idx == INVALID_INDEX) {
-                idx = dense_keys_.size();
-                dense_keys_.push_back(key);
-                dense_values_.push_back(Value{});
-                sparse_[toIndex(key)] = idx;
+                idx = append_entry(key, slot, Value{});
             }
             return dense_values_[idx];
         }
@@ -212,13 +457,10 @@ namespace lux::cxx
         template <typename... Args>
         Value& emplace(Key key, Args&&... args)
         {
-            ensure_sparse_size(key);
-            size_type idx = sparse_[toIndex(key)];
+            sparse_index_type& slot = ensure_sparse_slot(key);
+            size_type idx = slot;
             if (idx == INVALID_INDEX) {
-                idx = dense_keys_.size();
-                dense_keys_.push_back(key);
-                dense_values_.emplace_back(std::forward<Args>(args)...);
-                sparse_[toIndex(key)] = idx;
+                idx = append_entry(key, slot, std::forward<Args>(args)...);
             }
             else {
                 dense_values_[idx].~Value();
@@ -227,6 +469,69 @@ namespace lux::cxx
             return dense_values_[idx];
         }
 
+        /**
+         * @brief Tests a batch of keys for membership.
+         * @param keys The keys to test.
+         * @param out  Receives one flag per key; must hold at least keys.size() entries.
+         * @return The number of keys that were found.
+         */
+        size_type contains_many(std::span<const Key> keys, std::span<bool> out) const
+        {
+            checkBatchOutput(keys.size(), out.size());
+            size_type found = 0;
+            size_type block[kBatchBlock];
+            for (size_type base = 0; base < keys.size(); base += kBatchBlock) {
+                const size_type n = (std::min)(kBatchBlock, keys.size() - base);
+                resolve(keys.data() + base, n, block);
+                for (size_type i = 0; i < n; ++i) {
+                    const bool hit = block[i] != INVALID_INDEX;
+                    out[base + i] = hit;
+                    found += hit;
+                }
+            }
+            return found;
+        }
+
+        /**
+         * @brief Resolves a batch of keys to their positions in the dense arrays.
+         * @param keys The keys to look up.
+         * @param out  Receives the dense index of each key (usable with keys()/values()),
+         *             or INVALID_INDEX if absent; must hold at least keys.size() entries.
+         * @return The number of keys that were found.
+         */
+        size_type find_many(std::span<const Key> keys, std::span<size_type> out) const
+        {
+            checkBatchOutput(keys.size(), out.size());
+            resolve(keys.data(), keys.size(), out.data());
+            size_type found = 0;
+            for (size_type i = 0; i < keys.size(); ++i) {
+                found += out[i] != INVALID_INDEX;
+            }
+            return found;
+        }
+
+        /**
+         * @brief Removes every key of a batch that is present in the set.
+         * @param keys The keys to remove. Duplicates and absent keys are ignored.
+         * @return The number of keys that were removed.
+         *
+         * Removal is inherently sequential (each swap-and-pop moves the last element),
+         * so this is a scalar loop; it saves the redundant lookup done by erase().
+         */
+        size_type erase_many(std::span<const Key> keys)
+        {
+            size_type erased = 0;
+            for (Key key : keys) {
+                const size_type i = lookup(key);
+                if (i == INVALID_INDEX) {
+                    continue;
+                }
+                erase_at(key, i);
+                ++erased;
+            }
+            return erased;
+        }
+
         /**
          * @brief Removes the specified key from the set if it exists.
          * @param key The key to remove.
@@ -236,21 +541,11 @@ namespace lux::cxx
          */
         bool erase(Key key)
         {
-            if (!contains(key)) {
+            const size_type i = lookup(key);
+            if (i == INVALID_INDEX) {
                 return false;
             }
-            size_type i = sparse_[toIndex(key)];
-            size_type last = dense_keys_.size() - 1;
-
-            if (i != last) {
-                Key last_key = dense_keys_[last];
-                dense_keys_[i] = last_key;
-                dense_values_[i] = std::move(dense_values_[last]);
-                sparse_[toIndex(last_key)] = i;
-            }
-            dense_keys_.pop_back();
-            dense_values_.pop_back();
-            sparse_[toIndex(key)] = INVALID_INDEX;
+            erase_at(key, i);
             return true;
         }
 
@@ -262,10 +557,10 @@ namespace lux::cxx
          */
         bool extract(Key key, Value& value)
         {
-            if (!contains(key)) {
+            const size_type idx = lookup(key);
+            if (idx == INVALID_INDEX) {
                 return false;
             }
-            size_type idx = sparse_[toIndex(key)];
             value = std::move(dense_values_[idx]);
             erase(key);
             return true;
@@ -279,8 +574,7 @@ namespace lux::cxx
          */
         Value& at(Key key)
         {
-            checkKeyValid(key);
-            return dense_values_.at(sparse_.at(toIndex(key)));
+            return dense_values_[checkedLookup(key)];
         }
 
         /**
@@ -291,8 +585,7 @@ namespace lux::cxx
          */
         const Value& at(Key key) const
         {
-            checkKeyValid(key);
-            return dense_values_.at(sparse_.at(toIndex(key)));
+            return dense_values_[checkedLookup(key)];
         }
 
         /**
@@ -313,7 +606,291 @@ namespace lux::cxx
             return dense_values_;
         }
 
+        /**
+         * @brief Returns a pointer to the dense value array (aligned with keys()).
+         * @return Pointer to the first dense value.
+         */
+        Value* data() noexcept
+        {
+            return dense_values_.data();
+        }
+
+        const Value* data() const noexcept
+        {
+            return dense_values_.data();
+        }
+
+        /**
+         * @brief Returns the position of @p key in the dense arrays.
+         * @param key The key to look up.
+         * @return The dense index, or INVALID_INDEX if the key is absent.
+         */
+        size_type index_of(Key key) const noexcept
+        {
+            return lookup(key);
+        }
+
+        /**
+         * @brief Swaps two elements of the dense arrays and fixes up their sparse entries.
+         * @param a Dense index of the first element.
+         * @param b Dense index of the second element.
+         *
+         * Keys keep their values; only their iteration order changes.
+         */
+        void swap_dense(size_type a, size_type b)
+        {
+            if (a == b) {
+                return;
+            }
+            using std::swap;
+            swap(dense_keys_[a], dense_keys_[b]);
+            swap(dense_values_[a], dense_values_[b]);
+            sparse_.set(toIndex(dense_keys_[a]), static_cast<sparse_index_type>(a));
+            sparse_.set(toIndex(dense_keys_[b]), static_cast<sparse_index_type>(b));
+        }
+
+        /**
+         * @brief Reorders the dense arrays so that keys() is sorted by @p comp.
+         * @param comp Strict weak ordering on keys (ascending by default).
+         *
+         * Sorting by key turns iteration in key order into a linear scan.
+         */
+        template <typename Compare = std::less<Key>>
+        void sort(Compare comp = Compare{})
+        {
+            std::vector<size_type> order(dense_keys_.size());
+            for (size_type i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return comp(dense_keys_[a], dense_keys_[b]);
+            });
+
+            // Apply the permutation in place, one cycle at a time.
+            for (size_type i = 0; i < order.size(); ++i) {
+                size_type curr = i;
+                size_type next = order[curr];
+                while (next != i) {
+                    swap_dense(curr, next);
+                    order[curr] = curr;
+                    curr = next;
+                    next = order[curr];
+                }
+                order[curr] = curr;
+            }
+        }
+
     private:
+        /**
+         * @brief Number of keys resolved per block by the batched lookups.
+         */
+        static constexpr size_type kBatchBlock = 256;
+
+        /**
+         * @brief Returns the dense index of @p key, or INVALID_INDEX if absent.
+         */
+        size_type lookup(Key key) const noexcept
+        {
+            if (key < Offset) {
+                return INVALID_INDEX;
+            }
+            return static_cast<size_type>(sparse_.get(toIndex(key)));
+        }
+
+        /**
+         * @brief Returns the dense index of @p key.
+         * @throws std::out_of_range if key < Offset or the key is not found.
+         */
+        size_type checkedLookup(Key key) const
+        {
+            checkKeyValid(key);
+            const size_type idx = lookup(key);
+            if (idx == INVALID_INDEX) {
+                throw std::out_of_range("OffsetSparseSet: key not found.");
+            }
+            return idx;
+        }
+
+        /**
+         * @brief Appends a new (key, value) pair and points @p slot at it.
+         *
+         * If the value cannot be constructed, the dense arrays are left unchanged and a
+         * sparse page allocated for @p key by ensure_sparse_slot() is released again.
+         * @return The dense index of the new element.
+         */
+        template <typename... Args>
+        size_type append_entry(Key key, sparse_index_type& slot, Args&&... args)
+        {
+            size_type idx = 0;
+            try {
+                idx = next_dense_index();
+                dense_keys_.push_back(key);
+                try {
+                    dense_values_.emplace_back(std::forward<Args>(args)...);
+                }
+                catch (...) {
+                    dense_keys_.pop_back();
+                    throw;
+                }
+            }
+            catch (...) {
+                sparse_.on_failed_insert(toIndex(key));
+                throw;
+            }
+            slot = static_cast<sparse_index_type>(idx);
+            sparse_.on_insert(toIndex(key));
+            return idx;
+        }
+
+        /**
+         * @brief Returns the dense index the next new element will occupy.
+         * @throws std::length_error if it cannot be represented by sparse_index_type.
+         */
+        size_type next_dense_index() const
+        {
+            const size_type idx = dense_keys_.size();
+            if constexpr (sizeof(sparse_index_type) < sizeof(size_type)) {
+                if (idx >= INVALID_INDEX) {
+                    throw std::length_error("OffsetSparseSet: too many elements for SparseIndex.");
+                }
+            }
+            return idx;
+        }
+
+        /**
+         * @brief Removes the element of @p key stored at dense index @p i ("swap with last").
+         */
+        void erase_at(Key key, size_type i)
+        {
+            const size_type last = dense_keys_.size() - 1;
+
+            if (i != last) {
+                Key last_key = dense_keys_[last];
+                dense_keys_[i] = last_key;
+                dense_values_[i] = std::move(dense_values_[last]);
+                sparse_.set(toIndex(last_key), static_cast<sparse_index_type>(i));
+            }
+            dense_keys_.pop_back();
+            dense_values_.pop_back();
+            sparse_.set(toIndex(key), static_cast<sparse_index_type>(INVALID_INDEX));
+            sparse_.on_erase(toIndex(key));
+        }
+
+        /**
+         * @brief Throws if a batch output buffer is shorter than its input.
+         */
+        static void checkBatchOutput(size_type n_keys, size_type n_out)
+        {
+            if (n_out < n_keys) {
+                throw std::length_error("OffsetSparseSet: batch output is smaller than input.");
+            }
+        }
+
+        /**
+         * @brief Writes the dense index of each of the @p n keys to @p out
+         *        (INVALID_INDEX for absent keys). Dispatches to an AVX2 kernel when available.
+         */
+        void resolve(const Key* keys, size_type n, size_type* out) const noexcept
+        {
+            size_type i = 0;
+#if defined(__AVX2__)
+            if constexpr (!sparse_storage_type::is_contiguous) {
+                // Paged storage cannot be gathered from a single base address.
+            }
+            else if constexpr (sizeof(Key) == 4 && sizeof(sparse_index_type) == 4) {
+                // 32-bit gathers use signed 32-bit offsets.
+                if (sparse_.extent() <= static_cast<size_type>((std::numeric_limits<std::int32_t>::max)())) {
+                    i = resolve_avx2_k32(keys, n, out);
+                }
+            }
+            else if constexpr (sizeof(Key) == 8 && (sizeof(sparse_index_type) == 4 || sizeof(sparse_index_type) == 8)) {
+                i = resolve_avx2_k64(keys, n, out);
+            }
+#endif
+            for (; i < n; ++i) {
+                out[i] = lookup(keys[i]);
+            }
+        }
+
+#if defined(__AVX2__)
+        /**
+         * @brief AVX2 kernel for 32-bit keys and a 32-bit sparse index (8 lanes).
+         * @return The number of keys processed; the tail is left to the scalar loop.
+         */
+        size_type resolve_avx2_k32(const Key* keys, size_type n, size_type* out) const noexcept
+        {
+            const __m256i bias    = _mm256_set1_epi32((std::numeric_limits<std::int32_t>::min)());
+            const __m256i offset  = _mm256_set1_epi32(static_cast<std::int32_t>(Offset));
+            const __m256i limit   = _mm256_xor_si256(_mm256_set1_epi32(static_cast<std::int32_t>(sparse_.extent())), bias);
+            const __m256i invalid = _mm256_set1_epi32(-1);
+            const auto*   base    = reinterpret_cast<const int*>(sparse_.data());
+
+            size_type i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+                __m256i below;
+                if constexpr (std::is_signed_v<Key>) {
+                    below = _mm256_cmpgt_epi32(offset, k);
+                }
+                else {
+                    below = _mm256_cmpgt_epi32(_mm256_xor_si256(offset, bias), _mm256_xor_si256(k, bias));
+                }
+                const __m256i d        = _mm256_sub_epi32(k, offset);
+                const __m256i in_range = _mm256_cmpgt_epi32(limit, _mm256_xor_si256(d, bias));
+                const __m256i mask     = _mm256_andnot_si256(below, in_range);
+                const __m256i v        = _mm256_mask_i32gather_epi32(invalid, base, d, mask, 4);
+
+                // Zero-extension maps the 32-bit sentinel onto INVALID_INDEX.
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                    _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4),
+                    _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)));
+            }
+            return i;
+        }
+
+        /**
+         * @brief AVX2 kernel for 64-bit keys and a 32/64-bit sparse index (4 lanes).
+         * @return The number of keys processed; the tail is left to the scalar loop.
+         */
+        size_type resolve_avx2_k64(const Key* keys, size_type n, size_type* out) const noexcept
+        {
+            const __m256i bias   = _mm256_set1_epi64x((std::numeric_limits<std::int64_t>::min)());
+            const __m256i offset = _mm256_set1_epi64x(static_cast<std::int64_t>(Offset));
+            const __m256i limit  = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<std::int64_t>(sparse_.extent())), bias);
+
+            size_type i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+                __m256i below;
+                if constexpr (std::is_signed_v<Key>) {
+                    below = _mm256_cmpgt_epi64(offset, k);
+                }
+                else {
+                    below = _mm256_cmpgt_epi64(_mm256_xor_si256(offset, bias), _mm256_xor_si256(k, bias));
+                }
+                const __m256i d        = _mm256_sub_epi64(k, offset);
+                const __m256i in_range = _mm256_cmpgt_epi64(limit, _mm256_xor_si256(d, bias));
+                const __m256i mask     = _mm256_andnot_si256(below, in_range);
+
+                __m256i v;
+                if constexpr (sizeof(sparse_index_type) == 8) {
+                    v = _mm256_mask_i64gather_epi64(_mm256_set1_epi64x(-1),
+                        reinterpret_cast<const long long*>(sparse_.data()), d, mask, 8);
+                }
+                else {
+                    // Narrow the 64-bit lane mask to the 32-bit lanes of the gather result.
+                    const __m128i mask32 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+                        mask, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+                    v = _mm256_cvtepu32_epi64(_mm256_mask_i64gather_epi32(_mm_set1_epi32(-1),
+                        reinterpret_cast<const int*>(sparse_.data()), d, mask32, 4));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+            }
+            return i;
+        }
+#endif
+
         /**
          * @brief Converts a key to an index in the sparse array by subtracting the Offset.
          * @param key The key to convert.
@@ -325,17 +902,15 @@ namespace lux::cxx
         }
 
         /**
-         * @brief Ensures the sparse array is large enough to index a given key.
+         * @brief Ensures the sparse array can index a given key and returns its entry.
          * @param key The key to check.
          * @throws std::out_of_range if key < Offset.
+         * @return A reference to the sparse entry of @p key.
          */
-        void ensure_sparse_size(Key key)
+        sparse_index_type& ensure_sparse_slot(Key key)
         {
             checkKeyValid(key);
-            const size_type idx = toIndex(key);
-            if (idx >= sparse_.size()) {
-                sparse_.resize(idx + 1, INVALID_INDEX);
-            }
+            return sparse_.ensure(toIndex(key));
         }
 
         /**
@@ -351,11 +926,13 @@ namespace lux::cxx
         }
 
     private:
+        friend struct SnapshotAccess;
+
         /**
          * @brief The sparse array where sparse_[key - Offset] stores the index of (key, value)
          *        in the dense arrays. INVALID_INDEX indicates an absent key.
          */
-        std::vector<size_type> sparse_;
+        sparse_storage_type    sparse_;
 
         /**
          * @brief Dense array of keys.
@@ -376,19 +953,32 @@ namespace lux::cxx
      * - If there are free IDs from previously erased elements, reuse them.
      * - Otherwise, allocate keys from @p next_id_, starting at Offset.
      *
-     * @tparam Value  The type of values to store.
-     * @tparam Key    The integral type for the key.
-     * @tparam Offset A compile-time offset from which to start allocating new keys.
+     * @tparam Value       The type of values to store.
+     * @tparam Key         The integral type for the key.
+     * @tparam Offset      A compile-time offset from which to start allocating new keys.
+     * @tparam SparseIndex Unsigned integer type stored in the sparse array.
+     * @tparam PageSize    Entries per sparse page (power of two), or 0 for a contiguous array.
      */
-    template <typename Key, typename Value, Key Offset = 0>
-    class OffsetAutoSparseSet : protected OffsetSparseSet<Key, Value, Offset>
+    template <typename Key, typename Value, Key Offset = 0, typename SparseIndex = std::size_t, std::size_t PageSize = 0>
+    class OffsetAutoSparseSet : protected OffsetSparseSet<Key, Value, Offset, SparseIndex, PageSize>
     {
         static_assert(std::is_integral_v<Key>,
             "OffsetAutoSparseSet: Key must be an integral type.");
 
     public:
-        using BaseType = OffsetSparseSet<Key, Value, Offset>;
+        using BaseType = OffsetSparseSet<Key, Value, Offset, SparseIndex, PageSize>;
         using size_type = typename BaseType::size_type;
+        using sparse_index_type = typename BaseType::sparse_index_type;
+
+        using key_type   = typename BaseType::key_type;
+        using value_type = typename BaseType::value_type;
+
+        using BaseType::INVALID_INDEX;
+        using BaseType::sparse_memory_bytes;
+        using BaseType::data;
+        using BaseType::index_of;
+        using BaseType::swap_dense;
+        using BaseType::sort;
 
         /**
          * @brief Default constructor. next_id_ is initialized to Offset.
@@ -527,6 +1117,44 @@ namespace lux::cxx
             return BaseType::contains(key);
         }
 
+        /**
+         * @brief Tests a batch of keys for membership.
+         * @param keys The keys to test.
+         * @param out  Receives one flag per key; must hold at least keys.size() entries.
+         * @return The number of keys that were found.
+         */
+        size_type contains_many(std::span<const Key> keys, std::span<bool> out) const
+        {
+            return BaseType::contains_many(keys, out);
+        }
+
+        /**
+         * @brief Resolves a batch of keys to their positions in the dense arrays.
+         * @param keys The keys to look up.
+         * @param out  Receives the dense index of each key, or INVALID_INDEX if absent.
+         * @return The number of keys that were found.
+         */
+        size_type find_many(std::span<const Key> keys, std::span<size_type> out) const
+        {
+            return BaseType::find_many(keys, out);
+        }
+
+        /**
+         * @brief Removes every key of a batch that is present in the set.
+         * @param keys The keys to remove.
+         * @return The number of keys that were removed.
+         *
+         * Each removed key is reclaimed for future reuse.
+         */
+        size_type erase_many(std::span<const Key> keys)
+        {
+            size_type erased = 0;
+            for (Key key : keys) {
+                erased += erase(key);
+            }
+            return erased;
+        }
+
         /**
          * @brief Returns the count of free IDs currently stored.
          * @return The number of available free IDs.
@@ -623,7 +1251,9 @@ namespace lux::cxx
         Key next_id_;
     };
 
-	template<typename Key, typename Value, Key offset = 0> using SparseSet     = OffsetSparseSet<Key, Value, offset>;
-	template<typename Value, size_t offset = 0> using AutoSparseSet = OffsetAutoSparseSet<size_t, Value, offset>;
+	template<typename Key, typename Value, Key offset = 0, typename SparseIndex = std::size_t> using SparseSet     = OffsetSparseSet<Key, Value, offset, SparseIndex>;
+	template<typename Value, size_t offset = 0, typename SparseIndex = std::size_t> using AutoSparseSet = OffsetAutoSparseSet<size_t, Value, offset, SparseIndex>;
+	template<typename Key, typename Value, Key offset = 0, typename SparseIndex = std::uint32_t, std::size_t PageSize = 4096>
+	using PagedSparseSet = OffsetSparseSet<Key, Value, offset, SparseIndex, PageSize>;
 
 } // namespace lux::cxx
@@ -0,0 +1,219 @@
+#pragma once
+/**
+ * @file SparseSetJoin.hpp
+ * @brief Join (intersection) views over several sparse sets sharing the same keys,
+ *        with an optional group-style reordering that turns the join into a linear scan.
+ *
+ * @copyright
+ * Copyright (c) 2025 Chenhui Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <lux/cxx/container/SparseSet.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace lux::cxx
+{
+    /**
+     * @class SparseSetJoin
+     * @brief Iterates the keys present in every one of several sparse sets.
+     *
+     * each() drives the join from the smallest participating set and probes the others
+     * by key. That is correct at any time, but every probe is a random access.
+     *
+     * align() additionally reorders the dense arrays of all sets (in the style of EnTT
+     * groups): every key present in all sets is swapped to the same position
+     * `[0, aligned_size())` in each of them. each_aligned() then walks those aligned
+     * prefixes in lockstep without any lookup.
+     *
+     * @note Inserting into or erasing from any participating set breaks the alignment
+     *       (swap-and-pop moves elements); call align() again before each_aligned().
+     *
+     * @tparam Sets OffsetSparseSet / OffsetAutoSparseSet types sharing the same key type.
+     */
+    template <typename... Sets>
+    class SparseSetJoin
+    {
+        static_assert(sizeof...(Sets) >= 2,
+            "SparseSetJoin: at least two sets are required.");
+
+        using first_set = std::tuple_element_t<0, std::tuple<Sets...>>;
+
+    public:
+        using size_type = std::size_t;
+        using key_type  = typename first_set::key_type;
+
+        static_assert((std::is_same_v<typename Sets::key_type, key_type> && ...),
+            "SparseSetJoin: all sets must share the same key type.");
+
+        static constexpr size_type set_count = sizeof...(Sets);
+
+        /**
+         * @brief Constructs a join over @p sets. The sets must outlive the join.
+         */
+        explicit SparseSetJoin(Sets&... sets) noexcept
+            : sets_(sets...)
+        {
+        }
+
+        /**
+         * @brief Returns the position (in template order) of the smallest set.
+         */
+        size_type driver() const noexcept
+        {
+            const std::array<size_type, set_count> sizes = std::apply(
+                [](const auto&... set) { return std::array<size_type, set_count>{ set.size()... }; }, sets_);
+            size_type best = 0;
+            for (size_type i = 1; i < set_count; ++i) {
+                if (sizes[i] < sizes[best]) {
+                    best = i;
+                }
+            }
+            return best;
+        }
+
+        /**
+         * @brief Calls `func(key, value_0&, value_1&, ...)` for every key present in all sets.
+         *
+         * Iterates the smallest set and probes the others. The sets must not be
+         * modified structurally (insert/erase) from within @p func.
+         */
+        template <typename Func>
+        void each(Func&& func)
+        {
+            each_impl(func, std::index_sequence_for<Sets...>{});
+        }
+
+        /**
+         * @brief Reorders every set so that the keys present in all of them occupy the
+         *        same dense positions `[0, n)`, in the order of the smallest set.
+         * @return The length n of the aligned prefix (the join size).
+         */
+        size_type align()
+        {
+            aligned_ = align_impl(std::index_sequence_for<Sets...>{});
+            return aligned_;
+        }
+
+        /**
+         * @brief Returns the length of the prefix produced by the last align() call.
+         */
+        size_type aligned_size() const noexcept
+        {
+            return aligned_;
+        }
+
+        /**
+         * @brief Calls `func(key, value_0&, value_1&, ...)` for every element of the aligned
+         *        prefix, as a linear scan over the dense arrays.
+         *
+         * Requires a preceding align() with no structural modification since.
+         */
+        template <typename Func>
+        void each_aligned(Func&& func)
+        {
+            each_aligned_impl(func, std::index_sequence_for<Sets...>{});
+        }
+
+    private:
+        template <std::size_t I>
+        using set_t = std::tuple_element_t<I, std::tuple<Sets...>>;
+
+        template <typename Func, std::size_t... Is>
+        void each_impl(Func& func, std::index_sequence<Is...> seq)
+        {
+            const size_type d = driver();
+            ((d == Is ? each_driven_by<Is>(func, seq) : void()), ...);
+        }
+
+        template <std::size_t D, typename Func, std::size_t... Is>
+        void each_driven_by(Func& func, std::index_sequence<Is...>)
+        {
+            const auto& keys = std::get<D>(sets_).keys();
+            std::array<size_type, set_count> idx{};
+            for (size_type i = 0; i < keys.size(); ++i) {
+                const key_type key = keys[i];
+                const bool in_all = ((idx[Is] = (Is == D ? i : std::get<Is>(sets_).index_of(key)),
+                                      idx[Is] != set_t<Is>::INVALID_INDEX) && ...);
+                if (in_all) {
+                    func(key, std::get<Is>(sets_).data()[idx[Is]]...);
+                }
+            }
+        }
+
+        template <std::size_t... Is>
+        size_type align_impl(std::index_sequence<Is...> seq)
+        {
+            const size_type d = driver();
+            size_type n = 0;
+            ((d == Is ? (void)(n = align_driven_by<Is>(seq)) : void()), ...);
+            return n;
+        }
+
+        template <std::size_t D, std::size_t... Is>
+        size_type align_driven_by(std::index_sequence<Is...>)
+        {
+            auto& driver_set = std::get<D>(sets_);
+            std::array<size_type, set_count> idx{};
+            size_type n = 0;
+            // Partition: matching keys are swapped to the front. Position i only ever
+            // receives an already visited, non-matching element, so the scan stays valid.
+            for (size_type i = 0; i < driver_set.size(); ++i) {
+                const key_type key = driver_set.keys()[i];
+                const bool in_all = ((idx[Is] = (Is == D ? i : std::get<Is>(sets_).index_of(key)),
+                                      idx[Is] != set_t<Is>::INVALID_INDEX) && ...);
+                if (in_all) {
+                    (std::get<Is>(sets_).swap_dense(idx[Is], n), ...);
+                    ++n;
+                }
+            }
+            return n;
+        }
+
+        template <typename Func, std::size_t... Is>
+        void each_aligned_impl(Func& func, std::index_sequence<Is...>)
+        {
+            assert(((std::get<Is>(sets_).size() >= aligned_) && ...));
+            const auto& keys = std::get<0>(sets_).keys();
+            const std::tuple<decltype(std::get<Is>(sets_).data())...> values{ std::get<Is>(sets_).data()... };
+            for (size_type i = 0; i < aligned_; ++i) {
+                func(keys[i], std::get<Is>(values)[i]...);
+            }
+        }
+
+        std::tuple<Sets&...> sets_;
+        size_type            aligned_ = 0;
+    };
+
+    /**
+     * @brief Creates a SparseSetJoin over @p sets.
+     */
+    template <typename... Sets>
+    SparseSetJoin<Sets...> join(Sets&... sets) noexcept
+    {
+        return SparseSetJoin<Sets...>(sets...);
+    }
+
+} // namespace lux::cxx
@@ -0,0 +1,428 @@
+#pragma once
+/**
+ * @file SparseSetSoA.hpp
+ * @brief A sparse set storing each value column in its own contiguous array
+ *        (structure-of-arrays), for component-style storage.
+ *
+ * @copyright
+ * Copyright (c) 2025 Chenhui Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <lux/cxx/container/SparseSet.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lux::cxx
+{
+    /**
+     * @class SparseSetSoA
+     * @brief A sparse set whose values are split into independent, contiguous columns.
+     *
+     * Where OffsetSparseSet keeps one `dense_values_` array of whole objects, this
+     * variant keeps one array per column type. All columns, together with the dense key
+     * array, are kept index-aligned by insert() and the swap-and-pop in erase(), so
+     * `column<I>()[i]` always belongs to `keys()[i]`.
+     *
+     * Iterating one field therefore touches only that field's array (`column<I>()`
+     * returns a span suitable for vectorized loops), while `zip<Is...>()` walks several
+     * columns in lockstep.
+     *
+     * @tparam Key     The integral type of the key (keys must be >= 0).
+     * @tparam Columns The value types, one dense array each; bool is not allowed.
+     */
+    template <typename Key, typename... Columns>
+    class SparseSetSoA
+    {
+        static_assert(std::is_integral_v<Key>,
+            "SparseSetSoA: Key must be an integral type.");
+        static_assert(sizeof...(Columns) > 0,
+            "SparseSetSoA: at least one column is required.");
+        static_assert((!std::is_same_v<std::remove_cv_t<Columns>, bool> && ...),
+            "SparseSetSoA: bool columns are not supported (std::vector<bool> has no contiguous storage); use std::uint8_t.");
+
+    public:
+        using size_type = std::size_t;
+        using key_type  = Key;
+
+        /**
+         * @brief The value type of column @p I.
+         */
+        template <std::size_t I>
+        using column_type = std::tuple_element_t<I, std::tuple<Columns...>>;
+
+        static constexpr size_type column_count = sizeof...(Columns);
+
+        /**
+         * @brief Constant representing an absent key / invalid dense index.
+         */
+        static constexpr size_type INVALID_INDEX =
+            (std::numeric_limits<size_type>::max)();
+
+        /**
+         * @brief A forward range yielding `std::tuple<Key, column_type<Is>&...>` per element.
+         */
+        template <bool Const, std::size_t... Is>
+        class ZipView
+        {
+            template <std::size_t I>
+            using column_ptr = std::conditional_t<Const, const column_type<I>*, column_type<I>*>;
+
+            template <std::size_t I>
+            using column_ref = std::conditional_t<Const, const column_type<I>&, column_type<I>&>;
+
+            using pointers = std::tuple<column_ptr<Is>...>;
+
+        public:
+            using reference = std::tuple<Key, column_ref<Is>...>;
+
+            class iterator
+            {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = reference;
+                using difference_type   = std::ptrdiff_t;
+
+                iterator() = default;
+
+                iterator(const Key* keys, pointers columns, size_type index) noexcept
+                    : keys_(keys), columns_(columns), index_(index)
+                {
+                }
+
+                reference operator*() const
+                {
+                    return std::apply([this](auto*... column) {
+                        return reference(keys_[index_], column[index_]...);
+                    }, columns_);
+                }
+
+                iterator& operator++() noexcept
+                {
+                    ++index_;
+                    return *this;
+                }
+
+                iterator operator++(int) noexcept
+                {
+                    iterator tmp = *this;
+                    ++index_;
+                    return tmp;
+                }
+
+                bool operator==(const iterator& other) const noexcept { return index_ == other.index_; }
+                bool operator!=(const iterator& other) const noexcept { return index_ != other.index_; }
+
+            private:
+                const Key* keys_ = nullptr;
+                pointers   columns_{};
+                size_type  index_ = 0;
+            };
+
+            ZipView(const Key* keys, pointers columns, size_type size) noexcept
+                : keys_(keys), columns_(columns), size_(size)
+            {
+            }
+
+            iterator  begin() const noexcept { return iterator(keys_, columns_, 0); }
+            iterator  end()   const noexcept { return iterator(keys_, columns_, size_); }
+            size_type size()  const noexcept { return size_; }
+            bool      empty() const noexcept { return size_ == 0; }
+
+        private:
+            const Key* keys_;
+            pointers   columns_;
+            size_type  size_;
+        };
+
+        /**
+         * @brief Default constructor; does not allocate any storage.
+         */
+        SparseSetSoA() = default;
+
+        /**
+         * @brief Constructor with initial capacity for the dense arrays.
+         * @param initial_capacity The initial capacity to reserve in every dense array.
+         */
+        explicit SparseSetSoA(size_type initial_capacity)
+        {
+            reserve(initial_capacity);
+        }
+
+        /**
+         * @brief Returns the number of stored elements.
+         */
+        size_type size() const noexcept
+        {
+            return dense_keys_.size();
+        }
+
+        /**
+         * @brief Checks if the set is empty.
+         */
+        bool empty() const noexcept
+        {
+            return dense_keys_.empty();
+        }
+
+        /**
+         * @brief Reserves storage for at least @p new_capacity elements in every dense array.
+         */
+        void reserve(size_type new_capacity)
+        {
+            dense_keys_.reserve(new_capacity);
+            std::apply([new_capacity](auto&... column) { (column.reserve(new_capacity), ...); }, columns_);
+        }
+
+        /**
+         * @brief Removes all elements, clearing the sparse array, keys and every column.
+         */
+        void clear()
+        {
+            dense_keys_.clear();
+            std::apply([](auto&... column) { (column.clear(), ...); }, columns_);
+            sparse_.clear();
+        }
+
+        /**
+         * @brief Checks if a given key is in the set.
+         */
+        bool contains(Key key) const
+        {
+            return index_of(key) != INVALID_INDEX;
+        }
+
+        /**
+         * @brief Returns the dense index of @p key, or INVALID_INDEX if absent.
+         */
+        size_type index_of(Key key) const noexcept
+        {
+            if constexpr (std::is_signed_v<Key>) {
+                if (key < 0) {
+                    return INVALID_INDEX;
+                }
+            }
+            return sparse_.get(toIndex(key));
+        }
+
+        /**
+         * @brief Inserts or updates the row of @p key, one value per column.
+         *
+         * If the key already exists, each column value is overwritten. Otherwise a new
+         * row is appended to every column. If constructing a column value throws, the
+         * columns appended so far are rolled back.
+         *
+         * @param key    The key to insert or update.
+         * @param values One value per column, in column order.
+         * @return The dense index of the row.
+         * @throws std::out_of_range if key < 0.
+         */
+        template <typename... Args>
+        size_type insert(Key key, Args&&... values)
+        {
+            static_assert(sizeof...(Args) == sizeof...(Columns),
+                "SparseSetSoA::insert: one value per column is required.");
+            checkKeyValid(key);
+
+            size_type& slot = sparse_.ensure(toIndex(key));
+            if (slot != INVALID_INDEX) {
+                assign_row(slot, std::index_sequence_for<Columns...>{}, std::forward<Args>(values)...);
+                return slot;
+            }
+
+            const size_type idx = dense_keys_.size();
+            dense_keys_.push_back(key);
+            try {
+                push_row(std::index_sequence_for<Columns...>{}, std::forward<Args>(values)...);
+            }
+            catch (...) {
+                dense_keys_.pop_back();
+                throw;
+            }
+            slot = idx;
+            sparse_.on_insert(toIndex(key));
+            return idx;
+        }
+
+        /**
+         * @brief Removes the row of @p key from every column ("swap with last").
+         * @return True if the key was removed, false if it was not found.
+         */
+        bool erase(Key key)
+        {
+            const size_type i = index_of(key);
+            if (i == INVALID_INDEX) {
+                return false;
+            }
+
+            const size_type last = dense_keys_.size() - 1;
+            if (i != last) {
+                const Key last_key = dense_keys_[last];
+                dense_keys_[i] = last_key;
+                std::apply([i, last](auto&... column) { ((column[i] = std::move(column[last])), ...); }, columns_);
+                sparse_.set(toIndex(last_key), i);
+            }
+            dense_keys_.pop_back();
+            std::apply([](auto&... column) { (column.pop_back(), ...); }, columns_);
+            sparse_.set(toIndex(key), INVALID_INDEX);
+            sparse_.on_erase(toIndex(key));
+            return true;
+        }
+
+        /**
+         * @brief Returns the column-@p I value of @p key.
+         * @throws std::out_of_range if the key is not found.
+         */
+        template <std::size_t I>
+        column_type<I>& get(Key key)
+        {
+            return std::get<I>(columns_)[checkedIndex(key)];
+        }
+
+        template <std::size_t I>
+        const column_type<I>& get(Key key) const
+        {
+            return std::get<I>(columns_)[checkedIndex(key)];
+        }
+
+        /**
+         * @brief Returns a const reference to the dense array of keys.
+         */
+        const std::vector<Key>& keys() const noexcept
+        {
+            return dense_keys_;
+        }
+
+        /**
+         * @brief Returns the dense array of column @p I, aligned with keys().
+         */
+        template <std::size_t I>
+        std::span<column_type<I>> column() noexcept
+        {
+            return std::span<column_type<I>>(std::get<I>(columns_));
+        }
+
+        template <std::size_t I>
+        std::span<const column_type<I>> column() const noexcept
+        {
+            return std::span<const column_type<I>>(std::get<I>(columns_));
+        }
+
+        /**
+         * @brief Returns a view iterating the key and columns @p Is... in lockstep.
+         */
+        template <std::size_t... Is>
+        ZipView<false, Is...> zip() noexcept
+        {
+            return ZipView<false, Is...>(dense_keys_.data(), { std::get<Is>(columns_).data()... }, size());
+        }
+
+        template <std::size_t... Is>
+        ZipView<true, Is...> zip() const noexcept
+        {
+            return ZipView<true, Is...>(dense_keys_.data(), { std::get<Is>(columns_).data()... }, size());
+        }
+
+        /**
+         * @brief Returns a view iterating the key and every column in lockstep.
+         */
+        auto zip_all() noexcept
+        {
+            return zip_all_impl(*this, std::index_sequence_for<Columns...>{});
+        }
+
+        auto zip_all() const noexcept
+        {
+            return zip_all_impl(*this, std::index_sequence_for<Columns...>{});
+        }
+
+    private:
+        template <typename Self, std::size_t... Is>
+        static auto zip_all_impl(Self& self, std::index_sequence<Is...>) noexcept
+        {
+            return self.template zip<Is...>();
+        }
+
+        template <std::size_t... Is, typename... Args>
+        void push_row(std::index_sequence<Is...>, Args&&... values)
+        {
+            std::size_t pushed = 0;
+            try {
+                ((std::get<Is>(columns_).emplace_back(std::forward<Args>(values)), ++pushed), ...);
+            }
+            catch (...) {
+                ((Is < pushed ? std::get<Is>(columns_).pop_back() : void()), ...);
+                throw;
+            }
+        }
+
+        template <std::size_t... Is, typename... Args>
+        void assign_row(size_type idx, std::index_sequence<Is...>, Args&&... values)
+        {
+            ((std::get<Is>(columns_)[idx] = std::forward<Args>(values)), ...);
+        }
+
+        size_type checkedIndex(Key key) const
+        {
+            const size_type idx = index_of(key);
+            if (idx == INVALID_INDEX) {
+                throw std::out_of_range("SparseSetSoA: key not found.");
+            }
+            return idx;
+        }
+
+        static constexpr size_type toIndex(Key key)
+        {
+            return static_cast<size_type>(key);
+        }
+
+        static void checkKeyValid([[maybe_unused]] Key key)
+        {
+            if constexpr (std::is_signed_v<Key>) {
+                if (key < 0) {
+                    throw std::out_of_range("SparseSetSoA: key < 0.");
+                }
+            }
+        }
+
+        /**
+         * @brief sparse_[key] stores the dense row of key, INVALID_INDEX if absent.
+         */
+        detail::FlatSparseArray<size_type>   sparse_;
+
+        /**
+         * @brief Dense array of keys, aligned with every column.
+         */
+        std::vector<Key>                     dense_keys_;
+
+        /**
+         * @brief One dense array per column.
+         */
+        std::tuple<std::vector<Columns>...>  columns_;
+    };
+
+} // namespace lux::cxx
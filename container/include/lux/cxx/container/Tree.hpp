@@ -21,11 +21,17 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <lux/cxx/concurrent/ThreadPool.hpp>
 
 namespace lux::cxx
 {
@@ -422,6 +428,206 @@ namespace lux::cxx
         std::vector<std::unique_ptr<self_type>> children_;
     };
 
+    /**
+     * @brief Storage order of the nodes of an IndexedNaryTreeSoA.
+     *
+     * Unordered is creation order. PreOrder places every subtree in one contiguous
+     * index range starting at its root; BreadthFirst places the nodes level by level
+     * (all roots, then all their children, ...), with the children of a node adjacent
+     * and in slot order.
+     */
+    enum class TreeLayout
+    {
+        Unordered,
+        PreOrder,
+        BreadthFirst
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Child table storing an array of N child indices per node (-1 for an empty slot).
+         *
+         * childIndex() is one load, but every node pays for N slots however many it uses.
+         */
+        template<std::size_t N>
+        class FixedChildTable
+        {
+        public:
+            static constexpr std::size_t bytes_per_node = sizeof(std::array<int, N>);
+
+            void push_back() { slots_.emplace_back().fill(-1); }
+
+            void resize(std::size_t count)
+            {
+                std::array<int, N> empty;
+                empty.fill(-1);
+                slots_.resize(count, empty);
+            }
+
+            int get(int node, int slot) const noexcept { return slots_[node][slot]; }
+
+            /// Puts child into the empty slot.
+            void link(int node, int slot, int child) noexcept { slots_[node][slot] = child; }
+
+            /// Empties the slot and returns the child that was there, or -1.
+            int unlink(int node, int slot) noexcept { return std::exchange(slots_[node][slot], -1); }
+
+            /// Drops every child link of node.
+            void clear(int node) noexcept { slots_[node].fill(-1); }
+
+            /// Calls f(slot, child) for every occupied slot, in slot order.
+            template<typename F>
+            void forEachChild(int node, F&& f) const
+            {
+                const std::array<int, N>& row = slots_[node];
+                for (std::size_t slot = 0; slot < N; ++slot) {
+                    if (row[slot] != -1) {
+                        f(static_cast<int>(slot), row[slot]);
+                    }
+                }
+            }
+
+            /// Sets the links of node `to` to those of `from` in src, renumbered through remap.
+            void assign(int to, const FixedChildTable& src, int from, const std::vector<int>& remap) noexcept
+            {
+                const std::array<int, N> row = src.slots_[from];
+                for (std::size_t slot = 0; slot < N; ++slot) {
+                    slots_[to][slot] = row[slot] == -1 ? -1 : remap[row[slot]];
+                }
+            }
+
+        private:
+            std::vector<std::array<int, N>> slots_;
+        };
+
+        /**
+         * @brief Child table storing a first-child / next-sibling list per node.
+         *
+         * Each node keeps its first child, its next sibling and the slot it occupies in its
+         * parent; siblings stay sorted by slot. A node costs the same however many children
+         * it has, and walking the children touches only the ones that exist. childIndex()
+         * and linking walk the sibling list.
+         */
+        template<std::size_t N>
+        class SiblingChildTable
+        {
+            using slot_type = std::conditional_t<(N <= 256), std::uint8_t, std::uint32_t>;
+
+        public:
+            static constexpr std::size_t bytes_per_node = 2 * sizeof(int) + sizeof(slot_type);
+
+            void push_back()
+            {
+                first_.push_back(-1);
+                next_.push_back(-1);
+                slot_.push_back(0);
+            }
+
+            void resize(std::size_t count)
+            {
+                first_.resize(count, -1);
+                next_.resize(count, -1);
+                slot_.resize(count, 0);
+            }
+
+            int get(int node, int slot) const noexcept
+            {
+                const auto s = static_cast<slot_type>(slot);
+                int c = first_[node];
+                while (c != -1 && slot_[c] < s) {
+                    c = next_[c];
+                }
+                return (c != -1 && slot_[c] == s) ? c : -1;
+            }
+
+            /// Puts child into the empty slot, keeping the siblings sorted by slot.
+            void link(int node, int slot, int child) noexcept
+            {
+                const auto s = static_cast<slot_type>(slot);
+                int* at = &first_[node];
+                while (*at != -1 && slot_[*at] < s) {
+                    at = &next_[*at];
+                }
+                next_[child] = *at;
+                slot_[child] = s;
+                *at = child;
+            }
+
+            /// Empties the slot and returns the child that was there, or -1.
+            int unlink(int node, int slot) noexcept
+            {
+                const auto s = static_cast<slot_type>(slot);
+                int* at = &first_[node];
+                while (*at != -1 && slot_[*at] < s) {
+                    at = &next_[*at];
+                }
+                const int c = *at;
+                if (c == -1 || slot_[c] != s) {
+                    return -1;
+                }
+                *at = next_[c];
+                next_[c] = -1;
+                return c;
+            }
+
+            /// Drops every child link of node, and its own sibling link.
+            void clear(int node) noexcept
+            {
+                first_[node] = -1;
+                next_[node] = -1;
+            }
+
+            /// Calls f(slot, child) for every child, in slot order.
+            template<typename F>
+            void forEachChild(int node, F&& f) const
+            {
+                for (int c = first_[node]; c != -1; c = next_[c]) {
+                    f(static_cast<int>(slot_[c]), c);
+                }
+            }
+
+            /// Sets the links of node `to` to those of `from` in src, renumbered through remap.
+            void assign(int to, const SiblingChildTable& src, int from, const std::vector<int>& remap) noexcept
+            {
+                const int first = src.first_[from];
+                const int next = src.next_[from];
+                const slot_type slot = src.slot_[from];
+                first_[to] = first == -1 ? -1 : remap[first];
+                next_[to] = next == -1 ? -1 : remap[next];
+                slot_[to] = slot;
+            }
+
+        private:
+            std::vector<int>       first_;
+            std::vector<int>       next_;
+            std::vector<slot_type> slot_;
+        };
+    } // namespace detail
+
+    /**
+     * @brief IndexedNaryTreeSoA children policy: a fixed array of N child slots per node (the default).
+     *
+     * Best when most nodes use most of their slots.
+     */
+    struct FixedChildrenPolicy
+    {
+        template<std::size_t N>
+        using children_t = detail::FixedChildTable<N>;
+    };
+
+    /**
+     * @brief IndexedNaryTreeSoA children policy: first-child / next-sibling links.
+     *
+     * Constant per-node cost independent of N, for wide trees whose nodes use few slots.
+     * childIndex() becomes linear in the number of children.
+     */
+    struct SiblingChildrenPolicy
+    {
+        template<std::size_t N>
+        using children_t = detail::SiblingChildTable<N>;
+    };
+
     /**
      * @brief An indexed N-ary tree (with fixed branching factor N) stored in a single array (SoA structure).
      *
@@ -430,15 +636,49 @@ namespace lux::cxx
      * an integer index rather than by pointer. This can improve data locality for certain
      * access patterns and reduce pointer-related overhead.
      *
-     * @tparam T Data type stored in each node.
-     * @tparam N Maximum number of children per node.
+     * Traversals use an explicit stack, so arbitrarily deep trees are safe. Nodes are
+     * stored in creation order until relayout() permutes them into pre-order or
+     * breadth-first order; while that layout holds, subtree sizes are known and the
+     * pre-order traversals become a linear scan. Any structural change reverts the
+     * layout to TreeLayout::Unordered.
+     *
+     * Every node also carries a dirty flag for top-down propagation (e.g. local to world
+     * transforms): propagateDown() recomputes dirty nodes and everything below them, and
+     * its ThreadPool overload processes each depth level of the breadth-first layout in
+     * parallel.
+     *
+     * eraseSubtree() frees nodes for reuse by later creations; each index carries a
+     * generation that is bumped when it is freed, so a NodeHandle taken earlier can be
+     * checked for staleness. compact() closes the holes left behind.
+     *
+     * How child links are stored is set by ChildPolicy: FixedChildrenPolicy keeps N slots
+     * per node, SiblingChildrenPolicy keeps first-child / next-sibling links. Both expose
+     * the same slot-based API.
+     *
+     * @tparam T           Data type stored in each node.
+     * @tparam N           Maximum number of children per node.
+     * @tparam ChildPolicy FixedChildrenPolicy or SiblingChildrenPolicy.
      */
-    template<typename T, std::size_t N>
+    template<typename T, std::size_t N, typename ChildPolicy = FixedChildrenPolicy>
     class IndexedNaryTreeSoA
     {
     public:
         using value_type = T;
         using size_type = std::size_t;
+        using children_t = typename ChildPolicy::template children_t<N>;
+
+        /**
+         * @brief A node index paired with the generation it had when the handle was taken.
+         */
+        struct NodeHandle
+        {
+            int           index = -1;
+            std::uint32_t generation = 0;
+
+            /// Returns false for a default-constructed handle.
+            [[nodiscard]] bool valid() const noexcept { return index != -1; }
+            friend bool operator==(const NodeHandle&, const NodeHandle&) = default;
+        };
 
         // ---------------------- Constructors ---------------------- //
 
@@ -463,14 +703,10 @@ namespace lux::cxx
             if (rootIndex_ != -1) {
                 throw std::runtime_error("Root already exists!");
             }
-            int newIndex = static_cast<int>(values_.size());
-
-            values_.push_back(val);
-            parents_.push_back(-1);    // Root has no parent
-            children_.push_back({});
-            children_[newIndex].fill(-1);
+            int newIndex = allocateNode(-1, val);    // Root has no parent
 
             rootIndex_ = newIndex;
+            invalidateLayout();
             return newIndex;
         }
 
@@ -489,14 +725,10 @@ namespace lux::cxx
             if (rootIndex_ != -1) {
                 throw std::runtime_error("Root already exists!");
             }
-            int newIndex = static_cast<int>(values_.size());
-
-            values_.emplace_back(std::forward<Args>(args)...);
-            parents_.push_back(-1);    // Root has no parent
-            children_.push_back({});
-            children_[newIndex].fill(-1);
+            int newIndex = allocateNode(-1, std::forward<Args>(args)...);    // Root has no parent
 
             rootIndex_ = newIndex;
+            invalidateLayout();
             return newIndex;
         }
 
@@ -515,18 +747,14 @@ namespace lux::cxx
             checkIndexValid(parentIdx);
             checkChildSlot(childSlot);
 
-            if (children_[parentIdx][childSlot] != -1) {
+            if (children_.get(parentIdx, childSlot) != -1) {
                 throw std::runtime_error("Child slot is already occupied.");
             }
 
-            int newIndex = static_cast<int>(values_.size());
-
-            values_.push_back(val);
-            parents_.push_back(parentIdx);
-            children_.push_back({});
-            children_[newIndex].fill(-1);
+            int newIndex = allocateNode(parentIdx, val);
 
-            children_[parentIdx][childSlot] = newIndex;
+            children_.link(parentIdx, childSlot, newIndex);
+            invalidateLayout();
             return newIndex;
         }
 
@@ -547,18 +775,14 @@ namespace lux::cxx
             checkIndexValid(parentIdx);
             checkChildSlot(childSlot);
 
-            if (children_[parentIdx][childSlot] != -1) {
+            if (children_.get(parentIdx, childSlot) != -1) {
                 throw std::runtime_error("Child slot is already occupied.");
             }
 
-            int newIndex = static_cast<int>(values_.size());
-
-            values_.emplace_back(std::forward<Args>(args)...);
-            parents_.push_back(parentIdx);
-            children_.push_back({});
-            children_[newIndex].fill(-1);
+            int newIndex = allocateNode(parentIdx, std::forward<Args>(args)...);
 
-            children_[parentIdx][childSlot] = newIndex;
+            children_.link(parentIdx, childSlot, newIndex);
+            invalidateLayout();
             return newIndex;
         }
 
@@ -607,7 +831,23 @@ namespace lux::cxx
         {
             checkIndexValid(idx);
             checkChildSlot(slot);
-            return children_[idx][slot];
+            return children_.get(idx, slot);
+        }
+
+        /**
+         * @brief Calls f(slot, childIdx) for every occupied child slot of a node, in slot order.
+         *
+         * Cheaper than probing every slot with childIndex(), especially under SiblingChildrenPolicy.
+         *
+         * @tparam F A callable with signature: void(int slot, int childIdx).
+         * @param idx The index of the node.
+         * @param f   The function called for each child.
+         */
+        template<typename F>
+        void forEachChild(int idx, F&& f) const
+        {
+            checkIndexValid(idx);
+            children_.forEachChild(idx, f);
         }
 
         /**
@@ -625,14 +865,167 @@ namespace lux::cxx
             checkIndexValid(parentIdx);
             checkChildSlot(childSlot);
 
-            int cIdx = children_[parentIdx][childSlot];
+            // Reset parent slot
+            int cIdx = children_.unlink(parentIdx, childSlot);
             if (cIdx == -1) {
                 return; // No child at this slot.
             }
-            // Reset child's parent index
+            // Reset child's parent index; it now has no parent value to derive from.
             parents_[cIdx] = -1;
-            // Reset parent slot
-            children_[parentIdx][childSlot] = -1;
+            dirty_[cIdx] = 1;
+            anyDirty_ = true;
+            invalidateLayout();
+        }
+
+        /**
+         * @brief Unlinks a node from its parent and frees it together with all of its descendants.
+         *
+         * Freed indices go on a free list and are handed out again by later creations; their
+         * generations are bumped, so handles to them stop resolving. Erasing the root leaves
+         * the tree without one.
+         *
+         * @param idx The index of the subtree root to erase.
+         * @return The number of nodes freed.
+         */
+        size_type eraseSubtree(int idx)
+        {
+            checkIndexValid(idx);
+
+            const int p = parents_[idx];
+            if (p != -1) {
+                int slot = -1;
+                children_.forEachChild(p, [&](int s, int c) {
+                    if (c == idx) {
+                        slot = s;
+                    }
+                });
+                children_.unlink(p, slot);
+            }
+            if (idx == rootIndex_) {
+                rootIndex_ = -1;
+            }
+
+            size_type count = 0;
+            std::vector<int> stack{ idx };
+            while (!stack.empty()) {
+                int cur = stack.back();
+                stack.pop_back();
+                children_.forEachChild(cur, [&](int, int c) { stack.push_back(c); });
+                if constexpr (std::is_default_constructible_v<T> && std::is_move_assignable_v<T>) {
+                    values_[cur] = T();    // release what the value owns now, not on reuse
+                }
+                parents_[cur] = kFreedNode;
+                children_.clear(cur);
+                dirty_[cur] = 0;
+                ++generations_[cur];
+                freeList_.push_back(cur);
+                ++count;
+            }
+            invalidateLayout();
+            return count;
+        }
+
+        /**
+         * @brief Renumbers the live nodes contiguously, keeping their relative order.
+         *
+         * Nodes that move get a generation above any issued at their new index, so handles
+         * taken before the call never resolve to a different node; carry live handles over
+         * with remapHandle(). Layout and dirty flags are unchanged, and so is storage when
+         * there is nothing to close.
+         *
+         * @return A remap table with remap[oldIndex] == newIndex, or -1 for freed indices.
+         */
+        std::vector<int> compact()
+        {
+            const int n = static_cast<int>(values_.size());
+            std::vector<int> remap(n, -1);
+            int live = 0;
+            for (int i = 0; i < n; ++i) {
+                if (parents_[i] != kFreedNode) {
+                    remap[i] = live++;
+                }
+            }
+            if (live == n) {
+                return remap;
+            }
+
+            const std::vector<std::uint32_t> floors = generationFloors();
+            // remap[i] <= i, so moving front to back never overwrites an unread node.
+            for (int i = 0; i < n; ++i) {
+                const int to = remap[i];
+                if (to == -1) {
+                    continue;
+                }
+                if (to != i) {
+                    values_[to] = std::move(values_[i]);
+                    generations_[to] = floors[to];
+                }
+                parents_[to] = parents_[i] == -1 ? -1 : remap[parents_[i]];
+                children_.assign(to, children_, i, remap);
+                dirty_[to] = dirty_[i];
+            }
+            values_.erase(values_.begin() + live, values_.end());
+            parents_.resize(live);
+            children_.resize(live);
+            dirty_.resize(live);
+            generations_.resize(live);
+            retireGenerations(floors, live);
+            freeList_.clear();
+            if (rootIndex_ != -1) {
+                rootIndex_ = remap[rootIndex_];
+            }
+
+            parentsFirst_ = true;
+            for (int i = 0; i < live; ++i) {
+                parentsFirst_ = parentsFirst_ && parents_[i] < i;
+            }
+            return remap;
+        }
+
+        /**
+         * @brief Returns a handle to the node at the given index.
+         * @param idx The index of a live node.
+         */
+        NodeHandle handle(int idx) const
+        {
+            checkIndexValid(idx);
+            return NodeHandle{ idx, generations_[idx] };
+        }
+
+        /**
+         * @brief Checks that the handle still refers to the node it was taken from.
+         * @param h The handle to check.
+         * @return False if the node was erased, even if its index has been reused since.
+         */
+        bool isValidHandle(NodeHandle h) const noexcept
+        {
+            return isValidIndex(h.index) && generations_[h.index] == h.generation;
+        }
+
+        /**
+         * @brief Carries a handle across the table returned by compact() or relayout().
+         *
+         * The handle must have been valid right before that call; a handle that was already
+         * stale cannot be told apart from a live one by the table alone.
+         *
+         * @param h     A handle taken before the remap.
+         * @param remap The table returned by compact() or relayout().
+         * @return The handle of the same node now, or a default handle if it was freed.
+         */
+        NodeHandle remapHandle(NodeHandle h, const std::vector<int>& remap) const
+        {
+            if (h.index < 0 || static_cast<std::size_t>(h.index) >= remap.size() || remap[h.index] == -1) {
+                return NodeHandle{};
+            }
+            return handle(remap[h.index]);
+        }
+
+        /**
+         * @brief Returns the node index of a handle, or -1 if the handle is stale.
+         */
+        int resolve(NodeHandle h) const noexcept
+        {
+            return isValidHandle(h) ? h.index : -1;
         }
 
         /**
@@ -640,6 +1033,16 @@ namespace lux::cxx
          * @return The size as a std::size_t.
          */
         size_type size() const noexcept
+        {
+            return values_.size() - freeList_.size();
+        }
+
+        /**
+         * @brief Returns one past the largest node index, freed indices included.
+         *
+         * Equal to size() when no index is waiting on the free list.
+         */
+        size_type slotCount() const noexcept
         {
             return values_.size();
         }
@@ -654,13 +1057,289 @@ namespace lux::cxx
         }
 
         /**
-         * @brief Checks if the given index is within the valid range.
+         * @brief Checks if the given index is within the valid range and refers to a live node.
          * @param idx The node index to check.
          * @return True if valid, false otherwise.
          */
         bool isValidIndex(int idx) const noexcept
         {
-            return (idx >= 0 && static_cast<size_type>(idx) < values_.size());
+            return (idx >= 0 && static_cast<size_type>(idx) < values_.size() && parents_[idx] != kFreedNode);
+        }
+
+        // ---------------------- Layout ---------------------- //
+
+        /**
+         * @brief Returns the current storage order of the nodes.
+         */
+        TreeLayout layout() const noexcept
+        {
+            return layout_;
+        }
+
+        /**
+         * @brief Returns the number of nodes in the subtree rooted at idx, including idx.
+         *
+         * O(1) while the tree is laid out by relayout(); otherwise the subtree is counted.
+         *
+         * @param idx The index of the subtree root.
+         * @return The subtree size.
+         */
+        size_type subtreeSize(int idx) const
+        {
+            checkIndexValid(idx);
+            if (layout_ != TreeLayout::Unordered) {
+                return static_cast<size_type>(subtreeSizes_[idx]);
+            }
+            size_type count = 0;
+            std::vector<int> stack{ idx };
+            while (!stack.empty()) {
+                int cur = stack.back();
+                stack.pop_back();
+                ++count;
+                children_.forEachChild(cur, [&](int, int c) { stack.push_back(c); });
+            }
+            return count;
+        }
+
+        /**
+         * @brief Permutes node storage into the given order.
+         *
+         * The root's tree comes first, followed by every detached subtree (see removeChild)
+         * in order of its old root index; in TreeLayout::BreadthFirst the trees are merged
+         * level by level so each depth is one index range (see levelRange). All node indices
+         * change and freed indices are dropped; the returned table maps each old index to its
+         * new one. Dirty flags move with their nodes; nodes whose index changes get a fresh
+         * generation as in compact(), so use remapHandle() to carry handles over.
+         * TreeLayout::Unordered only compacts (see compact()).
+         *
+         * @param order The target layout.
+         * @return A remap table with remap[oldIndex] == newIndex, or -1 for freed indices.
+         */
+        std::vector<int> relayout(TreeLayout order)
+        {
+            if (order == TreeLayout::Unordered) {
+                return compact();
+            }
+            const int n = static_cast<int>(values_.size());
+            const int live = static_cast<int>(size());
+            std::vector<int> remap(n, -1);
+
+            // sequence[newIndex] == oldIndex
+            std::vector<int> sequence;
+            sequence.reserve(live);
+            std::vector<int> tops;
+            if (rootIndex_ != -1) {
+                tops.push_back(rootIndex_);
+            }
+            for (int i = 0; i < n; ++i) {
+                if (parents_[i] == -1 && i != rootIndex_) {
+                    tops.push_back(i);
+                }
+            }
+
+            std::vector<int> levelOffsets;
+            if (order == TreeLayout::PreOrder) {
+                std::vector<int> stack;
+                for (int top : tops) {
+                    stack.push_back(top);
+                    while (!stack.empty()) {
+                        int cur = stack.back();
+                        stack.pop_back();
+                        sequence.push_back(cur);
+                        pushChildrenReversed(cur, stack);
+                    }
+                }
+            } else {
+                // The sequence itself is the BFS queue; every pass over it appends one level.
+                sequence = std::move(tops);
+                std::size_t head = 0;
+                while (head < sequence.size()) {
+                    levelOffsets.push_back(static_cast<int>(head));
+                    const std::size_t levelEnd = sequence.size();
+                    for (; head < levelEnd; ++head) {
+                        children_.forEachChild(sequence[head], [&](int, int c) { sequence.push_back(c); });
+                    }
+                }
+                levelOffsets.push_back(live);
+            }
+
+            for (int i = 0; i < live; ++i) {
+                remap[sequence[i]] = i;
+            }
+            const std::vector<std::uint32_t> floors = generationFloors();
+
+            std::vector<T> values;
+            std::vector<int> parents(live);
+            children_t children;
+            children.resize(live);
+            std::vector<std::uint8_t> dirty(live);
+            std::vector<std::uint32_t> generations(live);
+            values.reserve(live);
+            for (int i = 0; i < live; ++i) {
+                const int old = sequence[i];
+                values.push_back(std::move(values_[old]));
+                dirty[i] = dirty_[old];
+                generations[i] = old == i ? generations_[old] : floors[i];
+                parents[i] = parents_[old] == -1 ? -1 : remap[parents_[old]];
+                children.assign(i, children_, old, remap);
+            }
+            values_ = std::move(values);
+            parents_ = std::move(parents);
+            children_ = std::move(children);
+            dirty_ = std::move(dirty);
+            generations_ = std::move(generations);
+            retireGenerations(floors, live);
+            freeList_.clear();
+            if (rootIndex_ != -1) {
+                rootIndex_ = remap[rootIndex_];
+            }
+
+            // Both orders place parents before their children.
+            parentsFirst_ = true;
+            subtreeSizes_.assign(live, 1);
+            for (int i = live - 1; i >= 0; --i) {
+                if (parents_[i] != -1) {
+                    subtreeSizes_[parents_[i]] += subtreeSizes_[i];
+                }
+            }
+            levelOffsets_ = std::move(levelOffsets);
+            layout_ = order;
+            return remap;
+        }
+
+        /**
+         * @brief Returns the number of depth levels of the breadth-first layout.
+         *
+         * Throws a std::runtime_error unless the tree is laid out in TreeLayout::BreadthFirst.
+         */
+        size_type levelCount() const
+        {
+            checkBreadthFirst();
+            return levelOffsets_.size() - 1;
+        }
+
+        /**
+         * @brief Returns the index range [first, second) holding every node at the given depth.
+         *
+         * Throws a std::runtime_error unless the tree is laid out in TreeLayout::BreadthFirst,
+         * and std::out_of_range if depth >= levelCount().
+         *
+         * @param depth The depth, 0 being the roots.
+         * @return The half-open index range of that level.
+         */
+        std::pair<int, int> levelRange(size_type depth) const
+        {
+            checkBreadthFirst();
+            if (depth + 1 >= levelOffsets_.size()) {
+                throw std::out_of_range("Tree level out of range");
+            }
+            return { levelOffsets_[depth], levelOffsets_[depth + 1] };
+        }
+
+        // ---------------------- Dirty Propagation ---------------------- //
+
+        /**
+         * @brief Flags a node for recomputation by the next propagateDown().
+         *
+         * Nodes start out dirty, and a subtree detached by removeChild() is flagged as well.
+         *
+         * @param idx The index of the node whose value changed.
+         */
+        void markDirty(int idx)
+        {
+            checkIndexValid(idx);
+            dirty_[idx] = 1;
+            anyDirty_ = true;
+        }
+
+        /**
+         * @brief Checks whether the node is flagged for recomputation.
+         * @param idx The index of the node.
+         */
+        bool isDirty(int idx) const
+        {
+            checkIndexValid(idx);
+            return dirty_[idx] != 0;
+        }
+
+        /**
+         * @brief Recomputes every dirty node and all of its descendants, parents first, then
+         *        clears the dirty flags.
+         *
+         * Parents precede their children in storage unless a freed index was reused for a
+         * child of a later node, so this is normally one linear pass in any layout, and a
+         * walk from each root otherwise. A call with nothing dirty returns immediately.
+         *
+         * @tparam F A callable with signature: void(int nodeIdx, const T* parent, T& val),
+         *           where parent is nullptr for nodes without a parent.
+         * @param update The function recomputing a node from its parent.
+         */
+        template<typename F>
+        void propagateDown(F&& update)
+        {
+            if (!anyDirty_) {
+                return;
+            }
+            if (parentsFirst_) {
+                propagateRange(0, static_cast<int>(values_.size()), update);
+            } else {
+                std::vector<int> stack;
+                for (int top = 0; top < static_cast<int>(values_.size()); ++top) {
+                    if (parents_[top] != -1) {
+                        continue;
+                    }
+                    stack.push_back(top);
+                    while (!stack.empty()) {
+                        int cur = stack.back();
+                        stack.pop_back();
+                        propagateNode(cur, update);
+                        children_.forEachChild(cur, [&](int, int c) { stack.push_back(c); });
+                    }
+                }
+            }
+            std::fill(dirty_.begin(), dirty_.end(), std::uint8_t(0));
+            anyDirty_ = false;
+        }
+
+        /**
+         * @brief Parallel propagateDown(): each depth level is split into chunks run on the
+         *        pool, and the next level starts once the whole level is done.
+         *
+         * Throws a std::runtime_error unless the tree is laid out in TreeLayout::BreadthFirst.
+         * update may be called concurrently for nodes of the same level; it may only read
+         * the parent and write the node it is given.
+         *
+         * @tparam F A callable with signature: void(int nodeIdx, const T* parent, T& val).
+         * @param pool     The pool to run on; must not be the pool running the caller.
+         * @param update   The function recomputing a node from its parent.
+         * @param minChunk The fewest nodes per chunk; narrower levels run on the caller.
+         */
+        template<typename F>
+        void propagateDown(ThreadPool& pool, F&& update, int minChunk = 4096)
+        {
+            checkBreadthFirst();
+            if (!anyDirty_) {
+                return;
+            }
+            minChunk = std::max(minChunk, 1);
+            const std::size_t slots = pool.thread_count() + 1;
+            for (std::size_t level = 0; level + 1 < levelOffsets_.size(); ++level) {
+                const int begin = levelOffsets_[level];
+                const int end = levelOffsets_[level + 1];
+                const std::size_t chunks = std::max<std::size_t>(
+                    1, std::min(slots, static_cast<std::size_t>((end - begin) / minChunk)));
+                if (chunks == 1) {
+                    propagateRange(begin, end, update);
+                    continue;
+                }
+                pool.parallel_for(chunks, [&](std::size_t c) {
+                    const int count = end - begin;
+                    propagateRange(begin + static_cast<int>(count * c / chunks),
+                                   begin + static_cast<int>(count * (c + 1) / chunks), update);
+                });
+            }
+            std::fill(dirty_.begin(), dirty_.end(), std::uint8_t(0));
+            anyDirty_ = false;
         }
 
         // ---------------------- Tree Traversals ---------------------- //
@@ -668,25 +1347,54 @@ namespace lux::cxx
         /**
          * @brief Performs a pre-order traversal (current node, then children).
          *
+         * A linear scan over the subtree's index range when the tree is laid out in
+         * TreeLayout::PreOrder.
+         *
          * @tparam F A callable with signature: void(int nodeIdx, const T& val).
          * @param nodeIdx The index of the node from which to start.
          * @param visit   The visiting function to be applied to each node.
          */
         template<typename F>
         void preorderTraverse(int nodeIdx, F&& visit)
+        {
+            preorderTraversePruned(nodeIdx, [&visit](int idx, const T& val) {
+                visit(idx, val);
+                return true;
+            });
+        }
+
+        /**
+         * @brief Pre-order traversal that skips the descendants of nodes the visitor rejects.
+         *
+         * In TreeLayout::PreOrder a rejected subtree is skipped in O(1) by its size.
+         *
+         * @tparam F A callable with signature: bool(int nodeIdx, const T& val), returning
+         *           false to skip the node's descendants.
+         * @param nodeIdx The index of the node from which to start.
+         * @param visit   The visiting function to be applied to each node.
+         */
+        template<typename F>
+        void preorderTraversePruned(int nodeIdx, F&& visit)
         {
             if (nodeIdx == -1) {
                 return;
             }
-            // (1) Visit current node
-            visit(nodeIdx, values_[nodeIdx]);
+            if (layout_ == TreeLayout::PreOrder) {
+                const int end = nodeIdx + subtreeSizes_[nodeIdx];
+                for (int i = nodeIdx; i < end;) {
+                    i += visit(i, values_[i]) ? 1 : subtreeSizes_[i];
+                }
+                return;
+            }
 
-            // (2) Recursively traverse children
-            for (std::size_t slot = 0; slot < N; ++slot) {
-                int c = children_[nodeIdx][slot];
-                if (c != -1) {
-                    preorderTraverse(c, visit);
+            std::vector<int> stack{ nodeIdx };
+            while (!stack.empty()) {
+                int cur = stack.back();
+                stack.pop_back();
+                if (!visit(cur, values_[cur])) {
+                    continue;
                 }
+                pushChildrenReversed(cur, stack);
             }
         }
 
@@ -700,18 +1408,8 @@ namespace lux::cxx
         template<typename F>
         void postorderTraverse(int nodeIdx, F&& visit)
         {
-            if (nodeIdx == -1) {
-                return;
-            }
-            // (1) Traverse children
-            for (std::size_t slot = 0; slot < N; ++slot) {
-                int c = children_[nodeIdx][slot];
-                if (c != -1) {
-                    postorderTraverse(c, visit);
-                }
-            }
-            // (2) Visit current node
-            visit(nodeIdx, values_[nodeIdx]);
+            // Visiting after all N child steps gives post-order.
+            depthFirstTraverse(nodeIdx, N, visit);
         }
 
         /**
@@ -727,33 +1425,202 @@ namespace lux::cxx
          */
         template<typename F>
         void inorderTraverse(int nodeIdx, F&& visit)
+        {
+            // For multi-way trees with N>2, define mid = N/2 for demonstration.
+            depthFirstTraverse(nodeIdx, N / 2, visit);
+        }
+
+        /**
+         * @brief Performs a breadth-first traversal (level by level, children in slot order).
+         *
+         * A linear scan when the tree is laid out in TreeLayout::BreadthFirst and nodeIdx
+         * is the root of the only tree in storage.
+         *
+         * @tparam F A callable with signature: void(int nodeIdx, const T& val).
+         * @param nodeIdx The index of the node from which to start.
+         * @param visit   The visiting function to be applied to each node.
+         */
+        template<typename F>
+        void breadthFirstTraverse(int nodeIdx, F&& visit)
         {
             if (nodeIdx == -1) {
                 return;
             }
-            // For multi-way trees with N>2, define mid = N/2 for demonstration.
-            std::size_t mid = N / 2;
+            if (layout_ == TreeLayout::BreadthFirst && static_cast<size_type>(subtreeSizes_[nodeIdx]) == values_.size()) {
+                const int end = nodeIdx + subtreeSizes_[nodeIdx];
+                for (int i = nodeIdx; i < end; ++i) {
+                    visit(i, values_[i]);
+                }
+                return;
+            }
+
+            std::vector<int> queue{ nodeIdx };
+            for (std::size_t head = 0; head < queue.size(); ++head) {
+                int cur = queue[head];
+                visit(cur, values_[cur]);
+                children_.forEachChild(cur, [&](int, int c) { queue.push_back(c); });
+            }
+        }
+
+    private:
+        /**
+         * @brief Pushes the children of node so that they pop in slot order.
+         */
+        void pushChildrenReversed(int node, std::vector<int>& stack) const
+        {
+            const std::size_t mark = stack.size();
+            children_.forEachChild(node, [&](int, int c) { stack.push_back(c); });
+            std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(mark), stack.end());
+        }
 
-            // (1) Traverse the first half of the children
-            for (std::size_t slot = 0; slot < mid; ++slot) {
-                int c = children_[nodeIdx][slot];
-                if (c != -1) {
-                    inorderTraverse(c, visit);
+        /**
+         * @brief Explicit-stack depth-first walk that visits a node before its children in
+         *        slots >= visitAt and after the others.
+         *
+         * Expanding a node pushes, to pop in this order: the children before visitAt, the
+         * node itself marked for visiting, then the remaining children.
+         */
+        template<typename F>
+        void depthFirstTraverse(int nodeIdx, std::size_t visitAt, F& visit)
+        {
+            if (nodeIdx == -1) {
+                return;
+            }
+            struct Frame
+            {
+                int  node;
+                bool expanded;
+            };
+            std::vector<Frame> stack{ Frame{ nodeIdx, false } };
+            while (!stack.empty()) {
+                const Frame top = stack.back();
+                stack.pop_back();
+                if (top.expanded) {
+                    visit(top.node, values_[top.node]);
+                    continue;
                 }
+                const std::size_t mark = stack.size();
+                bool placed = false;
+                children_.forEachChild(top.node, [&](int slot, int c) {
+                    if (!placed && static_cast<std::size_t>(slot) >= visitAt) {
+                        stack.push_back(Frame{ top.node, true });
+                        placed = true;
+                    }
+                    stack.push_back(Frame{ c, false });
+                });
+                if (!placed) {
+                    stack.push_back(Frame{ top.node, true });
+                }
+                std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(mark), stack.end());
             }
-            // (2) Visit the current node
-            visit(nodeIdx, values_[nodeIdx]);
+        }
 
-            // (3) Traverse the second half of the children
-            for (std::size_t slot = mid; slot < N; ++slot) {
-                int c = children_[nodeIdx][slot];
-                if (c != -1) {
-                    inorderTraverse(c, visit);
+        /**
+         * @brief Creates a node under parentIdx (-1 for none), reusing a freed index if there is one.
+         *
+         * Links only the new node to its parent; the caller fills the parent's slot.
+         */
+        template<typename... Args>
+        int allocateNode(int parentIdx, Args&&... args)
+        {
+            int newIndex;
+            if (!freeList_.empty()) {
+                newIndex = freeList_.back();
+                values_[newIndex] = T(std::forward<Args>(args)...);
+                freeList_.pop_back();
+                parents_[newIndex] = parentIdx;
+                dirty_[newIndex] = 1;
+                parentsFirst_ = parentsFirst_ && parentIdx < newIndex;
+            } else {
+                newIndex = static_cast<int>(values_.size());
+                values_.emplace_back(std::forward<Args>(args)...);
+                parents_.push_back(parentIdx);
+                children_.push_back();
+                dirty_.push_back(1);
+                generations_.push_back(static_cast<std::size_t>(newIndex) < retiredGenerations_.size()
+                    ? retiredGenerations_[newIndex] : 0);
+            }
+            anyDirty_ = true;
+            return newIndex;
+        }
+
+        /**
+         * @brief Recomputes one node if it or its (already final) parent is dirty.
+         */
+        template<typename F>
+        void propagateNode(int i, F& update)
+        {
+            const int p = parents_[i];
+            if (p != -1 && dirty_[p]) {
+                dirty_[i] = 1;
+            }
+            if (dirty_[i]) {
+                update(i, p == -1 ? nullptr : &values_[p], values_[i]);
+            }
+        }
+
+        /**
+         * @brief Recomputes the dirty nodes in [begin, end), skipping freed indices.
+         *
+         * Every parent lies before begin or earlier in the range, and is final by then.
+         */
+        template<typename F>
+        void propagateRange(int begin, int end, F& update)
+        {
+            for (int i = begin; i < end; ++i) {
+                if (parents_[i] != kFreedNode) {
+                    propagateNode(i, update);
                 }
             }
         }
 
-    private:
+        /**
+         * @brief Returns, for every index, a generation above any handle issued there so far.
+         *
+         * A live index has issued its current generation; a freed one was bumped on erase.
+         */
+        std::vector<std::uint32_t> generationFloors() const
+        {
+            std::vector<std::uint32_t> floors(generations_.size());
+            for (std::size_t i = 0; i < floors.size(); ++i) {
+                floors[i] = generations_[i] + (parents_[i] != kFreedNode ? 1u : 0u);
+            }
+            return floors;
+        }
+
+        /**
+         * @brief Remembers the floors of the indices a remap truncated, for when storage regrows.
+         */
+        void retireGenerations(const std::vector<std::uint32_t>& floors, int live)
+        {
+            if (retiredGenerations_.size() < floors.size()) {
+                retiredGenerations_.resize(floors.size(), 0);
+            }
+            for (std::size_t i = static_cast<std::size_t>(live); i < floors.size(); ++i) {
+                retiredGenerations_[i] = floors[i];
+            }
+        }
+
+        /**
+         * @brief Drops the relayout() ordering after a structural change.
+         */
+        void invalidateLayout() noexcept
+        {
+            layout_ = TreeLayout::Unordered;
+            subtreeSizes_.clear();
+            levelOffsets_.clear();
+        }
+
+        /**
+         * @brief Throws std::runtime_error unless the tree is laid out breadth-first.
+         */
+        void checkBreadthFirst() const
+        {
+            if (layout_ != TreeLayout::BreadthFirst) {
+                throw std::runtime_error("Tree is not laid out breadth-first; call relayout() first.");
+            }
+        }
+
         // ---------------------- Validation Helpers ---------------------- //
 
         /**
@@ -779,6 +1646,9 @@ namespace lux::cxx
         }
 
     private:
+        /// Parent index stored for nodes on the free list.
+        static constexpr int kFreedNode = -2;
+
         // ---------------------- SoA Data Members ---------------------- //
 
         /// (1) Stores the values of all nodes.
@@ -787,11 +1657,38 @@ namespace lux::cxx
         /// (2) Stores the parent index of each node. A value of -1 indicates no parent.
         std::vector<int> parents_;
 
-        /// (3) Stores the child indices for each node in a fixed-size array of length N.
-        std::vector<std::array<int, N>> children_;
+        /// (3) Stores the child links of each node, as laid out by ChildPolicy.
+        children_t children_;
+
+        /// (4) Subtree size of each node; only maintained while layout_ is not Unordered.
+        std::vector<int> subtreeSizes_;
+
+        /// (5) Per-node dirty flag consumed by propagateDown().
+        std::vector<std::uint8_t> dirty_;
+
+        /// (6) Generation of each index, bumped whenever the node there is erased.
+        std::vector<std::uint32_t> generations_;
+
+        /// Start index of every depth level plus the end; only maintained in BreadthFirst layout.
+        std::vector<int> levelOffsets_;
+
+        /// Freed indices, reused last-in first-out.
+        std::vector<int> freeList_;
+
+        /// Generation floors of indices dropped by compact() or relayout(), used when they regrow.
+        std::vector<std::uint32_t> retiredGenerations_;
 
         /// The index of the root node. -1 indicates that no root has been created.
         int rootIndex_;
+
+        /// Storage order established by the last relayout().
+        TreeLayout layout_ = TreeLayout::Unordered;
+
+        /// Set whenever a dirty flag is raised, so a clean propagateDown() is free.
+        bool anyDirty_ = false;
+
+        /// True while every parent index is smaller than its children's.
+        bool parentsFirst_ = true;
     };
 
 } // namespace lux::cxx
@@ -0,0 +1,327 @@
+#include <lux/cxx/container/ConcurrentSlotMap.hpp>
+#include <lux/cxx/container/SlotMap.hpp>
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lux::cxx;
+
+#define TEST_ASSERT(cond) \
+    if (!(cond)) { \
+        std::cerr << "FAIL: " << #cond << " at line " << __LINE__ << std::endl; \
+        assert(cond); \
+    }
+
+/// Counts live instances, to check that every erased value is eventually destroyed.
+struct Tracked
+{
+    static inline std::atomic<int> alive{ 0 };
+
+    explicit Tracked(int v) : value(v) { alive.fetch_add(1); }
+    Tracked(const Tracked& o) : value(o.value) { alive.fetch_add(1); }
+    ~Tracked() { alive.fetch_sub(1); }
+
+    int value;
+};
+
+// ---- basic tests ------------------------------------------------------------
+
+void test_basic_operations()
+{
+    ConcurrentSlotMap<std::string> map;
+    auto guard = map.pin();
+
+    auto k1 = map.insert("hello");
+    auto k2 = map.emplace(3, 'x');
+    TEST_ASSERT(map.size() == 2);
+    TEST_ASSERT(map.is_valid(k1));
+    TEST_ASSERT(*map.find(k1) == "hello");
+    TEST_ASSERT(*map.find(k2) == "xxx");
+
+    TEST_ASSERT(map.erase(k1));
+    TEST_ASSERT(!map.erase(k1));
+    TEST_ASSERT(!map.is_valid(k1));
+    TEST_ASSERT(map.find(k1) == nullptr);
+    TEST_ASSERT(map.size() == 1);
+
+    // The freed slot is reused with a bumped generation: the old key stays stale.
+    auto k3 = map.insert("again");
+    TEST_ASSERT(k3.index == k1.index);
+    TEST_ASSERT(k3.gen != k1.gen);
+    TEST_ASSERT(!map.is_valid(k1));
+    TEST_ASSERT(*map.find(k3) == "again");
+
+    TEST_ASSERT(!map.is_valid(decltype(k1){}));
+    TEST_ASSERT(!map.erase(decltype(k1){}));
+
+    std::cout << "  basic operation tests passed" << std::endl;
+}
+
+void test_assign_and_read()
+{
+    ConcurrentSlotMap<int> map;
+    auto k = map.insert(1);
+
+    {
+        auto guard = map.pin();
+        const int* before = map.find(k);
+        TEST_ASSERT(map.assign(k, 2));
+        // The old value stays readable while this reader is pinned.
+        TEST_ASSERT(*before == 1);
+        TEST_ASSERT(*map.find(k) == 2);
+    }
+
+    int seen = 0;
+    TEST_ASSERT(map.read(k, [&](const int& v) { seen = v; }));
+    TEST_ASSERT(seen == 2);
+
+    map.erase(k);
+    TEST_ASSERT(!map.assign(k, 3));
+    TEST_ASSERT(!map.read(k, [&](const int&) { seen = -1; }));
+    TEST_ASSERT(seen == 2);
+
+    std::cout << "  assign and read tests passed" << std::endl;
+}
+
+void test_reclamation()
+{
+    Tracked::alive = 0;
+    {
+        ConcurrentSlotMap<Tracked> map;
+        std::vector<decltype(map)::key_t> keys;
+        for (int i = 0; i < 1000; ++i)
+            keys.push_back(map.emplace(i));
+
+        {
+            auto guard = map.pin();
+            const Tracked* pinned = map.find(keys[0]);
+            for (auto k : keys)
+                map.erase(k);
+            map.collect();
+            // Pinned before the erase: nothing may have been reclaimed under us.
+            TEST_ASSERT(pinned->value == 0);
+            TEST_ASSERT(Tracked::alive == 1000);
+        }
+
+        map.collect();
+        TEST_ASSERT(map.retired_count() == 0);
+        TEST_ASSERT(Tracked::alive == 0);
+
+        for (int i = 0; i < 10; ++i)
+            map.emplace(i);
+    }
+    // The destructor frees live values too.
+    TEST_ASSERT(Tracked::alive == 0);
+
+    std::cout << "  reclamation tests passed" << std::endl;
+}
+
+void test_for_each()
+{
+    ConcurrentSlotMap<int> map;
+    std::vector<decltype(map)::key_t> keys;
+    for (int i = 0; i < 100; ++i)
+        keys.push_back(map.insert(i));
+    for (int i = 0; i < 100; i += 2)
+        map.erase(keys[i]);
+
+    auto guard = map.pin();
+    int count = 0;
+    map.for_each([&](auto key, const int& v) {
+        TEST_ASSERT(v % 2 == 1);
+        TEST_ASSERT(key == keys[v]);
+        ++count;
+    });
+    TEST_ASSERT(count == 50);
+
+    std::cout << "  for_each tests passed" << std::endl;
+}
+
+void test_capacity_exhausted()
+{
+    ConcurrentSlotMap<int, void, 4, 2> map;
+    for (int i = 0; i < 8; ++i)
+        map.insert(i);
+
+    bool threw = false;
+    try { map.insert(8); }
+    catch (const std::length_error&) { threw = true; }
+    TEST_ASSERT(threw);
+
+    std::cout << "  capacity tests passed" << std::endl;
+}
+
+// ---- concurrency ------------------------------------------------------------
+
+void test_concurrent_insert_erase_find()
+{
+    Tracked::alive = 0;
+    {
+        ConcurrentSlotMap<Tracked> map;
+        constexpr int kWriters   = 4;
+        constexpr int kReaders   = 4;
+        constexpr int kPerWriter = 20000;
+
+        std::atomic<bool> stop{ false };
+        std::atomic<int>  bad_reads{ 0 };
+
+        // Every stored value encodes the slot index it lives in, so a reader that
+        // ever observes a value through a key of another slot detects a torn read.
+        std::vector<std::thread> readers;
+        for (int r = 0; r < kReaders; ++r)
+        {
+            readers.emplace_back([&, r] {
+                std::mt19937 rng(r);
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    auto guard = map.pin();
+                    decltype(map)::key_t key{ static_cast<std::uint32_t>(rng() % 4096), static_cast<std::uint32_t>(1 + rng() % 4) };
+                    if (const Tracked* t = map.find(key))
+                    {
+                        if (t->value != -1 && t->value != static_cast<int>(key.index))
+                            bad_reads.fetch_add(1);
+                    }
+                }
+            });
+        }
+        // is_valid() needs no pin: it must never touch a node being reclaimed.
+        readers.emplace_back([&] {
+            std::mt19937 rng(kReaders);
+            std::size_t valid = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                decltype(map)::key_t key{ static_cast<std::uint32_t>(rng() % 4096), static_cast<std::uint32_t>(1 + rng() % 4) };
+                valid += map.is_valid(key);
+                map.collect();
+            }
+            (void)valid;
+        });
+
+        std::vector<std::thread> writers;
+        for (int w = 0; w < kWriters; ++w)
+        {
+            writers.emplace_back([&] {
+                std::vector<decltype(map)::key_t> mine;
+                for (int i = 0; i < kPerWriter; ++i)
+                {
+                    // Insert a placeholder, then republish with the slot index.
+                    auto k = map.emplace(-1);
+                    map.assign(k, static_cast<int>(k.index));
+                    mine.push_back(k);
+                    if (mine.size() > 256)
+                    {
+                        TEST_ASSERT(map.erase(mine.front()));
+                        mine.erase(mine.begin());
+                    }
+                }
+                for (auto k : mine)
+                    TEST_ASSERT(map.erase(k));
+            });
+        }
+
+        for (auto& t : writers) t.join();
+        stop = true;
+        for (auto& t : readers) t.join();
+
+        TEST_ASSERT(map.empty());
+        map.collect();
+        TEST_ASSERT(map.retired_count() == 0);
+        TEST_ASSERT(Tracked::alive == 0);
+        // Placeholder values (-1) may be observed briefly; values of other slots never.
+        TEST_ASSERT(bad_reads == 0);
+    }
+    TEST_ASSERT(Tracked::alive == 0);
+
+    std::cout << "  concurrent insert/erase/find tests passed" << std::endl;
+}
+
+// ---- benchmark --------------------------------------------------------------
+
+/**
+ * Reader scaling: N threads hammer find() over a pre-populated map, against the
+ * same lookups through a SlotMap guarded by one global mutex.
+ */
+void bench_reader_scaling()
+{
+    constexpr std::size_t kElements         = 1 << 16;
+    constexpr std::size_t kLookupsPerThread = 1 << 20;
+
+    ConcurrentSlotMap<std::uint64_t>       cmap;
+    SlotMap<std::uint64_t>                 smap;
+    std::mutex                             smap_mutex;
+    std::vector<ConcurrentSlotMap<std::uint64_t>::key_t> ckeys;
+    std::vector<SlotMap<std::uint64_t>::key_t>           skeys;
+    for (std::size_t i = 0; i < kElements; ++i)
+    {
+        ckeys.push_back(cmap.insert(i));
+        skeys.push_back(smap.insert(i));
+    }
+
+    auto run = [&](std::size_t threads, auto&& body) {
+        std::vector<std::thread> pool;
+        std::atomic<std::uint64_t> sink{ 0 };
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            pool.emplace_back([&, t] {
+                std::uint64_t local = 0;
+                std::uint32_t x = static_cast<std::uint32_t>(t * 2654435761u + 1);
+                body(local, x);
+                sink.fetch_add(local, std::memory_order_relaxed);
+            });
+        }
+        for (auto& th : pool) th.join();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        TEST_ASSERT(sink.load() != 0);
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        return static_cast<double>(threads * kLookupsPerThread) / (ms * 1000.0); // Mops/s
+    };
+
+    std::cout << "  reader scaling (" << kElements << " elements, "
+              << kLookupsPerThread << " lookups/thread), Mlookups/s:" << std::endl;
+    std::cout << "    threads, ConcurrentSlotMap, mutex+SlotMap" << std::endl;
+    for (std::size_t threads : { 1u, 2u, 4u, 8u, 16u, 32u })
+    {
+        const double concurrent = run(threads, [&](std::uint64_t& local, std::uint32_t x) {
+            auto guard = cmap.pin();
+            for (std::size_t i = 0; i < kLookupsPerThread; ++i)
+            {
+                x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+                if (const auto* v = cmap.find(ckeys[x % kElements]))
+                    local += *v;
+            }
+        });
+        const double locked = run(threads, [&](std::uint64_t& local, std::uint32_t x) {
+            for (std::size_t i = 0; i < kLookupsPerThread; ++i)
+            {
+                x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+                std::lock_guard<std::mutex> lock(smap_mutex);
+                if (const auto* v = smap.find(skeys[x % kElements]))
+                    local += *v;
+            }
+        });
+        std::cout << "    " << threads << ", " << concurrent << ", " << locked << std::endl;
+    }
+}
+
+int main()
+{
+    std::cout << "concurrent_slot_map tests:" << std::endl;
+    test_basic_operations();
+    test_assign_and_read();
+    test_reclamation();
+    test_for_each();
+    test_capacity_exhausted();
+    test_concurrent_insert_erase_find();
+    bench_reader_scaling();
+    std::cout << "All concurrent_slot_map tests passed!" << std::endl;
+    return 0;
+}
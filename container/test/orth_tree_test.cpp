@@ -2,20 +2,29 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <map>
 #include <memory_resource>
 #include <numeric>
 #include <random>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Adjust the header path to match your project layout.
 #include "lux/cxx/container/OrthTree.hpp"
+#include "lux/cxx/container/PackedOrthTree.hpp"
+#include "lux/cxx/container/OrthTreeSnapshot.hpp"
+#include "lux/cxx/concurrent/ThreadPool.hpp"
 
 namespace
 {
@@ -75,6 +84,16 @@ namespace
         const std::array<float, 2>& operator()(const Point2f& p) const noexcept { return p.xy; }
     };
 
+    /// Stateful accessor: a default-constructed copy reads different positions.
+    struct ShiftedPosition
+    {
+        float shift = 0.0f;
+        std::array<float, 3> operator()(const Point3f& p) const noexcept
+        {
+            return { p.position[0] + shift, p.position[1] + shift, p.position[2] + shift };
+        }
+    };
+
     // ----------------------------
     // Utility helpers
     // ----------------------------
@@ -455,216 +474,1721 @@ namespace
     }
 
     // ============================================================
-    // Performance test: Orthtree 3D
+    // Correctness test: bulk loading
+    //
+    // A bulk-loaded tree must hold the same points as one built by
+    // incremental insertion and answer queries identically. Every leaf
+    // stays within capacity, and the parallel build is identical to the
+    // serial one.
     // ============================================================
-    void perf_orthtree_3d(const Args& a)
+    template <class Tree>
+    std::vector<std::vector<std::uint32_t>> leaf_id_lists(const Tree& tree)
     {
-        std::cout << "\n[Performance] Orthtree 3D\n";
-
-        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
-        Tree::Config cfg;
-        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
-        cfg.max_depth = 10;
-        cfg.max_points_per_leaf = 512;
+        std::vector<std::vector<std::uint32_t>> lists;
+        for (const auto& leaf : tree.captureSnapshot(true).leaves)
+        {
+            std::vector<std::uint32_t> ids;
+            for (const auto& p : leaf.points) ids.push_back(p.id);
+            lists.push_back(std::move(ids));
+        }
+        std::sort(lists.begin(), lists.end());
+        return lists;
+    }
 
-        auto pts = gen_points3(a.n_points, a.seed);
+    template <class Tree, std::size_t Dim>
+    std::vector<std::uint32_t> ids_in_box(const Tree& tree, const lux::cxx::Box<float, Dim>& region)
+    {
+        std::vector<std::uint32_t> ids;
+        tree.forEachPointInBox(region, [&](const auto& p) { ids.push_back(p.id); });
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
 
-        Tree tree(cfg);
+    template <class Tree>
+    void check_bulk_leaves(const Tree& tree, std::size_t max_leaf_points)
+    {
+        for (const auto& ids : leaf_id_lists(tree))
+            LUX_TEST_ASSERT(ids.size() <= max_leaf_points);
+    }
 
-        Timer t;
+    void test_correctness_bulk_load()
+    {
+        std::cout << "[Correctness] Orthtree bulk load\n";
 
-        // Insert all points.
-        t.start();
-        for (const auto& p : pts) tree.insert(p);
-        double insert_ms = t.ms();
-        std::cout << "Insert: " << a.n_points << " points, " << insert_ms << " ms, "
-                  << (double(a.n_points) / (insert_ms / 1000.0)) << " pts/s\n";
+        using Tree3 = lux::cxx::Orthtree<Point3f, 3, float>;
+        using Tree2 = lux::cxx::OrthtreePmr<Point2f, 2, float, GetXY>;
+        lux::cxx::ThreadPool pool(3);
 
-        // Query.
-        auto boxes = gen_query_boxes<3>(a.n_queries, a.seed + 111);
+        // 3D: serial and parallel bulk load against insert, plus out-of-bounds points.
+        {
+            Tree3::Config cfg;
+            cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+            cfg.max_depth = 8;
+            cfg.max_points_per_leaf = 64;
+
+            auto pts = gen_points3(100'000, 5, -1.2f, 1.2f);
+
+            Tree3 incremental(cfg);
+            std::size_t expect_loaded = 0;
+            for (const auto& p : pts) expect_loaded += incremental.insert(p) ? 1 : 0;
+            LUX_TEST_ASSERT(expect_loaded < pts.size());
+
+            Tree3 bulk(cfg, pts);
+            Tree3 parallel(cfg);
+            LUX_TEST_ASSERT(parallel.bulkLoad(pts, pool) == expect_loaded);
+            LUX_TEST_ASSERT(parallel.version() == 1);
+
+            LUX_TEST_ASSERT(bulk.totalAlivePoints() == expect_loaded);
+            LUX_TEST_ASSERT(parallel.nodeCount() == bulk.nodeCount());
+            LUX_TEST_ASSERT(leaf_id_lists(parallel) == leaf_id_lists(bulk));
+            check_bulk_leaves(bulk, cfg.max_points_per_leaf);
+
+            for (const auto& region : gen_query_boxes<3>(200, 8))
+                LUX_TEST_ASSERT(ids_in_box(bulk, region) == ids_in_box(incremental, region));
+
+            // The loaded tree stays fully mutable.
+            lux::cxx::Box<float,3> region({-0.4f,-0.1f,-0.3f},{0.2f,0.5f,0.1f});
+            LUX_TEST_ASSERT(bulk.markDeletedInBox(region) == incremental.markDeletedInBox(region));
+            Point3f extra({0.5f, 0.5f, 0.5f}, 999'999, 0);
+            LUX_TEST_ASSERT(bulk.insert(extra) && incremental.insert(extra));
+            bulk.compactDirtyLeaves();
+            LUX_TEST_ASSERT(bulk.totalAlivePoints() == incremental.totalAlivePoints());
+            LUX_TEST_ASSERT(ids_in_box(bulk, cfg.root_bounds) == ids_in_box(incremental, cfg.root_bounds));
+
+            // Loading again replaces the previous contents.
+            bulk.bulkLoad(std::vector<Point3f>{ extra });
+            LUX_TEST_ASSERT(bulk.totalAlivePoints() == 1 && bulk.nodeCount() == 1);
+        }
 
-        std::uint64_t total_hits = 0;
-        t.start();
-        for (const auto& b : boxes)
+        // 3D, deeper than a 64-bit code resolves: clustered and duplicate points.
         {
-            tree.forEachPointInBox(b, [&](const Point3f&) { ++total_hits; });
+            Tree3::Config cfg;
+            cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+            cfg.max_depth = 30;
+            cfg.max_points_per_leaf = 4;
+
+            auto pts = gen_points3(2'000, 6, 0.25f, 0.25001f);
+            for (std::uint32_t i = 0; i < 20; ++i)
+                pts.push_back(Point3f({-0.5f, -0.5f, -0.5f}, 100'000 + i, 0));
+
+            Tree3 incremental(cfg);
+            incremental.insertMany(pts);
+            Tree3 bulk(cfg, pts);
+
+            LUX_TEST_ASSERT(bulk.totalAlivePoints() == pts.size());
+            LUX_TEST_ASSERT(ids_in_box(bulk, cfg.root_bounds) == ids_in_box(incremental, cfg.root_bounds));
+            lux::cxx::Box<float,3> cluster({0.25f,0.25f,0.25f},{0.250004f,0.250004f,0.250004f});
+            LUX_TEST_ASSERT(ids_in_box(bulk, cluster) == ids_in_box(incremental, cluster));
+
+            // Only the duplicates, stuck at max_depth, may exceed the leaf capacity.
+            const auto leaves = leaf_id_lists(bulk);
+            LUX_TEST_ASSERT(std::count_if(leaves.begin(), leaves.end(),
+                [&](const auto& ids) { return ids.size() > cfg.max_points_per_leaf; }) == 1);
         }
-        double query_ms = t.ms();
-        std::cout << "Query: " << a.n_queries << " boxes, " << query_ms << " ms, "
-                  << (double(a.n_queries) / (query_ms / 1000.0)) << " queries/s, "
-                  << "total_hits=" << total_hits << "\n";
 
-        // Delete points inside a fixed box.
-        lux::cxx::Box<float,3> del_box({-0.3f,-0.3f,-0.3f},{0.3f,0.3f,0.3f});
-        t.start();
-        std::size_t removed = tree.markDeletedInBox(del_box);
-        double del_ms = t.ms();
-        std::cout << "Delete(box): removed=" << removed << ", " << del_ms << " ms\n";
+        // 2D with a PMR pool: allocations stay on the calling thread.
+        {
+            std::pmr::unsynchronized_pool_resource resource;
 
-        // Compact.
-        t.start();
-        std::size_t compact_removed = tree.compactDirtyLeaves();
-        double compact_ms = t.ms();
-        std::cout << "Compact: removed=" << compact_removed << ", " << compact_ms << " ms\n";
+            Tree2::Config cfg;
+            cfg.root_bounds = make_root_bounds<2>(-1.0f, 1.0f);
+            cfg.max_depth = 10;
+            cfg.max_points_per_leaf = 32;
 
-        // Snapshot.
-        t.start();
-        auto snap = tree.captureSnapshot(true);
-        double snap_ms = t.ms();
-        std::cout << "Snapshot: leaves=" << snap.leaves.size() << ", " << snap_ms << " ms\n";
+            auto pts = gen_points2(80'000, 7);
+
+            Tree2 incremental(cfg, GetXY{}, &resource);
+            incremental.insertMany(pts);
+            Tree2 bulk(cfg, GetXY{}, &resource);
+            LUX_TEST_ASSERT(bulk.bulkLoad(pts, pool) == pts.size());
+
+            check_bulk_leaves(bulk, cfg.max_points_per_leaf);
+            for (const auto& region : gen_query_boxes<2>(200, 9))
+                LUX_TEST_ASSERT(ids_in_box(bulk, region) == ids_in_box(incremental, region));
+        }
     }
 
     // ============================================================
-    // Performance test: OrthtreePmr 3D
+    // Correctness test: nearest-neighbour and ball queries
+    //
+    // kNearest / nearest / forEachPointInBall and their batched
+    // variants are checked against brute force over the alive points.
     // ============================================================
-    void perf_orthtree_pmr_3d(const Args& a)
+    template <class PointT, class GetPos, class VecLike>
+    std::vector<float> brute_knn_dist2(const std::vector<PointT>& alive, GetPos get, const VecLike& q,
+        std::size_t k, float max_d2 = std::numeric_limits<float>::max())
     {
-        std::cout << "\n[Performance] OrthtreePmr 3D (PMR)\n";
+        std::vector<float> d2s;
+        for (const auto& p : alive)
+        {
+            const auto& pos = get(p);
+            float d2 = 0.0f;
+            for (std::size_t i = 0; i < std::size(pos); ++i) { float d = float(pos[i]) - float(q[i]); d2 += d * d; }
+            if (d2 <= max_d2) d2s.push_back(d2);
+        }
+        std::sort(d2s.begin(), d2s.end());
+        if (d2s.size() > k) d2s.resize(k);
+        return d2s;
+    }
 
-        std::pmr::unsynchronized_pool_resource pool;
+    /// Squared distances agree up to rounding: with FP contraction (-mfma) the tree and the
+    /// brute force may round the same distance differently, so exact equality is too strict.
+    bool dist2_match(const std::vector<float>& got, const std::vector<float>& want)
+    {
+        if (got.size() != want.size()) return false;
+        for (std::size_t i = 0; i < got.size(); ++i)
+            if (std::abs(got[i] - want[i]) > 1e-5f * std::max(std::abs(want[i]), 1e-6f)) return false;
+        return true;
+    }
 
-        using Tree = lux::cxx::OrthtreePmr<Point3f, 3, float>;
+    /// True if no id appears twice.
+    template <class PointT>
+    bool distinct_ids(const std::vector<PointT>& pts)
+    {
+        std::vector<std::uint32_t> ids;
+        for (const auto& p : pts) ids.push_back(p.id);
+        std::sort(ids.begin(), ids.end());
+        return std::adjacent_find(ids.begin(), ids.end()) == ids.end();
+    }
+
+    void test_correctness_knn_and_ball()
+    {
+        std::cout << "[Correctness] Orthtree kNN / ball queries\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
         Tree::Config cfg;
         cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
-        cfg.max_depth = 10;
-        cfg.max_points_per_leaf = 512;
+        cfg.max_depth = 8;
+        cfg.max_points_per_leaf = 32;
 
-        auto pts = gen_points3(a.n_points, a.seed);
+        auto get = [](const Point3f& p) { return p.position; };
+        auto dist2 = [](const std::array<float, 3>& a, const std::array<float, 3>& b) {
+            float d2 = 0.0f;
+            for (std::size_t i = 0; i < 3; ++i) { float d = a[i] - b[i]; d2 += d * d; }
+            return d2;
+        };
 
-        Tree tree(cfg, {}, &pool);
+        // Empty tree.
+        {
+            Tree tree(cfg);
+            std::vector<Point3f> out;
+            LUX_TEST_ASSERT(tree.nearest(std::array<float,3>{0.0f, 0.0f, 0.0f}) == nullptr);
+            LUX_TEST_ASSERT(tree.kNearest(std::array<float,3>{0.0f, 0.0f, 0.0f}, 4, std::back_inserter(out)) == 0);
+        }
 
-        Timer t;
+        auto pts = gen_points3(20'000, 11);
+        Tree tree(cfg, pts);
 
-        // Insert all points.
-        t.start();
-        for (const auto& p : pts) tree.insert(p);
-        double insert_ms = t.ms();
-        std::cout << "Insert: " << a.n_points << " points, " << insert_ms << " ms, "
-                  << (double(a.n_points) / (insert_ms / 1000.0)) << " pts/s\n";
+        // Soft-deleted points must never be returned.
+        lux::cxx::Box<float,3> dead({-0.2f,-0.2f,-0.2f},{0.2f,0.2f,0.2f});
+        tree.markDeletedInBox(dead);
+        std::vector<Point3f> alive;
+        for (const auto& p : pts) if (!in_box(dead, p.position)) alive.push_back(p);
 
-        // Query.
-        auto boxes = gen_query_boxes<3>(a.n_queries, a.seed + 222);
+        // Queries inside, on the deleted region and outside the root bounds.
+        auto queries = gen_points3(300, 12, -1.5f, 1.5f);
+        std::vector<std::array<float,3>> centers;
+        for (const auto& q : queries) centers.push_back(q.position);
 
-        std::uint64_t total_hits = 0;
-        t.start();
-        for (const auto& b : boxes)
+        constexpr std::size_t k = 10;
+        std::vector<std::vector<std::uint32_t>> knn_ids(centers.size());
+        for (std::size_t qi = 0; qi < centers.size(); ++qi)
         {
-            tree.forEachPointInBox(b, [&](const Point3f&) { ++total_hits; });
+            const auto& c = centers[qi];
+            std::vector<Point3f> got;
+            LUX_TEST_ASSERT(tree.kNearest(c, k, std::back_inserter(got)) == k);
+            std::vector<float> got_d2;
+            for (const auto& p : got) got_d2.push_back(dist2(p.position, c));
+            LUX_TEST_ASSERT(std::is_sorted(got_d2.begin(), got_d2.end()));
+            LUX_TEST_ASSERT(dist2_match(got_d2, brute_knn_dist2(alive, get, c, k)));
+            LUX_TEST_ASSERT(distinct_ids(got));
+            for (const auto& p : got) knn_ids[qi].push_back(p.id);
+
+            const Point3f* nn = tree.nearest(c);
+            LUX_TEST_ASSERT(nn != nullptr && dist2_match({ dist2(nn->position, c) }, { got_d2.front() }));
+
+            // A search radius caps the result.
+            got.clear();
+            const float r = 0.1f;
+            const std::size_t n_in = tree.kNearest(c, k, std::back_inserter(got), r);
+            LUX_TEST_ASSERT(n_in == brute_knn_dist2(alive, get, c, k, r * r).size());
+            LUX_TEST_ASSERT((tree.nearest(c, r) == nullptr) == (n_in == 0));
+
+            // Ball query.
+            std::vector<std::uint32_t> expect_ids, got_ids;
+            for (const auto& p : alive)
+                if (in_ball<std::array<float,3>, std::array<float,3>, 3>(p.position, c, 0.2f)) expect_ids.push_back(p.id);
+            tree.forEachPointInBall(c, 0.2f, [&](const Point3f& p) { got_ids.push_back(p.id); });
+            sort_unique_ids<Point3f>(expect_ids);
+            sort_unique_ids<Point3f>(got_ids);
+            LUX_TEST_ASSERT(got_ids == expect_ids);
         }
-        double query_ms = t.ms();
-        std::cout << "Query: " << a.n_queries << " boxes, " << query_ms << " ms, "
-                  << (double(a.n_queries) / (query_ms / 1000.0)) << " queries/s, "
-                  << "total_hits=" << total_hits << "\n";
 
-        // Delete points inside a fixed box.
-        lux::cxx::Box<float,3> del_box({-0.3f,-0.3f,-0.3f},{0.3f,0.3f,0.3f});
-        t.start();
-        std::size_t removed = tree.markDeletedInBox(del_box);
-        double del_ms = t.ms();
-        std::cout << "Delete(box): removed=" << removed << ", " << del_ms << " ms\n";
+        // A ball covering the whole tree takes the full-containment path.
+        std::size_t everything = 0;
+        tree.forEachPointInBall(std::array<float,3>{0.0f, 0.0f, 0.0f}, 2.0f, [&](const Point3f&) { ++everything; });
+        LUX_TEST_ASSERT(everything == alive.size());
 
-        // Compact.
-        t.start();
-        std::size_t compact_removed = tree.compactDirtyLeaves();
-        double compact_ms = t.ms();
-        std::cout << "Compact: removed=" << compact_removed << ", " << compact_ms << " ms\n";
+        // k larger than the tree.
+        {
+            Tree small(cfg, std::vector<Point3f>(pts.begin(), pts.begin() + 5));
+            std::vector<Point3f> got;
+            LUX_TEST_ASSERT(small.kNearest(centers[0], 50, std::back_inserter(got)) == 5);
+        }
 
-        // Snapshot
-        t.start();
-        auto snap = tree.captureSnapshot(true);
-        double snap_ms = t.ms();
-        std::cout << "Snapshot: leaves=" << snap.leaves.size() << ", " << snap_ms << " ms\n";
+        // Batched variants agree with the single-query calls.
+        {
+            std::vector<std::vector<std::uint32_t>> batch_ids(centers.size());
+            tree.kNearestMany(centers, k, [&](std::size_t q, const Point3f& p) { batch_ids[q].push_back(p.id); });
+            for (std::size_t qi = 0; qi < centers.size(); ++qi)
+            {
+                LUX_TEST_ASSERT(batch_ids[qi].size() == k);
+                std::vector<float> a, b;
+                for (auto id : batch_ids[qi]) a.push_back(dist2(pts[id - 1].position, centers[qi]));
+                for (auto id : knn_ids[qi]) b.push_back(dist2(pts[id - 1].position, centers[qi]));
+                LUX_TEST_ASSERT(a == b);
+            }
+
+            std::vector<std::vector<std::uint32_t>> ball_ids(centers.size());
+            tree.forEachPointInBalls(centers, 0.15f, [&](std::size_t q, const Point3f& p) { ball_ids[q].push_back(p.id); });
+            for (std::size_t qi = 0; qi < centers.size(); ++qi)
+            {
+                std::vector<std::uint32_t> single;
+                tree.forEachPointInBall(centers[qi], 0.15f, [&](const Point3f& p) { single.push_back(p.id); });
+                sort_unique_ids<Point3f>(single);
+                sort_unique_ids<Point3f>(ball_ids[qi]);
+                LUX_TEST_ASSERT(single == ball_ids[qi]);
+            }
+        }
+
+        // 2D with a custom accessor.
+        {
+            using Tree2 = lux::cxx::Orthtree<Point2f, 2, float, GetXY>;
+            Tree2::Config cfg2;
+            cfg2.root_bounds = make_root_bounds<2>(-1.0f, 1.0f);
+            cfg2.max_depth = 10;
+            cfg2.max_points_per_leaf = 16;
+
+            auto pts2 = gen_points2(10'000, 13);
+            Tree2 tree2(cfg2, pts2, GetXY{});
+            for (const auto& q : gen_points2(100, 14))
+            {
+                std::vector<Point2f> got;
+                tree2.kNearest(q.xy, 5, std::back_inserter(got));
+                std::vector<float> got_d2;
+                for (const auto& p : got)
+                {
+                    float dx = p.xy[0] - q.xy[0], dy = p.xy[1] - q.xy[1];
+                    got_d2.push_back(dx * dx + dy * dy);
+                }
+                LUX_TEST_ASSERT(std::is_sorted(got_d2.begin(), got_d2.end()));
+                LUX_TEST_ASSERT(dist2_match(got_d2, brute_knn_dist2(pts2, GetXY{}, q.xy, 5)));
+                LUX_TEST_ASSERT(distinct_ids(got));
+            }
+        }
     }
 
-    // Optional 2-D performance test (complement to the 3-D version above).
-    void perf_orthtree_2d(const Args& a)
+    // ============================================================
+    // Correctness test: PackedOrthtree against Orthtree
+    // ============================================================
+    template <class TreeA, class TreeB>
+    void check_same_box_queries(const TreeA& a, const TreeB& b, std::uint64_t seed)
     {
-        std::cout << "\n[Performance] Orthtree 2D\n";
+        for (const auto& box : gen_query_boxes<3>(200, seed))
+        {
+            std::vector<std::uint32_t> ia, ib;
+            a.forEachPointInBox(box, [&](const Point3f& p) { ia.push_back(p.id); });
+            b.forEachPointInBox(box, [&](const Point3f& p) { ib.push_back(p.id); });
+            std::sort(ia.begin(), ia.end());
+            std::sort(ib.begin(), ib.end());
+            LUX_TEST_ASSERT(ia == ib);
+        }
+    }
 
-        using Tree = lux::cxx::Orthtree<Point2f, 2, float, GetXY>;
+    void test_correctness_packed_orthtree()
+    {
+        std::cout << "[Correctness] PackedOrthtree\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        using Packed = lux::cxx::PackedOrthtree<Point3f, 3, float>;
         Tree::Config cfg;
-        cfg.root_bounds = make_root_bounds<2>(-1.0f, 1.0f);
-        cfg.max_depth = 12;
-        cfg.max_points_per_leaf = 256;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 8;
+        cfg.max_points_per_leaf = 32;
 
-        auto pts = gen_points2(a.n_points, a.seed + 10);
+        // Empty tree.
+        {
+            Packed packed(cfg);
+            std::size_t hits = 0;
+            packed.forEachPointInBox(cfg.root_bounds, [&](const Point3f&) { ++hits; });
+            LUX_TEST_ASSERT(hits == 0 && packed.nodeCount() == 1 && packed.totalAlivePoints() == 0);
+            LUX_TEST_ASSERT(packed.nearest(std::array<float,3>{0.0f, 0.0f, 0.0f}) == nullptr);
+        }
 
-        Tree tree(cfg, GetXY{});
+        // Some points fall outside the root bounds and are skipped.
+        auto pts = gen_points3(30'000, 21, -1.1f, 1.1f);
+        Tree tree(cfg, pts);
+        Packed packed(cfg, pts);
+        LUX_TEST_ASSERT(packed.size() == tree.totalAlivePoints());
+        LUX_TEST_ASSERT(packed.totalAlivePoints() == packed.size());
+        check_same_box_queries(tree, packed, 22);
 
-        Timer t;
+        // Layout: children adjacent and after their parent, ranges nested, leaves tile the point array.
+        {
+            const auto nodes = packed.nodes();
+            std::uint32_t next_leaf_begin = 0;
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> leaf_ranges;
+            for (std::uint32_t i = 0; i < nodes.size(); ++i)
+            {
+                const auto& n = nodes[i];
+                if (n.isLeaf()) { LUX_TEST_ASSERT(n.end - n.begin <= cfg.max_points_per_leaf); continue; }
+                LUX_TEST_ASSERT(n.first_child > i && n.first_child + n.child_count <= nodes.size());
+                LUX_TEST_ASSERT(nodes[n.first_child].begin == n.begin);
+                LUX_TEST_ASSERT(nodes[n.first_child + n.child_count - 1].end == n.end);
+                for (std::uint32_t c = 0; c < n.child_count; ++c)
+                {
+                    const auto& child = nodes[n.first_child + c];
+                    LUX_TEST_ASSERT(child.begin < child.end);
+                    if (c > 0) LUX_TEST_ASSERT(nodes[n.first_child + c - 1].end == child.begin);
+                    for (auto& pt : packed.points().subspan(child.begin, child.end - child.begin))
+                        LUX_TEST_ASSERT(child.bounds.contains(pt.position));
+                }
+            }
+            for (const auto& n : nodes)
+                if (n.isLeaf()) leaf_ranges.emplace_back(n.begin, n.end);
+            std::sort(leaf_ranges.begin(), leaf_ranges.end());
+            for (const auto& [b, e] : leaf_ranges)
+            {
+                LUX_TEST_ASSERT(b == next_leaf_begin);
+                next_leaf_begin = e;
+            }
+            LUX_TEST_ASSERT(next_leaf_begin == packed.size());
+            LUX_TEST_ASSERT(packed.leafCount() == leaf_ranges.size());
+        }
 
-        t.start();
-        for (const auto& p : pts) tree.insert(p);
-        double insert_ms = t.ms();
-        std::cout << "Insert: " << a.n_points << " points, " << insert_ms << " ms, "
-                  << (double(a.n_points) / (insert_ms / 1000.0)) << " pts/s\n";
+        // Deletion, ball and kNN queries match the pointer-based tree.
+        lux::cxx::Box<float,3> dead({-0.3f,-0.3f,-0.3f},{0.25f,0.25f,0.25f});
+        const std::size_t removed = tree.markDeletedInBox(dead);
+        const auto v = packed.version();
+        LUX_TEST_ASSERT(packed.markDeletedInBox(dead) == removed);
+        LUX_TEST_ASSERT(packed.version() == v + 1);
+        LUX_TEST_ASSERT(packed.markDeletedInBox(dead) == 0 && packed.version() == v + 1);
+        const std::array<float,3> ball_c{ 0.5f, -0.5f, 0.5f };
+        LUX_TEST_ASSERT(packed.markDeletedInBall(ball_c, 0.2f) == tree.markDeletedInBall(ball_c, 0.2f));
+        auto odd = [](const Point3f& p) { return p.id % 7 == 0; };
+        LUX_TEST_ASSERT(packed.markDeletedIf(odd) == tree.markDeletedIf(odd));
+        LUX_TEST_ASSERT(packed.totalAlivePoints() == tree.totalAlivePoints());
+        check_same_box_queries(tree, packed, 23);
+
+        auto dist2 = [](const std::array<float, 3>& a, const std::array<float, 3>& b) {
+            float d2 = 0.0f;
+            for (std::size_t i = 0; i < 3; ++i) { float d = a[i] - b[i]; d2 += d * d; }
+            return d2;
+        };
+        for (const auto& q : gen_points3(200, 24, -1.3f, 1.3f))
+        {
+            std::vector<Point3f> a, b;
+            tree.kNearest(q.position, 8, std::back_inserter(a));
+            packed.kNearest(q.position, 8, std::back_inserter(b));
+            LUX_TEST_ASSERT(a.size() == b.size());
+            for (std::size_t i = 0; i < a.size(); ++i)
+                LUX_TEST_ASSERT(dist2(a[i].position, q.position) == dist2(b[i].position, q.position));
+            LUX_TEST_ASSERT(dist2(packed.nearest(q.position)->position, q.position) == dist2(a[0].position, q.position));
+
+            std::vector<std::uint32_t> ia, ib;
+            tree.forEachPointInBall(q.position, 0.25f, [&](const Point3f& p) { ia.push_back(p.id); });
+            packed.forEachPointInBall(q.position, 0.25f, [&](const Point3f& p) { ib.push_back(p.id); });
+            std::sort(ia.begin(), ia.end());
+            std::sort(ib.begin(), ib.end());
+            LUX_TEST_ASSERT(ia == ib);
+        }
 
-        auto boxes = gen_query_boxes<2>(a.n_queries, a.seed + 333);
+        // Converting the pointer-based tree packs exactly its alive points.
+        {
+            Packed converted(tree);
+            LUX_TEST_ASSERT(converted.size() == tree.totalAlivePoints());
+            check_same_box_queries(tree, converted, 25);
+        }
 
-        std::uint64_t total_hits = 0;
-        t.start();
-        for (const auto& b : boxes)
+        // The converted tree keeps a stateful position accessor.
         {
-            tree.forEachPointInBox(b, [&](const Point2f&) { ++total_hits; });
+            using ShiftedTree = lux::cxx::Orthtree<Point3f, 3, float, ShiftedPosition>;
+            const ShiftedPosition shifted{ 0.5f };
+            ShiftedTree::Config scfg;
+            scfg.root_bounds = cfg.root_bounds;
+            scfg.max_depth = cfg.max_depth;
+            scfg.max_points_per_leaf = cfg.max_points_per_leaf;
+            ShiftedTree source(scfg, gen_points3(5'000, 27, -0.4f, 0.4f), shifted);
+            lux::cxx::PackedOrthtree<Point3f, 3, float, ShiftedPosition> converted(source);
+            LUX_TEST_ASSERT(converted.positionAccessor().shift == shifted.shift);
+            LUX_TEST_ASSERT(converted.size() == source.totalAlivePoints());
+            check_same_box_queries(source, converted, 28);
         }
-        double query_ms = t.ms();
-        std::cout << "Query: " << a.n_queries << " boxes, " << query_ms << " ms, "
-                  << (double(a.n_queries) / (query_ms / 1000.0)) << " queries/s, "
-                  << "total_hits=" << total_hits << "\n";
 
-        lux::cxx::Box<float,2> del_box({-0.3f,-0.3f},{0.3f,0.3f});
-        t.start();
-        std::size_t removed = tree.markDeletedInBox(del_box);
-        double del_ms = t.ms();
-        std::cout << "Delete(box): removed=" << removed << ", " << del_ms << " ms\n";
+        // compact() drops dead points and keeps every query answer.
+        {
+            const auto alive_before = packed.totalAlivePoints();
+            const auto size_before = packed.size();
+            const auto nodes_before = packed.nodeCount();
+            LUX_TEST_ASSERT(packed.compact() == size_before - alive_before);
+            LUX_TEST_ASSERT(packed.size() == alive_before && packed.totalAlivePoints() == alive_before);
+            LUX_TEST_ASSERT(packed.nodeCount() == nodes_before);
+            LUX_TEST_ASSERT(packed.compact() == 0);
+            check_same_box_queries(tree, packed, 26);
+        }
 
-        t.start();
-        std::size_t compact_removed = tree.compactDirtyLeaves();
-        double compact_ms = t.ms();
-        std::cout << "Compact: removed=" << compact_removed << ", " << compact_ms << " ms\n";
+        // Coincident points beyond the leaf capacity stay in one leaf at max_depth.
+        {
+            std::vector<Point3f> same(100, Point3f({ 0.1f, 0.1f, 0.1f }, 0, 0));
+            for (std::uint32_t i = 0; i < same.size(); ++i) same[i].id = i + 1;
+            Packed dup(cfg, same);
+            std::size_t hits = 0;
+            dup.forEachPointInBall(std::array<float,3>{ 0.1f, 0.1f, 0.1f }, 0.0f, [&](const Point3f&) { ++hits; });
+            LUX_TEST_ASSERT(hits == same.size() && dup.leafCount() == 1);
+        }
 
-        t.start();
-        auto snap = tree.captureSnapshot(true);
-        double snap_ms = t.ms();
-        std::cout << "Snapshot: leaves=" << snap.leaves.size() << ", " << snap_ms << " ms\n";
+        // 2D with a custom accessor and PMR storage.
+        {
+            using Packed2 = lux::cxx::PackedOrthtreePmr<Point2f, 2, float, GetXY>;
+            using Tree2 = lux::cxx::OrthtreePmr<Point2f, 2, float, GetXY>;
+            std::pmr::unsynchronized_pool_resource res;
+            Tree2::Config cfg2;
+            cfg2.root_bounds = make_root_bounds<2>(-1.0f, 1.0f);
+            cfg2.max_depth = 10;
+            cfg2.max_points_per_leaf = 16;
+
+            auto pts2 = gen_points2(10'000, 27);
+            Tree2 tree2(cfg2, pts2, GetXY{}, std::pmr::polymorphic_allocator<std::byte>(&res));
+            Packed2 packed2(tree2, std::pmr::polymorphic_allocator<std::byte>(&res));
+            LUX_TEST_ASSERT(packed2.size() == pts2.size());
+            for (const auto& box : gen_query_boxes<2>(200, 28))
+            {
+                std::vector<std::uint32_t> ia, ib;
+                tree2.forEachPointInBox(box, [&](const Point2f& p) { ia.push_back(p.id); });
+                packed2.forEachPointInBox(box, [&](const Point2f& p) { ib.push_back(p.id); });
+                std::sort(ia.begin(), ia.end());
+                std::sort(ib.begin(), ib.end());
+                LUX_TEST_ASSERT(ia == ib);
+            }
+        }
     }
 
-    void perf_orthtree_pmr_2d(const Args& a)
+    // ============================================================
+    // Correctness test: delta snapshots
+    // ============================================================
+    struct LeafCopy
     {
-        std::cout << "\n[Performance] OrthtreePmr 2D (PMR)\n";
+        std::vector<std::uint32_t> ids;
+        std::vector<std::uint8_t> alive;
+        bool operator==(const LeafCopy&) const = default;
+    };
+    using LeafMap = std::map<std::uint32_t, LeafCopy>;
 
-        std::pmr::unsynchronized_pool_resource pool;
+    template <class Tree>
+    LeafMap leaf_map(const Tree& tree)
+    {
+        LeafMap m;
+        for (const auto& leaf : tree.captureSnapshot(false).leaves)
+        {
+            auto& c = m[leaf.id];
+            for (const auto& p : leaf.points) c.ids.push_back(p.id);
+            c.alive = leaf.alive;
+        }
+        return m;
+    }
 
-        using Tree = lux::cxx::OrthtreePmr<Point2f, 2, float, GetXY>;
+    template <class Delta>
+    void apply_delta(LeafMap& m, const Delta& d)
+    {
+        if (d.full) m.clear();
+        for (auto id : d.removed) m.erase(id);
+        for (const auto& leaf : d.changed)
+        {
+            auto& c = m[leaf.id];
+            c.ids.clear();
+            for (const auto& p : leaf.points) c.ids.push_back(p.id);
+            c.alive.assign(leaf.alive.begin(), leaf.alive.end());
+        }
+    }
+
+    void test_correctness_delta_snapshot()
+    {
+        std::cout << "[Correctness] Orthtree delta snapshots\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
         Tree::Config cfg;
-        cfg.root_bounds = make_root_bounds<2>(-1.0f, 1.0f);
-        cfg.max_depth = 12;
-        cfg.max_points_per_leaf = 256;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 8;
+        cfg.max_points_per_leaf = 16;
 
-        auto pts = gen_points2(a.n_points, a.seed + 20);
+        Tree tree(cfg);
+        LeafMap mirror;
+        std::uint64_t seen = tree.version();
 
-        Tree tree(cfg, GetXY{}, &pool);
+        // Nothing changed: empty delta.
+        {
+            auto d = tree.captureDelta(seen);
+            LUX_TEST_ASSERT(d.changed.empty() && d.removed.empty() && !d.full);
+        }
 
-        Timer t;
+        // Rounds of inserts (with splits), deletions and compaction, each replayed from the last delta.
+        auto pts = gen_points3(8'000, 31);
+        std::mt19937_64 rng(32);
+        std::uniform_real_distribution<float> dist(-0.9f, 0.7f);
+        std::size_t next = 0;
+        for (int round = 0; round < 12; ++round)
+        {
+            for (int i = 0; i < 500 && next < pts.size(); ++i) tree.insert(pts[next++]);
+            if (round % 3 == 1)
+            {
+                const float lo = dist(rng);
+                tree.markDeletedInBox({ {lo, lo, lo}, {lo + 0.2f, lo + 0.2f, lo + 0.2f} });
+            }
+            if (round % 4 == 3) tree.compactDirtyLeaves();
 
-        t.start();
-        for (const auto& p : pts) tree.insert(p);
-        double insert_ms = t.ms();
-        std::cout << "Insert: " << a.n_points << " points, " << insert_ms << " ms, "
-                  << (double(a.n_points) / (insert_ms / 1000.0)) << " pts/s\n";
+            auto d = tree.captureDelta(seen);
+            LUX_TEST_ASSERT(d.since_version == seen && d.version == tree.version() && !d.full);
+            apply_delta(mirror, d);
+            LUX_TEST_ASSERT(mirror == leaf_map(tree));
+            seen = d.version;
+        }
 
-        auto boxes = gen_query_boxes<2>(a.n_queries, a.seed + 444);
+        // A small local change reports only the leaves it touched.
+        {
+            const auto leaves = tree.captureSnapshot(false).leaves.size();
+            const std::array<float,3> c{ 0.5f, 0.5f, 0.5f };
+            LUX_TEST_ASSERT(tree.markDeletedInBall(c, 0.05f) > 0);
+            auto d = tree.captureDelta(seen);
+            LUX_TEST_ASSERT(!d.changed.empty() && d.changed.size() * 10 < leaves && d.removed.empty());
+            apply_delta(mirror, d);
+            LUX_TEST_ASSERT(mirror == leaf_map(tree));
+            seen = d.version;
+        }
 
-        std::uint64_t total_hits = 0;
-        t.start();
-        for (const auto& b : boxes)
+        // Trimmed history: older deltas become full, newer ones stay incremental.
         {
-            tree.forEachPointInBox(b, [&](const Point2f&) { ++total_hits; });
+            const std::uint64_t old = seen;
+            tree.insert(pts[0]);
+            seen = tree.version();
+            tree.trimDeltaHistory(seen);
+            tree.insert(pts[1]);
+            LUX_TEST_ASSERT(tree.captureDelta(old).full);
+            auto d = tree.captureDelta(seen);
+            LUX_TEST_ASSERT(!d.full);
+            LeafMap fresh;
+            apply_delta(fresh, tree.captureDelta(old));
+            LUX_TEST_ASSERT(fresh == leaf_map(tree));
+            mirror = fresh;
+            seen = d.version;
         }
-        double query_ms = t.ms();
-        std::cout << "Query: " << a.n_queries << " boxes, " << query_ms << " ms, "
-                  << (double(a.n_queries) / (query_ms / 1000.0)) << " queries/s, "
-                  << "total_hits=" << total_hits << "\n";
+
+        // bulkLoad and clear replace every node, so deltas across them are full.
+        {
+            tree.bulkLoad(pts);
+            auto d = tree.captureDelta(seen);
+            LUX_TEST_ASSERT(d.full);
+            apply_delta(mirror, d);
+            LUX_TEST_ASSERT(mirror == leaf_map(tree));
+            seen = d.version;
+
+            tree.clear();
+            d = tree.captureDelta(seen);
+            LUX_TEST_ASSERT(d.full && d.changed.size() == 1);
+        }
+
+        // Zero-copy deltas require a frozen tree, and a frozen tree rejects writes.
+        {
+            Tree t2(cfg, pts);
+            const std::uint64_t v0 = t2.version();
+            t2.markDeletedInBox({ {-0.1f, -0.1f, -0.1f}, {0.1f, 0.1f, 0.1f} });
+            bool threw = false;
+            try { (void)t2.captureDeltaView(v0); } catch (const std::logic_error&) { threw = true; }
+            LUX_TEST_ASSERT(threw);
+
+            t2.freeze();
+            threw = false;
+            try { t2.insert(pts[0]); } catch (const std::logic_error&) { threw = true; }
+            LUX_TEST_ASSERT(threw && t2.frozen());
+
+            auto copy = t2.captureDelta(v0);
+            auto view = t2.captureDeltaView(v0);
+            LUX_TEST_ASSERT(view.changed.size() == copy.changed.size() && view.removed == copy.removed);
+            for (std::size_t i = 0; i < view.changed.size(); ++i)
+            {
+                LUX_TEST_ASSERT(view.changed[i].id == copy.changed[i].id);
+                LUX_TEST_ASSERT(view.changed[i].points.size() == copy.changed[i].points.size());
+                LUX_TEST_ASSERT(std::equal(view.changed[i].alive.begin(), view.changed[i].alive.end(),
+                    copy.changed[i].alive.begin(), copy.changed[i].alive.end()));
+            }
+            t2.unfreeze();
+            LUX_TEST_ASSERT(t2.insert(pts[0]));
+        }
+    }
+
+    // ============================================================
+    // Correctness test: parallel, batched and concurrent queries
+    // ============================================================
+    void test_correctness_parallel_queries()
+    {
+        std::cout << "[Correctness] Orthtree parallel / batched queries\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 8;
+        cfg.max_points_per_leaf = 32;
+
+        auto pts = gen_points3(40'000, 41);
+        Tree tree(cfg, pts);
+        tree.markDeletedIf([](const Point3f& p) { return p.id % 5 == 0; });
+        lux::cxx::ThreadPool pool(3);
+
+        auto boxes = gen_query_boxes<3>(300, 42);
+        // Large boxes exercise the full-containment path of the batched traversal.
+        boxes.push_back({ {-0.9f, -0.9f, -0.9f}, {0.9f, 0.9f, 0.9f} });
+        boxes.push_back(cfg.root_bounds);
+
+        std::vector<std::vector<std::uint32_t>> expect(boxes.size());
+        for (std::size_t q = 0; q < boxes.size(); ++q)
+        {
+            tree.forEachPointInBox(boxes[q], [&](const Point3f& p) { expect[q].push_back(p.id); });
+            std::sort(expect[q].begin(), expect[q].end());
+        }
+
+        // Parallel single-box queries: per-slot callback and merged output.
+        for (std::size_t q = 0; q < boxes.size(); ++q)
+        {
+            std::vector<std::vector<std::uint32_t>> per_slot(pool.thread_count() + 1);
+            tree.forEachPointInBox(boxes[q], pool, [&](std::size_t slot, const Point3f& p) { per_slot[slot].push_back(p.id); });
+            std::vector<std::uint32_t> got;
+            for (const auto& s : per_slot) got.insert(got.end(), s.begin(), s.end());
+            std::sort(got.begin(), got.end());
+            LUX_TEST_ASSERT(got == expect[q]);
+
+            std::vector<Point3f> out;
+            tree.queryPointsInBox(boxes[q], std::back_inserter(out), pool);
+            LUX_TEST_ASSERT(out.size() == expect[q].size());
+        }
+
+        // Batched, serial and parallel.
+        {
+            std::vector<std::vector<std::uint32_t>> got(boxes.size());
+            tree.forEachPointInBoxes(boxes, [&](std::size_t q, const Point3f& p) { got[q].push_back(p.id); });
+            for (std::size_t q = 0; q < boxes.size(); ++q)
+            {
+                std::sort(got[q].begin(), got[q].end());
+                LUX_TEST_ASSERT(got[q] == expect[q]);
+            }
+
+            std::vector<std::vector<std::uint32_t>> got_par(boxes.size());
+            tree.forEachPointInBoxes(boxes, pool, [&](std::size_t q, const Point3f& p) { got_par[q].push_back(p.id); });
+            for (std::size_t q = 0; q < boxes.size(); ++q)
+            {
+                std::sort(got_par[q].begin(), got_par[q].end());
+                LUX_TEST_ASSERT(got_par[q] == expect[q]);
+            }
+        }
+
+        // Parallel deletion matches serial deletion, including delta bookkeeping.
+        {
+            Tree serial(cfg, pts);
+            Tree parallel(cfg, pts);
+            const std::uint64_t v0 = parallel.version();
+            const lux::cxx::Box<float,3> region({-0.6f, -0.2f, -0.6f}, {0.4f, 0.5f, 0.3f});
+            const std::size_t removed = serial.markDeletedInBox(region);
+            LUX_TEST_ASSERT(removed > 0 && parallel.markDeletedInBox(region, pool) == removed);
+            const std::array<float,3> c{ 0.6f, 0.6f, -0.5f };
+            LUX_TEST_ASSERT(parallel.markDeletedInBall(c, 0.3f, pool) == serial.markDeletedInBall(c, 0.3f));
+            LUX_TEST_ASSERT(parallel.totalAlivePoints() == serial.totalAlivePoints());
+            LUX_TEST_ASSERT(parallel.version() == v0 + 2);
+            LUX_TEST_ASSERT(parallel.captureDelta(v0).changed.size() == serial.captureDelta(v0).changed.size());
+            LUX_TEST_ASSERT(parallel.markDeletedInBox(region, pool) == 0 && parallel.version() == v0 + 2);
+        }
+
+        // Read-only concurrent access: plain threads query a frozen tree at once.
+        {
+            tree.freeze();
+            std::vector<int> ok(4, 0);
+            std::vector<std::thread> readers;
+            for (std::size_t t = 0; t < ok.size(); ++t)
+            {
+                readers.emplace_back([&, t] {
+                    bool good = true;
+                    for (std::size_t q = t; q < boxes.size(); q += ok.size())
+                    {
+                        std::vector<std::uint32_t> got;
+                        tree.forEachPointInBox(boxes[q], [&](const Point3f& p) { got.push_back(p.id); });
+                        std::sort(got.begin(), got.end());
+                        good = good && got == expect[q];
+                        std::vector<Point3f> nn;
+                        good = good && tree.kNearest(boxes[q].center(), 4, std::back_inserter(nn)) == 4;
+                    }
+                    ok[t] = good ? 1 : 0;
+                });
+            }
+            for (auto& r : readers) r.join();
+            for (int v : ok) LUX_TEST_ASSERT(v == 1);
+            tree.unfreeze();
+        }
+    }
+
+    // ============================================================
+    // Correctness test: incremental maintenance (compaction queue, merging, free list)
+    // ============================================================
+    template <class Tree>
+    std::size_t reachable_leaf_count(const Tree& tree)
+    {
+        return tree.captureSnapshot(false).leaves.size();
+    }
+
+    void test_correctness_maintenance()
+    {
+        std::cout << "[Correctness] Orthtree maintain\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 8;
+        cfg.max_points_per_leaf = 32;
+        cfg.merge_threshold = 8;
+
+        auto pts = gen_points3(20'000, 51);
+        Tree tree(cfg);
+        tree.insertMany(pts);
+        const std::size_t leaves_full = reachable_leaf_count(tree);
+
+        // Nothing queued: a no-op that does not bump the version.
+        {
+            const auto v = tree.version();
+            auto st = tree.maintain();
+            LUX_TEST_ASSERT(st.done && st.leaves_compacted == 0 && tree.version() == v);
+        }
+
+        // Delete 90% of the points, then maintain in small budgeted steps.
+        LeafMap mirror = leaf_map(tree);
+        std::uint64_t seen = tree.version();
+        tree.markDeletedIf([](const Point3f& p) { return p.id % 10 != 0; });
+        std::vector<Point3f> alive;
+        for (const auto& p : pts) if (p.id % 10 == 0) alive.push_back(p);
+
+        std::size_t calls = 0, merged = 0, freed = 0;
+        for (;;)
+        {
+            auto st = tree.maintain(std::size_t(500));
+            ++calls;
+            merged += st.nodes_merged;
+            freed += st.nodes_freed;
+            LUX_TEST_ASSERT(st.work < 500 + cfg.max_points_per_leaf * 8 * 2);
+            if (st.done) break;
+        }
+        LUX_TEST_ASSERT(calls > 1 && merged > 0);
+        LUX_TEST_ASSERT(tree.freeNodeCount() == freed);
+        LUX_TEST_ASSERT(tree.totalAlivePoints() == alive.size());
+        LUX_TEST_ASSERT(reachable_leaf_count(tree) * 4 < leaves_full);
+        for (const auto& leaf : tree.captureSnapshot(false).leaves)
+        {
+            LUX_TEST_ASSERT(leaf.points.size() <= cfg.max_points_per_leaf);
+            LUX_TEST_ASSERT(std::all_of(leaf.alive.begin(), leaf.alive.end(), [](std::uint8_t a) { return a == 1; }));
+        }
+
+        // Queries still see exactly the survivors.
+        for (const auto& box : gen_query_boxes<3>(200, 52))
+        {
+            std::vector<std::uint32_t> expect, got;
+            for (const auto& p : alive) if (in_box(box, p.position)) expect.push_back(p.id);
+            tree.forEachPointInBox(box, [&](const Point3f& p) { got.push_back(p.id); });
+            std::sort(expect.begin(), expect.end());
+            std::sort(got.begin(), got.end());
+            LUX_TEST_ASSERT(got == expect);
+        }
+
+        // Deltas report merged-away and freed leaves as removed.
+        {
+            auto d = tree.captureDelta(seen);
+            LUX_TEST_ASSERT(!d.full && !d.removed.empty());
+            apply_delta(mirror, d);
+            LUX_TEST_ASSERT(mirror == leaf_map(tree));
+            seen = d.version;
+        }
+
+        // Re-inserting reuses freed node IDs before growing the node array.
+        {
+            const auto nodes = tree.nodeCount();
+            const auto free_before = tree.freeNodeCount();
+            for (const auto& p : pts) if (p.id % 10 != 0 && p.id % 3 == 0) tree.insert(p);
+            LUX_TEST_ASSERT(tree.freeNodeCount() < free_before);
+            LUX_TEST_ASSERT(tree.nodeCount() == nodes || tree.freeNodeCount() == 0);
+            auto d = tree.captureDelta(seen);
+            apply_delta(mirror, d);
+            LUX_TEST_ASSERT(mirror == leaf_map(tree));
+        }
+
+        // merge_threshold = 0 only compacts; the time-budget overload finishes the queue.
+        {
+            Tree::Config no_merge = cfg;
+            no_merge.merge_threshold = 0;
+            Tree t2(no_merge);
+            t2.insertMany(pts);
+            t2.markDeletedIf([](const Point3f& p) { return p.id % 10 != 0; });
+            auto st = t2.maintain(std::chrono::milliseconds(100));
+            while (!st.done) st = t2.maintain(std::chrono::milliseconds(100));
+            LUX_TEST_ASSERT(st.nodes_merged == 0);
+            LUX_TEST_ASSERT(t2.totalAlivePoints() == alive.size());
+            LUX_TEST_ASSERT(t2.markDeletedInBox(cfg.root_bounds) == alive.size());
+            // Everything gone: maintain collapses the whole tree into an empty root leaf.
+            Tree::Config merge_all = cfg;
+            Tree t3(merge_all, pts);
+            t3.markDeletedInBox(cfg.root_bounds);
+            t3.maintain();
+            LUX_TEST_ASSERT(reachable_leaf_count(t3) == 1 && t3.totalAlivePoints() == 0);
+            LUX_TEST_ASSERT(t3.insert(pts[0]) && t3.totalAlivePoints() == 1);
+        }
+    }
+
+    // ============================================================
+    // Correctness test: stable point handles and update/updateMany
+    // ============================================================
+    template <class Tree>
+    void check_handles(const Tree& tree, const std::map<std::uint32_t, typename Tree::PointHandle>& handles,
+        const std::map<std::uint32_t, Point3f>& expect)
+    {
+        LUX_TEST_ASSERT(tree.totalAlivePoints() == expect.size());
+        for (const auto& [id, h] : handles)
+        {
+            const Point3f* p = tree.find(h);
+            auto it = expect.find(id);
+            if (it == expect.end()) { LUX_TEST_ASSERT(p == nullptr); continue; }
+            LUX_TEST_ASSERT(p != nullptr && p->id == id && p->position == it->second.position);
+        }
+        for (const auto& box : gen_query_boxes<3>(50, 64))
+        {
+            std::vector<std::uint32_t> want, got;
+            for (const auto& [id, p] : expect) if (in_box(box, p.position)) want.push_back(id);
+            tree.forEachPointInBox(box, [&](const Point3f& p) { got.push_back(p.id); });
+            std::sort(got.begin(), got.end());
+            LUX_TEST_ASSERT(got == want);
+        }
+    }
+
+    void test_correctness_point_handles()
+    {
+        std::cout << "[Correctness] Orthtree point handles / update\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        using Handle = Tree::PointHandle;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 8;
+        cfg.max_points_per_leaf = 32;
+        cfg.merge_threshold = 24;
+        cfg.track_handles = true;
+
+        // Handles survive the splits caused by incremental insertion.
+        auto pts = gen_points3(5'000, 61);
+        Tree tree(cfg);
+        std::map<std::uint32_t, Handle> handles;
+        std::map<std::uint32_t, Point3f> expect;
+        for (const auto& p : pts)
+        {
+            const Handle h = tree.insertTracked(p);
+            LUX_TEST_ASSERT(h.valid());
+            handles[p.id] = h;
+            expect[p.id] = p;
+        }
+        check_handles(tree, handles, expect);
+        LUX_TEST_ASSERT(!tree.insertTracked(Point3f({ 2.0f, 0.0f, 0.0f }, 0, 0)).valid());
+
+        // Soft deletion, compaction and merges: survivors keep their handles.
+        tree.markDeletedIf([](const Point3f& p) { return p.id % 4 != 0; });
+        for (auto it = expect.begin(); it != expect.end();)
+            it = it->first % 4 != 0 ? expect.erase(it) : std::next(it);
+        check_handles(tree, handles, expect);
+        auto st = tree.maintain();
+        LUX_TEST_ASSERT(st.done && st.nodes_merged > 0);
+        check_handles(tree, handles, expect);
+
+        LeafMap mirror = leaf_map(tree);
+        std::uint64_t seen = tree.version();
+
+        // update: small jitter mostly stays in the leaf, large jumps cross subtrees.
+        std::mt19937_64 rng(62);
+        std::uniform_real_distribution<float> jitter(-0.01f, 0.01f), anywhere(-1.0f, 1.0f);
+        for (auto& [id, p] : expect)
+        {
+            Point3f q = p;
+            for (float& c : q.position) c = id % 3 == 0 ? anywhere(rng) : std::clamp(c + jitter(rng), -1.0f, 1.0f);
+            q.payload = p.payload + 1;
+            LUX_TEST_ASSERT(tree.update(handles[id], q));
+            p = q;
+        }
+        check_handles(tree, handles, expect);
+        {
+            auto d = tree.captureDelta(seen);
+            LUX_TEST_ASSERT(!d.full);
+            apply_delta(mirror, d);
+            LUX_TEST_ASSERT(mirror == leaf_map(tree));
+            seen = d.version;
+        }
+
+        // A position outside the root is rejected and leaves the point as it was.
+        {
+            const auto& [id, p] = *expect.begin();
+            Point3f q = p;
+            q.position[0] = 5.0f;
+            const auto v = tree.version();
+            LUX_TEST_ASSERT(!tree.update(handles[id], q));
+            LUX_TEST_ASSERT(tree.version() == v && tree.find(handles[id])->position == p.position);
+        }
+
+        // updateMany applies a whole frame and bumps the version once.
+        {
+            std::vector<std::pair<Handle, Point3f>> moves;
+            for (auto& [id, p] : expect)
+            {
+                Point3f q = p;
+                for (float& c : q.position) c = anywhere(rng);
+                moves.emplace_back(handles[id], q);
+                p = q;
+            }
+            moves.emplace_back(Handle{}, pts[0]);
+            const auto v = tree.version();
+            LUX_TEST_ASSERT(tree.updateMany(moves) == expect.size());
+            LUX_TEST_ASSERT(tree.version() == v + 1);
+            check_handles(tree, handles, expect);
+            auto d = tree.captureDelta(seen);
+            apply_delta(mirror, d);
+            LUX_TEST_ASSERT(mirror == leaf_map(tree));
+        }
+
+        // Crowding a small cube with one batch splits its leaves down to capacity.
+        {
+            std::uniform_real_distribution<float> corner(0.5f, 0.6f);
+            std::vector<std::pair<Handle, Point3f>> moves;
+            for (auto& [id, p] : expect)
+            {
+                if (moves.size() == 1000) break;
+                Point3f q = p;
+                for (float& c : q.position) c = corner(rng);
+                moves.emplace_back(handles[id], q);
+                p = q;
+            }
+            LUX_TEST_ASSERT(tree.updateMany(moves) == moves.size());
+            check_handles(tree, handles, expect);
+            for (const auto& leaf : tree.captureSnapshot(false).leaves)
+                LUX_TEST_ASSERT(static_cast<std::size_t>(std::count(leaf.alive.begin(), leaf.alive.end(), 1))
+                                <= cfg.max_points_per_leaf);
+            auto d = tree.captureDelta(seen);
+            apply_delta(mirror, d);
+            LUX_TEST_ASSERT(mirror == leaf_map(tree));
+            seen = d.version;
+        }
+
+        // erase removes at once; the handle goes stale and its slot is reused with a new generation.
+        {
+            const std::uint32_t id = expect.begin()->first;
+            const Handle old = handles[id];
+            LUX_TEST_ASSERT(tree.erase(old));
+            expect.erase(id);
+            LUX_TEST_ASSERT(!tree.erase(old) && !tree.update(old, pts[0]) && tree.find(old) == nullptr);
+            const Handle h = tree.insertTracked(pts[id - 1]);
+            LUX_TEST_ASSERT(h.index == old.index && h.generation != old.generation);
+            LUX_TEST_ASSERT(tree.find(old) == nullptr && tree.find(h)->id == id);
+            handles[id] = h;
+            expect[id] = pts[id - 1];
+            check_handles(tree, handles, expect);
+        }
+
+        // Erasing every point in a leaf queues it, so maintain() can unlink it.
+        {
+            for (auto& [id, p] : expect) if (p.position[0] > 0.5f) LUX_TEST_ASSERT(tree.erase(handles[id]));
+            std::erase_if(expect, [](const auto& e) { return e.second.position[0] > 0.5f; });
+            const auto leaves = reachable_leaf_count(tree);
+            tree.maintain();
+            LUX_TEST_ASSERT(reachable_leaf_count(tree) < leaves);
+            check_handles(tree, handles, expect);
+        }
+
+        // bulkLoad hands out one handle per input and invalidates the old ones.
+        {
+            const auto old = handles;
+            std::vector<Point3f> load = gen_points3(3'000, 63);
+            load[7].position = { 3.0f, 0.0f, 0.0f };
+            std::vector<Handle> loaded;
+            LUX_TEST_ASSERT(tree.bulkLoad(load, loaded) == load.size() - 1);
+            LUX_TEST_ASSERT(loaded.size() == load.size() && !loaded[7].valid());
+            for (const auto& [id, h] : old) LUX_TEST_ASSERT(tree.find(h) == nullptr);
+            handles.clear();
+            expect.clear();
+            for (std::size_t i = 0; i < load.size(); ++i)
+            {
+                if (i == 7) continue;
+                handles[load[i].id] = loaded[i];
+                expect[load[i].id] = load[i];
+            }
+            check_handles(tree, handles, expect);
+
+            // Plain insert attaches a handle too, from the slots bulkLoad left free.
+            LUX_TEST_ASSERT(tree.insert(load[8]) && tree.totalAlivePoints() == expect.size() + 1);
+            const Handle h = tree.insertTracked(load[9]);
+            LUX_TEST_ASSERT(h.valid() && h.index >= load.size());
+        }
+
+        // Without track_handles, handle members reject every handle.
+        {
+            Tree::Config plain = cfg;
+            plain.track_handles = false;
+            Tree t2(plain, pts);
+            bool threw = false;
+            try { (void)t2.insertTracked(pts[0]); } catch (const std::logic_error&) { threw = true; }
+            LUX_TEST_ASSERT(threw);
+            LUX_TEST_ASSERT(!t2.update(Handle{ 0, 0 }, pts[0]) && t2.find(Handle{ 0, 0 }) == nullptr);
+        }
+    }
+
+    // ============================================================
+    // Correctness test: SIMD leaf scans
+    //
+    // A tree scanning position lanes must answer box and ball queries and
+    // soft-delete exactly like one testing points one by one, through
+    // splits, compaction, merges, handle updates and bulk loads.
+    // ============================================================
+    template <class Scalar, std::size_t Dim>
+    struct LanePoint
+    {
+        std::array<Scalar, Dim> position{};
+        std::uint32_t id = 0;
+    };
+
+    template <class Scalar, std::size_t Dim>
+    LanePoint<Scalar, Dim> gen_lane_point(std::mt19937_64& rng, std::uint32_t id)
+    {
+        // One coordinate in four sits on a 1/8 grid so query boxes hit points on their faces.
+        std::uniform_real_distribution<Scalar> dist(Scalar(-1), Scalar(1));
+        std::uniform_int_distribution<int> grid(-8, 8);
+        LanePoint<Scalar, Dim> p;
+        p.id = id;
+        for (auto& c : p.position) c = rng() % 4 == 0 ? Scalar(grid(rng)) / Scalar(8) : dist(rng);
+        return p;
+    }
+
+    template <class Scalar, std::size_t Dim>
+    void check_lane_queries(const lux::cxx::Orthtree<LanePoint<Scalar, Dim>, Dim, Scalar>& on,
+        const lux::cxx::Orthtree<LanePoint<Scalar, Dim>, Dim, Scalar>& off,
+        const std::map<std::uint32_t, LanePoint<Scalar, Dim>>& expect, std::uint64_t seed)
+    {
+        using Point = LanePoint<Scalar, Dim>;
+        LUX_TEST_ASSERT(on.totalAlivePoints() == expect.size() && off.totalAlivePoints() == expect.size());
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<int> grid(-8, 8);
+        std::uniform_real_distribution<Scalar> dist(Scalar(-1), Scalar(1)), radius(Scalar(0.02), Scalar(0.6));
+        auto collect = [](const auto& tree, auto&& query) {
+            std::vector<std::uint32_t> ids;
+            query(tree, [&](const Point& p) { ids.push_back(p.id); });
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        };
+        for (int q = 0; q < 60; ++q)
+        {
+            lux::cxx::Box<Scalar, Dim> box;
+            for (std::size_t a = 0; a < Dim; ++a)
+            {
+                Scalar lo = Scalar(grid(rng)) / Scalar(8), hi = Scalar(grid(rng)) / Scalar(8);
+                if (q % 2) { lo = dist(rng); hi = dist(rng); }
+                box.min[a] = std::min(lo, hi);
+                box.max[a] = std::max(lo, hi);
+            }
+            std::vector<std::uint32_t> want;
+            for (const auto& [id, p] : expect) if (box.contains(p.position)) want.push_back(id);
+            auto in_box_query = [&](const auto& tree, auto&& fn) { tree.forEachPointInBox(box, fn); };
+            LUX_TEST_ASSERT(collect(on, in_box_query) == want);
+            LUX_TEST_ASSERT(collect(off, in_box_query) == want);
+
+            std::array<Scalar, Dim> center;
+            for (auto& c : center) c = dist(rng);
+            const Scalar r = radius(rng);
+            want.clear();
+            for (const auto& [id, p] : expect)
+                if (lux::cxx::detail::orthtreeWithinDistance<Scalar, Dim>(p.position, center, r * r)) want.push_back(id);
+            auto in_ball_query = [&](const auto& tree, auto&& fn) { tree.forEachPointInBall(center, r, fn); };
+            LUX_TEST_ASSERT(collect(on, in_ball_query) == want);
+            LUX_TEST_ASSERT(collect(off, in_ball_query) == want);
+        }
+    }
+
+    template <class Scalar, std::size_t Dim>
+    void test_lane_scans(std::size_t n, std::uint64_t seed)
+    {
+        using Point = LanePoint<Scalar, Dim>;
+        using Tree = lux::cxx::Orthtree<Point, Dim, Scalar>;
+        using Handle = typename Tree::PointHandle;
+        typename Tree::Config cfg;
+        for (std::size_t a = 0; a < Dim; ++a) { cfg.root_bounds.min[a] = Scalar(-1); cfg.root_bounds.max[a] = Scalar(1); }
+        cfg.max_depth = 6;
+        cfg.max_points_per_leaf = 40;   // Not a multiple of the lane width: leaves end in partial blocks.
+        cfg.merge_threshold = 24;
+        cfg.track_handles = true;
+        typename Tree::Config scalar_cfg = cfg;
+        scalar_cfg.position_lanes = false;
+
+        Tree on(cfg), off(scalar_cfg);
+        std::map<std::uint32_t, Point> expect;
+        std::map<std::uint32_t, std::pair<Handle, Handle>> handles;
+        std::mt19937_64 rng(seed);
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            const Point p = gen_lane_point<Scalar, Dim>(rng, i);
+            handles[i] = { on.insertTracked(p), off.insertTracked(p) };
+            expect[i] = p;
+        }
+        check_lane_queries(on, off, expect, seed + 1);
+
+        // Soft deletion by shape, then by predicate; compaction moves survivors within leaves.
+        std::array<Scalar, Dim> center{};
+        const std::size_t removed = on.markDeletedInBall(center, Scalar(0.5));
+        LUX_TEST_ASSERT(off.markDeletedInBall(center, Scalar(0.5)) == removed && removed > 0);
+        lux::cxx::Box<Scalar, Dim> slab = cfg.root_bounds;
+        slab.max[0] = Scalar(-0.5);
+        LUX_TEST_ASSERT(on.markDeletedInBox(slab) == off.markDeletedInBox(slab));
+        on.markDeletedIf([](const Point& p) { return p.id % 3 == 0; });
+        off.markDeletedIf([](const Point& p) { return p.id % 3 == 0; });
+        for (auto it = expect.begin(); it != expect.end();)
+        {
+            const auto& pos = it->second.position;
+            const bool dead = lux::cxx::detail::orthtreeWithinDistance<Scalar, Dim>(pos, center, Scalar(0.25))
+                || slab.contains(pos) || it->first % 3 == 0;
+            it = dead ? expect.erase(it) : std::next(it);
+        }
+        check_lane_queries(on, off, expect, seed + 2);
+        on.compactDirtyLeaves();
+        off.compactDirtyLeaves();
+        check_lane_queries(on, off, expect, seed + 3);
+
+        // Merges pull children's points into the parent leaf.
+        on.markDeletedIf([](const Point& p) { return p.id % 5 != 0; });
+        off.markDeletedIf([](const Point& p) { return p.id % 5 != 0; });
+        for (auto it = expect.begin(); it != expect.end();)
+            it = it->first % 5 != 0 ? expect.erase(it) : std::next(it);
+        LUX_TEST_ASSERT(on.maintain().nodes_merged > 0);
+        off.maintain();
+        check_lane_queries(on, off, expect, seed + 4);
+
+        // Moves in place and across leaves, single and batched, and erasure.
+        std::vector<std::pair<Handle, Point>> moves_on, moves_off;
+        for (auto& [id, p] : expect)
+        {
+            const Point moved = gen_lane_point<Scalar, Dim>(rng, id);
+            if (id % 2)
+            {
+                LUX_TEST_ASSERT(on.update(handles[id].first, moved) && off.update(handles[id].second, moved));
+            }
+            else
+            {
+                moves_on.emplace_back(handles[id].first, moved);
+                moves_off.emplace_back(handles[id].second, moved);
+            }
+            p = moved;
+        }
+        on.updateMany(moves_on);
+        off.updateMany(moves_off);
+        for (auto it = expect.begin(); it != expect.end();)
+        {
+            if (it->first % 7 != 1) { ++it; continue; }
+            LUX_TEST_ASSERT(on.erase(handles[it->first].first) && off.erase(handles[it->first].second));
+            it = expect.erase(it);
+        }
+        check_lane_queries(on, off, expect, seed + 5);
+
+        // Bulk loads fill the lanes leaf by leaf.
+        std::vector<Point> pts;
+        expect.clear();
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            pts.push_back(gen_lane_point<Scalar, Dim>(rng, i));
+            expect[i] = pts.back();
+        }
+        on.bulkLoad(pts);
+        off.bulkLoad(pts);
+        check_lane_queries(on, off, expect, seed + 6);
+    }
+
+    void test_correctness_lane_scans()
+    {
+        std::cout << "[Correctness] Orthtree SIMD leaf scans\n";
+        test_lane_scans<float, 3>(6000, 70);
+        test_lane_scans<double, 3>(6000, 71);
+        test_lane_scans<float, 2>(4000, 72);
+        test_lane_scans<double, 2>(4000, 73);
+    }
+
+    // ============================================================
+    // Correctness test: snapshots and OrthtreeView
+    //
+    // A view over a saved tree answers box, ball and kNN queries like the
+    // tree's alive points; quantized positions stay within one step of the
+    // originals, and malformed files are rejected.
+    // ============================================================
+    std::span<const std::byte> as_bytes(const std::string& s)
+    {
+        return { reinterpret_cast<const std::byte*>(s.data()), s.size() };
+    }
+
+    template <class View>
+    std::vector<std::uint32_t> view_ids_in_box(const View& view, const lux::cxx::Box<float, 3>& box)
+    {
+        std::vector<std::uint32_t> ids;
+        view.forEachPointInBox(box, [&](const Point3f& p) { ids.push_back(p.id); });
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    void test_correctness_snapshot()
+    {
+        std::cout << "[Correctness] Orthtree snapshots / OrthtreeView\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        using View = lux::cxx::OrthtreeView<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 8;
+        cfg.max_points_per_leaf = 32;
+
+        const auto pts = gen_points3(20000, 80);
+        Tree tree(cfg);
+        tree.insertMany(pts);
+        tree.markDeletedIf([](const Point3f& p) { return p.id % 5 == 0; });
+        std::map<std::uint32_t, Point3f> alive;
+        for (const auto& p : pts) if (p.id % 5 != 0) alive[p.id] = p;
+        std::vector<Point3f> alive_pts;
+        for (const auto& [id, p] : alive) alive_pts.push_back(p);
+
+        std::stringstream raw_buf;
+        lux::cxx::save_snapshot(raw_buf, tree);
+        const std::string raw = raw_buf.str();
+        const View view(as_bytes(raw));
+        LUX_TEST_ASSERT(view.size() == alive.size() && !view.quantized());
+
+        // Raw positions: exactly the tree's answers.
+        const auto boxes = gen_query_boxes<3>(50, 81);
+        for (const auto& box : boxes)
+            LUX_TEST_ASSERT(view_ids_in_box(view, box) == ids_in_box(tree, box));
+        std::mt19937_64 rng(82);
+        std::uniform_real_distribution<float> dist(-1.2f, 1.2f), radius(0.05f, 0.5f);
+        for (int q = 0; q < 50; ++q)
+        {
+            const std::array<float, 3> c{ dist(rng), dist(rng), dist(rng) };
+            const float r = radius(rng);
+            std::vector<std::uint32_t> want, got;
+            for (const auto& [id, p] : alive)
+                if (lux::cxx::detail::orthtreeWithinDistance<float, 3>(p.position, c, r * r)) want.push_back(id);
+            view.forEachPointInBall(c, r, [&](const Point3f& p) { got.push_back(p.id); });
+            std::sort(got.begin(), got.end());
+            LUX_TEST_ASSERT(got == want);
+
+            std::vector<Point3f> knn;
+            LUX_TEST_ASSERT(view.kNearest(c, 8, std::back_inserter(knn)) == 8);
+            std::vector<float> got_d2;
+            for (const auto& p : knn) got_d2.push_back(lux::cxx::detail::orthtreeDistanceSquared<float, 3>(p.position, c));
+            LUX_TEST_ASSERT(dist2_match(got_d2, brute_knn_dist2(alive_pts, [](const Point3f& p) -> const auto& { return p.position; }, c, 8)));
+            LUX_TEST_ASSERT(view.nearest(c)->id == knn.front().id);
+        }
+
+        // Through a memory-mapped file.
+        const auto path = std::filesystem::temp_directory_path() / "lux_orthtree_snapshot.bin";
+        {
+            std::ofstream out(path, std::ios::binary);
+            lux::cxx::save_snapshot(out, tree);
+        }
+        {
+            lux::cxx::MappedSnapshot<View> mapped(path);
+            LUX_TEST_ASSERT(mapped->size() == alive.size());
+            for (const auto& box : boxes)
+                LUX_TEST_ASSERT(view_ids_in_box(*mapped, box) == ids_in_box(tree, box));
+        }
+        std::filesystem::remove(path);
+
+        // Quantized positions with id records: within a step of the originals.
+        {
+            std::stringstream buf;
+            lux::cxx::save_snapshot(buf, tree, [](const Point3f& p) { return p.id; }, { .quantize_positions = true });
+            const std::string bytes = buf.str();
+            LUX_TEST_ASSERT(bytes.size() < raw.size() * 2 / 3);   // 10 bytes per point instead of 20
+            const lux::cxx::OrthtreeView<std::uint32_t, 3, float> qview(as_bytes(bytes));
+            LUX_TEST_ASSERT(qview.size() == alive.size() && qview.quantized());
+
+            const float tol = 2.0f / 65535.0f;   // A step of the root cell; leaves are no larger.
+            for (const auto& box : boxes)
+            {
+                std::vector<std::uint32_t> got;
+                qview.forEachPointInBox(box, [&](std::uint32_t id, const std::array<float, 3>& pos) {
+                    got.push_back(id);
+                    for (std::size_t a = 0; a < 3; ++a)
+                    {
+                        LUX_TEST_ASSERT(std::abs(pos[a] - alive.at(id).position[a]) <= tol);
+                        LUX_TEST_ASSERT(pos[a] >= box.min[a] && pos[a] <= box.max[a]);
+                    }
+                });
+                std::sort(got.begin(), got.end());
+                LUX_TEST_ASSERT(std::adjacent_find(got.begin(), got.end()) == got.end());
+                for (const auto& [id, p] : alive)
+                {
+                    bool deep_inside = true;
+                    for (std::size_t a = 0; a < 3; ++a)
+                        deep_inside &= p.position[a] >= box.min[a] + tol && p.position[a] <= box.max[a] - tol;
+                    if (deep_inside) LUX_TEST_ASSERT(std::binary_search(got.begin(), got.end(), id));
+                }
+            }
+            const float slack = 2.0f * std::sqrt(3.0f) * tol;
+            for (int q = 0; q < 50; ++q)
+            {
+                const std::array<float, 3> c{ dist(rng), dist(rng), dist(rng) };
+                std::vector<std::uint32_t> knn;
+                LUX_TEST_ASSERT(qview.kNearest(c, 8, std::back_inserter(knn)) == 8);
+                const auto want = brute_knn_dist2(alive_pts, [](const Point3f& p) -> const auto& { return p.position; }, c, 8);
+                for (std::size_t i = 0; i < knn.size(); ++i)
+                {
+                    const float d = std::sqrt(lux::cxx::detail::orthtreeDistanceSquared<float, 3>(alive.at(knn[i]).position, c));
+                    LUX_TEST_ASSERT(d <= std::sqrt(want[i]) + slack);
+                }
+            }
+        }
+
+        // A PackedOrthtree with dead points, and a double-precision 2D tree.
+        {
+            lux::cxx::PackedOrthtree<Point3f, 3> packed(cfg, pts);
+            packed.markDeletedInBox(boxes[0]);
+            packed.markDeletedIf([](const Point3f& p) { return p.id % 7 == 0; });
+            std::stringstream buf;
+            lux::cxx::save_snapshot(buf, packed);
+            const std::string bytes = buf.str();
+            const View pview(as_bytes(bytes));
+            LUX_TEST_ASSERT(pview.size() == packed.totalAlivePoints());
+            for (const auto& box : boxes)
+            {
+                std::vector<std::uint32_t> want;
+                packed.forEachPointInBox(box, [&](const Point3f& p) { want.push_back(p.id); });
+                std::sort(want.begin(), want.end());
+                LUX_TEST_ASSERT(view_ids_in_box(pview, box) == want);
+            }
+        }
+        {
+            using Point = LanePoint<double, 2>;
+            lux::cxx::Orthtree<Point, 2, double>::Config cfg2;
+            cfg2.root_bounds = lux::cxx::Box<double, 2>({ -1.0, -1.0 }, { 1.0, 1.0 });
+            cfg2.max_points_per_leaf = 16;
+            std::vector<Point> pts2;
+            for (std::uint32_t i = 0; i < 5000; ++i) pts2.push_back(gen_lane_point<double, 2>(rng, i));
+            lux::cxx::Orthtree<Point, 2, double> tree2(cfg2, pts2);
+            for (const bool quantize : { false, true })
+            {
+                std::stringstream buf;
+                lux::cxx::save_snapshot(buf, tree2, { .quantize_positions = quantize });
+                const std::string bytes = buf.str();
+                const lux::cxx::OrthtreeView<Point, 2, double> view2(as_bytes(bytes));
+                for (int q = 0; q < 20; ++q)
+                {
+                    const std::array<double, 2> c{ dist(rng), dist(rng) };
+                    std::vector<std::uint32_t> want, got;
+                    tree2.forEachPointInBall(c, 0.3, [&](const Point& p) { want.push_back(p.id); });
+                    view2.forEachPointInBall(c, 0.3, [&](const Point& p) { got.push_back(p.id); });
+                    std::sort(want.begin(), want.end());
+                    std::sort(got.begin(), got.end());
+                    // 16-bit steps of a double cell can move a point across the sphere.
+                    if (!quantize) LUX_TEST_ASSERT(got == want);
+                    else LUX_TEST_ASSERT(got.size() + 5 >= want.size() && got.size() <= want.size() + 5);
+                }
+            }
+        }
+
+        // An empty tree, and files that do not match the view.
+        {
+            std::stringstream buf;
+            lux::cxx::save_snapshot(buf, Tree(cfg));
+            const std::string bytes = buf.str();
+            const View empty(as_bytes(bytes));
+            LUX_TEST_ASSERT(empty.empty() && empty.nearest(std::array<float, 3>{}) == nullptr);
+            LUX_TEST_ASSERT(view_ids_in_box(empty, cfg.root_bounds).empty());
+        }
+        auto throws = [](auto&& f) {
+            try { f(); }
+            catch (const std::runtime_error&) { return true; }
+            return false;
+        };
+        const auto b = as_bytes(raw);
+        LUX_TEST_ASSERT(throws([&] { lux::cxx::OrthtreeView<Point3f, 3, double> v(b); }));
+        LUX_TEST_ASSERT(throws([&] { lux::cxx::OrthtreeView<Point3f, 2, float> v(b); }));
+        LUX_TEST_ASSERT(throws([&] { lux::cxx::OrthtreeView<Point2f, 3, float> v(b); }));
+        LUX_TEST_ASSERT(throws([&] { View v(b.first(b.size() - 1)); }));
+        {
+            // The root's children pointing back at the root: caught when a query gets there.
+            std::string bad = raw;
+            lux::cxx::detail::SnapshotHeader header;
+            std::memcpy(&header, bad.data(), sizeof(header));
+            lux::cxx::detail::OrthtreeSnapshotNode<float, 3> root;
+            std::memcpy(&root, bad.data() + header.sections[0].offset, sizeof(root));
+            LUX_TEST_ASSERT(root.child_count > 0);
+            root.first_child = 0;
+            std::memcpy(bad.data() + header.sections[0].offset, &root, sizeof(root));
+            const View v(as_bytes(bad));
+            LUX_TEST_ASSERT(throws([&] { view_ids_in_box(v, cfg.root_bounds); }));
+            LUX_TEST_ASSERT(throws([&] { v.nearest(std::array<float, 3>{}); }));
+        }
+        {
+            // Saving an Orthtree packs it with the tree's own (stateful) position accessor.
+            using ShiftedTree = lux::cxx::Orthtree<Point3f, 3, float, ShiftedPosition>;
+            ShiftedTree::Config scfg;
+            scfg.root_bounds = cfg.root_bounds;
+            scfg.max_depth = cfg.max_depth;
+            scfg.max_points_per_leaf = cfg.max_points_per_leaf;
+            const ShiftedTree shifted(scfg, gen_points3(5'000, 83, -0.4f, 0.4f), ShiftedPosition{ 0.5f });
+            std::stringstream raw_shifted, projected;
+            lux::cxx::save_snapshot(raw_shifted, shifted);
+            lux::cxx::save_snapshot(projected, shifted, [](const Point3f& p) { return p.id; });
+            const std::string raw_bytes = raw_shifted.str(), projected_bytes = projected.str();
+            // Raw points: the view reads positions through its own accessor.
+            const lux::cxx::OrthtreeView<Point3f, 3, float, ShiftedPosition> sview(as_bytes(raw_bytes), ShiftedPosition{ 0.5f });
+            // Projected records: the file's position section was written through the tree's accessor.
+            const lux::cxx::OrthtreeView<std::uint32_t, 3, float> pview(as_bytes(projected_bytes));
+            LUX_TEST_ASSERT(sview.size() == shifted.totalAlivePoints() && pview.size() == sview.size());
+            for (const auto& box : gen_query_boxes<3>(50, 84))
+            {
+                const auto want = ids_in_box(shifted, box);
+                LUX_TEST_ASSERT(view_ids_in_box(sview, box) == want);
+                std::vector<std::uint32_t> got;
+                pview.forEachPointInBox(box, [&](std::uint32_t id) { got.push_back(id); });
+                std::sort(got.begin(), got.end());
+                LUX_TEST_ASSERT(got == want);
+            }
+        }
+        {
+            // A one-node file whose leaf root claims more children than the section holds.
+            std::stringstream buf;
+            lux::cxx::save_snapshot(buf, Tree(cfg, std::vector<Point3f>(pts.begin(), pts.begin() + 4)));
+            std::string bad = buf.str();
+            lux::cxx::detail::SnapshotHeader header;
+            std::memcpy(&header, bad.data(), sizeof(header));
+            LUX_TEST_ASSERT(header.sections[0].bytes == sizeof(lux::cxx::detail::OrthtreeSnapshotNode<float, 3>));
+            lux::cxx::detail::OrthtreeSnapshotNode<float, 3> root;
+            std::memcpy(&root, bad.data() + header.sections[0].offset, sizeof(root));
+            root.child_count = 2;
+            root.first_child = 0xFFFFFFF0u;
+            std::memcpy(bad.data() + header.sections[0].offset, &root, sizeof(root));
+            const View v(as_bytes(bad));
+            LUX_TEST_ASSERT(throws([&] { view_ids_in_box(v, cfg.root_bounds); }));
+            LUX_TEST_ASSERT(throws([&] { v.nearest(std::array<float, 3>{}); }));
+        }
+    }
+
+    // ============================================================
+    // Performance test: Orthtree 3D
+    // ============================================================
+    void perf_orthtree_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] Orthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 512;
+
+        auto pts = gen_points3(a.n_points, a.seed);
+
+        Tree tree(cfg);
+
+        Timer t;
+
+        // Insert all points.
+        t.start();
+        for (const auto& p : pts) tree.insert(p);
+        double insert_ms = t.ms();
+        std::cout << "Insert: " << a.n_points << " points, " << insert_ms << " ms, "
+                  << (double(a.n_points) / (insert_ms / 1000.0)) << " pts/s\n";
+
+        // Query.
+        auto boxes = gen_query_boxes<3>(a.n_queries, a.seed + 111);
+
+        std::uint64_t total_hits = 0;
+        t.start();
+        for (const auto& b : boxes)
+        {
+            tree.forEachPointInBox(b, [&](const Point3f&) { ++total_hits; });
+        }
+        double query_ms = t.ms();
+        std::cout << "Query: " << a.n_queries << " boxes, " << query_ms << " ms, "
+                  << (double(a.n_queries) / (query_ms / 1000.0)) << " queries/s, "
+                  << "total_hits=" << total_hits << "\n";
+
+        // Delete points inside a fixed box.
+        lux::cxx::Box<float,3> del_box({-0.3f,-0.3f,-0.3f},{0.3f,0.3f,0.3f});
+        t.start();
+        std::size_t removed = tree.markDeletedInBox(del_box);
+        double del_ms = t.ms();
+        std::cout << "Delete(box): removed=" << removed << ", " << del_ms << " ms\n";
+
+        // Compact.
+        t.start();
+        std::size_t compact_removed = tree.compactDirtyLeaves();
+        double compact_ms = t.ms();
+        std::cout << "Compact: removed=" << compact_removed << ", " << compact_ms << " ms\n";
+
+        // Snapshot.
+        t.start();
+        auto snap = tree.captureSnapshot(true);
+        double snap_ms = t.ms();
+        std::cout << "Snapshot: leaves=" << snap.leaves.size() << ", " << snap_ms << " ms\n";
+    }
+
+    // ============================================================
+    // Performance test: OrthtreePmr 3D
+    // ============================================================
+    void perf_orthtree_pmr_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] OrthtreePmr 3D (PMR)\n";
+
+        std::pmr::unsynchronized_pool_resource pool;
+
+        using Tree = lux::cxx::OrthtreePmr<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 512;
+
+        auto pts = gen_points3(a.n_points, a.seed);
+
+        Tree tree(cfg, {}, &pool);
+
+        Timer t;
+
+        // Insert all points.
+        t.start();
+        for (const auto& p : pts) tree.insert(p);
+        double insert_ms = t.ms();
+        std::cout << "Insert: " << a.n_points << " points, " << insert_ms << " ms, "
+                  << (double(a.n_points) / (insert_ms / 1000.0)) << " pts/s\n";
+
+        // Query.
+        auto boxes = gen_query_boxes<3>(a.n_queries, a.seed + 222);
+
+        std::uint64_t total_hits = 0;
+        t.start();
+        for (const auto& b : boxes)
+        {
+            tree.forEachPointInBox(b, [&](const Point3f&) { ++total_hits; });
+        }
+        double query_ms = t.ms();
+        std::cout << "Query: " << a.n_queries << " boxes, " << query_ms << " ms, "
+                  << (double(a.n_queries) / (query_ms / 1000.0)) << " queries/s, "
+                  << "total_hits=" << total_hits << "\n";
+
+        // Delete points inside a fixed box.
+        lux::cxx::Box<float,3> del_box({-0.3f,-0.3f,-0.3f},{0.3f,0.3f,0.3f});
+        t.start();
+        std::size_t removed = tree.markDeletedInBox(del_box);
+        double del_ms = t.ms();
+        std::cout << "Delete(box): removed=" << removed << ", " << del_ms << " ms\n";
+
+        // Compact.
+        t.start();
+        std::size_t compact_removed = tree.compactDirtyLeaves();
+        double compact_ms = t.ms();
+        std::cout << "Compact: removed=" << compact_removed << ", " << compact_ms << " ms\n";
+
+        // Snapshot
+        t.start();
+        auto snap = tree.captureSnapshot(true);
+        double snap_ms = t.ms();
+        std::cout << "Snapshot: leaves=" << snap.leaves.size() << ", " << snap_ms << " ms\n";
+    }
+
+    // Optional 2-D performance test (complement to the 3-D version above).
+    void perf_orthtree_2d(const Args& a)
+    {
+        std::cout << "\n[Performance] Orthtree 2D\n";
+
+        using Tree = lux::cxx::Orthtree<Point2f, 2, float, GetXY>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<2>(-1.0f, 1.0f);
+        cfg.max_depth = 12;
+        cfg.max_points_per_leaf = 256;
+
+        auto pts = gen_points2(a.n_points, a.seed + 10);
+
+        Tree tree(cfg, GetXY{});
+
+        Timer t;
+
+        t.start();
+        for (const auto& p : pts) tree.insert(p);
+        double insert_ms = t.ms();
+        std::cout << "Insert: " << a.n_points << " points, " << insert_ms << " ms, "
+                  << (double(a.n_points) / (insert_ms / 1000.0)) << " pts/s\n";
+
+        auto boxes = gen_query_boxes<2>(a.n_queries, a.seed + 333);
+
+        std::uint64_t total_hits = 0;
+        t.start();
+        for (const auto& b : boxes)
+        {
+            tree.forEachPointInBox(b, [&](const Point2f&) { ++total_hits; });
+        }
+        double query_ms = t.ms();
+        std::cout << "Query: " << a.n_queries << " boxes, " << query_ms << " ms, "
+                  << (double(a.n_queries) / (query_ms / 1000.0)) << " queries/s, "
+                  << "total_hits=" << total_hits << "\n";
+
+        lux::cxx::Box<float,2> del_box({-0.3f,-0.3f},{0.3f,0.3f});
+        t.start();
+        std::size_t removed = tree.markDeletedInBox(del_box);
+        double del_ms = t.ms();
+        std::cout << "Delete(box): removed=" << removed << ", " << del_ms << " ms\n";
+
+        t.start();
+        std::size_t compact_removed = tree.compactDirtyLeaves();
+        double compact_ms = t.ms();
+        std::cout << "Compact: removed=" << compact_removed << ", " << compact_ms << " ms\n";
+
+        t.start();
+        auto snap = tree.captureSnapshot(true);
+        double snap_ms = t.ms();
+        std::cout << "Snapshot: leaves=" << snap.leaves.size() << ", " << snap_ms << " ms\n";
+    }
+
+    void perf_orthtree_pmr_2d(const Args& a)
+    {
+        std::cout << "\n[Performance] OrthtreePmr 2D (PMR)\n";
+
+        std::pmr::unsynchronized_pool_resource pool;
+
+        using Tree = lux::cxx::OrthtreePmr<Point2f, 2, float, GetXY>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<2>(-1.0f, 1.0f);
+        cfg.max_depth = 12;
+        cfg.max_points_per_leaf = 256;
+
+        auto pts = gen_points2(a.n_points, a.seed + 20);
+
+        Tree tree(cfg, GetXY{}, &pool);
+
+        Timer t;
+
+        t.start();
+        for (const auto& p : pts) tree.insert(p);
+        double insert_ms = t.ms();
+        std::cout << "Insert: " << a.n_points << " points, " << insert_ms << " ms, "
+                  << (double(a.n_points) / (insert_ms / 1000.0)) << " pts/s\n";
+
+        auto boxes = gen_query_boxes<2>(a.n_queries, a.seed + 444);
+
+        std::uint64_t total_hits = 0;
+        t.start();
+        for (const auto& b : boxes)
+        {
+            tree.forEachPointInBox(b, [&](const Point2f&) { ++total_hits; });
+        }
+        double query_ms = t.ms();
+        std::cout << "Query: " << a.n_queries << " boxes, " << query_ms << " ms, "
+                  << (double(a.n_queries) / (query_ms / 1000.0)) << " queries/s, "
+                  << "total_hits=" << total_hits << "\n";
 
         lux::cxx::Box<float,2> del_box({-0.3f,-0.3f},{0.3f,0.3f});
         t.start();
@@ -791,6 +2315,601 @@ namespace
                       << (double(a.n_points) / (ms / 1000.0)) << " pts/s\n";
         }
     }
+
+    // ============================================================
+    // Build time: incremental insertMany vs bulkLoad (serial and on a ThreadPool)
+    // ============================================================
+    void perf_bulk_load_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] insertMany vs bulkLoad — Orthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 512;
+
+        auto pts = gen_points3(a.n_points, a.seed + 600);
+        lux::cxx::ThreadPool pool;
+
+        Timer t;
+        auto report = [&](const char* name, double ms, const Tree& tree) {
+            std::cout << name << ": " << a.n_points << " points, " << ms << " ms, "
+                      << (double(a.n_points) / (ms / 1000.0)) << " pts/s, nodes=" << tree.nodeCount() << "\n";
+        };
+
+        {
+            Tree tree(cfg);
+            t.start();
+            tree.insertMany(pts);
+            report("insertMany", t.ms(), tree);
+        }
+        {
+            Tree tree(cfg);
+            t.start();
+            tree.bulkLoad(pts);
+            report("bulkLoad", t.ms(), tree);
+        }
+        {
+            Tree tree(cfg);
+            t.start();
+            tree.bulkLoad(pts, pool);
+            report("bulkLoad (ThreadPool)", t.ms(), tree);
+        }
+    }
+
+    // ============================================================
+    // kNN and ball queries: tree vs brute force vs box-query-then-filter
+    // ============================================================
+    void perf_knn_and_ball_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] kNN / ball queries — Orthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 64;
+
+        auto pts = gen_points3(a.n_points, a.seed + 700);
+        Tree tree(cfg, pts);
+
+        std::vector<std::array<float,3>> centers;
+        for (const auto& q : gen_points3(a.n_queries, a.seed + 701)) centers.push_back(q.position);
+
+        constexpr std::size_t k = 16;
+        auto dist2 = [](const std::array<float,3>& p, const std::array<float,3>& q) {
+            float d2 = 0.0f;
+            for (std::size_t i = 0; i < 3; ++i) { float d = p[i] - q[i]; d2 += d * d; }
+            return d2;
+        };
+        auto per_query_us = [](double ms, std::size_t q) { return ms * 1000.0 / double(q); };
+
+        Timer t;
+        std::uint64_t checksum = 0;
+
+        // Brute force over every point (few queries; it is O(n) each).
+        const std::size_t brute_q = std::min<std::size_t>(centers.size(), 20);
+        {
+            std::vector<std::pair<float, std::uint32_t>> all(pts.size());
+            t.start();
+            for (std::size_t qi = 0; qi < brute_q; ++qi)
+            {
+                for (std::size_t i = 0; i < pts.size(); ++i) all[i] = { dist2(pts[i].position, centers[qi]), pts[i].id };
+                std::partial_sort(all.begin(), all.begin() + k, all.end());
+                checksum += all[0].second;
+            }
+            std::cout << "kNN brute force: " << per_query_us(t.ms(), brute_q) << " us/query\n";
+        }
+
+        // Box query sized for ~k points, grown until it holds k, then sorted by the caller.
+        {
+            const float half0 = 0.5f * std::cbrt(8.0f * float(2 * k) / float(pts.size()));
+            std::vector<std::pair<float, std::uint32_t>> cand;
+            t.start();
+            for (const auto& c : centers)
+            {
+                for (float half = half0;; half *= 2.0f)
+                {
+                    cand.clear();
+                    lux::cxx::Box<float,3> box({c[0]-half, c[1]-half, c[2]-half}, {c[0]+half, c[1]+half, c[2]+half});
+                    tree.forEachPointInBox(box, [&](const Point3f& p) { cand.emplace_back(dist2(p.position, c), p.id); });
+                    if (cand.size() < k) continue;
+                    std::partial_sort(cand.begin(), cand.begin() + k, cand.end());
+                    // The k-th hit is exact only if its sphere fits in the box.
+                    if (cand[k - 1].first <= half * half) break;
+                }
+                checksum += cand[0].second;
+            }
+            std::cout << "kNN box query + filter: " << per_query_us(t.ms(), centers.size()) << " us/query\n";
+        }
+
+        {
+            std::vector<Point3f> out;
+            t.start();
+            for (const auto& c : centers)
+            {
+                out.clear();
+                tree.kNearest(c, k, std::back_inserter(out));
+                checksum += out[0].id;
+            }
+            std::cout << "kNearest: " << per_query_us(t.ms(), centers.size()) << " us/query\n";
+        }
+        {
+            t.start();
+            tree.kNearestMany(centers, k, [&](std::size_t, const Point3f& p) { checksum += p.id; });
+            std::cout << "kNearestMany: " << per_query_us(t.ms(), centers.size()) << " us/query\n";
+        }
+
+        // Ball queries.
+        const float r = 0.05f;
+        std::uint64_t hits_box = 0, hits_ball = 0, hits_balls = 0;
+        t.start();
+        for (const auto& c : centers)
+        {
+            lux::cxx::Box<float,3> box({c[0]-r, c[1]-r, c[2]-r}, {c[0]+r, c[1]+r, c[2]+r});
+            tree.forEachPointInBox(box, [&](const Point3f& p) { if (dist2(p.position, c) <= r * r) ++hits_box; });
+        }
+        std::cout << "ball via box query + filter: " << per_query_us(t.ms(), centers.size()) << " us/query\n";
+
+        t.start();
+        for (const auto& c : centers)
+            tree.forEachPointInBall(c, r, [&](const Point3f&) { ++hits_ball; });
+        std::cout << "forEachPointInBall: " << per_query_us(t.ms(), centers.size()) << " us/query\n";
+
+        t.start();
+        tree.forEachPointInBalls(centers, r, [&](std::size_t, const Point3f&) { ++hits_balls; });
+        std::cout << "forEachPointInBalls: " << per_query_us(t.ms(), centers.size()) << " us/query"
+                  << ", hits=" << hits_balls << " (checksum " << checksum << ")\n";
+
+        LUX_TEST_ASSERT(hits_ball == hits_box && hits_balls == hits_box);
+    }
+    // ============================================================
+    // Box queries: per-leaf vectors (Orthtree) vs packed arrays (PackedOrthtree)
+    // ============================================================
+    void perf_packed_orthtree_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] Orthtree vs PackedOrthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        using Packed = lux::cxx::PackedOrthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 64;
+
+        auto pts = gen_points3(a.n_points, a.seed + 800);
+        // Incremental insertion scatters leaf allocations across the heap, as in a long-lived tree.
+        Tree tree(cfg);
+        tree.insertMany(pts);
+
+        Timer t;
+        t.start();
+        Packed packed(tree);
+        std::cout << "pack: " << t.ms() << " ms, nodes=" << packed.nodeCount()
+                  << ", leaves=" << packed.leafCount() << "\n";
+
+        auto small_boxes = gen_query_boxes<3>(a.n_queries, a.seed + 801);
+        // Large boxes are dominated by fully covered nodes.
+        std::vector<lux::cxx::Box<float,3>> large_boxes;
+        for (const auto& c : gen_points3(std::max<std::size_t>(a.n_queries / 50, 1), a.seed + 802, -0.6f, 0.6f))
+        {
+            const auto& p = c.position;
+            large_boxes.push_back({ {p[0]-0.4f, p[1]-0.4f, p[2]-0.4f}, {p[0]+0.4f, p[1]+0.4f, p[2]+0.4f} });
+        }
+
+        auto run = [&](const char* name, const auto& tr, const std::vector<lux::cxx::Box<float,3>>& boxes) {
+            std::uint64_t hits = 0, checksum = 0;
+            t.start();
+            for (const auto& b : boxes)
+                tr.forEachPointInBox(b, [&](const Point3f& p) { ++hits; checksum += p.payload; });
+            const double ms = t.ms();
+            std::cout << name << ": " << boxes.size() << " boxes, " << ms << " ms, "
+                      << (double(hits) / (ms / 1000.0) / 1e6) << " M hits/s (hits=" << hits
+                      << ", checksum " << checksum << ")\n";
+            return hits;
+        };
+
+        const auto small_tree = run("Orthtree small boxes", tree, small_boxes);
+        LUX_TEST_ASSERT(run("PackedOrthtree small boxes", packed, small_boxes) == small_tree);
+        const auto large_tree = run("Orthtree large boxes", tree, large_boxes);
+        LUX_TEST_ASSERT(run("PackedOrthtree large boxes", packed, large_boxes) == large_tree);
+    }
+    // ============================================================
+    // Full snapshot vs delta snapshot under light churn
+    // ============================================================
+    void perf_delta_snapshot_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] captureSnapshot vs captureDelta — Orthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 64;
+
+        auto pts = gen_points3(a.n_points, a.seed + 900);
+        Tree tree(cfg, pts);
+        auto churn = gen_points3(std::max<std::size_t>(a.n_points / 1000, 1), a.seed + 901);
+
+        Timer t;
+        double full_ms = 0.0, delta_ms = 0.0;
+        std::size_t full_leaves = 0, delta_leaves = 0;
+        constexpr int frames = 10;
+        for (int f = 0; f < frames; ++f)
+        {
+            const std::uint64_t since = tree.version();
+            // ~0.1% of the points move per frame: delete near one spot, insert elsewhere.
+            const auto& c = churn[std::size_t(f) % churn.size()].position;
+            tree.markDeletedInBall(c, 0.03f);
+            for (std::size_t i = f; i < churn.size(); i += frames) tree.insert(churn[i]);
+
+            t.start();
+            auto snap = tree.captureSnapshot(false);
+            full_ms += t.ms();
+            full_leaves += snap.leaves.size();
+
+            t.start();
+            auto delta = tree.captureDelta(since);
+            delta_ms += t.ms();
+            delta_leaves += delta.changed.size();
+        }
+        std::cout << "captureSnapshot: " << full_ms / frames << " ms/frame, "
+                  << full_leaves / frames << " leaves/frame\n";
+        std::cout << "captureDelta: " << delta_ms / frames << " ms/frame, "
+                  << delta_leaves / frames << " leaves/frame\n";
+    }
+    // ============================================================
+    // Many boxes per frame: one at a time vs batched vs on a ThreadPool
+    // ============================================================
+    void perf_parallel_queries_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] parallel / batched box queries — Orthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 64;
+
+        auto pts = gen_points3(a.n_points, a.seed + 1000);
+        Tree tree(cfg, pts);
+        auto boxes = gen_query_boxes<3>(a.n_queries, a.seed + 1001);
+        lux::cxx::ThreadPool pool;
+        std::cout << "threads: " << pool.thread_count() + 1 << "\n";
+
+        Timer t;
+        auto report = [&](const char* name, double ms, std::uint64_t hits) {
+            std::cout << name << ": " << boxes.size() << " boxes, " << ms << " ms, hits=" << hits << "\n";
+        };
+
+        std::uint64_t hits_serial = 0;
+        t.start();
+        for (const auto& b : boxes)
+            tree.forEachPointInBox(b, [&](const Point3f&) { ++hits_serial; });
+        report("forEachPointInBox (loop)", t.ms(), hits_serial);
+
+        std::vector<std::uint64_t> per_slot(pool.thread_count() + 1, 0);
+        t.start();
+        for (const auto& b : boxes)
+            tree.forEachPointInBox(b, pool, [&](std::size_t slot, const Point3f&) { ++per_slot[slot]; });
+        const double ms_par = t.ms();
+        std::uint64_t hits_par = 0;
+        for (auto h : per_slot) hits_par += h;
+        report("forEachPointInBox (ThreadPool, loop)", ms_par, hits_par);
+
+        std::vector<std::uint64_t> per_query(boxes.size(), 0);
+        t.start();
+        tree.forEachPointInBoxes(boxes, [&](std::size_t q, const Point3f&) { ++per_query[q]; });
+        const double ms_batch = t.ms();
+        std::uint64_t hits_batch = 0;
+        for (auto h : per_query) hits_batch += h;
+        report("forEachPointInBoxes", ms_batch, hits_batch);
+
+        std::fill(per_query.begin(), per_query.end(), 0);
+        t.start();
+        tree.forEachPointInBoxes(boxes, pool, [&](std::size_t q, const Point3f&) { ++per_query[q]; });
+        const double ms_batch_par = t.ms();
+        std::uint64_t hits_batch_par = 0;
+        for (auto h : per_query) hits_batch_par += h;
+        report("forEachPointInBoxes (ThreadPool)", ms_batch_par, hits_batch_par);
+
+        LUX_TEST_ASSERT(hits_par == hits_serial && hits_batch == hits_serial && hits_batch_par == hits_serial);
+    }
+    // ============================================================
+    // Churn: full compaction scan vs budgeted incremental maintenance
+    // ============================================================
+    void perf_maintenance_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] compactDirtyLeaves vs maintain under churn — Orthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 64;
+        cfg.merge_threshold = 16;
+
+        auto pts = gen_points3(a.n_points, a.seed + 1100);
+        auto boxes = gen_query_boxes<3>(a.n_queries, a.seed + 1101);
+        Timer t;
+
+        auto query_ms = [&](const Tree& tree) {
+            std::uint64_t hits = 0;
+            t.start();
+            for (const auto& b : boxes) tree.forEachPointInBox(b, [&](const Point3f&) { ++hits; });
+            return t.ms();
+        };
+
+        // A small frame: 0.1% of the points die in one region, then the tree is tidied.
+        {
+            Tree full(cfg, pts), incr(cfg, pts);
+            const lux::cxx::Box<float,3> region({-0.2f, -0.2f, -0.2f}, {0.0f, 0.0f, 0.0f});
+            full.markDeletedInBox(region);
+            incr.markDeletedInBox(region);
+            t.start();
+            full.compactDirtyLeaves();
+            std::cout << "0.1% churn, compactDirtyLeaves: " << t.ms() << " ms\n";
+            t.start();
+            auto st = incr.maintain();
+            std::cout << "0.1% churn, maintain: " << t.ms() << " ms, leaves=" << st.leaves_compacted
+                      << ", merged=" << st.nodes_merged << "\n";
+        }
+
+        // Heavy churn: 95% of the points die; merging restores traversal speed.
+        {
+            Tree tree(cfg, pts);
+            tree.markDeletedIf([](const Point3f& p) { return p.id % 20 != 0; });
+            std::cout << "95% deleted, query before: " << query_ms(tree) << " ms, leaves="
+                      << reachable_leaf_count(tree) << "\n";
+
+            Tree compacted(cfg, pts);
+            compacted.markDeletedIf([](const Point3f& p) { return p.id % 20 != 0; });
+            compacted.compactDirtyLeaves();
+            std::cout << "95% deleted, query after compactDirtyLeaves: " << query_ms(compacted) << " ms\n";
+
+            std::size_t calls = 0;
+            t.start();
+            for (;;)
+            {
+                ++calls;
+                if (tree.maintain(std::size_t(1) << 16).done) break;
+            }
+            const double maint_ms = t.ms();
+            std::cout << "maintain (64K-point budget): " << calls << " calls, " << maint_ms << " ms total, "
+                      << maint_ms / double(calls) << " ms/call\n";
+            std::cout << "95% deleted, query after maintain: " << query_ms(tree) << " ms, leaves="
+                      << reachable_leaf_count(tree) << ", free nodes=" << tree.freeNodeCount() << "\n";
+        }
+    }
+
+    // ============================================================
+    // Every point moves each frame: rebuild vs update vs updateMany
+    // ============================================================
+    void perf_update_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] Moving points: bulkLoad vs update vs updateMany — Orthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        using Handle = Tree::PointHandle;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 64;
+        cfg.track_handles = true;
+
+        constexpr int kFrames = 3;
+        const auto pts = gen_points3(a.n_points, a.seed + 1200);
+        Timer t;
+
+        // Slow movers mostly stay in their leaf; fast ones mostly change leaf.
+        for (const float speed : { 0.002f, 0.02f })
+        {
+            // Precomputed frames, each point bouncing off the root bounds.
+            std::vector<std::vector<Point3f>> frames(kFrames + 1, pts);
+            {
+                std::mt19937_64 rng(a.seed + 1201);
+                std::uniform_real_distribution<float> dist(-speed, speed);
+                std::vector<std::array<float, 3>> vel(pts.size());
+                for (auto& v : vel) v = { dist(rng), dist(rng), dist(rng) };
+                for (int f = 1; f <= kFrames; ++f)
+                    for (std::size_t i = 0; i < pts.size(); ++i)
+                        for (std::size_t k = 0; k < 3; ++k)
+                        {
+                            float c = frames[f - 1][i].position[k] + vel[i][k];
+                            if (c < -1.0f || c > 1.0f) { vel[i][k] = -vel[i][k]; c = std::clamp(c, -1.0f, 1.0f); }
+                            frames[f][i].position[k] = c;
+                        }
+            }
+            std::cout << "max step " << speed << ":\n";
+
+            Tree rebuilt(cfg), looped(cfg), batched(cfg);
+            std::vector<Handle> handles;
+            rebuilt.bulkLoad(frames[0], handles);
+            looped.bulkLoad(frames[0], handles);
+            batched.bulkLoad(frames[0], handles);
+
+            double rebuild_ms = 0.0, loop_ms = 0.0, batch_ms = 0.0;
+            std::vector<std::pair<Handle, Point3f>> moves(pts.size());
+            for (int f = 1; f <= kFrames; ++f)
+            {
+                std::vector<Handle> reloaded;
+                t.start();
+                rebuilt.bulkLoad(frames[f], reloaded);
+                rebuild_ms += t.ms();
+
+                t.start();
+                for (std::size_t i = 0; i < pts.size(); ++i) looped.update(handles[i], frames[f][i]);
+                loop_ms += t.ms();
+
+                for (std::size_t i = 0; i < pts.size(); ++i) moves[i] = { handles[i], frames[f][i] };
+                t.start();
+                batched.updateMany(moves);
+                batch_ms += t.ms();
+            }
+            LUX_TEST_ASSERT(looped.totalAlivePoints() == pts.size() && batched.totalAlivePoints() == pts.size());
+            std::cout << "  bulkLoad per frame: " << rebuild_ms / kFrames << " ms\n";
+            std::cout << "  update per frame: " << loop_ms / kFrames << " ms\n";
+            std::cout << "  updateMany per frame: " << batch_ms / kFrames << " ms\n";
+        }
+    }
+    // ============================================================
+    // Performance test: SIMD leaf scans vs per-point tests
+    // ============================================================
+    template <class Scalar>
+    void perf_leaf_kernels(const Args& a, const char* name)
+    {
+        using Point = LanePoint<Scalar, 3>;
+        using Tree = lux::cxx::Orthtree<Point, 3, Scalar>;
+        typename Tree::Config cfg;
+        for (std::size_t k = 0; k < 3; ++k) { cfg.root_bounds.min[k] = Scalar(-1); cfg.root_bounds.max[k] = Scalar(1); }
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 64;
+
+        std::vector<Point> pts;
+        for (const auto& p : gen_points3(a.n_points, a.seed + 1300))
+            pts.push_back({ { Scalar(p.position[0]), Scalar(p.position[1]), Scalar(p.position[2]) }, p.id });
+        std::vector<std::array<Scalar, 3>> centers;
+        for (const auto& q : gen_points3(a.n_queries, a.seed + 1301))
+            centers.push_back({ Scalar(q.position[0]), Scalar(q.position[1]), Scalar(q.position[2]) });
+
+        std::cout << name << ":\n";
+        Timer t;
+        double ms[2][4] = {};
+        std::uint64_t hits[2][4] = {};
+        for (int lanes = 0; lanes < 2; ++lanes)
+        {
+            typename Tree::Config c = cfg;
+            c.position_lanes = lanes != 0;
+            Tree tree(c);
+            tree.bulkLoad(pts);
+
+            std::size_t col = 0;
+            for (const Scalar half : { Scalar(0.02), Scalar(0.2) })
+            {
+                t.start();
+                for (const auto& q : centers)
+                {
+                    const lux::cxx::Box<Scalar, 3> box({ q[0] - half, q[1] - half, q[2] - half }, { q[0] + half, q[1] + half, q[2] + half });
+                    tree.forEachPointInBox(box, [&](const Point& p) { hits[lanes][col] += p.id; });
+                }
+                ms[lanes][col++] = t.ms();
+            }
+            t.start();
+            for (const auto& q : centers)
+                tree.forEachPointInBall(q, Scalar(0.05), [&](const Point& p) { hits[lanes][col] += p.id; });
+            ms[lanes][col++] = t.ms();
+
+            t.start();
+            for (const auto& q : centers) hits[lanes][col] += tree.markDeletedInBall(q, Scalar(0.05));
+            ms[lanes][col] = t.ms();
+        }
+        const char* labels[] = { "small box (half 0.02)", "large box (half 0.2)", "ball (r 0.05)", "markDeletedInBall (r 0.05)" };
+        for (std::size_t col = 0; col < 4; ++col)
+        {
+            LUX_TEST_ASSERT(hits[0][col] == hits[1][col]);
+            std::cout << "  " << labels[col] << ": per-point " << ms[0][col] << " ms, lanes " << ms[1][col]
+                      << " ms (x" << ms[0][col] / ms[1][col] << ")\n";
+        }
+    }
+
+    void perf_leaf_kernels_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] SIMD leaf scans vs per-point tests — Orthtree 3D, " << a.n_queries << " queries\n";
+        if (!lux::cxx::detail::kOrthtreeLaneKernels)
+            std::cout << "(built without AVX2 / AVX-512: both runs test points one by one)\n";
+        perf_leaf_kernels<float>(a, "float");
+        perf_leaf_kernels<double>(a, "double");
+    }
+    // ============================================================
+    // Performance test: open-to-first-query, snapshot vs rebuild
+    //
+    // Restarting from a raw point dump (read + insertMany or bulkLoad)
+    // against mapping a snapshot. The files were just written, so they are
+    // in the page cache: this measures CPU cost, not disk reads.
+    // ============================================================
+    void perf_snapshot_3d(const Args& a)
+    {
+        std::cout << "\n[Performance] open-to-first-query: snapshot vs rebuild — Orthtree 3D\n";
+
+        using Tree = lux::cxx::Orthtree<Point3f, 3, float>;
+        Tree::Config cfg;
+        cfg.root_bounds = make_root_bounds<3>(-1.0f, 1.0f);
+        cfg.max_depth = 10;
+        cfg.max_points_per_leaf = 64;
+
+        const auto pts = gen_points3(a.n_points, a.seed + 1400);
+        const auto boxes = gen_query_boxes<3>(a.n_queries, a.seed + 1401);
+        const auto dir = std::filesystem::temp_directory_path();
+        const auto dump_path = dir / "lux_orthtree_points.bin";
+        const auto raw_path = dir / "lux_orthtree_raw.snap";
+        const auto quant_path = dir / "lux_orthtree_q16.snap";
+        {
+            std::ofstream out(dump_path, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(pts.data()), static_cast<std::streamsize>(pts.size() * sizeof(Point3f)));
+            const Tree tree(cfg, pts);
+            std::ofstream raw(raw_path, std::ios::binary);
+            lux::cxx::save_snapshot(raw, tree);
+            std::ofstream quant(quant_path, std::ios::binary);
+            lux::cxx::save_snapshot(quant, tree, [](const Point3f& p) { return p.id; }, { .quantize_positions = true });
+        }
+        std::cout << "files: points " << std::filesystem::file_size(dump_path) / 1024 << " KiB, snapshot "
+                  << std::filesystem::file_size(raw_path) / 1024 << " KiB, quantized (id records) "
+                  << std::filesystem::file_size(quant_path) / 1024 << " KiB\n";
+
+        Timer t;
+        std::uint64_t checksum = 0;
+        auto read_points = [&] {
+            std::vector<Point3f> loaded(std::filesystem::file_size(dump_path) / sizeof(Point3f));
+            std::ifstream in(dump_path, std::ios::binary);
+            in.read(reinterpret_cast<char*>(loaded.data()), static_cast<std::streamsize>(loaded.size() * sizeof(Point3f)));
+            return loaded;
+        };
+
+        t.start();
+        {
+            Tree tree(cfg);
+            tree.insertMany(read_points());
+            tree.forEachPointInBox(boxes[0], [&](const Point3f& p) { checksum += p.id; });
+            std::cout << "read + insertMany + first query: " << t.ms() << " ms\n";
+        }
+        t.start();
+        {
+            Tree tree(cfg);
+            tree.bulkLoad(read_points());
+            tree.forEachPointInBox(boxes[0], [&](const Point3f& p) { checksum += p.id; });
+            std::cout << "read + bulkLoad + first query: " << t.ms() << " ms\n";
+        }
+
+        const Tree tree(cfg, pts);
+        t.start();
+        lux::cxx::MappedSnapshot<lux::cxx::OrthtreeView<Point3f, 3>> raw(raw_path);
+        raw->forEachPointInBox(boxes[0], [&](const Point3f& p) { checksum += p.id; });
+        std::cout << "map snapshot + first query: " << t.ms() << " ms\n";
+        t.start();
+        lux::cxx::MappedSnapshot<lux::cxx::OrthtreeView<std::uint32_t, 3>> quant(quant_path);
+        quant->forEachPointInBox(boxes[0], [&](std::uint32_t id) { checksum += id; });
+        std::cout << "map quantized snapshot + first query: " << t.ms() << " ms\n";
+
+        // Steady state: the same boxes against the tree and both views.
+        std::uint64_t hits[3] = {};
+        t.start();
+        for (const auto& box : boxes) tree.forEachPointInBox(box, [&](const Point3f&) { ++hits[0]; });
+        const double tree_ms = t.ms();
+        t.start();
+        for (const auto& box : boxes) raw->forEachPointInBox(box, [&](const Point3f&) { ++hits[1]; });
+        const double raw_ms = t.ms();
+        t.start();
+        for (const auto& box : boxes) quant->forEachPointInBox(box, [&](std::uint32_t) { ++hits[2]; });
+        const double quant_ms = t.ms();
+        LUX_TEST_ASSERT(hits[0] == hits[1] && checksum > 0);
+        std::cout << boxes.size() << " box queries: Orthtree " << tree_ms << " ms, view " << raw_ms
+                  << " ms, quantized view " << quant_ms << " ms (hits " << hits[0] << " / " << hits[2] << ")\n";
+
+        std::filesystem::remove(dump_path);
+        std::filesystem::remove(raw_path);
+        std::filesystem::remove(quant_path);
+    }
 }
 
 int main(int argc, char** argv)
@@ -813,6 +2932,15 @@ int main(int argc, char** argv)
         test_correctness_orthtree_2d();
         test_correctness_orthtree_pmr_2d();
     }
+    test_correctness_bulk_load();
+    test_correctness_knn_and_ball();
+    test_correctness_packed_orthtree();
+    test_correctness_delta_snapshot();
+    test_correctness_parallel_queries();
+    test_correctness_maintenance();
+    test_correctness_point_handles();
+    test_correctness_lane_scans();
+    test_correctness_snapshot();
 
     std::cout << "\nAll correctness tests passed.\n";
 
@@ -831,6 +2959,33 @@ int main(int argc, char** argv)
     if (args.run_3d) perf_insert_vs_emplace_3d(args);
     if (args.run_2d) perf_insert_vs_emplace_2d(args);
 
+    // -------- bulk load --------
+    if (args.run_3d) perf_bulk_load_3d(args);
+
+    // -------- kNN / ball --------
+    if (args.run_3d) perf_knn_and_ball_3d(args);
+
+    // -------- packed layout --------
+    if (args.run_3d) perf_packed_orthtree_3d(args);
+
+    // -------- delta snapshots --------
+    if (args.run_3d) perf_delta_snapshot_3d(args);
+
+    // -------- parallel / batched queries --------
+    if (args.run_3d) perf_parallel_queries_3d(args);
+
+    // -------- maintenance --------
+    if (args.run_3d) perf_maintenance_3d(args);
+
+    // -------- moving points --------
+    if (args.run_3d) perf_update_3d(args);
+
+    // -------- SIMD leaf scans --------
+    if (args.run_3d) perf_leaf_kernels_3d(args);
+
+    // -------- snapshots --------
+    if (args.run_3d) perf_snapshot_3d(args);
+
     std::cout << "\nDone.\n";
     return 0;
 }
\ No newline at end of file
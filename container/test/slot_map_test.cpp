@@ -7,6 +7,9 @@
 #include <numeric>
 #include <memory>
 #include <unordered_set>
+#include <chrono>
+#include <cstdint>
+#include <random>
 
 using namespace lux::cxx;
 
@@ -378,6 +381,312 @@ void test_capacity_and_shrink()
     std::cout << "  capacity/shrink_to_fit tests passed" << std::endl;
 }
 
+// ---- paged storage ----------------------------------------------------------
+
+void test_paged_storage()
+{
+    PagedSlotMap<std::string, void, 16> map;
+    auto first = map.insert("first");
+    const std::string* first_ptr = map.find(first);
+
+    std::vector<decltype(first)> keys;
+    for (int i = 0; i < 1000; i++)
+        keys.push_back(map.insert(std::to_string(i)));
+
+    // Growth appends pages; values inserted earlier never move.
+    TEST_ASSERT(map.find(first) == first_ptr);
+    TEST_ASSERT(*first_ptr == "first");
+    TEST_ASSERT(map.size() == 1001);
+
+    for (int i = 0; i < 1000; i += 2)
+        TEST_ASSERT(map.erase(keys[i]));
+    TEST_ASSERT(map.size() == 501);
+    for (int i = 1; i < 1000; i += 2)
+        TEST_ASSERT(map.at(keys[i]) == std::to_string(i));
+    TEST_ASSERT(!map.is_valid(keys[0]));
+
+    // Dense iteration, element-wise and page-wise, sees every live value once.
+    std::size_t count = 0;
+    for (const auto& v : map)
+    {
+        (void)v;
+        ++count;
+    }
+    TEST_ASSERT(count == map.size());
+
+    std::size_t paged = 0;
+    for (std::size_t p = 0; p < map.values().page_count(); ++p)
+        paged += map.values().page(p).size();
+    TEST_ASSERT(paged == map.size());
+
+    // Copies are deep.
+    auto copy = map;
+    copy.at(first) = "changed";
+    TEST_ASSERT(map.at(first) == "first");
+
+    map.clear();
+    TEST_ASSERT(map.empty());
+    auto k = map.insert("again");
+    TEST_ASSERT(map.at(k) == "again");
+
+    std::cout << "  paged storage tests passed" << std::endl;
+}
+
+struct Payload
+{
+    std::uint64_t a, b, c, d;
+};
+
+/**
+ * Worst-case single insert latency while growing to 1M elements. The contiguous
+ * policy pays for each doubling with a full relocation; the paged one only
+ * allocates a page.
+ */
+template <typename Map>
+double worst_insert_latency_us(std::size_t n, double& total_ms)
+{
+    Map map;
+    double worst = 0.0;
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        map.insert(Payload{ i, i, i, i });
+        auto t1 = std::chrono::high_resolution_clock::now();
+        worst = (std::max)(worst, std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    total_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+    TEST_ASSERT(map.size() == n);
+    return worst;
+}
+
+void bench_worst_case_insert_latency()
+{
+    constexpr std::size_t N = 1 << 20;
+
+    double contiguous_total = 0.0, paged_total = 0.0;
+    const double contiguous = worst_insert_latency_us<SlotMap<Payload>>(N, contiguous_total);
+    const double paged      = worst_insert_latency_us<PagedSlotMap<Payload>>(N, paged_total);
+
+    std::cout << "  worst-case insert latency over " << N << " inserts: contiguous "
+              << contiguous << " us (total " << contiguous_total << " ms), paged "
+              << paged << " us (total " << paged_total << " ms)" << std::endl;
+}
+
+// ---- batch and deferred erase ----------------------------------------------
+
+void test_insert_many()
+{
+    SlotMap<std::string> map;
+    map.insert("existing");
+
+    std::vector<std::string> values{ "a", "b", "c", "d" };
+    std::vector<SlotMap<std::string>::key_t> keys(values.size());
+    TEST_ASSERT(map.insert_many(values, keys) == 4);
+    TEST_ASSERT(map.size() == 5);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        TEST_ASSERT(map.at(keys[i]) == values[i]);
+
+    // Recycled slots are handed out too.
+    map.erase(keys[1]);
+    std::vector<SlotMap<std::string>::key_t> more(2);
+    map.insert_many(std::vector<std::string>{ "x", "y" }, more);
+    TEST_ASSERT(more[0].index == keys[1].index);
+    TEST_ASSERT(map.at(more[0]) == "x");
+    TEST_ASSERT(!map.is_valid(keys[1]));
+
+    bool threw = false;
+    std::vector<SlotMap<std::string>::key_t> small(1);
+    try { map.insert_many(values, small); }
+    catch (const std::length_error&) { threw = true; }
+    TEST_ASSERT(threw);
+    TEST_ASSERT(map.size() == 6);
+
+    // Paged arrays reserve only the pages a batch needs.
+    PagedSlotMap<int, void, 16> paged;
+    std::vector<int> ints(20, 7);
+    std::vector<PagedSlotMap<int, void, 16>::key_t> int_keys(ints.size());
+    paged.insert_many(ints, int_keys);
+    paged.insert_many(ints, int_keys);
+    TEST_ASSERT(paged.size() == 40);
+    TEST_ASSERT(paged.values().capacity() == 48);
+
+    std::cout << "  insert_many tests passed" << std::endl;
+}
+
+void test_erase_many()
+{
+    SlotMap<int> map;
+    std::vector<SlotMap<int>::key_t> keys(100);
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    map.insert_many(values, keys);
+
+    // Every third key, plus a duplicate and a stale key.
+    std::vector<SlotMap<int>::key_t> victims;
+    for (std::size_t i = 0; i < keys.size(); i += 3)
+        victims.push_back(keys[i]);
+    victims.push_back(keys[0]);
+    victims.push_back(SlotMap<int>::key_t::invalid());
+
+    TEST_ASSERT(map.erase_many(victims) == 34);
+    TEST_ASSERT(map.size() == 66);
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        TEST_ASSERT(map.is_valid(keys[i]) == (i % 3 != 0));
+        if (i % 3 != 0)
+            TEST_ASSERT(map.at(keys[i]) == static_cast<int>(i));
+    }
+
+    // Erasing the tail entirely must not move doomed elements around.
+    std::vector<SlotMap<int>::key_t> rest;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        if (i % 3 != 0)
+            rest.push_back(keys[i]);
+    TEST_ASSERT(map.erase_many(rest) == 66);
+    TEST_ASSERT(map.empty());
+
+    std::cout << "  erase_many tests passed" << std::endl;
+}
+
+void test_deferred_erase()
+{
+    SlotMap<int> map;
+    std::vector<SlotMap<int>::key_t> keys;
+    for (int i = 0; i < 10; ++i)
+        keys.push_back(map.insert(i));
+
+    map.set_deferred_erase(true);
+    TEST_ASSERT(map.erase(keys[2]));
+    TEST_ASSERT(map.erase_many(std::vector<SlotMap<int>::key_t>{ keys[5], keys[7] }) == 2);
+    TEST_ASSERT(!map.erase(keys[2]));
+
+    // Keys are invalid immediately; the dense order is untouched.
+    TEST_ASSERT(!map.is_valid(keys[2]));
+    TEST_ASSERT(map.size() == 7);
+    TEST_ASSERT(map.pending_erase_count() == 3);
+    TEST_ASSERT(map.values().size() == 10);
+    TEST_ASSERT(map.is_tombstone(2));
+    TEST_ASSERT(map.values()[9] == 9);
+
+    std::vector<int> seen;
+    map.for_each([&](int v) { seen.push_back(v); });
+    TEST_ASSERT((seen == std::vector<int>{ 0, 1, 3, 4, 6, 8, 9 }));
+
+    // The freed slot is reused right away; the new value is appended.
+    auto k = map.insert(42);
+    TEST_ASSERT(map.at(k) == 42);
+
+    map.compact();
+    TEST_ASSERT(map.pending_erase_count() == 0);
+    TEST_ASSERT(map.values().size() == 8);
+    TEST_ASSERT((std::vector<int>(map.begin(), map.end()) == std::vector<int>{ 0, 1, 3, 4, 6, 8, 9, 42 }));
+    for (int i : { 0, 1, 3, 4, 6, 8, 9 })
+        TEST_ASSERT(map.at(keys[i]) == i);
+    TEST_ASSERT(map.at(k) == 42);
+
+    // Disabling the mode flushes pending tombstones.
+    map.erase(keys[0]);
+    map.set_deferred_erase(false);
+    TEST_ASSERT(map.pending_erase_count() == 0);
+    TEST_ASSERT(map.values().size() == 7);
+    TEST_ASSERT(map.values()[0] == 1);
+
+    std::cout << "  deferred erase tests passed" << std::endl;
+}
+
+/**
+ * Spawning and despawning 100k objects: per-element emplace/erase against
+ * insert_many/erase_many and deferred erase with a single compact().
+ */
+void bench_batch_spawn_despawn()
+{
+    constexpr std::size_t N = 100'000;
+    std::vector<Payload> payloads(N, Payload{ 1, 2, 3, 4 });
+    std::vector<SlotMap<Payload>::key_t> keys(N);
+
+    // Keep a resident population so erasure has to fill holes.
+    auto make_world = [&] {
+        SlotMap<Payload> map;
+        for (std::size_t i = 0; i < N; ++i)
+            map.insert(Payload{});
+        return map;
+    };
+    auto despawn_order = [&] {
+        std::vector<SlotMap<Payload>::key_t> order(keys.begin(), keys.end());
+        std::shuffle(order.begin(), order.end(), std::mt19937(42));
+        return order;
+    };
+    using clock = std::chrono::high_resolution_clock;
+    auto ms = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    auto single = make_world();
+    auto t0 = clock::now();
+    for (std::size_t i = 0; i < N; ++i)
+        keys[i] = single.insert(payloads[i]);
+    auto t1 = clock::now();
+    for (const auto& k : despawn_order())
+        single.erase(k);
+    auto t2 = clock::now();
+
+    auto batch = make_world();
+    auto t3 = clock::now();
+    batch.insert_many(payloads, keys);
+    auto t4 = clock::now();
+    batch.erase_many(despawn_order());
+    auto t5 = clock::now();
+
+    auto deferred = make_world();
+    deferred.insert_many(payloads, keys);
+    deferred.set_deferred_erase(true);
+    auto t6 = clock::now();
+    deferred.erase_many(despawn_order());
+    deferred.compact();
+    auto t7 = clock::now();
+
+    TEST_ASSERT(single.size() == N && batch.size() == N && deferred.size() == N);
+    std::cout << "  spawn/despawn " << N << " objects (ms): emplace " << ms(t1 - t0)
+              << ", insert_many " << ms(t4 - t3) << "; erase " << ms(t2 - t1)
+              << ", erase_many " << ms(t5 - t4) << ", deferred+compact " << ms(t7 - t6) << std::endl;
+}
+
+// ---- move-only payloads through erase and compact ----------------------------
+
+void test_move_only_erase_compact()
+{
+    auto check = [](auto& map) {
+        using key_t = typename std::remove_reference_t<decltype(map)>::key_t;
+        std::vector<key_t> keys;
+        for (int i = 0; i < 1000; ++i)
+            keys.push_back(map.insert(std::make_unique<std::string>(std::to_string(i))));
+
+        std::vector<key_t> order(keys);
+        std::shuffle(order.begin(), order.end(), std::mt19937(3));
+        for (std::size_t i = 0; i < 300; ++i)
+            map.erase(order[i]);
+
+        map.set_deferred_erase(true);
+        for (std::size_t i = 300; i < 600; ++i)
+            map.erase(order[i]);
+        map.compact();
+
+        TEST_ASSERT(map.size() == 400);
+        for (std::size_t i = 600; i < 1000; ++i)
+        {
+            const auto* v = map.find(order[i]);
+            TEST_ASSERT(v != nullptr);
+            TEST_ASSERT(**v == std::to_string(std::find(keys.begin(), keys.end(), order[i]) - keys.begin()));
+        }
+    };
+
+    SlotMap<std::unique_ptr<std::string>> contiguous;
+    PagedSlotMap<std::unique_ptr<std::string>, void, 64> paged;
+    check(contiguous);
+    check(paged);
+
+    std::cout << "  move-only erase/compact tests passed" << std::endl;
+}
+
 int main()
 {
     std::cout << "slot_map tests:" << std::endl;
@@ -398,6 +707,13 @@ int main()
     test_slotkey_tag_discrimination();
     test_generation_starts_at_one();
     test_capacity_and_shrink();
+    test_paged_storage();
+    bench_worst_case_insert_latency();
+    test_insert_many();
+    test_erase_many();
+    test_deferred_erase();
+    bench_batch_spawn_despawn();
+    test_move_only_erase_compact();
     std::cout << "All slot_map tests passed!" << std::endl;
     return 0;
 }
@@ -0,0 +1,401 @@
+#include <lux/cxx/container/SmallVector.hpp>
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <string>
+#include <vector>
+
+using namespace lux::cxx;
+
+#define TEST_ASSERT(cond) \
+    if (!(cond)) { \
+        std::cerr << "FAIL: " << #cond << " at line " << __LINE__ << std::endl; \
+        assert(cond); \
+    }
+
+/// memory_resource that counts bytes handed out through it.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocated   = 0;
+    std::size_t deallocated = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override
+    {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+    {
+        deallocated += bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// ---- basic tests ------------------------------------------------------------
+
+void test_inline_and_spill()
+{
+    SmallVector<std::string, 4> v;
+    TEST_ASSERT(v.capacity() == 4);
+    for (int i = 0; i < 4; ++i)
+        v.push_back(std::to_string(i));
+    const std::string* inline_data = v.data();
+
+    v.push_back("4");
+    TEST_ASSERT(v.data() != inline_data);
+    TEST_ASSERT(v.size() == 5);
+    for (int i = 0; i < 5; ++i)
+        TEST_ASSERT(v[i] == std::to_string(i));
+
+    v.resize(2);
+    v.shrink_to_fit();
+    TEST_ASSERT(v.capacity() == 4);
+    TEST_ASSERT(v[1] == "1");
+
+    std::cout << "  inline and spill tests passed" << std::endl;
+}
+
+void test_growth_policies()
+{
+    SmallVector<int, 2, std::allocator<int>, PowerOfTwoGrowth> pow2;
+    SmallVector<int, 2, std::allocator<int>, GeometricGrowth>  geo;
+    SmallVector<int, 2, std::allocator<int>, ExactGrowth>      exact;
+    std::vector<std::size_t> pow2_caps, geo_caps, exact_caps;
+    for (int i = 0; i < 20; ++i)
+    {
+        pow2.push_back(i);
+        geo.push_back(i);
+        exact.push_back(i);
+        if (pow2_caps.empty() || pow2_caps.back() != pow2.capacity()) pow2_caps.push_back(pow2.capacity());
+        if (geo_caps.empty() || geo_caps.back() != geo.capacity()) geo_caps.push_back(geo.capacity());
+        if (exact_caps.empty() || exact_caps.back() != exact.capacity()) exact_caps.push_back(exact.capacity());
+    }
+    TEST_ASSERT((pow2_caps == std::vector<std::size_t>{ 2, 4, 8, 16, 32 }));
+    TEST_ASSERT((geo_caps == std::vector<std::size_t>{ 2, 3, 4, 6, 9, 13, 19, 28 }));
+    TEST_ASSERT(exact_caps.size() == 19 && exact.capacity() == 20);
+    for (int i = 0; i < 20; ++i)
+        TEST_ASSERT(pow2[i] == i && geo[i] == i && exact[i] == i);
+
+    std::cout << "  growth policy tests passed" << std::endl;
+}
+
+void test_reserve_exact()
+{
+    SmallVector<std::string, 2> v;
+    v.reserve(100);
+    TEST_ASSERT(v.capacity() == 128); // rounded by the default policy
+
+    SmallVector<std::string, 2> w;
+    w.push_back("a");
+    w.reserve_exact(100);
+    TEST_ASSERT(w.capacity() == 100);
+    TEST_ASSERT(w[0] == "a");
+    w.reserve_exact(50); // never shrinks
+    TEST_ASSERT(w.capacity() == 100);
+
+    std::cout << "  reserve_exact tests passed" << std::endl;
+}
+
+void test_realloc_path()
+{
+    // Trivially copyable with the default allocator: heap growth goes through realloc.
+    SmallVector<std::uint64_t, 4> v;
+    for (std::uint64_t i = 0; i < 100000; ++i)
+        v.push_back(i * 3);
+    for (std::uint64_t i = 0; i < 100000; ++i)
+        TEST_ASSERT(v[i] == i * 3);
+
+    v.resize(10);
+    v.shrink_to_fit();
+    TEST_ASSERT(v.capacity() == 10);
+    v.resize(3);
+    v.shrink_to_fit();
+    TEST_ASSERT(v.capacity() == 4);
+    TEST_ASSERT(v[2] == 6);
+
+    SmallVector<std::uint64_t, 4> moved(std::move(v));
+    TEST_ASSERT(moved.size() == 3 && moved[1] == 3);
+
+    std::cout << "  realloc path tests passed" << std::endl;
+}
+
+// ---- allocator support ------------------------------------------------------
+
+void test_pmr_allocator()
+{
+    CountingResource resource;
+    {
+        pmr::SmallVector<int, 4> v(&resource);
+        for (int i = 0; i < 4; ++i)
+            v.push_back(i);
+        TEST_ASSERT(resource.allocated == 0); // still inline
+
+        v.push_back(4);
+        TEST_ASSERT(resource.allocated > 0);
+        TEST_ASSERT(v.get_allocator().resource() == &resource);
+
+        // A copy selects the default resource, like std::pmr::vector.
+        pmr::SmallVector<int, 4> copy(v);
+        TEST_ASSERT(copy.get_allocator().resource() == std::pmr::get_default_resource());
+        TEST_ASSERT(copy == v);
+    }
+    TEST_ASSERT(resource.allocated == resource.deallocated);
+
+    std::cout << "  pmr allocator tests passed" << std::endl;
+}
+
+void test_pmr_move_between_resources()
+{
+    CountingResource a, b;
+    pmr::SmallVector<std::string, 2> from(&a);
+    for (int i = 0; i < 10; ++i)
+        from.push_back(std::to_string(i));
+
+    // Different resources do not propagate on move assignment: elements are moved.
+    pmr::SmallVector<std::string, 2> to(&b);
+    to = std::move(from);
+    TEST_ASSERT(to.size() == 10 && to[9] == "9");
+    TEST_ASSERT(to.get_allocator().resource() == &b);
+    TEST_ASSERT(b.allocated > 0);
+
+    // Same resource: the heap buffer is stolen.
+    pmr::SmallVector<std::string, 2> same(&b);
+    const std::string* buffer = to.data();
+    same = std::move(to);
+    TEST_ASSERT(same.data() == buffer);
+
+    // Element-wise moves may allocate, so only always-equal allocators make the move noexcept.
+    static_assert(std::is_nothrow_move_assignable_v<SmallVector<std::string, 2>>);
+    static_assert(!std::is_nothrow_move_assignable_v<pmr::SmallVector<std::string, 2>>);
+
+    // A failed allocation leaves the target untouched.
+    {
+        std::byte tiny_buffer[16];
+        std::pmr::monotonic_buffer_resource tiny(tiny_buffer, sizeof(tiny_buffer), std::pmr::null_memory_resource());
+        pmr::SmallVector<std::string, 2> target(&tiny);
+        target.push_back("kept");
+        bool threw = false;
+        try { target = std::move(same); }
+        catch (const std::bad_alloc&) { threw = true; }
+        TEST_ASSERT(threw);
+        TEST_ASSERT(target.size() == 1 && target[0] == "kept");
+        TEST_ASSERT(same.size() == 10 && same[9] == "9");
+    }
+
+    // Arena-backed frame allocation.
+    std::byte arena[4096];
+    std::pmr::monotonic_buffer_resource frame(arena, sizeof(arena), std::pmr::null_memory_resource());
+    pmr::SmallVector<int, 4, GeometricGrowth> scratch(&frame);
+    for (int i = 0; i < 200; ++i)
+        scratch.push_back(i);
+    TEST_ASSERT(scratch.size() == 200 && scratch[199] == 199);
+
+    std::cout << "  pmr move between resources tests passed" << std::endl;
+}
+
+// ---- trivial relocation -----------------------------------------------------
+
+/// Owns a heap string and counts live instances; only <true> is marked relocatable.
+template <bool Relocatable>
+struct Label
+{
+    static inline int alive = 0;
+
+    explicit Label(int i) : text(std::make_unique<std::string>("label " + std::to_string(i))) { ++alive; }
+    Label(Label&& other) noexcept : text(std::move(other.text)) { ++alive; }
+    Label& operator=(Label&&) noexcept = default;
+    ~Label() { --alive; }
+
+    std::unique_ptr<std::string> text;
+};
+
+template <>
+struct lux::cxx::is_trivially_relocatable<Label<true>> : std::true_type {};
+
+void test_relocation()
+{
+    static_assert(is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(is_trivially_relocatable_v<std::shared_ptr<int>>);
+    static_assert(is_trivially_relocatable_v<std::pair<int, std::unique_ptr<int>>>);
+    static_assert(!is_trivially_relocatable_v<Label<false>>);
+    static_assert(is_trivially_relocatable_v<Label<true>>);
+
+    using L = Label<true>;
+    {
+        SmallVector<L, 4> v;
+        for (int i = 0; i < 100; ++i)
+            v.emplace_back(i); // spills, then grows through realloc
+        TEST_ASSERT(L::alive == 100);
+
+        v.erase(v.begin() + 10);
+        v.erase(v.begin());
+        TEST_ASSERT(v.size() == 98 && L::alive == 98);
+        TEST_ASSERT(*v[0].text == "label 1" && *v[9].text == "label 11" && *v.back().text == "label 99");
+
+        while (v.size() > 3)
+            v.pop_back();
+        v.shrink_to_fit(); // back into the inline buffer
+        TEST_ASSERT(v.capacity() == 4 && L::alive == 3);
+        TEST_ASSERT(*v[2].text == "label 3");
+
+        SmallVector<L, 4> inline_moved(std::move(v));
+        TEST_ASSERT(v.empty() && inline_moved.size() == 3 && L::alive == 3);
+
+        SmallVector<L, 4> other;
+        other.emplace_back(7);
+        other.swap(inline_moved);
+        TEST_ASSERT(other.size() == 3 && inline_moved.size() == 1 && L::alive == 4);
+        TEST_ASSERT(*other[0].text == "label 1" && *other[2].text == "label 3");
+        TEST_ASSERT(*inline_moved[0].text == "label 7");
+    }
+    TEST_ASSERT(L::alive == 0);
+
+    std::cout << "  relocation tests passed" << std::endl;
+}
+
+/**
+ * Growing to 1M heap-string payloads and erasing from the front of a 4k vector,
+ * with move-construct plus destroy against trivial relocation.
+ */
+void bench_relocation()
+{
+    using clock = std::chrono::high_resolution_clock;
+    auto ms = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    auto run = [&](auto tag) {
+        using L = decltype(tag);
+        auto t0 = clock::now();
+        {
+            SmallVector<L, 8> v;
+            for (int i = 0; i < (1 << 20); ++i)
+                v.emplace_back(i);
+        }
+        auto t1 = clock::now();
+        {
+            SmallVector<L, 8> v;
+            for (int i = 0; i < 4096; ++i)
+                v.emplace_back(i);
+            while (!v.empty())
+                v.erase(v.begin());
+        }
+        auto t2 = clock::now();
+        return std::pair{ ms(t1 - t0), ms(t2 - t1) };
+    };
+
+    auto [grow_moved, erase_moved]         = run(Label<false>(0));
+    auto [grow_relocated, erase_relocated] = run(Label<true>(0));
+    std::cout << "  string payloads (ms): grow to 1M " << grow_moved << " moved, " << grow_relocated
+              << " relocated; front erase of 4k " << erase_moved << " moved, " << erase_relocated
+              << " relocated" << std::endl;
+}
+
+// ---- compact layout ---------------------------------------------------------
+
+void test_compact_layout()
+{
+    static_assert(sizeof(CompactSmallVector<std::uint32_t, 4>) == 24);
+    static_assert(sizeof(CompactSmallVector<std::uint32_t, 2>) == 16);
+    static_assert(sizeof(CompactSmallVector<std::uint32_t, 4>) < sizeof(SmallVector<std::uint32_t, 4>));
+
+    CompactSmallVector<std::string, 2> v;
+    TEST_ASSERT(v.capacity() == 2 && v.max_size() < (std::size_t{ 1 } << 31));
+    v.push_back("a");
+    v.push_back("b");
+    v.push_back("c"); // spills: the heap pointer now occupies the inline bytes
+    TEST_ASSERT(v.capacity() == 4 && v.size() == 3);
+    TEST_ASSERT(v[0] == "a" && v[2] == "c");
+
+    v.pop_back();
+    v.shrink_to_fit(); // back inline, overwriting the stored pointer
+    TEST_ASSERT(v.capacity() == 2 && v[1] == "b");
+
+    for (int i = 0; i < 50; ++i)
+        v.push_back(std::to_string(i));
+    CompactSmallVector<std::string, 2> copy(v);
+    CompactSmallVector<std::string, 2> moved(std::move(v));
+    TEST_ASSERT(v.empty() && v.capacity() == 2);
+    TEST_ASSERT(copy == moved && moved.size() == 52 && moved.back() == "49");
+
+    CompactSmallVector<std::string, 2> small{ "x" };
+    small.swap(moved);
+    TEST_ASSERT(small.size() == 52 && moved.size() == 1 && moved[0] == "x");
+    moved = std::move(small);
+    TEST_ASSERT(moved.size() == 52 && small.empty());
+
+    CompactSmallVector<std::uint64_t, 4> ints{ 1, 2, 3 };
+    ints.insert(ints.begin() + 1, 7);
+    ints.erase(ints.begin());
+    TEST_ASSERT((ints == CompactSmallVector<std::uint64_t, 4>{ 7, 2, 3 }));
+
+    std::cout << "  compact layout tests passed" << std::endl;
+}
+
+/**
+ * 10M adjacency lists of uint32_t (mostly 0-4 entries, 1 in 16 with 12):
+ * object + heap footprint and one summing pass, standard against compact layout.
+ */
+void bench_compact_layout()
+{
+    constexpr std::size_t kLists = 10'000'000;
+    using clock = std::chrono::high_resolution_clock;
+    auto ms = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    auto run = [&](const char* label, auto tag) {
+        using Vec = decltype(tag);
+        std::vector<Vec> lists(kLists);
+        std::uint32_t x = 12345;
+        std::size_t heap_bytes = 0;
+        for (auto& list : lists)
+        {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            const std::uint32_t degree = (x % 16 == 0) ? 12 : x % 5;
+            for (std::uint32_t e = 0; e < degree; ++e)
+                list.push_back(x + e);
+            if (list.capacity() > 4)
+                heap_bytes += list.capacity() * sizeof(std::uint32_t);
+        }
+
+        auto t0 = clock::now();
+        std::uint64_t sum = 0;
+        for (const auto& list : lists)
+            for (std::uint32_t v : list)
+                sum += v;
+        auto t1 = clock::now();
+        TEST_ASSERT(sum != 0);
+
+        const double mb = static_cast<double>(sizeof(Vec) * kLists + heap_bytes) / (1024.0 * 1024.0);
+        std::cout << "    " << label << ": sizeof " << sizeof(Vec) << ", " << mb << " MB, iterate "
+                  << ms(t1 - t0) << " ms" << std::endl;
+    };
+
+    std::cout << "  10M adjacency lists (uint32_t, N = 4):" << std::endl;
+    run("SmallVector       ", SmallVector<std::uint32_t, 4>{});
+    run("CompactSmallVector", CompactSmallVector<std::uint32_t, 4>{});
+}
+
+int main()
+{
+    std::cout << "small_vector tests:" << std::endl;
+    test_inline_and_spill();
+    test_growth_policies();
+    test_reserve_exact();
+    test_realloc_path();
+    test_pmr_allocator();
+    test_pmr_move_between_resources();
+    test_relocation();
+    bench_relocation();
+    test_compact_layout();
+    bench_compact_layout();
+    std::cout << "All small_vector tests passed!" << std::endl;
+    return 0;
+}
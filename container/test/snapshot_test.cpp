@@ -0,0 +1,361 @@
+#include <lux/cxx/container/Snapshot.hpp>
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace lux::cxx;
+
+#define TEST_ASSERT(cond) \
+    if (!(cond)) { \
+        std::cerr << "FAIL: " << #cond << " at line " << __LINE__ << std::endl; \
+        assert(cond); \
+    }
+
+struct Particle
+{
+    float         x, y, z;
+    std::uint32_t id;
+};
+
+static std::filesystem::path temp_file(const char* name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+static void write_file(const std::filesystem::path& path, const std::string& bytes)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// ---- SlotMap ----------------------------------------------------------------
+
+void test_slot_map_round_trip()
+{
+    SlotMap<Particle> map;
+    std::vector<SlotMap<Particle>::key_t> keys;
+    for (std::uint32_t i = 0; i < 1000; ++i)
+        keys.push_back(map.insert(Particle{ float(i), 0, 0, i }));
+    for (std::uint32_t i = 0; i < 1000; i += 7)
+        map.erase(keys[i]);
+
+    std::stringstream buffer;
+    save_snapshot(buffer, map);
+
+    SlotMap<Particle> loaded;
+    loaded.insert(Particle{}); // replaced by the load
+    load_snapshot(buffer, loaded);
+
+    TEST_ASSERT(loaded.size() == map.size());
+    for (std::uint32_t i = 0; i < 1000; ++i)
+    {
+        TEST_ASSERT(loaded.is_valid(keys[i]) == (i % 7 != 0));
+        if (i % 7 != 0)
+            TEST_ASSERT(loaded.at(keys[i]).id == i);
+    }
+
+    // The free list survives: the next insert reuses the same slot in both maps.
+    auto a = map.insert(Particle{});
+    auto b = loaded.insert(Particle{});
+    TEST_ASSERT(a == b);
+
+    std::cout << "  SlotMap round trip tests passed" << std::endl;
+}
+
+void test_slot_map_view()
+{
+    SlotMap<Particle> map;
+    std::vector<SlotMap<Particle>::key_t> keys;
+    for (std::uint32_t i = 0; i < 5000; ++i)
+        keys.push_back(map.insert(Particle{ 0, float(i), 0, i }));
+    map.erase(keys[10]);
+
+    const auto path = temp_file("lux_slot_map_snapshot.bin");
+    {
+        std::ofstream out(path, std::ios::binary);
+        save_snapshot(out, map);
+    }
+
+    {
+        MappedSnapshot<SlotMapView<Particle>> snapshot(path);
+        TEST_ASSERT(snapshot->size() == map.size());
+        TEST_ASSERT(!snapshot->is_valid(keys[10]));
+        TEST_ASSERT(snapshot->find(keys[10]) == nullptr);
+        TEST_ASSERT(snapshot->find(keys[11])->id == 11);
+        TEST_ASSERT(snapshot->at(keys[4999]).y == 4999.0f);
+        TEST_ASSERT(!snapshot->is_valid(SlotMap<Particle>::key_t::invalid()));
+
+        std::size_t count = 0;
+        for (const Particle& p : *snapshot)
+        {
+            (void)p;
+            ++count;
+        }
+        TEST_ASSERT(count == map.size());
+
+        bool threw = false;
+        try { (void)snapshot->at(keys[10]); }
+        catch (const std::out_of_range&) { threw = true; }
+        TEST_ASSERT(threw);
+    }
+    std::filesystem::remove(path);
+
+    std::cout << "  SlotMap view tests passed" << std::endl;
+}
+
+void test_slot_map_rejects_pending_erasures()
+{
+    SlotMap<int> map;
+    auto k = map.insert(1);
+    map.set_deferred_erase(true);
+    map.erase(k);
+
+    std::stringstream buffer;
+    bool threw = false;
+    try { save_snapshot(buffer, map); }
+    catch (const std::logic_error&) { threw = true; }
+    TEST_ASSERT(threw);
+
+    map.compact();
+    save_snapshot(buffer, map);
+
+    std::cout << "  pending erasure tests passed" << std::endl;
+}
+
+// ---- OffsetSparseSet --------------------------------------------------------
+
+void test_sparse_set_round_trip_and_view()
+{
+    OffsetSparseSet<std::uint32_t, Particle, 100, std::uint32_t> set;
+    for (std::uint32_t k = 100; k < 10100; k += 3)
+        set.insert(k, Particle{ 0, 0, float(k), k });
+
+    std::stringstream buffer;
+    save_snapshot(buffer, set);
+    const std::string bytes = buffer.str();
+
+    OffsetSparseSet<std::uint32_t, Particle, 100, std::uint32_t> loaded;
+    load_snapshot(buffer, loaded);
+    TEST_ASSERT(loaded.size() == set.size());
+    for (std::uint32_t k = 100; k < 10100; ++k)
+    {
+        TEST_ASSERT(loaded.contains(k) == ((k - 100) % 3 == 0));
+        if (loaded.contains(k))
+            TEST_ASSERT(loaded.at(k).id == k);
+    }
+    // A loaded set is fully mutable.
+    loaded.insert(20000, Particle{});
+    TEST_ASSERT(loaded.contains(20000));
+    loaded.erase(103);
+    TEST_ASSERT(!loaded.contains(103));
+
+    const auto path = temp_file("lux_sparse_set_snapshot.bin");
+    write_file(path, bytes);
+    {
+        MappedSnapshot<SparseSetView<std::uint32_t, Particle, 100, std::uint32_t>> snapshot(path);
+        TEST_ASSERT(snapshot->size() == set.size());
+        TEST_ASSERT(snapshot->contains(100));
+        TEST_ASSERT(!snapshot->contains(101));
+        TEST_ASSERT(!snapshot->contains(99));
+        TEST_ASSERT(!snapshot->contains(1u << 30));
+        TEST_ASSERT(snapshot->find(10099) != nullptr && snapshot->find(10099)->id == 10099);
+        TEST_ASSERT(snapshot->keys().size() == snapshot->values().size());
+    }
+    std::filesystem::remove(path);
+
+    std::cout << "  OffsetSparseSet round trip and view tests passed" << std::endl;
+}
+
+void test_rejects_mismatched_snapshots()
+{
+    OffsetSparseSet<std::uint32_t, int, 0, std::uint32_t> set;
+    set.insert(1, 2);
+    std::stringstream buffer;
+    save_snapshot(buffer, set);
+    const std::string bytes = buffer.str();
+    const std::span<const std::byte> raw(reinterpret_cast<const std::byte*>(bytes.data()), bytes.size());
+
+    auto throws = [](auto&& f) {
+        try { f(); }
+        catch (const std::runtime_error&) { return true; }
+        return false;
+    };
+
+    // Wrong container kind, wrong value type, wrong offset, truncated input.
+    TEST_ASSERT(throws([&] { std::stringstream in(bytes); SlotMap<int> m; load_snapshot(in, m); }));
+    TEST_ASSERT(throws([&] { std::stringstream in(bytes); OffsetSparseSet<std::uint32_t, double, 0, std::uint32_t> s; load_snapshot(in, s); }));
+    TEST_ASSERT(throws([&] { std::stringstream in(bytes); OffsetSparseSet<std::uint32_t, int, 1, std::uint32_t> s; load_snapshot(in, s); }));
+    TEST_ASSERT(throws([&] { std::stringstream in(bytes.substr(0, bytes.size() - 1)); OffsetSparseSet<std::uint32_t, int, 0, std::uint32_t> s; load_snapshot(in, s); }));
+    TEST_ASSERT(throws([&] { SparseSetView<std::uint32_t, int, 0, std::uint32_t> v(raw.first(raw.size() - 1)); }));
+    TEST_ASSERT(throws([&] { std::string bad = bytes; bad[0] = 'X'; std::stringstream in(bad); OffsetSparseSet<std::uint32_t, int, 0, std::uint32_t> s; load_snapshot(in, s); }));
+
+    std::cout << "  mismatch rejection tests passed" << std::endl;
+}
+
+/// Returns @p bytes with the @p T at element @p i of section @p section replaced by @p value.
+template <typename T>
+static std::string patch_section(std::string bytes, std::size_t section, std::size_t i, T value)
+{
+    detail::SnapshotHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    std::memcpy(bytes.data() + header.sections[section].offset + i * sizeof(T), &value, sizeof(T));
+    return bytes;
+}
+
+void test_rejects_corrupt_snapshots()
+{
+    auto throws = [](auto&& f) {
+        try { f(); }
+        catch (const std::runtime_error&) { return true; }
+        return false;
+    };
+
+    // A SlotMap with a three-slot free list: slots 4 -> 2 -> 0.
+    SlotMap<int> map;
+    std::vector<SlotMap<int>::key_t> keys;
+    for (int i = 0; i < 6; ++i)
+        keys.push_back(map.insert(i));
+    map.erase(keys[0]);
+    map.erase(keys[2]);
+    map.erase(keys[4]);
+    std::stringstream buffer;
+    save_snapshot(buffer, map);
+    const std::string bytes = buffer.str();
+    using slot_t = detail::SnapshotSlot<std::uint32_t, std::uint32_t>;
+
+    SlotMap<int> target;
+    const auto kept = target.insert(42);
+    auto rejects = [&](const std::string& bad) {
+        const bool threw = throws([&] { std::stringstream in(bad); load_snapshot(in, target); });
+        // A rejected snapshot leaves the map as it was.
+        return threw && target.size() == 1 && target.at(kept) == 42;
+    };
+    TEST_ASSERT(throws([&] { std::stringstream in(bytes); SlotMap<int> m; load_snapshot(in, m); }) == false);
+    // Dense entry pointing past the slots, or at a slot that points elsewhere.
+    TEST_ASSERT(rejects(patch_section<std::uint32_t>(bytes, 2, 0, 100)));
+    TEST_ASSERT(rejects(patch_section<std::uint32_t>(bytes, 2, 0, 3)));
+    // Live slot pointing past the dense array.
+    TEST_ASSERT(rejects(patch_section(bytes, 0, 1, slot_t{ 1000, 1 })));
+    // Free list: head out of range, a cycle, and an entry leaving the slots.
+    {
+        std::string bad = bytes;
+        detail::SnapshotHeader header;
+        std::memcpy(&header, bad.data(), sizeof(header));
+        TEST_ASSERT(header.aux == 4);
+        header.aux = 7;
+        std::memcpy(bad.data(), &header, sizeof(header));
+        TEST_ASSERT(rejects(bad));
+    }
+    TEST_ASSERT(rejects(patch_section(bytes, 0, 0, slot_t{ 4, 2 })));
+    TEST_ASSERT(rejects(patch_section(bytes, 0, 2, slot_t{ 99, 2 })));
+    // A section length far beyond the file is refused before anything is allocated.
+    {
+        std::string bad = bytes;
+        detail::SnapshotHeader header;
+        std::memcpy(&header, bad.data(), sizeof(header));
+        header.sections[1].bytes = std::uint64_t(1) << 50;
+        header.size              = header.sections[1].bytes / sizeof(int);
+        std::memcpy(bad.data(), &header, sizeof(header));
+        TEST_ASSERT(rejects(bad));
+    }
+
+    // OffsetSparseSet: a sparse entry past the dense arrays, a key past the sparse array,
+    // and a key whose sparse entry points at another dense slot.
+    using Set = OffsetSparseSet<std::uint32_t, int, 10, std::uint32_t>;
+    Set set;
+    for (std::uint32_t k = 10; k < 20; k += 2)
+        set.insert(k, int(k));
+    std::stringstream set_buffer;
+    save_snapshot(set_buffer, set);
+    const std::string set_bytes = set_buffer.str();
+    Set set_target;
+    set_target.insert(11, 7);
+    auto set_rejects = [&](const std::string& bad) {
+        const bool threw = throws([&] { std::stringstream in(bad); load_snapshot(in, set_target); });
+        return threw && set_target.size() == 1 && set_target.at(11) == 7;
+    };
+    TEST_ASSERT(set_rejects(patch_section<std::uint32_t>(set_bytes, 0, 1, 3)));
+    TEST_ASSERT(set_rejects(patch_section<std::uint32_t>(set_bytes, 0, 2, 1000)));
+    TEST_ASSERT(set_rejects(patch_section<std::uint32_t>(set_bytes, 1, 0, 5000)));
+    TEST_ASSERT(set_rejects(patch_section<std::uint32_t>(set_bytes, 1, 0, 5)));
+    TEST_ASSERT(set_rejects(patch_section<std::uint32_t>(set_bytes, 1, 1, 10)));
+    {
+        std::stringstream in(set_bytes);
+        load_snapshot(in, set_target);
+        TEST_ASSERT(set_target.size() == 5 && !set_target.contains(11) && set_target.at(18) == 18);
+    }
+
+    std::cout << "  corrupt snapshot rejection tests passed" << std::endl;
+}
+
+// ---- benchmark --------------------------------------------------------------
+
+/**
+ * Restart cost for 4M entries: rebuilding by re-inserting every element, loading
+ * the snapshot into a container, and mapping it for read-only use.
+ */
+void bench_load_vs_rebuild()
+{
+    using clock = std::chrono::high_resolution_clock;
+    auto ms = [](auto d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    constexpr std::uint32_t N = 1u << 22;
+
+    SlotMap<Particle> source;
+    std::vector<SlotMap<Particle>::key_t> keys(N);
+    for (std::uint32_t i = 0; i < N; ++i)
+        keys[i] = source.insert(Particle{ float(i), 0, 0, i });
+
+    const auto path = temp_file("lux_snapshot_bench.bin");
+    {
+        std::ofstream out(path, std::ios::binary);
+        save_snapshot(out, source);
+    }
+
+    auto t0 = clock::now();
+    SlotMap<Particle> rebuilt;
+    for (const Particle& p : source)
+        rebuilt.insert(p);
+    auto t1 = clock::now();
+
+    SlotMap<Particle> loaded;
+    {
+        std::ifstream in(path, std::ios::binary);
+        load_snapshot(in, loaded);
+    }
+    auto t2 = clock::now();
+
+    MappedSnapshot<SlotMapView<Particle>> mapped(path);
+    std::uint64_t sum = 0;
+    for (std::uint32_t i = 0; i < N; i += 4096)
+        sum += mapped->find(keys[i])->id; // touch a sample of pages
+    auto t3 = clock::now();
+
+    TEST_ASSERT(rebuilt.size() == N && loaded.size() == N && mapped->size() == N);
+    TEST_ASSERT(sum > 0);
+    std::filesystem::remove(path);
+
+    std::cout << "  restore " << N << " SlotMap entries (ms): rebuild " << ms(t1 - t0)
+              << ", load_snapshot " << ms(t2 - t1) << ", mmap view " << ms(t3 - t2) << std::endl;
+}
+
+int main()
+{
+    std::cout << "snapshot tests:" << std::endl;
+    test_slot_map_round_trip();
+    test_slot_map_view();
+    test_slot_map_rejects_pending_erasures();
+    test_sparse_set_round_trip_and_view();
+    test_rejects_mismatched_snapshots();
+    test_rejects_corrupt_snapshots();
+    bench_load_vs_rebuild();
+    std::cout << "All snapshot tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include <lux/cxx/container/SparseSetSoA.hpp>
+#include <lux/cxx/container/SparseSet.hpp>
+#include <iostream>
+#include <cassert>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace lux::cxx;
+
+#define TEST_ASSERT(cond) \
+    if (!(cond)) { \
+        std::cerr << "FAIL: " << #cond << " at line " << __LINE__ << std::endl; \
+        assert(cond); \
+    }
+
+struct Vec3
+{
+    float x = 0, y = 0, z = 0;
+};
+
+using Bodies = SparseSetSoA<std::uint32_t, Vec3, Vec3, std::string>;
+enum { kPosition = 0, kVelocity = 1, kName = 2 };
+
+// ---- basic tests ------------------------------------------------------------
+
+void test_insert_and_get()
+{
+    Bodies set;
+    set.insert(10, Vec3{ 1, 2, 3 }, Vec3{ 0, 1, 0 }, std::string("a"));
+    set.insert(3, Vec3{ 4, 5, 6 }, Vec3{ 1, 0, 0 }, std::string("b"));
+
+    TEST_ASSERT(set.size() == 2);
+    TEST_ASSERT(set.contains(10));
+    TEST_ASSERT(set.contains(3));
+    TEST_ASSERT(!set.contains(4));
+    TEST_ASSERT(set.get<kPosition>(10).x == 1);
+    TEST_ASSERT(set.get<kVelocity>(3).x == 1);
+    TEST_ASSERT(set.get<kName>(3) == "b");
+
+    // Re-inserting an existing key overwrites every column in place.
+    auto idx = set.insert(10, Vec3{ 7, 7, 7 }, Vec3{}, std::string("c"));
+    TEST_ASSERT(set.size() == 2);
+    TEST_ASSERT(idx == set.index_of(10));
+    TEST_ASSERT(set.get<kPosition>(10).x == 7);
+    TEST_ASSERT(set.get<kName>(10) == "c");
+
+    bool threw = false;
+    try { (void)set.get<kName>(99); }
+    catch (const std::out_of_range&) { threw = true; }
+    TEST_ASSERT(threw);
+
+    std::cout << "  insert and get tests passed" << std::endl;
+}
+
+void test_erase_keeps_columns_aligned()
+{
+    SparseSetSoA<int, int, double> set;
+    for (int k = 0; k < 100; ++k)
+        set.insert(k, k * 10, k * 0.5);
+
+    for (int k = 0; k < 100; k += 3)
+        TEST_ASSERT(set.erase(k));
+    TEST_ASSERT(!set.erase(0));
+    TEST_ASSERT(!set.erase(-1));
+
+    const auto& keys = set.keys();
+    auto ints = set.column<0>();
+    auto dbls = set.column<1>();
+    TEST_ASSERT(keys.size() == ints.size());
+    TEST_ASSERT(keys.size() == dbls.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        TEST_ASSERT(keys[i] % 3 != 0);
+        TEST_ASSERT(ints[i] == keys[i] * 10);
+        TEST_ASSERT(dbls[i] == keys[i] * 0.5);
+        TEST_ASSERT(set.index_of(keys[i]) == i);
+    }
+
+    std::cout << "  erase alignment tests passed" << std::endl;
+}
+
+void test_column_span_writes()
+{
+    SparseSetSoA<std::uint32_t, float, float> set;
+    for (std::uint32_t k = 0; k < 64; ++k)
+        set.insert(k * 2, static_cast<float>(k), 1.0f);
+
+    // Mutating through a span writes straight into the column.
+    for (auto& v : set.column<1>())
+        v *= 2.0f;
+    for (std::uint32_t k = 0; k < 64; ++k)
+        TEST_ASSERT(set.get<1>(k * 2) == 2.0f);
+
+    std::cout << "  column span tests passed" << std::endl;
+}
+
+void test_zip_view()
+{
+    Bodies set;
+    for (std::uint32_t k = 0; k < 16; ++k)
+        set.insert(k, Vec3{ float(k), 0, 0 }, Vec3{ 1, 0, 0 }, std::to_string(k));
+
+    for (auto [key, pos, vel] : set.zip<kPosition, kVelocity>())
+    {
+        pos.x += vel.x;
+        (void)key;
+    }
+    for (std::uint32_t k = 0; k < 16; ++k)
+        TEST_ASSERT(set.get<kPosition>(k).x == float(k) + 1);
+
+    std::size_t visited = 0;
+    const Bodies& cset = set;
+    for (auto [key, pos, vel, name] : cset.zip_all())
+    {
+        TEST_ASSERT(name == std::to_string(key));
+        (void)pos; (void)vel;
+        ++visited;
+    }
+    TEST_ASSERT(visited == set.size());
+
+    std::cout << "  zip view tests passed" << std::endl;
+}
+
+void test_clear_and_reinsert()
+{
+    SparseSetSoA<std::size_t, int> set(8);
+    for (std::size_t k = 0; k < 8; ++k)
+        set.insert(k, static_cast<int>(k));
+    set.clear();
+    TEST_ASSERT(set.empty());
+    TEST_ASSERT(!set.contains(3));
+    set.insert(3, 42);
+    TEST_ASSERT(set.get<0>(3) == 42);
+
+    std::cout << "  clear tests passed" << std::endl;
+}
+
+// ---- benchmark --------------------------------------------------------------
+
+/**
+ * Iterating a single float field: an AoS OffsetSparseSet drags the whole 64-byte
+ * row through the cache, the SoA column only the field itself.
+ */
+void bench_single_field_iteration()
+{
+    struct Row
+    {
+        float health;
+        float pad[15];
+    };
+    constexpr std::uint32_t N = 1 << 20;
+
+    OffsetSparseSet<std::uint32_t, Row> aos;
+    SparseSetSoA<std::uint32_t, float, std::array<float, 15>> soa;
+    aos.reserve(N);
+    soa.reserve(N);
+    for (std::uint32_t k = 0; k < N; ++k)
+    {
+        aos.insert(k, Row{ 1.0f, {} });
+        soa.insert(k, 1.0f, std::array<float, 15>{});
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    float aos_sum = 0;
+    for (const auto& row : aos.values())
+        aos_sum += row.health;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    float soa_sum = 0;
+    for (float h : soa.column<0>())
+        soa_sum += h;
+    auto t2 = std::chrono::high_resolution_clock::now();
+    TEST_ASSERT(aos_sum == soa_sum);
+
+    std::cout << "  single-field iteration over " << N << " rows: AoS "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, SoA "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+}
+
+int main()
+{
+    std::cout << "sparse_set_soa tests:" << std::endl;
+    test_insert_and_get();
+    test_erase_keeps_columns_aligned();
+    test_column_span_writes();
+    test_zip_view();
+    test_clear_and_reinsert();
+    bench_single_field_iteration();
+    std::cout << "All sparse_set_soa tests passed!" << std::endl;
+    return 0;
+}
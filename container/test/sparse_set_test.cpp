@@ -5,9 +5,14 @@
 #include <chrono>
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <stdexcept>
 
 // Include your OffsetSparseSet header here:
 #include <lux/cxx/container/SparseSet.hpp>
+#include <lux/cxx/container/SparseSetJoin.hpp>
 
 /**
  * @brief Alias for convenience.
@@ -279,6 +284,303 @@ double measureIterate_UnorderedMap(std::size_t N, int num_repeats) {
     return total_time_ns / static_cast<double>(num_repeats);
 }
 
+/**
+ * @brief Checks that batched lookups agree with contains() for a given set type,
+ *        including keys below the offset, past the sparse array and erased keys.
+ */
+template <typename Set>
+void verifyBatchLookup(std::size_t N) {
+    using Key = typename std::remove_cvref_t<decltype(std::declval<Set>().keys())>::value_type;
+    Set set;
+    for (std::size_t i = 0; i < N; ++i) {
+        set.insert(static_cast<Key>(kOffset + 3 * i), i);
+    }
+    std::vector<Key> erased;
+    for (std::size_t i = 0; i < N; i += 7) {
+        erased.push_back(static_cast<Key>(kOffset + 3 * i));
+    }
+    assert(set.erase_many(erased) == erased.size());
+
+    std::vector<Key> probe;
+    for (std::size_t i = 0; i < 3 * N + 64; ++i) {
+        probe.push_back(static_cast<Key>(i));
+    }
+
+    auto flags = std::make_unique<bool[]>(probe.size());
+    std::vector<std::size_t> idx(probe.size());
+    std::size_t hits  = set.contains_many(probe, std::span<bool>(flags.get(), probe.size()));
+    std::size_t found = set.find_many(probe, idx);
+    assert(hits == found);
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < probe.size(); ++i) {
+        bool c = set.contains(probe[i]);
+        expected += c;
+        assert(flags[i] == c);
+        assert((idx[i] != Set::INVALID_INDEX) == c);
+        if (c) {
+            assert(set.keys()[idx[i]] == probe[i]);
+        }
+    }
+    assert(expected == hits);
+}
+
+/**
+ * @brief Measure average time for looking up N keys one at a time vs. with find_many().
+ *        Half of the probed keys are present, in random order.
+ */
+template <typename Set>
+void measureBatchLookup(const char* label, std::size_t N, int num_repeats) {
+    using Key = typename std::remove_cvref_t<decltype(std::declval<Set>().keys())>::value_type;
+    Set set;
+    set.reserve(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        set.insert(static_cast<Key>(kOffset + 2 * i), i);
+    }
+
+    std::vector<Key> probe(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        probe[i] = static_cast<Key>(kOffset + i * 2 + (i & 1));
+    }
+    std::mt19937_64 gen(42);
+    std::shuffle(probe.begin(), probe.end(), gen);
+
+    std::vector<std::size_t> out(N);
+    double single_ns = 0.0;
+    double batch_ns  = 0.0;
+    std::size_t single_found = 0;
+    std::size_t batch_found  = 0;
+    for (int r = 0; r < num_repeats; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::size_t found = 0;
+        for (auto k : probe) {
+            found += set.contains(k);
+        }
+        auto mid = std::chrono::high_resolution_clock::now();
+        batch_found = set.find_many(probe, out);
+        auto end = std::chrono::high_resolution_clock::now();
+        single_found = found;
+
+        single_ns += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count());
+        batch_ns  += static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count());
+    }
+    assert(single_found == batch_found);
+    (void)single_found;
+    (void)batch_found;
+
+    std::cout << N << ", " << label << ", "
+        << single_ns / num_repeats << ", "
+        << batch_ns / num_repeats << ", "
+        << single_ns / batch_ns << "x\n";
+}
+
+/**
+ * @brief Builds a set from @p keys and reports sparse footprint, insert and lookup time.
+ */
+template <typename Set>
+void measureSparseFootprint(const char* dist, const char* label, const std::vector<std::uint32_t>& keys) {
+    Set set;
+    set.reserve(keys.size());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        set.insert(keys[i], i);
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    std::size_t found = 0;
+    for (auto k : keys) {
+        found += set.contains(k);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    assert(found == set.size());
+    (void)found;
+
+    std::cout << dist << ", " << label << ", " << set.size() << ", "
+        << static_cast<double>(set.sparse_memory_bytes()) / (1024.0 * 1024.0) << ", "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() << ", "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() << "\n";
+}
+
+/**
+ * @brief Compares the contiguous and paged sparse arrays over sparse, clustered and
+ *        dense key distributions inside a 2^26 key space.
+ */
+void measureSparseFootprints() {
+    using Flat  = lux::cxx::OffsetSparseSet<std::uint32_t, MyValue, 0, std::uint32_t>;
+    using Paged = lux::cxx::PagedSparseSet<std::uint32_t, MyValue, 0, std::uint32_t, 4096>;
+
+    constexpr std::size_t  kCount = 1 << 17;
+    constexpr std::uint32_t kSpace = 1u << 26;
+    std::mt19937 gen(7);
+
+    // Sparse: uniformly random keys over the whole key space.
+    std::vector<std::uint32_t> sparse_keys;
+    {
+        std::uniform_int_distribution<std::uint32_t> dist(0, kSpace - 1);
+        std::vector<bool> seen(kSpace, false);
+        while (sparse_keys.size() < kCount) {
+            auto k = dist(gen);
+            if (!seen[k]) {
+                seen[k] = true;
+                sparse_keys.push_back(k);
+            }
+        }
+    }
+    // Clustered: 64 runs of consecutive keys at random positions.
+    std::vector<std::uint32_t> clustered_keys;
+    {
+        constexpr std::size_t kRuns = 64;
+        const std::uint32_t stride = kSpace / kRuns;
+        std::uniform_int_distribution<std::uint32_t> dist(0, stride - static_cast<std::uint32_t>(kCount / kRuns));
+        for (std::size_t r = 0; r < kRuns; ++r) {
+            std::uint32_t base = static_cast<std::uint32_t>(r) * stride + dist(gen);
+            for (std::size_t i = 0; i < kCount / kRuns; ++i) {
+                clustered_keys.push_back(base + static_cast<std::uint32_t>(i));
+            }
+        }
+    }
+    // Dense: keys 0 .. kCount-1.
+    std::vector<std::uint32_t> dense_keys(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+        dense_keys[i] = static_cast<std::uint32_t>(i);
+    }
+    for (auto* keys : { &sparse_keys, &clustered_keys }) {
+        std::shuffle(keys->begin(), keys->end(), gen);
+    }
+
+    std::cout << "\nSparse array footprint: contiguous vs. paged (4096 entries/page), uint32 keys and index.\n";
+    std::cout << "Distribution, Container, Keys, Sparse(MiB), Insert(ns), Find(ns)\n";
+    measureSparseFootprint<Flat>("sparse", "contiguous", sparse_keys);
+    measureSparseFootprint<Paged>("sparse", "paged", sparse_keys);
+    measureSparseFootprint<Flat>("clustered", "contiguous", clustered_keys);
+    measureSparseFootprint<Paged>("clustered", "paged", clustered_keys);
+    measureSparseFootprint<Flat>("dense", "contiguous", dense_keys);
+    measureSparseFootprint<Paged>("dense", "paged", dense_keys);
+
+    // A single huge key: the contiguous array would need ~8 GiB here.
+    Paged huge;
+    huge.insert((1u << 31) - 1, 1);
+    assert(huge.sparse_storage().allocated_pages() == 1);
+    std::cout << "single key 2^31-1, paged, 1, "
+        << static_cast<double>(huge.sparse_memory_bytes()) / (1024.0 * 1024.0) << ", -, -\n";
+
+    // Pages are released once they become empty.
+    huge.erase((1u << 31) - 1);
+    assert(huge.sparse_storage().allocated_pages() == 0);
+
+    // A page allocated for an insert whose value constructor throws is released again.
+    struct Throwing {
+        Throwing() = default;
+        explicit Throwing(bool fail) { if (fail) throw std::runtime_error("ctor"); }
+    };
+    lux::cxx::PagedSparseSet<std::uint32_t, Throwing, 0, std::uint32_t, 64> throwing;
+    throwing.emplace(1, false);
+    bool threw = false;
+    try { throwing.emplace(1000, true); }
+    catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    assert(throwing.size() == 1 && throwing.keys().size() == 1);
+    assert(!throwing.contains(1000));
+    assert(throwing.sparse_storage().allocated_pages() == 1);
+}
+
+/**
+ * @brief Checks sort(), join each() and align()/each_aligned() against a brute-force intersection.
+ */
+void verifyJoin() {
+    lux::cxx::OffsetSparseSet<std::uint32_t, std::uint32_t> a;
+    lux::cxx::OffsetSparseSet<std::uint32_t, float, 0, std::uint32_t> b;
+    lux::cxx::PagedSparseSet<std::uint32_t, std::uint64_t, 0, std::uint32_t, 64> c;
+    std::mt19937 gen(3);
+    std::vector<std::uint32_t> ids(4000);
+    for (std::uint32_t i = 0; i < ids.size(); ++i) {
+        ids[i] = i;
+    }
+    std::shuffle(ids.begin(), ids.end(), gen);
+    for (auto id : ids) {
+        if (id % 2 == 0) a.insert(id, id);
+        if (id % 3 == 0) b.insert(id, static_cast<float>(id));
+        if (id % 5 != 0) c.insert(id, id * 2ull);
+    }
+
+    a.sort();
+    assert(std::is_sorted(a.keys().begin(), a.keys().end()));
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        assert(a.at(a.keys()[i]) == a.keys()[i]);
+    }
+
+    std::size_t expected = 0;
+    for (std::uint32_t id = 0; id < ids.size(); ++id) {
+        expected += (id % 2 == 0) && (id % 3 == 0) && (id % 5 != 0);
+    }
+
+    auto view = lux::cxx::join(a, b, c);
+    assert(view.driver() == 1);
+    std::size_t seen = 0;
+    view.each([&](std::uint32_t key, std::uint32_t& va, float& vb, std::uint64_t& vc) {
+        assert(va == key && vb == static_cast<float>(key) && vc == key * 2ull);
+        ++seen;
+    });
+    assert(seen == expected);
+
+    assert(view.align() == expected);
+    seen = 0;
+    view.each_aligned([&](std::uint32_t key, std::uint32_t& va, float& vb, std::uint64_t& vc) {
+        assert(a.keys()[seen] == key && b.keys()[seen] == key && c.keys()[seen] == key);
+        assert(va == key && vb == static_cast<float>(key) && vc == key * 2ull);
+        ++seen;
+    });
+    assert(seen == expected);
+    (void)seen;
+    (void)expected;
+}
+
+/**
+ * @brief 3-way join over N entities: probing each() vs. align() + each_aligned().
+ *        Components are inserted in independent random orders, as in a live world.
+ */
+void measureJoin(std::size_t N) {
+    struct Position { float x, y, z; };
+    struct Velocity { float x, y, z; };
+    struct Mass     { float m; };
+
+    lux::cxx::OffsetSparseSet<std::uint32_t, Position, 0, std::uint32_t> pos;
+    lux::cxx::OffsetSparseSet<std::uint32_t, Velocity, 0, std::uint32_t> vel;
+    lux::cxx::OffsetSparseSet<std::uint32_t, Mass, 0, std::uint32_t>     mass;
+
+    std::mt19937 gen(11);
+    std::vector<std::uint32_t> ids(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        ids[i] = static_cast<std::uint32_t>(i);
+    }
+    std::shuffle(ids.begin(), ids.end(), gen);
+    for (auto id : ids) pos.insert(id, Position{ 1, 1, 1 });
+    std::shuffle(ids.begin(), ids.end(), gen);
+    for (auto id : ids) if (id % 4 != 0) vel.insert(id, Velocity{ 1, 0, 0 });
+    std::shuffle(ids.begin(), ids.end(), gen);
+    for (auto id : ids) if (id % 8 != 1) mass.insert(id, Mass{ 2 });
+
+    auto view = lux::cxx::join(pos, vel, mass);
+    auto update = [](std::uint32_t, Position& p, Velocity& v, Mass& m) {
+        p.x += v.x / m.m;
+        p.y += v.y / m.m;
+        p.z += v.z / m.m;
+    };
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    view.each(update);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    const std::size_t n = view.align();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    view.each_aligned(update);
+    auto t3 = std::chrono::high_resolution_clock::now();
+
+    auto ns = [](auto a, auto b) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count();
+    };
+    std::cout << N << ", " << n << ", " << ns(t0, t1) << ", " << ns(t1, t2) << ", " << ns(t2, t3) << "\n";
+}
+
 int main() {
     // We will test for N in [2^10, 2^20], repeated multiple times for an average
     const int num_repeats = 5;
@@ -319,5 +621,29 @@ int main() {
             << t_iter_map << "\n";
     }
 
+    verifyBatchLookup<lux::cxx::OffsetSparseSet<std::uint32_t, MyValue, kOffset, std::uint32_t>>(5000);
+    verifyBatchLookup<lux::cxx::OffsetSparseSet<std::int32_t, MyValue, kOffset, std::uint16_t>>(5000);
+    verifyBatchLookup<lux::cxx::OffsetSparseSet<std::uint64_t, MyValue, kOffset, std::uint32_t>>(5000);
+    verifyBatchLookup<MyOffsetSparseSet>(5000);
+    verifyBatchLookup<lux::cxx::PagedSparseSet<std::uint32_t, MyValue, kOffset, std::uint32_t, 256>>(5000);
+
+    std::cout << "\nSingle vs. batched lookup (find_many), average ns for the whole batch.\n";
+    std::cout << "N, Container, Single(ns), Batched(ns), Speedup\n";
+    const std::size_t kBatchN = 1 << 20;
+    measureBatchLookup<lux::cxx::OffsetSparseSet<std::uint32_t, MyValue, kOffset, std::uint32_t>>(
+        "OffsetSparseSet<u32, uint32 index>", kBatchN, num_repeats);
+    measureBatchLookup<lux::cxx::OffsetSparseSet<std::uint64_t, MyValue, kOffset, std::uint32_t>>(
+        "OffsetSparseSet<u64, uint32 index>", kBatchN, num_repeats);
+    measureBatchLookup<MyOffsetSparseSet>(
+        "OffsetSparseSet<u64, size_t index>", kBatchN, num_repeats);
+
+    measureSparseFootprints();
+
+    verifyJoin();
+    std::cout << "\n3-way join (Position x Velocity x Mass), ns for one full pass.\n";
+    std::cout << "Entities, Joined, each()(ns), align()(ns), each_aligned()(ns)\n";
+    measureJoin(1 << 20);
+
+
     return 0;
 }
@@ -1,9 +1,773 @@
 #include <lux/cxx/container/Tree.hpp>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 template<typename T> using BinaryTreeNode = lux::cxx::StaticTreeNode<T, 2>;
 template<typename T> using OctreeNode = lux::cxx::StaticTreeNode<T, 8>;
 
+#define TEST_ASSERT(cond) \
+    if (!(cond)) { \
+        std::cerr << "FAIL: " << #cond << " at line " << __LINE__ << std::endl; \
+        assert(cond); \
+    }
+
+/// Random tree of `count` nodes; every node is attached to a random earlier node,
+/// so creation order bears no relation to traversal order.
+template<std::size_t N, class T, class Policy = lux::cxx::FixedChildrenPolicy>
+lux::cxx::IndexedNaryTreeSoA<T, N, Policy> make_random_tree(int count, std::uint32_t seed)
+{
+    lux::cxx::IndexedNaryTreeSoA<T, N, Policy> tree;
+    std::mt19937 rng(seed);
+    std::vector<int> open{ tree.emplaceRoot(T{}) };   // nodes with a free slot
+    while (static_cast<int>(tree.size()) < count)
+    {
+        std::size_t pick = rng() % open.size();
+        int parent = open[pick];
+        int slot = static_cast<int>(rng() % N);
+        if (tree.childIndex(parent, slot) != -1)
+        {
+            bool full = true;
+            for (int s = 0; s < static_cast<int>(N); ++s)
+                full = full && tree.childIndex(parent, s) != -1;
+            if (full)
+            {
+                open[pick] = open.back();
+                open.pop_back();
+            }
+            continue;
+        }
+        open.push_back(tree.emplaceChild(parent, slot, T{}));
+    }
+    return tree;
+}
+
+template<class Tree>
+std::vector<int> collect_preorder(Tree& tree, int from)
+{
+    std::vector<int> out;
+    tree.preorderTraverse(from, [&](int idx, const auto&) { out.push_back(idx); });
+    return out;
+}
+
+// ---- traversal / layout tests -----------------------------------------------
+
+template<class Policy>
+void test_deep_chain_traversals()
+{
+    // Far deeper than the recursive traversals could handle.
+    constexpr int depth = 1 << 20;
+    lux::cxx::IndexedNaryTreeSoA<int, 2, Policy> chain;
+    int cur = chain.emplaceRoot(0);
+    for (int i = 1; i < depth; ++i)
+        cur = chain.createChild(cur, i & 1, i);
+
+    long long pre = 0, post = 0, in = 0;
+    int first_post = -1;
+    chain.preorderTraverse(chain.rootIndex(), [&](int, const int& v) { pre += v; });
+    chain.postorderTraverse(chain.rootIndex(), [&](int idx, const int& v) {
+        if (first_post == -1) first_post = idx;
+        post += v;
+    });
+    chain.inorderTraverse(chain.rootIndex(), [&](int, const int& v) { in += v; });
+    const long long expect = static_cast<long long>(depth) * (depth - 1) / 2;
+    TEST_ASSERT(pre == expect && post == expect && in == expect);
+    TEST_ASSERT(first_post == cur);
+    TEST_ASSERT(chain.subtreeSize(chain.rootIndex()) == static_cast<std::size_t>(depth));
+
+    std::cout << "  deep chain traversal tests passed" << std::endl;
+}
+
+template<class Policy>
+void test_traversal_orders()
+{
+    // 0 -> (1, 2), 1 -> (3, 4), 2 -> (-, 5)
+    lux::cxx::IndexedNaryTreeSoA<int, 2, Policy> tree;
+    int r = tree.emplaceRoot(0);
+    int a = tree.createChild(r, 0, 1);
+    int b = tree.createChild(r, 1, 2);
+    tree.createChild(b, 1, 5);
+    tree.createChild(a, 0, 3);
+    tree.createChild(a, 1, 4);
+
+    auto values_of = [&](auto traverse) {
+        std::vector<int> out;
+        traverse([&](int, const int& v) { out.push_back(v); });
+        return out;
+    };
+    TEST_ASSERT(values_of([&](auto f) { tree.preorderTraverse(r, f); }) == (std::vector<int>{ 0, 1, 3, 4, 2, 5 }));
+    TEST_ASSERT(values_of([&](auto f) { tree.inorderTraverse(r, f); }) == (std::vector<int>{ 3, 1, 4, 0, 2, 5 }));
+    TEST_ASSERT(values_of([&](auto f) { tree.postorderTraverse(r, f); }) == (std::vector<int>{ 3, 4, 1, 5, 2, 0 }));
+    TEST_ASSERT(values_of([&](auto f) { tree.breadthFirstTraverse(r, f); }) == (std::vector<int>{ 0, 1, 2, 3, 4, 5 }));
+
+    // Pre-order layout: storage order equals traversal order.
+    tree.relayout(lux::cxx::TreeLayout::PreOrder);
+    TEST_ASSERT(tree.layout() == lux::cxx::TreeLayout::PreOrder);
+    TEST_ASSERT(tree.rootIndex() == 0);
+    for (int i = 0; i < 6; ++i)
+        TEST_ASSERT(tree.value(i) == (std::vector<int>{ 0, 1, 3, 4, 2, 5 })[i]);
+    TEST_ASSERT(tree.subtreeSize(1) == 3 && tree.subtreeSize(4) == 2 && tree.subtreeSize(3) == 1);
+    TEST_ASSERT(values_of([&](auto f) { tree.postorderTraverse(0, f); }) == (std::vector<int>{ 3, 4, 1, 5, 2, 0 }));
+
+    std::vector<int> pruned;
+    tree.preorderTraversePruned(0, [&](int, const int& v) { pruned.push_back(v); return v != 1; });
+    TEST_ASSERT(pruned == (std::vector<int>{ 0, 1, 2, 5 }));
+
+    // Breadth-first layout: levels are contiguous.
+    tree.relayout(lux::cxx::TreeLayout::BreadthFirst);
+    for (int i = 0; i < 6; ++i)
+        TEST_ASSERT(tree.value(i) == i);
+    TEST_ASSERT(values_of([&](auto f) { tree.preorderTraverse(0, f); }) == (std::vector<int>{ 0, 1, 3, 4, 2, 5 }));
+
+    // Structural changes drop the layout.
+    tree.createChild(2, 0, 6);
+    TEST_ASSERT(tree.layout() == lux::cxx::TreeLayout::Unordered);
+    TEST_ASSERT(tree.subtreeSize(0) == 7);
+
+    std::cout << "  traversal order tests passed" << std::endl;
+}
+
+template<class Policy>
+void test_relayout_random_tree()
+{
+    auto tree = make_random_tree<4, int, Policy>(5000, 7);
+    for (int i = 0; i < static_cast<int>(tree.size()); ++i)
+        tree.value(i) = i;
+    // Detach a subtree; it must survive relayout behind the main tree.
+    int detached = tree.childIndex(tree.rootIndex(), 0);
+    if (detached == -1) detached = tree.childIndex(tree.rootIndex(), 1);
+    tree.removeChild(tree.rootIndex(), tree.childIndex(tree.rootIndex(), 0) == detached ? 0 : 1);
+    const std::size_t detached_size = tree.subtreeSize(detached);
+
+    std::vector<int> before;
+    tree.preorderTraverse(tree.rootIndex(), [&](int, const int& v) { before.push_back(v); });
+
+    for (auto order : { lux::cxx::TreeLayout::PreOrder, lux::cxx::TreeLayout::BreadthFirst })
+    {
+        auto remap = tree.relayout(order);
+        TEST_ASSERT(remap.size() == tree.size());
+        detached = remap[detached];
+        TEST_ASSERT(tree.parentIndex(detached) == -1);
+        if (order == lux::cxx::TreeLayout::PreOrder)
+            TEST_ASSERT(detached == static_cast<int>(tree.size() - detached_size));
+        TEST_ASSERT(tree.subtreeSize(tree.rootIndex()) + detached_size == tree.size());
+
+        std::vector<int> after;
+        tree.preorderTraverse(tree.rootIndex(), [&](int, const int& v) { after.push_back(v); });
+        TEST_ASSERT(after == before);
+        for (int i = 0; i < static_cast<int>(tree.size()); ++i)
+        {
+            int p = tree.parentIndex(i);
+            TEST_ASSERT(p < i);
+            if (p != -1)
+            {
+                bool linked = false;
+                for (int s = 0; s < 4; ++s)
+                    linked = linked || tree.childIndex(p, s) == i;
+                TEST_ASSERT(linked);
+            }
+        }
+        if (order == lux::cxx::TreeLayout::PreOrder)
+        {
+            auto ids = collect_preorder(tree, tree.rootIndex());
+            for (int i = 0; i < static_cast<int>(ids.size()); ++i)
+                TEST_ASSERT(ids[i] == i);
+        }
+    }
+
+    // Breadth-first levels hold both trees, and every parent sits one level up.
+    std::size_t total = 0;
+    for (std::size_t d = 0; d < tree.levelCount(); ++d)
+    {
+        auto [begin, end] = tree.levelRange(d);
+        TEST_ASSERT(begin < end);
+        total += static_cast<std::size_t>(end - begin);
+        for (int i = begin; i < end; ++i)
+        {
+            int p = tree.parentIndex(i);
+            if (d == 0)
+            {
+                TEST_ASSERT(p == -1);
+            }
+            else
+            {
+                TEST_ASSERT(p >= tree.levelRange(d - 1).first && p < tree.levelRange(d - 1).second);
+            }
+        }
+    }
+    TEST_ASSERT(total == tree.size());
+    TEST_ASSERT(tree.levelRange(0).second == 2);
+
+    std::cout << "  random tree relayout tests passed" << std::endl;
+}
+
+// ---- propagation tests ------------------------------------------------------
+
+/// Scene node: a local offset and the accumulated world offset.
+struct SceneNode
+{
+    float local[12] = {};
+    float world[12] = {};
+};
+
+/// world = parent.world * local, with 3x4 affine matrices stored row-major.
+void compose(const SceneNode* parent, SceneNode& node)
+{
+    if (parent == nullptr)
+    {
+        std::copy(std::begin(node.local), std::end(node.local), std::begin(node.world));
+        return;
+    }
+    const float* a = parent->world;
+    const float* b = node.local;
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            float v = a[r * 4 + 0] * b[0 * 4 + c] + a[r * 4 + 1] * b[1 * 4 + c] + a[r * 4 + 2] * b[2 * 4 + c];
+            if (c == 3)
+                v += a[r * 4 + 3];
+            node.world[r * 4 + c] = v;
+        }
+    }
+}
+
+/// Identity rotation with translation (x, y, z).
+void set_translation(SceneNode& node, float x, float y, float z)
+{
+    std::fill(std::begin(node.local), std::end(node.local), 0.0f);
+    node.local[0] = node.local[5] = node.local[10] = 1.0f;
+    node.local[3] = x;
+    node.local[7] = y;
+    node.local[11] = z;
+}
+
+template<class Tree>
+bool worlds_match_reference(Tree& tree)
+{
+    // Reference: serial recursion-free pre-order walk from every top node.
+    bool ok = true;
+    for (int i = 0; i < static_cast<int>(tree.size()); ++i)
+    {
+        if (tree.parentIndex(i) != -1)
+            continue;
+        tree.preorderTraverse(i, [&](int idx, const SceneNode& n) {
+            SceneNode expect = n;
+            int p = tree.parentIndex(idx);
+            compose(p == -1 ? nullptr : &tree.value(p), expect);
+            for (int k = 0; k < 12; ++k)
+                ok = ok && expect.world[k] == n.world[k];
+        });
+    }
+    return ok;
+}
+
+template<class Policy>
+void test_dirty_propagation()
+{
+    auto tree = make_random_tree<4, SceneNode, Policy>(20000, 3);
+    for (int i = 0; i < static_cast<int>(tree.size()); ++i)
+        set_translation(tree.value(i), float(i % 5), 1.0f, float(i % 3));
+
+    lux::cxx::ThreadPool pool(3);
+    bool threw = false;
+    try { tree.propagateDown(pool, [](int, const SceneNode*, SceneNode&) {}); }
+    catch (const std::runtime_error&) { threw = true; }
+    TEST_ASSERT(threw);
+
+    std::size_t updated = 0;
+    auto update = [&](int, const SceneNode* parent, SceneNode& node) {
+        ++updated;
+        compose(parent, node);
+    };
+    tree.propagateDown(update);
+    TEST_ASSERT(updated == tree.size());
+    TEST_ASSERT(worlds_match_reference(tree));
+
+    // Nothing dirty: nothing recomputed.
+    updated = 0;
+    tree.propagateDown(update);
+    TEST_ASSERT(updated == 0);
+
+    tree.relayout(lux::cxx::TreeLayout::BreadthFirst);
+    const int moved = tree.levelRange(2).first;
+    set_translation(tree.value(moved), 10.0f, 0.0f, 0.0f);
+    tree.markDirty(moved);
+    TEST_ASSERT(tree.isDirty(moved) && !tree.isDirty(0));
+
+    // Only the moved node's subtree is recomputed, across the pool.
+    std::atomic<std::size_t> parallel_updated{ 0 };
+    tree.propagateDown(pool, [&](int, const SceneNode* parent, SceneNode& node) {
+        ++parallel_updated;
+        compose(parent, node);
+    });
+    TEST_ASSERT(parallel_updated == tree.subtreeSize(moved));
+    TEST_ASSERT(!tree.isDirty(moved));
+    TEST_ASSERT(worlds_match_reference(tree));
+
+    // Everything dirty in parallel matches the serial result.
+    for (int i = 0; i < static_cast<int>(tree.size()); ++i)
+    {
+        tree.value(i).local[3] += 0.5f;
+        tree.markDirty(i);
+    }
+    parallel_updated = 0;
+    tree.propagateDown(pool, [&](int, const SceneNode* parent, SceneNode& node) {
+        ++parallel_updated;
+        compose(parent, node);
+    });
+    TEST_ASSERT(parallel_updated == tree.size());
+    TEST_ASSERT(worlds_match_reference(tree));
+
+    // Small chunks split every wide level across the pool; workers must do part of it.
+    for (int i = 0; i < static_cast<int>(tree.size()); ++i)
+    {
+        tree.value(i).local[7] -= 0.25f;
+        tree.markDirty(i);
+    }
+    const auto caller = std::this_thread::get_id();
+    parallel_updated = 0;
+    std::atomic<std::size_t> off_caller{ 0 };
+    tree.propagateDown(pool, [&](int, const SceneNode* parent, SceneNode& node) {
+        ++parallel_updated;
+        if (std::this_thread::get_id() != caller)
+            ++off_caller;
+        compose(parent, node);
+    }, 64);
+    TEST_ASSERT(parallel_updated == tree.size());
+    TEST_ASSERT(off_caller > 0);
+    TEST_ASSERT(worlds_match_reference(tree));
+
+    std::cout << "  dirty propagation tests passed" << std::endl;
+}
+
+// ---- removal tests ----------------------------------------------------------
+
+template<class Policy>
+void test_erase_and_reuse()
+{
+    lux::cxx::IndexedNaryTreeSoA<std::string, 2, Policy> tree;
+    int r = tree.emplaceRoot("root");
+    int a = tree.createChild(r, 0, "a");
+    int b = tree.createChild(r, 1, "b");
+    int a0 = tree.createChild(a, 0, "a0");
+    int a1 = tree.createChild(a, 1, "a1");
+    tree.createChild(a1, 0, "a10");
+    auto ha = tree.handle(a);
+    auto hb = tree.handle(b);
+
+    TEST_ASSERT(tree.eraseSubtree(a) == 4);
+    TEST_ASSERT(tree.size() == 2 && tree.slotCount() == 6);
+    TEST_ASSERT(tree.childIndex(r, 0) == -1);
+    TEST_ASSERT(!tree.isValidIndex(a) && !tree.isValidIndex(a0));
+    TEST_ASSERT(!tree.isValidHandle(ha) && tree.resolve(ha) == -1);
+    TEST_ASSERT(tree.resolve(hb) == b);
+    bool threw = false;
+    try { (void)tree.value(a0); }
+    catch (const std::out_of_range&) { threw = true; }
+    TEST_ASSERT(threw);
+
+    // Freed indices are reused; the old handle stays stale even on the same index.
+    std::vector<int> reused;
+    for (int i = 0; i < 4; ++i)
+        reused.push_back(tree.createChild(i == 0 ? b : reused.back(), 0, "n" + std::to_string(i)));
+    TEST_ASSERT(tree.slotCount() == 6 && tree.size() == 6);
+    for (int idx : reused)
+        TEST_ASSERT(idx != r && idx != b);
+    if (std::find(reused.begin(), reused.end(), a) != reused.end())
+        TEST_ASSERT(!tree.isValidHandle(ha) && tree.handle(a).generation == ha.generation + 1);
+    TEST_ASSERT(tree.createChild(reused.back(), 1, "grown") == 6);
+
+    // Erasing the root empties the tree and allows a new one.
+    TEST_ASSERT(tree.eraseSubtree(r) == 7);
+    TEST_ASSERT(tree.size() == 0 && tree.rootIndex() == -1);
+    int r2 = tree.emplaceRoot("again");
+    TEST_ASSERT(tree.value(r2) == "again" && tree.size() == 1);
+
+    std::cout << "  erase and reuse tests passed" << std::endl;
+}
+
+template<class Policy>
+void test_compact()
+{
+    auto tree = make_random_tree<3, int, Policy>(3000, 19);
+    for (int i = 0; i < static_cast<int>(tree.size()); ++i)
+        tree.value(i) = i;
+    std::vector<typename decltype(tree)::NodeHandle> handles;
+    for (int i = 0; i < static_cast<int>(tree.size()); ++i)
+        handles.push_back(tree.handle(i));
+
+    // Erase a handful of subtrees, then reuse part of the freed space.
+    std::mt19937 rng(4);
+    for (int k = 0; k < 20; ++k)
+    {
+        int victim = static_cast<int>(rng() % tree.slotCount());
+        if (tree.isValidIndex(victim) && victim != tree.rootIndex())
+            tree.eraseSubtree(victim);
+    }
+    const std::size_t live = tree.size();
+    TEST_ASSERT(live < tree.slotCount());
+
+    std::vector<int> before;
+    tree.preorderTraverse(tree.rootIndex(), [&](int, const int& v) { before.push_back(v); });
+
+    auto remap = tree.compact();
+    TEST_ASSERT(remap.size() == handles.size());
+    TEST_ASSERT(tree.size() == live && tree.slotCount() == live);
+    int last = -1;
+    for (std::size_t old = 0; old < remap.size(); ++old)
+    {
+        if (remap[old] == -1)
+            continue;
+        TEST_ASSERT(remap[old] > last);   // order-preserving
+        last = remap[old];
+        TEST_ASSERT(tree.value(remap[old]) == static_cast<int>(old));
+        auto moved = tree.remapHandle(handles[old], remap);
+        TEST_ASSERT(moved.index == remap[old] && tree.isValidHandle(moved));
+        TEST_ASSERT(moved.index == static_cast<int>(old) || !tree.isValidHandle(handles[old]));
+        handles[old] = moved;
+    }
+    // Handles to erased nodes stay stale, whether their index was truncated or refilled.
+    std::vector<typename decltype(tree)::NodeHandle> stale;
+    for (std::size_t old = 0; old < remap.size(); ++old)
+    {
+        if (remap[old] == -1)
+        {
+            TEST_ASSERT(!tree.isValidHandle(handles[old]));
+            TEST_ASSERT(!tree.remapHandle(handles[old], remap).valid());
+            stale.push_back(handles[old]);
+        }
+    }
+
+    std::vector<int> after;
+    tree.preorderTraverse(tree.rootIndex(), [&](int, const int& v) { after.push_back(v); });
+    TEST_ASSERT(after == before);
+    TEST_ASSERT(tree.compact() == [&] { std::vector<int> id(live); for (std::size_t i = 0; i < live; ++i) id[i] = int(i); return id; }());
+
+    // Regrowing storage into truncated indices must not revive their old handles.
+    auto grow = [&](std::size_t count) {
+        int tip = tree.rootIndex();
+        while (tree.childIndex(tip, 0) != -1)
+            tip = tree.childIndex(tip, 0);
+        for (std::size_t k = 0; k < count; ++k)
+            tip = tree.createChild(tip, 0, 0);
+    };
+    grow(remap.size() - live);
+    for (auto h : stale)
+        TEST_ASSERT(!tree.isValidHandle(h));
+
+    // Same for relayout(), which moves almost every node.
+    std::vector<typename decltype(tree)::NodeHandle> live_handles;
+    for (int i = 0; i < static_cast<int>(tree.slotCount()); ++i)
+        live_handles.push_back(tree.handle(i));
+    for (int k = 0; k < 10; ++k)
+    {
+        int victim = static_cast<int>(rng() % tree.slotCount());
+        if (tree.isValidIndex(victim) && victim != tree.rootIndex())
+            tree.eraseSubtree(victim);
+    }
+    for (auto order : { lux::cxx::TreeLayout::BreadthFirst, lux::cxx::TreeLayout::PreOrder })
+    {
+        auto relaid = tree.relayout(order);
+        for (std::size_t old = 0; old < relaid.size(); ++old)
+        {
+            auto h = tree.remapHandle(live_handles[old], relaid);
+            TEST_ASSERT(h.valid() == (relaid[old] != -1) && (!h.valid() || tree.isValidHandle(h)));
+            TEST_ASSERT(relaid[old] == static_cast<int>(old) || !tree.isValidHandle(live_handles[old]));
+            if (relaid[old] == -1)
+                stale.push_back(live_handles[old]);
+            live_handles[old] = h;
+        }
+        live_handles.erase(std::remove_if(live_handles.begin(), live_handles.end(),
+            [](auto h) { return !h.valid(); }), live_handles.end());
+        std::sort(live_handles.begin(), live_handles.end(), [](auto a, auto b) { return a.index < b.index; });
+        for (auto h : stale)
+            TEST_ASSERT(!tree.isValidHandle(h));
+    }
+    grow(64);
+    for (auto h : stale)
+        TEST_ASSERT(!tree.isValidHandle(h));
+
+    // A sibling moved into an erased node's index does not answer to its handle.
+    lux::cxx::IndexedNaryTreeSoA<int, 2, Policy> small;
+    int r = small.emplaceRoot(0);
+    int a = small.createChild(r, 0, 1);
+    int b = small.createChild(r, 1, 2);
+    int c = small.createChild(b, 0, 3);
+    auto ha = small.handle(a);
+    const auto hb_before = small.handle(b);
+    auto hc = small.handle(c);
+    small.eraseSubtree(a);
+    auto remap_small = small.compact();
+    TEST_ASSERT(!small.isValidHandle(ha) && small.value(a) == 2);
+    auto hb = small.remapHandle(hb_before, remap_small);
+    TEST_ASSERT(hb.index == a && small.isValidHandle(hb));
+    hc = small.remapHandle(hc, remap_small);
+    small.eraseSubtree(hc.index);
+    small.compact();
+    // The new node lands on the index both b and c held before.
+    int reborn = small.createChild(hb.index, 0, 4);
+    TEST_ASSERT(reborn == hc.index && reborn == hb_before.index);
+    TEST_ASSERT(!small.isValidHandle(hc) && !small.isValidHandle(hb_before) && small.isValidHandle(hb));
+    TEST_ASSERT(!small.isValidHandle(ha));
+
+    std::cout << "  compact tests passed" << std::endl;
+}
+
+template<class Policy>
+void test_propagation_after_reuse()
+{
+    lux::cxx::IndexedNaryTreeSoA<SceneNode, 2, Policy> tree;
+    int r = tree.emplaceRoot();
+    int a = tree.emplaceChild(r, 0);
+    tree.emplaceChild(a, 0);
+    int b = tree.emplaceChild(r, 1);
+    int b0 = tree.emplaceChild(b, 0);
+    int b00 = tree.emplaceChild(b0, 0);
+    auto update = [](int, const SceneNode* parent, SceneNode& node) { compose(parent, node); };
+
+    // Free the low indices and reuse them under the deepest node: children now precede parents.
+    tree.eraseSubtree(a);
+    int c = tree.emplaceChild(b00, 0);
+    int d = tree.emplaceChild(c, 0);
+    TEST_ASSERT(c < b00 && d < c);
+    for (int i : { r, b, b0, b00, c, d })
+        set_translation(tree.value(i), 1.0f, float(i), 0.0f);
+    tree.propagateDown(update);
+    TEST_ASSERT(worlds_match_reference(tree));
+    TEST_ASSERT(tree.value(d).world[3] == 6.0f);
+
+    tree.relayout(lux::cxx::TreeLayout::BreadthFirst);
+    lux::cxx::ThreadPool pool(2);
+    tree.value(1).local[3] = 5.0f;
+    tree.markDirty(1);
+    tree.propagateDown(pool, update, 1);
+    TEST_ASSERT(worlds_match_reference(tree));
+
+    std::cout << "  propagation after reuse tests passed" << std::endl;
+}
+
+// ---- children policy tests --------------------------------------------------
+
+void test_sibling_children()
+{
+    // Wide nodes filled out of slot order; lookups and walks still see slot order.
+    lux::cxx::IndexedNaryTreeSoA<int, 300, lux::cxx::SiblingChildrenPolicy> tree;
+    int r = tree.emplaceRoot(-1);
+    const int slots[] = { 7, 299, 0, 3, 150, 8 };
+    for (int slot : slots)
+        tree.createChild(r, slot, slot);
+    for (int slot = 0; slot < 300; ++slot)
+    {
+        int c = tree.childIndex(r, slot);
+        TEST_ASSERT(c == -1 || tree.value(c) == slot);
+        TEST_ASSERT((c != -1) == (std::find(std::begin(slots), std::end(slots), slot) != std::end(slots)));
+    }
+    std::vector<int> seen;
+    tree.forEachChild(r, [&](int slot, int c) {
+        TEST_ASSERT(tree.value(c) == slot);
+        seen.push_back(slot);
+    });
+    TEST_ASSERT(seen == (std::vector<int>{ 0, 3, 7, 8, 150, 299 }));
+
+    bool threw = false;
+    try { tree.createChild(r, 150, 0); }
+    catch (const std::runtime_error&) { threw = true; }
+    TEST_ASSERT(threw);
+
+    // Unlinking the middle, first and last siblings.
+    for (int slot : { 8, 0, 299 })
+    {
+        int c = tree.childIndex(r, slot);
+        tree.removeChild(r, slot);
+        TEST_ASSERT(tree.parentIndex(c) == -1 && tree.childIndex(r, slot) == -1);
+    }
+    tree.removeChild(r, 1);   // empty slot: no-op
+    seen.clear();
+    tree.forEachChild(r, [&](int slot, int) { seen.push_back(slot); });
+    TEST_ASSERT(seen == (std::vector<int>{ 3, 7, 150 }));
+    TEST_ASSERT(tree.eraseSubtree(tree.childIndex(r, 7)) == 1);
+    TEST_ASSERT(tree.childIndex(r, 3) != -1 && tree.childIndex(r, 150) != -1 && tree.childIndex(r, 7) == -1);
+
+    std::vector<int> in;
+    tree.inorderTraverse(r, [&](int, const int& v) { in.push_back(v); });
+    TEST_ASSERT(in == (std::vector<int>{ 3, -1, 150 }));
+
+    std::cout << "  sibling children tests passed" << std::endl;
+}
+
+template<class Policy>
+void run_tree_tests(const char* name)
+{
+    std::cout << " " << name << ":" << std::endl;
+    test_deep_chain_traversals<Policy>();
+    test_traversal_orders<Policy>();
+    test_relayout_random_tree<Policy>();
+    test_dirty_propagation<Policy>();
+    test_erase_and_reuse<Policy>();
+    test_compact<Policy>();
+    test_propagation_after_reuse<Policy>();
+}
+
+// ---- benchmark --------------------------------------------------------------
+
+/**
+ * Pre-order walk over a 1M-node scene hierarchy whose nodes were created in random
+ * attachment order, before and after relayout(): the unordered walk jumps around the
+ * value array, the pre-order layout reads it front to back.
+ */
+void bench_scene_traversal()
+{
+    struct Transform
+    {
+        float m[12];
+    };
+    constexpr int count = 1 << 20;
+    auto tree = make_random_tree<4, Transform>(count, 42);
+    for (int i = 0; i < count; ++i)
+        tree.value(i).m[0] = static_cast<float>(i & 7);
+
+    auto time_ms = [](auto&& fn) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        fn();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    };
+    auto walk = [&](double& sum) {
+        tree.preorderTraverse(tree.rootIndex(), [&](int, const Transform& t) { sum += t.m[0]; });
+    };
+    // Skip the descendants of one node in eight.
+    auto pruned_walk = [&](std::size_t& visited) {
+        tree.preorderTraversePruned(tree.rootIndex(), [&](int idx, const Transform& t) {
+            ++visited;
+            return t.m[0] != 0.0f || tree.parentIndex(idx) == -1;
+        });
+    };
+
+    double unordered_sum = 0, preorder_sum = 0, bfs_sum = 0;
+    std::size_t unordered_visited = 0, preorder_visited = 0;
+    const double unordered_ms = time_ms([&] { walk(unordered_sum); });
+    const double unordered_pruned_ms = time_ms([&] { pruned_walk(unordered_visited); });
+    const double relayout_ms = time_ms([&] { tree.relayout(lux::cxx::TreeLayout::PreOrder); });
+    const double preorder_ms = time_ms([&] { walk(preorder_sum); });
+    const double preorder_pruned_ms = time_ms([&] { pruned_walk(preorder_visited); });
+    tree.relayout(lux::cxx::TreeLayout::BreadthFirst);
+    const double bfs_ms = time_ms([&] { walk(bfs_sum); });
+    TEST_ASSERT(unordered_sum == preorder_sum && preorder_sum == bfs_sum);
+    TEST_ASSERT(unordered_visited == preorder_visited);
+
+    std::cout << "  pre-order walk over " << count << " nodes: unordered " << unordered_ms
+              << " ms, breadth-first layout " << bfs_ms << " ms, pre-order layout " << preorder_ms
+              << " ms (relayout " << relayout_ms << " ms)" << std::endl;
+    std::cout << "  pruned walk (" << preorder_visited << " visited): unordered " << unordered_pruned_ms
+              << " ms, pre-order layout " << preorder_pruned_ms << " ms" << std::endl;
+}
+
+/**
+ * World-transform update of a 1M-node scene: per-node recursion-style pre-order visits
+ * (looking up each parent) against the level-synchronous propagateDown, serial and on
+ * a pool, and against a frame where 1% of the nodes moved.
+ */
+void bench_transform_propagation()
+{
+    constexpr int count = 1 << 20;
+    auto tree = make_random_tree<4, SceneNode>(count, 11);
+    for (int i = 0; i < count; ++i)
+        set_translation(tree.value(i), float(i % 5), 1.0f, float(i % 3));
+
+    auto time_ms = [](auto&& fn) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        fn();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    };
+    auto visit_all = [&] {
+        tree.preorderTraverse(tree.rootIndex(), [&](int idx, const SceneNode&) {
+            int p = tree.parentIndex(idx);
+            compose(p == -1 ? nullptr : &tree.value(p), tree.value(idx));
+        });
+    };
+    auto update = [](int, const SceneNode* parent, SceneNode& node) { compose(parent, node); };
+    auto mark_all = [&] {
+        for (int i = 0; i < count; ++i)
+            tree.markDirty(i);
+    };
+
+    const double visit_ms = time_ms(visit_all);
+    tree.relayout(lux::cxx::TreeLayout::BreadthFirst);
+    mark_all();
+    const double serial_ms = time_ms([&] { tree.propagateDown(update); });
+    lux::cxx::ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    mark_all();
+    const double parallel_ms = time_ms([&] { tree.propagateDown(pool, update); });
+    std::mt19937 rng(5);
+    for (int k = 0; k < count / 100; ++k)
+        tree.markDirty(static_cast<int>(rng() % count));
+    const double sparse_ms = time_ms([&] { tree.propagateDown(pool, update); });
+    const double clean_ms = time_ms([&] { tree.propagateDown(pool, update); });
+
+    std::cout << "  world transforms over " << count << " nodes (" << tree.levelCount()
+              << " levels): pre-order visits " << visit_ms << " ms, propagateDown serial "
+              << serial_ms << " ms, on " << pool.thread_count() + 1 << " threads " << parallel_ms
+              << " ms, 1% dirty " << sparse_ms << " ms, clean " << clean_ms << " ms" << std::endl;
+}
+
+/**
+ * A 16-ary tree where most nodes have 0-2 children: child-link memory and walk times
+ * of the fixed slot arrays against first-child / next-sibling lists.
+ */
+template<class Policy>
+void bench_children_policy(const char* name)
+{
+    constexpr int count = 1 << 20;
+    using Tree = lux::cxx::IndexedNaryTreeSoA<float, 16, Policy>;
+
+    auto time_ms = [](auto&& fn) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        fn();
+        auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    };
+    Tree tree;
+    const double build_ms = time_ms([&] { tree = make_random_tree<16, float, Policy>(count, 23); });
+
+    double sum = 0;
+    std::size_t leaves = 0;
+    auto visit = [&](int, const float& v) { sum += v; };
+    const double pre_ms = time_ms([&] { tree.preorderTraverse(tree.rootIndex(), visit); });
+    const double post_ms = time_ms([&] { tree.postorderTraverse(tree.rootIndex(), visit); });
+    const double bfs_ms = time_ms([&] { tree.breadthFirstTraverse(tree.rootIndex(), visit); });
+    const double fanout_ms = time_ms([&] {
+        for (int i = 0; i < count; ++i)
+        {
+            bool leaf = true;
+            tree.forEachChild(i, [&](int, int) { leaf = false; });
+            leaves += leaf;
+        }
+    });
+    TEST_ASSERT(sum == 0 && leaves > 0);
+
+    std::cout << "  " << name << ": child links " << Tree::children_t::bytes_per_node * count / (1024 * 1024)
+              << " MiB (" << Tree::children_t::bytes_per_node << " B/node), build " << build_ms
+              << " ms, pre-order " << pre_ms << " ms, post-order " << post_ms << " ms, breadth-first "
+              << bfs_ms << " ms, child scan " << fanout_ms << " ms" << std::endl;
+}
+
+void bench_children_policies()
+{
+    std::cout << "  1M-node 16-ary tree, mostly 0-2 children per node:" << std::endl;
+    bench_children_policy<lux::cxx::FixedChildrenPolicy>("fixed slots  ");
+    bench_children_policy<lux::cxx::SiblingChildrenPolicy>("sibling lists");
+}
+
 int main()
 {
     using namespace lux::cxx;
@@ -66,5 +830,13 @@ int main()
         );
     }
 
+    std::cout << "\ntree tests:" << std::endl;
+    run_tree_tests<FixedChildrenPolicy>("fixed child slots");
+    run_tree_tests<SiblingChildrenPolicy>("sibling lists");
+    test_sibling_children();
+    bench_scene_traversal();
+    bench_transform_propagation();
+    bench_children_policies();
+    std::cout << "All tree tests passed!" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -7,6 +7,10 @@
  * Pointers returned by @c acquire() remain stable until @c release() is called
  * — the pool never relocates live objects.
  *
+ * Single-threaded pools additionally offer a handle-based API
+ * (@c acquire_handle() / @c get() / @c release(handle)) returning generational
+ * @c PoolHandle values that detect use-after-release in O(1).
+ *
  * Two thread-safety modes are available via the @c ThreadSafe template parameter:
  * - @c false (default): zero-overhead single-threaded path (no atomics).
  * - @c true : lock-free free list with per-thread cache to minimise CAS
@@ -38,12 +42,14 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <new>
 #include <type_traits>
 #include <utility>
 #include <vector>
 #include <mutex>
+#include <stdexcept>
 
 namespace lux::cxx
 {
@@ -142,6 +148,60 @@ namespace lux::cxx
         pool_type* pool_;
     };
 
+    // ═══════════════════════════════ PoolHandle ══════════════════════════════
+
+    /**
+     * @brief A generational handle returned by @c ObjectPool::acquire_handle().
+     *
+     * Mirrors @c SlotKey from the container module: the index addresses a slot
+     * as @c chunk * ChunkSize + offset, and the generation is bumped every time
+     * the slot is released, so stale handles are rejected by @c ObjectPool::get().
+     * With the default 32-bit fields a handle is half the size of a @c pool_ptr.
+     *
+     * @tparam T              Element type of the owning pool (acts as the type tag).
+     * @tparam IndexType      Unsigned integer type for the slot index.
+     * @tparam GenerationType Unsigned integer type for the generation counter.
+     */
+    template <typename T, typename IndexType = std::uint32_t, typename GenerationType = std::uint32_t>
+    struct PoolHandle
+    {
+        static_assert(std::is_unsigned_v<IndexType>, "PoolHandle: IndexType must be unsigned");
+        static_assert(std::is_unsigned_v<GenerationType>, "PoolHandle: GenerationType must be unsigned");
+
+        using value_type   = T;
+        using index_t      = IndexType;
+        using generation_t = GenerationType;
+
+        index_t      index = (std::numeric_limits<index_t>::max)();
+        generation_t gen   = 0;
+
+        /** @brief Returns true if this handle has never been assigned. */
+        [[nodiscard]] constexpr bool is_null() const noexcept
+        {
+            return index == (std::numeric_limits<index_t>::max)();
+        }
+
+        /** @brief Returns true if this handle refers to a potentially valid slot. */
+        [[nodiscard]] constexpr bool valid() const noexcept { return !is_null(); }
+
+        /** @brief Returns an explicitly invalid (null) handle. */
+        [[nodiscard]] static constexpr PoolHandle invalid() noexcept { return PoolHandle{}; }
+
+        [[nodiscard]] constexpr bool operator==(const PoolHandle&) const noexcept = default;
+        [[nodiscard]] constexpr bool operator!=(const PoolHandle&) const noexcept = default;
+
+        /** @brief Hash functor for use with std::unordered_map / std::unordered_set. */
+        struct Hash
+        {
+            constexpr std::size_t operator()(const PoolHandle& h) const noexcept
+            {
+                std::size_t v = static_cast<std::size_t>(h.index);
+                v ^= static_cast<std::size_t>(h.gen) + std::size_t(0x9e3779b9) + (v << 6) + (v >> 2);
+                return v;
+            }
+        };
+    };
+
     // ═══════════════════════════════ ObjectPool ══════════════════════════════
 
     // ─── implementation detail: free-list node stored inside free slots ──────
@@ -197,6 +257,14 @@ namespace lux::cxx
      * acquire/release calls, achieving near-single-threaded throughput
      * under contention.
      *
+     * @par Generational handles (`ThreadSafe = false` only)
+     * @c acquire_handle() hands out a @c PoolHandle instead of a raw pointer.
+     * Handle slots live in dedicated chunks with an index-based free list and
+     * a per-slot generation, so @c get() and @c is_valid() are O(1) and a
+     * released handle can never alias the object that later reuses its slot.
+     * Handle slots and pointer slots are never mixed: a handle must be
+     * released through @c release(handle_type).
+     *
      * @tparam T          Element type. Must satisfy @c std::is_destructible.
      * @tparam ChunkSize  Number of elements per chunk (default 64).
      * @tparam ThreadSafe If true, acquire/release are safe to call from
@@ -214,8 +282,9 @@ namespace lux::cxx
 
     public:
         using value_type = T;
-        using pointer    = T*;
-        using size_type  = std::size_t;
+        using pointer     = T*;
+        using size_type   = std::size_t;
+        using handle_type = PoolHandle<T>;
 
         // ─── construction / destruction ─────────────────────────────────
 
@@ -299,11 +368,90 @@ namespace lux::cxx
                 acquire(std::forward<Args>(args)...), this);
         }
 
+        // ─── generational handles ───────────────────────────────────────
+
+        /**
+         * @brief Acquires a handle slot and constructs a @c T in-place.
+         *
+         * @tparam Args  Constructor argument types.
+         * @param  args  Arguments forwarded to @c T's constructor.
+         * @return A generational handle to the newly constructed object.
+         *
+         * Complexity: O(1) amortised. May allocate a new chunk if the handle
+         * free list is empty.
+         *
+         * @throws std::length_error if the handle index space is exhausted.
+         */
+        template <typename... Args>
+        [[nodiscard]] handle_type acquire_handle(Args&&... args) requires (!ThreadSafe)
+        {
+            if (handle_free_head_ == INVALID_HANDLE_INDEX)
+                grow_handles();
+
+            const handle_index_t idx = handle_free_head_;
+            new (slot_at(idx)) T(std::forward<Args>(args)...);
+
+            // Pop only after construction succeeded, so a throwing constructor
+            // leaves the free list untouched.
+            auto& meta = handle_slots_[idx];
+            handle_free_head_ = meta.next_free;
+            return handle_type{ idx, meta.generation };
+        }
+
+        /**
+         * @brief Destroys the object referenced by @p handle and recycles its slot.
+         * @return True if the object was released, false if the handle was stale or null.
+         */
+        bool release(handle_type handle) noexcept requires (!ThreadSafe)
+        {
+            if (!is_valid(handle))
+                return false;
+
+            std::launder(reinterpret_cast<T*>(slot_at(handle.index)))->~T();
+
+            auto& meta = handle_slots_[handle.index];
+            // Generation 0 is reserved for slots that never belong to a handle chunk.
+            if (++meta.generation == 0)
+                meta.generation = 1;
+            meta.next_free    = handle_free_head_;
+            handle_free_head_ = handle.index;
+            return true;
+        }
+
+        /**
+         * @brief Checks whether @p handle still refers to a live object.
+         */
+        [[nodiscard]] bool is_valid(handle_type handle) const noexcept requires (!ThreadSafe)
+        {
+            if (handle.is_null() || handle.index >= handle_slots_.size())
+                return false;
+            return handle_slots_[handle.index].generation == handle.gen;
+        }
+
+        /**
+         * @brief Returns a pointer to the object, or nullptr if the handle is stale.
+         */
+        [[nodiscard]] pointer get(handle_type handle) noexcept requires (!ThreadSafe)
+        {
+            if (!is_valid(handle))
+                return nullptr;
+            return std::launder(reinterpret_cast<T*>(slot_at(handle.index)));
+        }
+
+        [[nodiscard]] const T* get(handle_type handle) const noexcept requires (!ThreadSafe)
+        {
+            if (!is_valid(handle))
+                return nullptr;
+            return std::launder(reinterpret_cast<const T*>(slot_at(handle.index)));
+        }
+
         // ─── capacity ───────────────────────────────────────────────────
 
         /**
          * @brief Pre-allocates enough chunks so that at least @p n objects
          *        can be acquired without further allocation.
+         *
+         * Chunks reserved for handle slots do not count towards @p n.
          */
         void reserve(size_type n)
         {
@@ -312,10 +460,21 @@ namespace lux::cxx
         }
 
         /**
-         * @brief Returns the total number of slots (free + in-use) across all chunks.
+         * @brief Returns the number of slots (free + in-use) served by acquire().
+         *
+         * Slots of chunks reserved for generational handles are reported by
+         * handle_capacity() instead.
          */
         [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
 
+        /**
+         * @brief Returns the number of handle slots (free + in-use).
+         */
+        [[nodiscard]] size_type handle_capacity() const noexcept requires (!ThreadSafe)
+        {
+            return handle_capacity_;
+        }
+
         /**
          * @brief Returns the number of currently allocated chunks.
          */
@@ -558,9 +717,7 @@ namespace lux::cxx
          */
         void grow()
         {
-            // Allocate raw memory for ChunkSize slots.
-            void* raw = ::operator new(SLOT_SIZE * ChunkSize, std::align_val_t{SLOT_ALIGN});
-            chunks_.push_back(raw);
+            void* raw = allocate_chunk();
             capacity_ += ChunkSize;
 
             // Thread slots into the free list in reverse order so that the
@@ -608,14 +765,88 @@ namespace lux::cxx
             }
         }
 
+        /**
+         * @brief Allocates raw memory for ChunkSize slots and registers the chunk.
+         */
+        void* allocate_chunk()
+        {
+            void* raw = ::operator new(SLOT_SIZE * ChunkSize, std::align_val_t{SLOT_ALIGN});
+            try
+            {
+                chunks_.push_back(raw);
+            }
+            catch (...)
+            {
+                ::operator delete(raw, std::align_val_t{SLOT_ALIGN});
+                throw;
+            }
+            return raw;
+        }
+
+        // ═══ Handle slots ═══════════════════════════════════════════════
+
+        using handle_index_t = typename handle_type::index_t;
+
+        static constexpr handle_index_t INVALID_HANDLE_INDEX =
+            (std::numeric_limits<handle_index_t>::max)();
+
+        /**
+         * @brief Per-slot bookkeeping for the handle API, indexed by global slot index.
+         *
+         * Entries belonging to pointer chunks keep generation 0 so that no
+         * handle can ever validate against them.
+         */
+        struct HandleSlot
+        {
+            typename handle_type::generation_t generation = 0;
+            handle_index_t                     next_free  = INVALID_HANDLE_INDEX;
+        };
+
+        /**
+         * @brief Returns the address of global slot @p idx (chunk-indexed addressing).
+         */
+        [[nodiscard]] void* slot_at(size_type idx) const noexcept
+        {
+            return static_cast<std::byte*>(chunks_[idx / ChunkSize]) + (idx % ChunkSize) * SLOT_SIZE;
+        }
+
+        /**
+         * @brief Allocates a chunk reserved for handle slots and threads its
+         *        indices onto the handle free list.
+         */
+        void grow_handles()
+        {
+            const size_type first = chunks_.size() * ChunkSize;
+            if (first + ChunkSize > INVALID_HANDLE_INDEX)
+                throw std::length_error("ObjectPool: handle index space exhausted");
+
+            handle_slots_.resize(first + ChunkSize);
+            allocate_chunk();
+            handle_capacity_ += ChunkSize;
+
+            // Thread in reverse so that the first slot of the chunk is popped first.
+            for (size_type i = ChunkSize; i-- > 0;)
+            {
+                auto& meta      = handle_slots_[first + i];
+                meta.generation = 1;
+                meta.next_free  = handle_free_head_;
+                handle_free_head_ = static_cast<handle_index_t>(first + i);
+            }
+        }
+
         // ═══ Data members ═══════════════════════════════════════════════
 
         std::vector<void*> chunks_;           ///< Pointers to allocated chunks.
-        size_type          capacity_ = 0;     ///< Total slot count across all chunks.
+        size_type          capacity_ = 0;     ///< Slot count of the chunks serving acquire().
 
         // ─── single-threaded free list ──────────────────────────────────
         detail::FreeNode* free_head_st_ = nullptr;
 
+        // ─── generational handle slots (single-threaded only) ───────────
+        std::vector<HandleSlot> handle_slots_;
+        handle_index_t          handle_free_head_ = INVALID_HANDLE_INDEX;
+        size_type               handle_capacity_  = 0; ///< Slot count of handle chunks.
+
         // ─── lock-free free list + thread-local cache ───────────────────
         // alignas(64) avoids false sharing with adjacent members.
         alignas(64) std::atomic<detail::TaggedPtr> free_head_lf_{};
@@ -421,6 +421,150 @@ void test_large_aligned_objects()
     std::cout << "passed\n";
 }
 
+// ─── 15. generational handles ──────────────────────────────────────────────
+
+void test_handle_acquire_release()
+{
+    std::cout << "  handle acquire/release ... ";
+    reset_counters();
+
+    lux::cxx::ObjectPool<Tracked, 4, false> pool;
+
+    auto h = pool.acquire_handle(7);
+    assert(h.valid());
+    assert(pool.is_valid(h));
+    assert(pool.get(h) != nullptr);
+    assert(pool.get(h)->value == 7);
+
+    assert(pool.release(h));
+    assert(!pool.is_valid(h));
+    assert(pool.get(h) == nullptr);
+    assert(!pool.release(h)); // double release is detected
+
+    // Null handle never validates.
+    lux::cxx::ObjectPool<Tracked, 4, false>::handle_type null_handle;
+    assert(null_handle.is_null());
+    assert(!pool.is_valid(null_handle));
+
+    assert(g_ctor_count.load() == 1);
+    assert(g_dtor_count.load() == 1);
+
+    std::cout << "passed\n";
+}
+
+// ─── 16. stale handles after slot reuse ────────────────────────────────────
+
+void test_handle_generation_reuse()
+{
+    std::cout << "  handle generation reuse ... ";
+
+    lux::cxx::ObjectPool<int, 4, false> pool;
+
+    auto a = pool.acquire_handle(1);
+    pool.release(a);
+
+    // LIFO reuse hands back the same slot with a bumped generation.
+    auto b = pool.acquire_handle(2);
+    assert(b.index == a.index);
+    assert(b.gen != a.gen);
+    assert(pool.get(a) == nullptr);
+    assert(*pool.get(b) == 2);
+
+    pool.release(b);
+
+    std::cout << "passed\n";
+}
+
+// ─── 17. handle stability across chunks, mixed with raw pointers ──────────
+
+void test_handle_stability_mixed()
+{
+    std::cout << "  handle stability (mixed with pointers) ... ";
+
+    lux::cxx::ObjectPool<int, 4, false> pool;
+
+    std::vector<int*> ptrs;
+    std::vector<lux::cxx::ObjectPool<int, 4, false>::handle_type> handles;
+    for (int i = 0; i < 20; ++i)
+    {
+        ptrs.push_back(pool.acquire(-i));
+        handles.push_back(pool.acquire_handle(i));
+    }
+
+    std::vector<int*> addrs;
+    for (auto h : handles)
+        addrs.push_back(pool.get(h));
+
+    // Handle slots never alias pointer slots.
+    std::set<int*> unique(addrs.begin(), addrs.end());
+    unique.insert(ptrs.begin(), ptrs.end());
+    assert(unique.size() == 40);
+
+    // Release every other handle; survivors keep their address and value.
+    for (std::size_t i = 0; i < handles.size(); i += 2)
+        assert(pool.release(handles[i]));
+    for (std::size_t i = 1; i < handles.size(); i += 2)
+    {
+        assert(pool.get(handles[i]) == addrs[i]);
+        assert(*pool.get(handles[i]) == static_cast<int>(i));
+    }
+
+    // A handle is the same size as a raw pointer and half a pool_ptr.
+    static_assert(sizeof(lux::cxx::PoolHandle<int>) == 8);
+    static_assert(sizeof(lux::cxx::pool_ptr<int, 4, false>) == 2 * sizeof(void*));
+
+    for (std::size_t i = 1; i < handles.size(); i += 2)
+        pool.release(handles[i]);
+    for (auto* p : ptrs)
+        pool.release(p);
+
+    std::cout << "passed\n";
+}
+
+// ─── 18. reserve after handle growth ──────────────────────────────────────
+
+void test_reserve_after_handle_growth()
+{
+    std::cout << "  reserve after handle growth ... ";
+
+    lux::cxx::ObjectPool<int, 4, false> pool;
+    auto h = pool.acquire_handle(1);
+    assert(pool.handle_capacity() == 4);
+    assert(pool.capacity() == 0);
+
+    // The handle chunk must not satisfy a reservation for acquire().
+    pool.reserve(4);
+    assert(pool.capacity() == 4);
+    const std::size_t chunks = pool.chunk_count();
+
+    std::vector<int*> ptrs;
+    for (int i = 0; i < 4; ++i)
+        ptrs.push_back(pool.acquire(i));
+    assert(pool.chunk_count() == chunks);
+
+    for (auto* p : ptrs)
+        pool.release(p);
+    pool.release(h);
+
+    std::cout << "passed\n";
+}
+
+// ─── 19. handle hash ───────────────────────────────────────────────────────
+
+void test_handle_hash()
+{
+    std::cout << "  handle hash ... ";
+
+    using Handle = lux::cxx::PoolHandle<int>;
+    Handle::Hash hasher;
+    Handle a{ 1, 1 };
+    Handle b{ 1, 2 };
+    assert(hasher(a) == hasher(Handle{ 1, 1 }));
+    assert(a != b);
+
+    std::cout << "passed\n";
+}
+
 // ─── main ───────────────────────────────────────────────────────────────────
 
 int main()
@@ -437,6 +581,13 @@ int main()
     test_move_only_types();
     test_large_aligned_objects();
 
+    std::cout << "\nObjectPool tests (generational handles):\n";
+    test_handle_acquire_release();
+    test_handle_generation_reuse();
+    test_handle_stability_mixed();
+    test_reserve_after_handle_growth();
+    test_handle_hash();
+
     std::cout << "\nObjectPool tests (lock-free):\n";
     test_lockfree_basic();
     test_lockfree_pool_ptr();